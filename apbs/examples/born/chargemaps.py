@@ -0,0 +1,60 @@
+#!/usr/bin/env python
+
+"""
+Write the charge maps of apbs-mol-blockmaps.in and apbs-mol-chargemaps.in:
+Gaussian charge clouds around the ion of ion.xml, in OpenDX format
+"""
+
+import math
+
+# Map grid, a little larger than the 24 A calculation grid
+npts = 49
+origin = -15.0
+delta = 30.0 / (npts - 1)
+sigma = 1.0
+
+# (charge, x, y, z) of the clouds in each map
+maps = (
+    ((1.0, 0.0, 0.0, 0.0),),
+    ((-1.0, 2.5, 0.0, 0.0),),
+    ((1.0, 0.0, -3.0, 1.0), (-1.0, 0.0, 3.0, -1.0)),
+    ((2.0, -2.0, 2.0, 0.0),),
+)
+
+
+def density(clouds, x, y, z):
+    """ Charge density (e/A^3) of a set of clouds at a point """
+    norm = 1.0 / math.pow(2.0 * math.pi * sigma * sigma, 1.5)
+    value = 0.0
+    for (q, cx, cy, cz) in clouds:
+        r2 = (x - cx) ** 2 + (y - cy) ** 2 + (z - cz) ** 2
+        value += q * norm * math.exp(-0.5 * r2 / (sigma * sigma))
+    return value
+
+
+for (imap, clouds) in enumerate(maps):
+    name = "chargemap-%d.dx" % (imap + 1)
+    out = open(name, "w")
+    out.write("# Charge map %d for the born block solve example\n" % (imap + 1))
+    out.write("object 1 class gridpositions counts %d %d %d\n" % (npts, npts, npts))
+    out.write("origin %12.6e %12.6e %12.6e\n" % (origin, origin, origin))
+    out.write("delta %12.6e %12.6e %12.6e\n" % (delta, 0.0, 0.0))
+    out.write("delta %12.6e %12.6e %12.6e\n" % (0.0, delta, 0.0))
+    out.write("delta %12.6e %12.6e %12.6e\n" % (0.0, 0.0, delta))
+    out.write("object 2 class gridconnections counts %d %d %d\n" % (npts, npts, npts))
+    out.write("object 3 class array type double rank 0 items %d data follows\n" % (npts ** 3))
+    values = []
+    for i in range(npts):
+        for j in range(npts):
+            for k in range(npts):
+                values.append(density(clouds, origin + i * delta,
+                                      origin + j * delta, origin + k * delta))
+    for n in range(0, len(values), 3):
+        out.write(" ".join(["%12.6e" % v for v in values[n:n + 3]]) + "\n")
+    out.write("attribute \"dep\" string \"positions\"\n")
+    out.write("object \"regular positions regular connections\" class field\n")
+    out.write("component \"positions\" value 1\n")
+    out.write("component \"connections\" value 2\n")
+    out.write("component \"data\" value 3\n")
+    out.close()
+    print("Wrote %s" % name)
@@ -0,0 +1,23 @@
+// Checks for x86 intrinsics, per-function target attributes and CPUID
+// dispatch, as used by src/pmgc/simdd.c
+
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) static double sum_avx2(double *p) {
+    __m256d v = _mm256_loadu_pd(p);
+    v = _mm256_permute4x64_pd(v, 0xD8);
+    return _mm256_cvtsd_f64(v);
+}
+
+__attribute__((target("avx512f"))) static double sum_avx512(double *p) {
+    __m512d v = _mm512_loadu_pd(p);
+    return _mm512_reduce_add_pd(v);
+}
+
+int main() {
+    double p[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return (int)sum_avx512(p);
+    if (__builtin_cpu_supports("avx2")) return (int)sum_avx2(p);
+    return 0;
+}
@@ -87,6 +87,8 @@
 //#include "geoflow/cpbconcz2.h"
 
 /* MG headers */
+#include "mg/varena.h"
+#include "mg/vdhtree.h"
 #include "mg/vgrid.h"
 #include "mg/vmgrid.h"
 #include "mg/vopot.h"
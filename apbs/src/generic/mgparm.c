@@ -169,6 +169,44 @@ VPUBLIC Vrc_Codes MGparm_ctor2(MGparm *thee, MGparm_CalcType type) {
     thee->useAqua = 0;
     thee->setUseAqua = 0;
 
+    thee->mgsmoo = 1;
+    thee->setmgsmoo = 0;
+
+    thee->mgdisc = 0;
+    thee->setmgdisc = 0;
+
+    thee->mgprec = 0;
+    thee->setmgprec = 0;
+
+    thee->mgsolv = 1;
+    thee->setmgsolv = 0;
+
+    thee->mgkey = 0;
+    thee->setmgkey = 0;
+
+    thee->reuseops = 0;
+    thee->setreuseops = 0;
+
+    thee->warmstart = 0;
+    thee->setwarmstart = 0;
+
+    thee->reusemaps = 0;
+    thee->setreusemaps = 0;
+
+    thee->nblockmaps = 0;
+    thee->setblockmaps = 0;
+
+    thee->pagemap = 0;
+    thee->setpagemap = 0;
+
+    thee->bctol = 0.0;
+    thee->setbctol = 0;
+
+    thee->simd = -1;
+    thee->setsimd = 0;
+
+    thee->setmethod = 0;
+
     return VRC_SUCCESS;
 }
 
@@ -225,6 +263,12 @@ VPUBLIC Vrc_Codes MGparm_check(MGparm *thee) {
         }
     }
 
+    /* The maps are solved on the grid of one calculation, not focused */
+    if (thee->setblockmaps && (thee->type != MCT_MANUAL)) {
+        Vnm_print(2, "MGparm_check:  BLOCKMAPS needs mg-manual!\n");
+        rc = VRC_FAILURE;
+    }
+
     /* Check sequential and parallel automatic focusing settings */
     if ((thee->type == MCT_AUTO) || (thee->type == MCT_PARALLEL)) {
         if (!thee->setcglen) {
@@ -406,10 +450,47 @@ VPUBLIC void MGparm_copy(MGparm *thee, MGparm *parm) {
     thee->setnonlintype = parm->setnonlintype;
 
     thee->method = parm->method;
-    thee->method = parm->method;
+    thee->setmethod = parm->setmethod;
 
     thee->useAqua = parm->useAqua;
     thee->setUseAqua = parm->setUseAqua;
+
+    thee->mgsmoo = parm->mgsmoo;
+    thee->setmgsmoo = parm->setmgsmoo;
+
+    thee->mgdisc = parm->mgdisc;
+    thee->setmgdisc = parm->setmgdisc;
+
+    thee->mgprec = parm->mgprec;
+    thee->setmgprec = parm->setmgprec;
+
+    thee->mgsolv = parm->mgsolv;
+    thee->setmgsolv = parm->setmgsolv;
+
+    thee->mgkey = parm->mgkey;
+    thee->setmgkey = parm->setmgkey;
+
+    thee->reuseops = parm->reuseops;
+    thee->setreuseops = parm->setreuseops;
+
+    thee->warmstart = parm->warmstart;
+    thee->setwarmstart = parm->setwarmstart;
+
+    thee->reusemaps = parm->reusemaps;
+    thee->setreusemaps = parm->setreusemaps;
+
+    thee->nblockmaps = parm->nblockmaps;
+    for (i=0; i<MGPARM_MAXMAPS; i++) thee->blockmaps[i] = parm->blockmaps[i];
+    thee->setblockmaps = parm->setblockmaps;
+
+    thee->pagemap = parm->pagemap;
+    thee->setpagemap = parm->setpagemap;
+
+    thee->bctol = parm->bctol;
+    thee->setbctol = parm->setbctol;
+
+    thee->simd = parm->simd;
+    thee->setsimd = parm->setsimd;
 }
 
 VPRIVATE Vrc_Codes MGparm_parseDIME(MGparm *thee, Vio *sock) {
@@ -916,6 +997,281 @@ VPRIVATE Vrc_Codes MGparm_parseUSEAQUA(MGparm *thee, Vio *sock) {
     return VRC_SUCCESS;
 }
 
+VPRIVATE Vrc_Codes MGparm_parseMGSMOO(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    int ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%d", &ti) == 1) {
+        if ((ti != 1) && (ti != 4) && (ti != 5) && (ti != 6)) {
+            Vnm_print(2, "NOsh:  Unsupported mgsmoo value (%d)!\n", ti);
+            return VRC_WARNING;
+        }
+        thee->mgsmoo = ti;
+    } else if (Vstring_strcasecmp(tok, "gs") == 0) {
+        thee->mgsmoo = 1;
+    } else if (Vstring_strcasecmp(tok, "cghs") == 0) {
+        thee->mgsmoo = 4;
+    } else if (Vstring_strcasecmp(tok, "mcgs") == 0) {
+        thee->mgsmoo = 5;
+    } else if (Vstring_strcasecmp(tok, "cheb") == 0) {
+        thee->mgsmoo = 6;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+mgsmoo!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmgsmoo = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseMGDISC(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    int ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%d", &ti) == 1) {
+        if ((ti != 0) && (ti != 2)) {
+            Vnm_print(2, "NOsh:  Unsupported mgdisc value (%d)!\n", ti);
+            return VRC_WARNING;
+        }
+        thee->mgdisc = ti;
+    } else if (Vstring_strcasecmp(tok, "box") == 0) {
+        thee->mgdisc = 0;
+    } else if (Vstring_strcasecmp(tok, "matfree") == 0) {
+        thee->mgdisc = 2;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+mgdisc!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmgdisc = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseMGSOLV(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    int ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%d", &ti) == 1) {
+        if ((ti < 0) || (ti > 2)) {
+            Vnm_print(2, "NOsh:  Unsupported mgsolv value (%d)!\n", ti);
+            return VRC_WARNING;
+        }
+        thee->mgsolv = ti;
+    } else if (Vstring_strcasecmp(tok, "cghs") == 0) {
+        thee->mgsolv = 0;
+    } else if (Vstring_strcasecmp(tok, "band") == 0) {
+        thee->mgsolv = 1;
+    } else if (Vstring_strcasecmp(tok, "sparse") == 0) {
+        thee->mgsolv = 2;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+mgsolv!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmgsolv = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseMGKEY(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    int ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%d", &ti) == 1) {
+        if ((ti != 0) && (ti != 1)) {
+            Vnm_print(2, "NOsh:  Unsupported mgkey value (%d)!\n", ti);
+            return VRC_WARNING;
+        }
+        thee->mgkey = ti;
+    } else if (Vstring_strcasecmp(tok, "vcycle") == 0) {
+        thee->mgkey = 0;
+    } else if (Vstring_strcasecmp(tok, "fmg") == 0) {
+        thee->mgkey = 1;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+mgkey!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmgkey = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parsePRECISION(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (Vstring_strcasecmp(tok, "double") == 0) {
+        thee->mgprec = 0;
+    } else if (Vstring_strcasecmp(tok, "mixed") == 0) {
+        thee->mgprec = 1;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+precision!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmgprec = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseREUSEOPS(MGparm *thee, Vio *sock) {
+    Vnm_print(0, "NOsh: parsed reuseops\n");
+    thee->reuseops = 1;
+    thee->setreuseops = 1;
+    return VRC_SUCCESS;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseWARMSTART(MGparm *thee, Vio *sock) {
+    Vnm_print(0, "NOsh: parsed warmstart (experimental)\n");
+    thee->warmstart = 1;
+    thee->setwarmstart = 1;
+    return VRC_SUCCESS;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseREUSEMAPS(MGparm *thee, Vio *sock) {
+    Vnm_print(0, "NOsh: parsed reusemaps\n");
+    thee->reusemaps = 1;
+    thee->setreusemaps = 1;
+    return VRC_SUCCESS;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseBLOCKMAPS(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    int i, ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%d", &ti) == 0) {
+        Vnm_print(2, "NOsh:  Read non-integer (%s) while parsing blockmaps \
+keyword!\n", tok);
+        return VRC_WARNING;
+    } else if ((ti < 1) || (ti > MGPARM_MAXMAPS)) {
+        Vnm_print(2, "parseMG:  blockmaps takes 1 to %d charge maps!\n",
+                  MGPARM_MAXMAPS);
+        return VRC_WARNING;
+    }
+    thee->nblockmaps = ti;
+    for (i=0; i<thee->nblockmaps; i++) {
+        VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+        if (sscanf(tok, "%d", &ti) == 0) {
+            Vnm_print(2, "NOsh:  Read non-integer (%s) while parsing \
+blockmaps keyword!\n", tok);
+            return VRC_WARNING;
+        }
+        thee->blockmaps[i] = ti;
+    }
+    thee->setblockmaps = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parsePAGEMAP(MGparm *thee, Vio *sock) {
+    Vnm_print(0, "NOsh: parsed pagemap\n");
+    thee->pagemap = 1;
+    thee->setpagemap = 1;
+    return VRC_SUCCESS;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseBCTOL(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+    double tf;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (sscanf(tok, "%lf", &tf) == 0) {
+        Vnm_print(2, "NOsh:  Read non-float (%s) while parsing bctol \
+keyword!\n", tok);
+        return VRC_WARNING;
+    } else if ((tf < 0.0) || (tf >= 1.0)) {
+        Vnm_print(2, "parseMG:  bctol must be at least 0 and less than 1!\n");
+        return VRC_WARNING;
+    } else thee->bctol = tf;
+    thee->setbctol = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseSIMD(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (Vstring_strcasecmp(tok, "auto") == 0) {
+        thee->simd = -1;
+    } else if (Vstring_strcasecmp(tok, "scalar") == 0) {
+        thee->simd = 0;
+    } else if (Vstring_strcasecmp(tok, "avx2") == 0) {
+        thee->simd = 1;
+    } else if (Vstring_strcasecmp(tok, "avx512") == 0) {
+        thee->simd = 2;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+simd!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setsimd = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
+VPRIVATE Vrc_Codes MGparm_parseSOLVER(MGparm *thee, Vio *sock) {
+
+    char tok[VMAX_BUFSIZE];
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (Vstring_strcasecmp(tok, "mg") == 0) {
+        thee->method = VSOL_MG;
+    } else if (Vstring_strcasecmp(tok, "cgmg") == 0) {
+        thee->method = VSOL_CGMG;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) when parsing \
+solver!\n", tok);
+        return VRC_WARNING;
+    }
+    thee->setmethod = 1;
+    return VRC_SUCCESS;
+
+    VERROR1:
+        Vnm_print(2, "parseMG:  ran out of tokens!\n");
+        return VRC_WARNING;
+}
+
 VPUBLIC Vrc_Codes MGparm_parseToken(MGparm *thee, char tok[VMAX_BUFSIZE],
   Vio *sock) {
 
@@ -964,6 +1320,32 @@ VPUBLIC Vrc_Codes MGparm_parseToken(MGparm *thee, char tok[VMAX_BUFSIZE],
         return MGparm_parseGAMMA(thee, sock);
     } else if (Vstring_strcasecmp(tok, "useaqua") == 0) {
         return MGparm_parseUSEAQUA(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "mgsmoo") == 0) {
+        return MGparm_parseMGSMOO(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "mgdisc") == 0) {
+        return MGparm_parseMGDISC(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "mgsolv") == 0) {
+        return MGparm_parseMGSOLV(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "mgkey") == 0) {
+        return MGparm_parseMGKEY(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "solver") == 0) {
+        return MGparm_parseSOLVER(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "precision") == 0) {
+        return MGparm_parsePRECISION(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "reuseops") == 0) {
+        return MGparm_parseREUSEOPS(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "warmstart") == 0) {
+        return MGparm_parseWARMSTART(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "reusemaps") == 0) {
+        return MGparm_parseREUSEMAPS(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "blockmaps") == 0) {
+        return MGparm_parseBLOCKMAPS(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "pagemap") == 0) {
+        return MGparm_parsePAGEMAP(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "bctol") == 0) {
+        return MGparm_parseBCTOL(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "simd") == 0) {
+        return MGparm_parseSIMD(thee, sock);
     } else {
         Vnm_print(2, "parseMG:  Unrecognized keyword (%s)!\n", tok);
         return VRC_WARNING;
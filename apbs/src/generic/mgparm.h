@@ -70,6 +70,11 @@
 #include "generic/vhal.h"
 #include "generic/vstring.h"
 
+/** @brief   Number of charge maps one calculation can solve for in a block
+ *  @ingroup MGparm
+ */
+#define MGPARM_MAXMAPS 20
+
 /**
  * @brief  Calculation type
  * @ingroup MGparm
@@ -189,11 +194,62 @@ struct sMGparm {
     int nonlintype; /**< Linearity Type Method to be used */
     int setnonlintype; /**< Flag, @see nonlintype */
 
-    int method;		/**< Solver Method */
+    int method;		/**< Solver Method; the "solver {mg|cgmg}" keyword picks
+                      VSOL_MG or VSOL_CGMG for the linearized PBE */
     int setmethod; /**< Flag, @see method */
 
     int useAqua;  /**< Enable use of lpbe/aqua */
     int setUseAqua; /**< Flag, @see useAqua */
+
+    int mgsmoo;  /**< Multigrid smoothing method; see Vpmgp::mgsmoo */
+    int setmgsmoo;  /**< Flag, @see mgsmoo */
+
+    int mgdisc;  /**< Fine grid discretization; see Vpmgp::mgdisc */
+    int setmgdisc;  /**< Flag, @see mgdisc */
+
+    int mgprec;  /**< Multigrid precision; see Vpmgp::mgprec */
+    int setmgprec;  /**< Flag, @see mgprec */
+
+    int mgsolv;  /**< Coarsest level solver; see Vpmgp::mgsolv */
+    int setmgsolv;  /**< Flag, @see mgsolv */
+
+    int mgkey;  /**< Multigrid method; see Vpmgp::mgkey */
+    int setmgkey;  /**< Flag, @see mgkey */
+
+    int reuseops;  /**< Keep the multigrid hierarchy between solves on the
+                     same coefficients; see Vpmgp::reuseops */
+    int setreuseops;  /**< Flag, @see reuseops */
+
+    int warmstart;  /**< Start each solve from the potential of the previous
+                      calculation (interpolated onto this grid) instead of
+                      zero; experimental, see Vpmg_setGuessPmg */
+    int setwarmstart;  /**< Flag, @see warmstart */
+
+    int reusemaps;  /**< Build the coefficient maps from those of the
+                      previous calculation when only a few atoms differ;
+                      see Vpmg_fillcoFrom */
+    int setreusemaps;  /**< Flag, @see reusemaps */
+
+    int nblockmaps;  /**< Number of charge maps solved for after the
+                       calculation itself, in one block solve on its
+                       operator; see Vpmg_solveMaps */
+    int blockmaps[MGPARM_MAXMAPS];  /**< IDs of those charge maps (starting
+                                      at 1) */
+    int setblockmaps;  /**< Flag, @see nblockmaps */
+
+    int pagemap;  /**< Report on which NUMA node the pages of the grid arrays
+                    ended up; see Vpmgp::pagemap */
+    int setpagemap;  /**< Flag, @see pagemap */
+
+    double bctol;  /**< Relative accuracy of the treecode for bcfl mdh
+                     boundary values (0 sums every atom directly); see
+                     Vpmgp::bctol */
+    int setbctol;  /**< Flag, @see bctol */
+
+    int simd;  /**< Highest instruction set for the vectorized kernels
+                 (-1 = detected, 0 = scalar, 1 = AVX2, 2 = AVX-512); see
+                 Vpmgp::simd */
+    int setsimd;  /**< Flag, @see simd */
 };
 
 /** @typedef MGparm
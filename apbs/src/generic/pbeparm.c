@@ -138,6 +138,7 @@ VPUBLIC int PBEparm_ctor2(PBEparm *thee) {
     thee->settemp = 0;
     thee->setcalcenergy = 0;
     thee->setcalcforce = 0;
+    thee->setnewton = 0;
     thee->setsdens = 0;
     thee->numwrite = 0;
     thee->setwritemat = 0;
@@ -216,7 +217,8 @@ VPUBLIC int PBEparm_check(PBEparm *thee) {
         Vnm_print(2, "PBEparm_check: PDIE not set!\n");
         return 0;
     }
-    if (((thee->srfm==VSM_MOL) || (thee->srfm==VSM_MOLSMOOTH)) \
+    if (((thee->srfm==VSM_MOL) || (thee->srfm==VSM_MOLSMOOTH) || \
+         (thee->srfm==VSM_MOLEDT) || (thee->srfm==VSM_MOLSMOOTHEDT)) \
       && (!thee->setsdens) && (thee->srad > VSMALL)) {
         Vnm_print(2, "PBEparm_check: SDENS not set!\n");
         return 0;
@@ -229,7 +231,8 @@ VPUBLIC int PBEparm_check(PBEparm *thee) {
         Vnm_print(2, "PBEparm_check: SRFM not set!\n");
         return 0;
     }
-    if (((thee->srfm==VSM_MOL) || (thee->srfm==VSM_MOLSMOOTH)) \
+    if (((thee->srfm==VSM_MOL) || (thee->srfm==VSM_MOLSMOOTH) || \
+         (thee->srfm==VSM_MOLEDT) || (thee->srfm==VSM_MOLSMOOTHEDT)) \
       && (!thee->setsrad)) {
         Vnm_print(2, "PBEparm_check: SRAD not set!\n");
         return 0;
@@ -252,6 +255,7 @@ VPUBLIC int PBEparm_check(PBEparm *thee) {
     }
     if (!thee->setcalcenergy) thee->calcenergy = PCE_NO;
     if (!thee->setcalcforce) thee->calcforce = PCF_NO;
+    if (!thee->setnewton) thee->newton = 0;
     if (!thee->setwritemat) thee->writemat = 0;
 
     /*--------------------------------------------------------*/
@@ -327,6 +331,8 @@ VPUBLIC void PBEparm_copy(PBEparm *thee, PBEparm *parm) {
     thee->setcalcenergy = parm->setcalcenergy;
     thee->calcforce = parm->calcforce;
     thee->setcalcforce = parm->setcalcforce;
+    thee->newton = parm->newton;
+    thee->setnewton = parm->setnewton;
 
     /*----------------------------------------------------*/
     /* Added by Michael Grabe                             */
@@ -736,6 +742,12 @@ statement.\n", ti);
             case VSM_SPLINE4:
                 Vnm_print(2, "spl4");
                 break;
+            case VSM_MOLEDT:
+                Vnm_print(2, "mol-edt");
+                break;
+            case VSM_MOLSMOOTHEDT:
+                Vnm_print(2, "smol-edt");
+                break;
             default:
                 Vnm_print(2, "UNKNOWN");
                 break;
@@ -764,6 +776,14 @@ statement.\n", ti);
         thee->srfm = VSM_SPLINE4;
         thee->setsrfm = 1;
         return 1;
+    } else if (Vstring_strcasecmp(tok, "mol-edt") == 0) {
+        thee->srfm = VSM_MOLEDT;
+        thee->setsrfm = 1;
+        return 1;
+    } else if (Vstring_strcasecmp(tok, "smol-edt") == 0) {
+        thee->srfm = VSM_MOLSMOOTHEDT;
+        thee->setsrfm = 1;
+        return 1;
     } else {
         Vnm_print(2, "NOsh:  Unrecongnized keyword (%s) when parsing \
 srfm!\n", tok);
@@ -998,6 +1018,35 @@ calcforce!\n", tok);
         return -1;
 }
 
+VPRIVATE int PBEparm_parseNEWTON(PBEparm *thee, Vio *sock) {
+    char tok[VMAX_BUFSIZE];
+    int ti;
+
+    VJMPERR1(Vio_scanf(sock, "%s", tok) == 1);
+    if (Vstring_strcasecmp(tok, "exact") == 0) {
+        thee->newton = 0;
+        thee->setnewton = 1;
+        return 1;
+    } else if (Vstring_strcasecmp(tok, "inexact") == 0) {
+        thee->newton = 1;
+        thee->setnewton = 1;
+        return 1;
+    } else if ((sscanf(tok, "%d", &ti) == 1) && ((ti == 0) || (ti == 1))) {
+        thee->newton = ti;
+        thee->setnewton = 1;
+        return 1;
+    } else {
+        Vnm_print(2, "NOsh:  Unrecognized parameter (%s) while parsing \
+newton!\n", tok);
+        return -1;
+    }
+    return 0;
+
+    VERROR1:
+        Vnm_print(2, "parsePBE:  ran out of tokens!\n");
+        return -1;
+}
+
 /*----------------------------------------------------------*/
 /* Added by Michael Grabe                                   */
 /*----------------------------------------------------------*/
@@ -1256,6 +1305,8 @@ VPUBLIC int PBEparm_parseToken(PBEparm *thee, char tok[VMAX_BUFSIZE],
         return PBEparm_parseCALCENERGY(thee, sock);
     } else if (Vstring_strcasecmp(tok, "calcforce") == 0) {
         return PBEparm_parseCALCFORCE(thee, sock);
+    } else if (Vstring_strcasecmp(tok, "newton") == 0) {
+        return PBEparm_parseNEWTON(thee, sock);
     } else if (Vstring_strcasecmp(tok, "write") == 0) {
         return PBEparm_parseWRITE(thee, sock);
     } else if (Vstring_strcasecmp(tok, "writemat") == 0) {
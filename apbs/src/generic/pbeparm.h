@@ -166,6 +166,11 @@ struct sPBEparm {
     int setcalcenergy;  /**< Flag, @see calcenergy */
     PBEparm_calcForce calcforce;  /**< Atomic forces calculation */
     int setcalcforce;  /**< Flag, @see calcforce */
+    int newton;  /**< Newton method for npbe/smpbe:
+                  * \li 0 => exact: v-cycles to a tight absolute tolerance
+                  * \li 1 => inexact Newton-Krylov with Eisenstat-Walker
+                  *          forcing terms */
+    int setnewton;  /**< Flag, @see newton */
 
     /*----------------------------------------------------------------*/
     /* Added by Michael Grabe                                         */
@@ -1003,6 +1003,17 @@ VPUBLIC VaccSurf* Vacc_atomSASPoints(Vacc *thee, double radius,
 
 }
 
+VPUBLIC void Vacc_atomSASReset(Vacc *thee, double radius, Vatom *atom) {
+
+    int id;
+
+    if (thee->surf == VNULL) return;
+    id = Vatom_getAtomID(atom);
+
+    VaccSurf_dtor(&(thee->surf[id]));
+    thee->surf[id] = Vacc_atomSurf(thee, atom, thee->refSphere, radius);
+}
+
 VPUBLIC void Vacc_splineAccGradAtomNorm4(Vacc *thee, double center[VAPBS_DIM],
                                          double win, double infrad, Vatom *atom, double *grad) {
 
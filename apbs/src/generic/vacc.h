@@ -516,6 +516,20 @@ VEXTERNC VaccSurf* Vacc_atomSASPoints(
         Vatom *atom  /**< Atom of interest */
         );
 
+/**
+ * @brief  Rebuild the cached SAS points of an atom
+ * @ingroup  Vacc
+ * @note  For an atom that moved or changed radius, or one near it whose
+ *        points may have been buried or uncovered.  The cell list must
+ *        already hold the new positions (see Vclist_moveAtom).  Nothing is
+ *        done if no surface has been built yet.
+ */
+VEXTERNC void Vacc_atomSASReset(
+        Vacc *thee,  /**< Accessibility object */
+        double radius,  /**< Probe molecule radius (&Aring;) */
+        Vatom *atom  /**< Atom of interest */
+        );
+
 /**
 * @brief  Get the derivatve of solvent accessible volume
  * @ingroup  Vacc
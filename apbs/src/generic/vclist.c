@@ -227,21 +227,19 @@ VPRIVATE Vrc_Codes Vclist_storeParms(Vclist *thee, Valist *alist,
     return VRC_SUCCESS;
 }
 
-/* Calculate the gridpoints an atom spans */
-VPRIVATE void Vclist_gridSpan(Vclist *thee,
-        Vatom *atom, /* Atom */
+/* Calculate the gridpoints a sphere spans */
+VPRIVATE void Vclist_span(Vclist *thee,
+        double *coord, /* Sphere center */
+        double radius, /* Sphere radius */
         int imin[VAPBS_DIM], /* Set to min grid indices */
         int imax[VAPBS_DIM]  /* Set to max grid indices */
         ) {
 
     int i;
-    double *coord, dc, idc, rtot;
-
-    /* Get the position in the grid's frame of reference */
-    coord = Vatom_getPosition(atom);
+    double dc, idc, rtot;
 
     /* Get the range the atom radius + probe radius spans */
-    rtot = Vatom_getRadius(atom) + thee->max_radius;
+    rtot = radius + thee->max_radius;
 
     /* Calculate the range of grid points the inflated atom spans in the x
      * direction. */
@@ -257,6 +255,17 @@ VPRIVATE void Vclist_gridSpan(Vclist *thee,
 
 }
 
+/* Calculate the gridpoints an atom spans */
+VPRIVATE void Vclist_gridSpan(Vclist *thee,
+        Vatom *atom, /* Atom */
+        int imin[VAPBS_DIM], /* Set to min grid indices */
+        int imax[VAPBS_DIM]  /* Set to max grid indices */
+        ) {
+
+    Vclist_span(thee, Vatom_getPosition(atom), Vatom_getRadius(atom),
+                imin, imax);
+}
+
 /* Get the array index for a particular cell based on its i,j,k
  * coordinates */
 VPRIVATE int Vclist_arrayIndex(Vclist *thee, int i, int j, int k) {
@@ -390,6 +399,100 @@ VPUBLIC Vrc_Codes Vclist_ctor2(Vclist *thee, Valist *alist, double max_radius,
 
 
 
+    return VRC_SUCCESS;
+}
+
+VPUBLIC Vrc_Codes Vclist_moveAtom(Vclist *thee, Vatom *atom,
+        double oldpos[VAPBS_DIM], double oldrad) {
+
+    int i, j, k, m, n, ui;
+    int imax[VAPBS_DIM], imin[VAPBS_DIM];
+    int npts[VAPBS_DIM];
+    double *pos, rtot, lower[VAPBS_DIM], upper[VAPBS_DIM];
+    Valist *alist;
+    VclistCell *cell;
+
+    pos = Vatom_getPosition(atom);
+    rtot = Vatom_getRadius(atom) + thee->max_radius;
+
+    /* An automatic domain was sized to hold every atom; start over if this
+     * one no longer fits */
+    if (thee->mode == CLIST_AUTO_DOMAIN) {
+        for (i=0; i<VAPBS_DIM; i++) {
+            if (((pos[i] - rtot) < thee->lower_corner[i]) ||
+                ((pos[i] + rtot) > thee->upper_corner[i])) break;
+        }
+        if (i < VAPBS_DIM) {
+            Vnm_print(0, "Vclist_moveAtom:  atom %d left the hash table; \
+rebuilding\n", (int)Vatom_getAtomID(atom));
+            alist = thee->alist;
+            for (i=0; i<VAPBS_DIM; i++) {
+                npts[i] = thee->npts[i];
+                lower[i] = thee->lower_corner[i];
+                upper[i] = thee->upper_corner[i];
+            }
+            Vclist_dtor2(thee);
+            return Vclist_ctor2(thee, alist, thee->max_radius, npts,
+                                CLIST_AUTO_DOMAIN, lower, upper);
+        }
+    }
+
+    /* Take the atom out of the cells it used to span */
+    Vclist_span(thee, oldpos, oldrad, imin, imax);
+    for (i=imin[0]; i<=imax[0]; i++) {
+        for (j=imin[1]; j<=imax[1]; j++) {
+            for (k=imin[2]; k<=imax[2]; k++) {
+                ui = Vclist_arrayIndex(thee, i, j, k);
+                cell = &(thee->cells[ui]);
+                for (m=0; m<cell->natoms; m++) {
+                    if (cell->atoms[m] == atom) break;
+                }
+                if (m == cell->natoms) continue;
+                n = cell->natoms;
+                for (; m<n-1; m++) cell->atoms[m] = cell->atoms[m+1];
+                if (n == 1) {
+                    Vmem_free(VNULL, 1, sizeof(Vatom *),
+                              (void **)&(cell->atoms));
+                } else {
+                    cell->atoms = (Vatom **)Vmem_realloc(VNULL, n,
+                            sizeof(Vatom *), (void **)&(cell->atoms), n-1);
+                }
+                cell->natoms = n-1;
+            }
+        }
+    }
+
+    /* Put it into the cells it spans now, keeping them in atom order */
+    Vclist_gridSpan(thee, atom, imin, imax);
+    for (i=imin[0]; i<=imax[0]; i++) {
+        for (j=imin[1]; j<=imax[1]; j++) {
+            for (k=imin[2]; k<=imax[2]; k++) {
+                ui = Vclist_arrayIndex(thee, i, j, k);
+                cell = &(thee->cells[ui]);
+                for (m=0; m<cell->natoms; m++) {
+                    if (cell->atoms[m] == atom) break;
+                }
+                if (m < cell->natoms) continue;
+                n = cell->natoms;
+                if (n == 0) {
+                    cell->atoms = (Vatom **)Vmem_malloc(VNULL, 1,
+                            sizeof(Vatom *));
+                } else {
+                    cell->atoms = (Vatom **)Vmem_realloc(VNULL, n,
+                            sizeof(Vatom *), (void **)&(cell->atoms), n+1);
+                }
+                VASSERT(cell->atoms != VNULL);
+                for (m=n; m>0; m--) {
+                    if (Vatom_getAtomID(cell->atoms[m-1]) <
+                        Vatom_getAtomID(atom)) break;
+                    cell->atoms[m] = cell->atoms[m-1];
+                }
+                cell->atoms[m] = atom;
+                cell->natoms = n+1;
+            }
+        }
+    }
+
     return VRC_SUCCESS;
 }
 
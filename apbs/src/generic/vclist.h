@@ -233,6 +233,23 @@ VEXTERNC VclistCell* Vclist_getCell(
         double position[VAPBS_DIM] /**< Position to evaluate */
         );
 
+/**
+ * @brief  Move an atom to the cells of its current position and radius
+ * @ingroup Vclist
+ * @returns Success enumeration
+ * @note  The atom is taken out of the cells its old position and radius
+ *        span and put into those it spans now, in atom order, so the cells
+ *        end up as a new cell list would build them.  Moving an atom twice
+ *        is harmless.  If the atom now reaches past an automatic domain the
+ *        whole list is rebuilt from the atom list.
+ */
+VEXTERNC Vrc_Codes Vclist_moveAtom(
+        Vclist *thee,  /**< Pointer to Vclist cell list */
+        Vatom *atom,  /**< Atom, already at its new position and radius */
+        double oldpos[VAPBS_DIM],  /**< Position when it was last placed */
+        double oldrad  /**< Radius when it was last placed */
+        );
+
 /**
  * @brief  Allocate and construct a cell list cell object
  * @ingroup Vclist
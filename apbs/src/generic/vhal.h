@@ -120,10 +120,18 @@ enum eVsurf_Meth {
                       *  a smoothly varying characteristic function
                       *  (continuity through 2nd derivatives) for surface
                       *  based paramters. */
-    VSM_SPLINE4=4   /**<  A 7th order polynomial spline is used to create
+    VSM_SPLINE4=4,  /**<  A 7th order polynomial spline is used to create
                       *  a smoothly varying characteristic function
                       *  (continuity through 3rd derivatives) for surface
                       *  based paramters. */
+    VSM_MOLEDT=5,    /**<  As VSM_MOL but the probe-excluded part of the
+                      *    dielectric is found with a Euclidean distance
+                      *    transform of the grid and exact probe contacts
+                      *    instead of the SAS points, giving the VSM_MOL
+                      *    surface in the limit of large sdens
+                      *    (multigrid only) */
+    VSM_MOLSMOOTHEDT=6 /**<  As VSM_MOLEDT but with the VSM_MOLSMOOTH
+                        *    harmonic average smoothing */
 };
 
 /** @typedef Vsurf_Meth
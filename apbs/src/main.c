@@ -500,6 +500,12 @@ int main(
                         &(nenergy[i]), &(totEnergy[i]), &(qfEnergy[i]),
                         &(qmEnergy[i]), &(dielEnergy[i]));
 
+                /* Solve for the charge maps sharing this operator */
+                if (blockMG(nosh, i, pmg[i], chargeMap) != 1) {
+                    Vnm_tprint(2, "Error solving for charge maps!\n");
+                    VJMPERR1(0);
+                }
+
                 /* Write out forces */
                 forceMG(mem, nosh, pbeparm, mgparm, pmg[i], &(nforce[i]),
                         &(atomForce[i]), alist);
@@ -0,0 +1,335 @@
+/**
+ *  @file    varena.c
+ *  @brief   Class Varena methods
+ *  @ingroup Varena
+ *  @version $Id$
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ *  Nathan A. Baker (nathan.baker@pnnl.gov)
+ *  Pacific Northwest National Laboratory
+ *
+ *  Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the
+ * Pacific Northwest National Laboratory, operated by Battelle Memorial
+ * Institute, Pacific Northwest Division for the U.S. Department of Energy.
+ *
+ * Portions Copyright (c) 2002-2010, Washington University in St. Louis.
+ * Portions Copyright (c) 2002-2010, Nathan A. Baker.
+ * Portions Copyright (c) 1999-2002, The Regents of the University of
+ * California.
+ * Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * Neither the name of the developer nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+#include "varena.h"
+
+#if defined(HAVE_MMAP)
+#   include <sys/mman.h>
+#   if !defined(MAP_ANONYMOUS)
+#       define MAP_ANONYMOUS MAP_ANON
+#   endif
+#endif
+
+#if defined(__linux__)
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#endif
+
+VEMBED(rcsid="$Id$")
+
+/* ///////////////////////////////////////////////////////////////////////////
+// Class Varena: Private methods
+/////////////////////////////////////////////////////////////////////////// */
+
+/* Allocate the memory behind a new block of num doubles.  The pages are not
+ * touched here, so that they are placed by whichever thread first writes
+ * them (see Varena_malloc). */
+VPRIVATE void Varena_map(VarenaBlock *blk, size_t num) {
+
+    size_t bytes;
+#if defined(HAVE_MMAP)
+    size_t page, len, head;
+    char *base, *start;
+
+    bytes = num*sizeof(double);
+    page = (bytes >= VARENA_HUGEPAGE) ? VARENA_HUGEPAGE : 4096;
+    len = ((bytes + page - 1)/page)*page;
+
+    /* Over-map by one huge page and trim, so that the block starts on a huge
+     * page boundary and can be backed by huge pages throughout */
+    if (page == VARENA_HUGEPAGE) {
+        base = (char *)mmap(VNULL, len + page, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        VASSERT_MSG1(base != (char *)MAP_FAILED,
+                     "Unable to map %lu bytes of grid memory",
+                     (unsigned long)len);
+        start = (char *)((((size_t)base) + page - 1) & ~(page - 1));
+        head = (size_t)(start - base);
+        if (head > 0) munmap(base, head);
+        munmap(start + len, page - head);
+#if defined(MADV_HUGEPAGE)
+        madvise(start, len, MADV_HUGEPAGE);
+#endif
+    } else {
+        start = (char *)mmap(VNULL, len, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        VASSERT_MSG1(start != (char *)MAP_FAILED,
+                     "Unable to map %lu bytes of grid memory",
+                     (unsigned long)len);
+    }
+    blk->base = start;
+    blk->len = len;
+    blk->data = (double *)start;
+#else
+    char *base;
+
+    bytes = num*sizeof(double);
+    base = (char *)malloc(bytes + VARENA_ALIGN);
+    VASSERT_MSG1(base != VNULL, "Unable to allocate %lu bytes of grid memory",
+                 (unsigned long)bytes);
+    blk->base = base;
+    blk->len = bytes + VARENA_ALIGN;
+    blk->data = (double *)((((size_t)base) + VARENA_ALIGN)
+                           & ~((size_t)VARENA_ALIGN - 1));
+#endif
+    blk->num = num;
+}
+
+VPRIVATE void Varena_unmap(VarenaBlock *blk) {
+
+#if defined(HAVE_MMAP)
+    munmap(blk->base, blk->len);
+#else
+    free(blk->base);
+#endif
+    blk->base = VNULL;
+    blk->data = VNULL;
+}
+
+/* Release the free blocks given back longest ago until a new block of len
+ * bytes fits within the most the arena has had handed out at once */
+VPRIVATE void Varena_trim(Varena *thee, size_t len) {
+
+    size_t bound;
+    VarenaBlock *blk, *prev, *old, *oldprev;
+
+    bound = VMAX2(thee->peak, thee->busy + len);
+    while (thee->bytes + len > bound) {
+        old = VNULL;
+        oldprev = VNULL;
+        prev = VNULL;
+        for (blk=thee->blocks; blk!=VNULL; prev=blk, blk=blk->next) {
+            if (blk->busy) continue;
+            if ((old == VNULL) || (blk->stamp < old->stamp)) {
+                old = blk;
+                oldprev = prev;
+            }
+        }
+        if (old == VNULL) return;
+
+        if (oldprev == VNULL) thee->blocks = old->next;
+        else oldprev->next = old->next;
+        thee->bytes -= old->len;
+        (thee->nrelease)++;
+        Varena_unmap(old);
+        Vmem_free(thee->vmem, 1, sizeof(VarenaBlock), (void **)&old);
+    }
+}
+
+/* ///////////////////////////////////////////////////////////////////////////
+// Class Varena: Non-inlineable methods
+/////////////////////////////////////////////////////////////////////////// */
+
+VPUBLIC Varena* Varena_ctor() {
+
+    Varena *thee = VNULL;
+
+    thee = (Varena *)Vmem_malloc(VNULL, 1, sizeof(Varena));
+    VASSERT(thee != VNULL);
+    VASSERT(Varena_ctor2(thee));
+
+    return thee;
+}
+
+VPUBLIC int Varena_ctor2(Varena *thee) {
+
+    if (thee == VNULL) return 0;
+
+    thee->vmem = Vmem_ctor("APBS:VARENA");
+    thee->blocks = VNULL;
+    thee->bytes = 0;
+    thee->busy = 0;
+    thee->peak = 0;
+    thee->stamp = 0;
+    thee->nnew = 0;
+    thee->nreuse = 0;
+    thee->nrelease = 0;
+
+    return 1;
+}
+
+VPUBLIC void Varena_dtor(Varena **thee) {
+
+    if ((*thee) != VNULL) {
+        Varena_dtor2(*thee);
+        Vmem_free(VNULL, 1, sizeof(Varena), (void **)thee);
+        (*thee) = VNULL;
+    }
+}
+
+VPUBLIC void Varena_dtor2(Varena *thee) {
+
+    VarenaBlock *blk, *next;
+
+    for (blk=thee->blocks; blk!=VNULL; blk=next) {
+        next = blk->next;
+        Varena_unmap(blk);
+        Vmem_free(thee->vmem, 1, sizeof(VarenaBlock), (void **)&blk);
+    }
+    thee->blocks = VNULL;
+    thee->bytes = 0;
+
+    Vmem_dtor(&(thee->vmem));
+}
+
+VPUBLIC double* Varena_malloc(Varena *thee, size_t num) {
+
+    VarenaBlock *blk, *best;
+
+    VASSERT(thee != VNULL);
+    if (num == 0) num = 1;
+
+    /* Smallest free block that fits without wasting more than a quarter */
+    best = VNULL;
+    for (blk=thee->blocks; blk!=VNULL; blk=blk->next) {
+        if (blk->busy || (blk->num < num) || (blk->num > num + num/4)) {
+            continue;
+        }
+        if ((best == VNULL) || (blk->num < best->num)) best = blk;
+    }
+
+    if (best != VNULL) {
+        (thee->nreuse)++;
+    } else {
+        best = (VarenaBlock *)Vmem_malloc(thee->vmem, 1, sizeof(VarenaBlock));
+        Varena_map(best, num);
+        Varena_trim(thee, best->len);
+        best->next = thee->blocks;
+        thee->blocks = best;
+        thee->bytes += best->len;
+        (thee->nnew)++;
+    }
+    best->busy = 1;
+    thee->busy += best->len;
+    thee->peak = VMAX2(thee->peak, thee->busy);
+
+    return best->data;
+}
+
+VPUBLIC void Varena_free(Varena *thee, double **ram) {
+
+    VarenaBlock *blk;
+
+    VASSERT(thee != VNULL);
+    if ((*ram) == VNULL) return;
+
+    for (blk=thee->blocks; blk!=VNULL; blk=blk->next) {
+        if (blk->data == (*ram)) {
+            VASSERT_MSG0(blk->busy, "Block freed twice");
+            blk->busy = 0;
+            blk->stamp = (thee->stamp)++;
+            thee->busy -= blk->len;
+            (*ram) = VNULL;
+            return;
+        }
+    }
+    VABORT_MSG0("Pointer does not belong to this arena");
+}
+
+VPUBLIC size_t Varena_bytes(Varena *thee) {
+
+    if (thee == VNULL) return 0;
+    return thee->bytes;
+}
+
+VPUBLIC size_t Varena_busyBytes(Varena *thee) {
+
+    if (thee == VNULL) return 0;
+    return thee->busy;
+}
+
+VPUBLIC size_t Varena_peakBytes(Varena *thee) {
+
+    if (thee == VNULL) return 0;
+    return thee->peak;
+}
+
+VPUBLIC int Varena_placement(double *ram, size_t num, int *count) {
+
+    int i;
+#if defined(SYS_move_pages)
+    int n, node, npage;
+    void *pages[1024];
+    int status[1024];
+    size_t page;
+    char *p, *end;
+#endif
+
+    for (i=0; i<VARENA_MAXNODE; i++) count[i] = 0;
+
+#if defined(SYS_move_pages)
+    /* move_pages with no target nodes only reports where each page is */
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    p = (char *)(((size_t)ram) & ~(page - 1));
+    end = (char *)(ram + num);
+    npage = 0;
+    while (p < end) {
+        for (n=0; (n<1024) && (p<end); n++, p+=page) pages[n] = p;
+        if (syscall(SYS_move_pages, 0, (unsigned long)n, pages, VNULL,
+                    status, 0) != 0) {
+            return -1;
+        }
+        for (i=0; i<n; i++) {
+            if (status[i] < 0) continue;
+            node = VMIN2(status[i], VARENA_MAXNODE-1);
+            count[node]++;
+            npage++;
+        }
+    }
+    return npage;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,226 @@
+/** @defgroup Varena Varena class
+ *  @brief  Recycling arena for multigrid grid arrays
+ */
+
+/**
+ *  @file     varena.h
+ *  @ingroup  Varena
+ *  @brief    Contains declarations for class Varena
+ *  @version  $Id$
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ *  Nathan A. Baker (nathan.baker@pnnl.gov)
+ *  Pacific Northwest National Laboratory
+ *
+ *  Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the
+ * Pacific Northwest National Laboratory, operated by Battelle Memorial
+ * Institute, Pacific Northwest Division for the U.S. Department of Energy.
+ *
+ * Portions Copyright (c) 2002-2010, Washington University in St. Louis.
+ * Portions Copyright (c) 2002-2010, Nathan A. Baker.
+ * Portions Copyright (c) 1999-2002, The Regents of the University of
+ * California.
+ * Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * Neither the name of the developer nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+#ifndef _VARENA_H_
+#define _VARENA_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+
+/** @brief   Alignment of the blocks handed out by Varena, in bytes
+ *  @ingroup Varena */
+#define VARENA_ALIGN 64
+
+/** @brief   Blocks at least this large are mapped on huge page boundaries
+ *  @ingroup Varena */
+#define VARENA_HUGEPAGE 2097152
+
+/** @brief   Highest NUMA node number Varena_placement tells apart
+ *  @ingroup Varena */
+#define VARENA_MAXNODE 16
+
+/**
+ *  @ingroup Varena
+ *  @brief   One block of grid memory owned by a Varena
+ */
+struct sVarenaBlock {
+    void *base;  /**< Start of the underlying allocation */
+    size_t len;  /**< Length of the underlying allocation in bytes */
+    double *data;  /**< Aligned start of the block */
+    size_t num;  /**< Capacity of the block in doubles */
+    int busy;  /**< 1 if the block is handed out, 0 if it is on the free
+                * list */
+    int stamp;  /**< Order in which the block was last given back */
+    struct sVarenaBlock *next;  /**< Next block of the arena */
+};
+
+/**
+ *  @ingroup Varena
+ *  @brief   Declaration of the VarenaBlock structure
+ */
+typedef struct sVarenaBlock VarenaBlock;
+
+/**
+ *  @ingroup Varena
+ *  @brief   Grid memory arena
+ *
+ *  Blocks given back with Varena_free are not released to the system
+ *  right away but kept for the next request of (about) the same size, so a
+ *  sequence of Vpmg objects on the same mesh reuses pages that are already
+ *  mapped instead of faulting in and zeroing new ones.  The cache is
+ *  bounded: the arena never holds more than the most it ever had handed
+ *  out at once, and a request that needs a new block first unmaps the
+ *  free blocks given back longest ago until that holds again.  Large
+ *  blocks are mapped on huge page boundaries and advised as huge pages
+ *  where the system supports it.
+ */
+struct sVarena {
+    Vmem *vmem;  /**< Memory management object for the block list */
+    VarenaBlock *blocks;  /**< All blocks of the arena */
+    size_t bytes;  /**< Bytes held by the arena (busy and free blocks) */
+    size_t busy;  /**< Bytes in busy blocks */
+    size_t peak;  /**< Most bytes ever in busy blocks at once */
+    int stamp;  /**< Number of blocks given back so far */
+    int nnew;  /**< Number of requests served by a new block */
+    int nreuse;  /**< Number of requests served by a recycled block */
+    int nrelease;  /**< Number of free blocks released to the system */
+};
+
+/**
+ *  @ingroup Varena
+ *  @brief   Declaration of the Varena class as the Varena structure
+ */
+typedef struct sVarena Varena;
+
+/** @brief   Construct an empty arena
+ *  @ingroup Varena
+ *  @returns Newly allocated Varena object
+ */
+VEXTERNC Varena* Varena_ctor();
+
+/** @brief   FORTRAN stub to construct an empty arena
+ *  @ingroup Varena
+ *  @param   thee  Pointer to allocated Varena object
+ *  @returns 1 if successful, 0 otherwise
+ */
+VEXTERNC int Varena_ctor2(Varena *thee);
+
+/** @brief   Object destructor
+ *  @ingroup Varena
+ *  @note    Releases every block, including blocks that were never given
+ *           back; the arena must outlive the objects it serves.
+ *  @param   thee  Pointer to memory location of object to be destroyed
+ */
+VEXTERNC void Varena_dtor(Varena **thee);
+
+/** @brief   FORTRAN stub object destructor
+ *  @ingroup Varena
+ *  @param   thee  Pointer to object to be destroyed
+ */
+VEXTERNC void Varena_dtor2(Varena *thee);
+
+/** @brief   Get a VARENA_ALIGN-aligned array of doubles
+ *  @ingroup Varena
+ *
+ *  A free block whose capacity is between num and num + num/4 is reused
+ *  (the smallest such block); otherwise a new block is allocated, after
+ *  releasing as many of the oldest free blocks as the cache bound asks
+ *  for (see Varena).  Unlike
+ *  Vmem_malloc the array is not cleared: a new block has not been touched
+ *  yet and a recycled one holds whatever its last user left.  The caller
+ *  initializes it, ideally from the threads that will work on each part of
+ *  it, since on a NUMA machine a page is placed next to the thread that
+ *  touches it first.
+ *
+ *  @param   thee  Varena object
+ *  @param   num  Number of doubles
+ *  @returns Pointer to the array
+ */
+VEXTERNC double* Varena_malloc(Varena *thee, size_t num);
+
+/** @brief   Give an array back to the arena for reuse
+ *  @ingroup Varena
+ *  @param   thee  Varena object
+ *  @param   ram  Pointer to the array (obtained from Varena_malloc on the
+ *                same arena); set to VNULL on return
+ */
+VEXTERNC void Varena_free(Varena *thee, double **ram);
+
+/** @brief   Get the number of bytes held by the arena
+ *  @ingroup Varena
+ *  @param   thee  Varena object
+ *  @returns Bytes held in busy and free blocks
+ */
+VEXTERNC size_t Varena_bytes(Varena *thee);
+
+/** @brief   Get the number of bytes handed out by the arena
+ *  @ingroup Varena
+ *  @param   thee  Varena object
+ *  @returns Bytes in busy blocks; the rest of Varena_bytes is cache
+ */
+VEXTERNC size_t Varena_busyBytes(Varena *thee);
+
+/** @brief   Get the most bytes the arena ever had handed out at once
+ *  @ingroup Varena
+ *  @param   thee  Varena object
+ *  @returns Peak of Varena_busyBytes, which also bounds Varena_bytes
+ */
+VEXTERNC size_t Varena_peakBytes(Varena *thee);
+
+/** @brief   Count the pages of an array on each NUMA node
+ *  @ingroup Varena
+ *
+ *  Works on any array, whether it came from an arena or not.  Pages that
+ *  have not been touched yet are not counted; pages on nodes at or above
+ *  VARENA_MAXNODE are counted with node VARENA_MAXNODE-1.
+ *
+ *  @param   ram  Array
+ *  @param   num  Number of doubles in the array
+ *  @param   count  Set to the number of pages on each node
+ *                  [VARENA_MAXNODE]
+ *  @returns Number of pages counted, or -1 if the system cannot report
+ *           page placement
+ */
+VEXTERNC int Varena_placement(double *ram, size_t num, int *count);
+
+#endif /* ifndef _VARENA_H_ */
@@ -0,0 +1,605 @@
+/**
+ *  @file    vdhtree.c
+ *  @brief   Class Vdhtree methods
+ *  @ingroup Vdhtree
+ *  @version $Id$
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ *  Nathan A. Baker (nathan.baker@pnnl.gov)
+ *  Pacific Northwest National Laboratory
+ *
+ *  Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the
+ * Pacific Northwest National Laboratory, operated by Battelle Memorial
+ * Institute, Pacific Northwest Division for the U.S. Department of Energy.
+ *
+ * Portions Copyright (c) 2002-2010, Washington University in St. Louis.
+ * Portions Copyright (c) 2002-2010, Nathan A. Baker.
+ * Portions Copyright (c) 1999-2002, The Regents of the University of
+ * California.
+ * Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * Neither the name of the developer nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#include "vdhtree.h"
+#include "pmgc/simdd.h"
+
+VEMBED(rcsid="$Id$")
+
+/* Most sources a leaf box holds */
+#define VDHTREE_LEAF 64
+
+/* Smallest half width of a box (A), so that sources lying in a plane or on
+ * a line still get an interpolation box of finite size */
+#define VDHTREE_MINHALF 0.01
+
+/* Deepest box stack Vdhtree_eval needs: the tree is never deeper than the
+ * number of halvings from the largest molecule to VDHTREE_MINHALF */
+#define VDHTREE_MAXSTACK 512
+
+/* ///////////////////////////////////////////////////////////////////////////
+// Class Vdhtree: Private methods
+/////////////////////////////////////////////////////////////////////////// */
+
+/* Pick the interpolation degree and opening ratio for a relative accuracy
+ * tol.  With an opening ratio of 1/2 each degree gains about 0.7 of a
+ * digit; strong screening makes G vary faster across a box and costs one
+ * more degree per 0.25/A of kappa (measured on random charge sets).
+ * Below degree 4 the boxes next to the molecule are not resolved, so
+ * that is the floor. */
+VPRIVATE void Vdhtree_setAccuracy(Vdhtree *thee, double tol) {
+
+    int order;
+
+    thee->theta = 0.5;
+    order = (int)ceil(-log10(tol)/0.7) + (int)(4.0*thee->kappa);
+    thee->order = VMAX2(4, VMIN2(VDHTREE_MAXORDER, order));
+    thee->nproxy = (thee->order+1)*(thee->order+1)*(thee->order+1);
+}
+
+/* Chebyshev points of the second kind on [-1,1] and the matrices that
+ * differentiate a polynomial given by its values there */
+VPRIVATE void Vdhtree_setCheb(Vdhtree *thee) {
+
+    int i, j, k, n;
+    double ci, cj, sum;
+
+    n = thee->order + 1;
+    for (i=0; i<n; i++) thee->cheb[i] = cos(VPI*i/thee->order);
+
+    for (i=0; i<n; i++) {
+        ci = ((i == 0) || (i == n-1)) ? 2.0 : 1.0;
+        sum = 0.0;
+        for (j=0; j<n; j++) {
+            if (i == j) continue;
+            cj = ((j == 0) || (j == n-1)) ? 2.0 : 1.0;
+            thee->dmat[i*n+j] = (ci/cj)*(((i+j)%2) ? -1.0 : 1.0)
+                                / (thee->cheb[i] - thee->cheb[j]);
+            sum += thee->dmat[i*n+j];
+        }
+        thee->dmat[i*n+i] = -sum;
+    }
+
+    for (i=0; i<n; i++) {
+        for (j=0; j<n; j++) {
+            sum = 0.0;
+            for (k=0; k<n; k++) sum += thee->dmat[i*n+k]*thee->dmat[k*n+j];
+            thee->dmat2[i*n+j] = sum;
+        }
+    }
+}
+
+/* Values at t of the Lagrange polynomials of the Chebyshev points, by the
+ * barycentric formula */
+VPRIVATE void Vdhtree_lagrange(Vdhtree *thee, double t, double *l) {
+
+    int j, m, n;
+    double w, diff, sum;
+
+    n = thee->order + 1;
+    sum = 0.0;
+    for (m=0; m<n; m++) {
+        diff = t - thee->cheb[m];
+        if (VABS(diff) < 1.0e-14) break;
+        w = (m%2) ? -1.0 : 1.0;
+        if ((m == 0) || (m == n-1)) w = 0.5*w;
+        l[m] = w/diff;
+        sum += l[m];
+    }
+
+    if (m < n) {
+        /* t is one of the points */
+        for (j=0; j<n; j++) l[j] = 0.0;
+        l[m] = 1.0;
+    } else {
+        for (m=0; m<n; m++) l[m] = l[m]/sum;
+    }
+}
+
+/* Derivatives of the Lagrange polynomials, from their values l at the same
+ * point, a differentiation matrix d and the scale s of the box */
+VPRIVATE void Vdhtree_lagrangeDeriv(Vdhtree *thee, double *l, double *d,
+                                    double s, double *dl) {
+
+    int j, m, n;
+    double sum;
+
+    n = thee->order + 1;
+    for (m=0; m<n; m++) {
+        sum = 0.0;
+        for (j=0; j<n; j++) sum += l[j]*d[j*n+m];
+        dl[m] = s*sum;
+    }
+}
+
+/* Add a box to the node array and return its index */
+VPRIVATE int Vdhtree_newNode(Vdhtree *thee) {
+
+    if (thee->nnode == thee->maxnode) {
+        thee->nodes = (VdhtreeNode *)Vmem_realloc(thee->vmem, thee->maxnode,
+                        sizeof(VdhtreeNode), (void **)&(thee->nodes),
+                        2*thee->maxnode);
+        VASSERT(thee->nodes != VNULL);
+        thee->maxnode = 2*thee->maxnode;
+    }
+    (thee->nnode)++;
+
+    return thee->nnode - 1;
+}
+
+/* Octant of source i relative to a box center, along the split sides */
+VPRIVATE int Vdhtree_octant(double *pos, int i, double *center, int *split) {
+
+    int d, oct;
+
+    oct = 0;
+    for (d=0; d<3; d++) {
+        if (split[d] && (pos[3*i+d] > center[d])) oct |= (1 << d);
+    }
+    return oct;
+}
+
+/* Build the box holding sources perm[ibeg..iend) and, recursively, its
+ * children.  A box is split at its center across every side longer than
+ * 1/sqrt(2) of its longest one, so that long thin boxes are not cut into
+ * slivers. */
+VPRIVATE int Vdhtree_build(Vdhtree *thee, double *pos, int *perm, int *work,
+                           int ibeg, int iend) {
+
+    int i, d, inode, oct, split[3], next[8], count[8];
+    double lo[3], hi[3], center[3], hmax;
+    VdhtreeNode *node;
+
+    inode = Vdhtree_newNode(thee);
+
+    for (d=0; d<3; d++) {
+        lo[d] = pos[3*perm[ibeg]+d];
+        hi[d] = lo[d];
+    }
+    for (i=ibeg+1; i<iend; i++) {
+        for (d=0; d<3; d++) {
+            lo[d] = VMIN2(lo[d], pos[3*perm[i]+d]);
+            hi[d] = VMAX2(hi[d], pos[3*perm[i]+d]);
+        }
+    }
+
+    node = &(thee->nodes[inode]);
+    node->ibeg = ibeg;
+    node->iend = iend;
+    node->nchild = 0;
+    node->proxy = VNULL;
+    hmax = 0.0;
+    for (d=0; d<3; d++) {
+        node->center[d] = 0.5*(lo[d] + hi[d]);
+        node->half[d] = VMAX2(0.5*(hi[d] - lo[d]), VDHTREE_MINHALF);
+        hmax = VMAX2(hmax, node->half[d]);
+        center[d] = node->center[d];
+    }
+    node->radius = VSQRT(VSQR(node->half[0]) + VSQR(node->half[1])
+                         + VSQR(node->half[2]));
+
+    if ((iend - ibeg <= VDHTREE_LEAF) || (hmax <= VDHTREE_MINHALF)) {
+        return inode;
+    }
+
+    /* Sort the sources by octant */
+    for (d=0; d<3; d++) split[d] = (node->half[d] >= hmax/VSQRT(2.0));
+    for (oct=0; oct<8; oct++) count[oct] = 0;
+    for (i=ibeg; i<iend; i++) {
+        count[Vdhtree_octant(pos, perm[i], center, split)]++;
+        work[i] = perm[i];
+    }
+    next[0] = ibeg;
+    for (oct=1; oct<8; oct++) next[oct] = next[oct-1] + count[oct-1];
+    for (i=ibeg; i<iend; i++) {
+        oct = Vdhtree_octant(pos, work[i], center, split);
+        perm[next[oct]] = work[i];
+        (next[oct])++;
+    }
+
+    /* The node array may move while the children are built */
+    for (oct=0; oct<8; oct++) {
+        if (count[oct] == 0) continue;
+        i = Vdhtree_build(thee, pos, perm, work, next[oct] - count[oct],
+                          next[oct]);
+        node = &(thee->nodes[inode]);
+        node->child[node->nchild] = i;
+        (node->nchild)++;
+    }
+
+    return inode;
+}
+
+/* Proxy charges of a box: each source spread over the Chebyshev points of
+ * the box with the Lagrange polynomials, and their derivatives for the
+ * dipoles and quadrupoles */
+VPRIVATE void Vdhtree_setProxy(Vdhtree *thee, VdhtreeNode *node) {
+
+    int i, a, b, c, n, d;
+    double l[3][VDHTREE_MAXORDER+1], dl[3][VDHTREE_MAXORDER+1];
+    double ddl[3][VDHTREE_MAXORDER+1], s[3];
+    double q, *p, *Q, *proxy, lab, dab, adb, ddab, addb, aab;
+
+    n = thee->order + 1;
+    proxy = node->proxy;
+    for (a=0; a<thee->nproxy; a++) proxy[a] = 0.0;
+    for (d=0; d<3; d++) s[d] = 1.0/node->half[d];
+
+    for (i=node->ibeg; i<node->iend; i++) {
+        for (d=0; d<3; d++) {
+            Vdhtree_lagrange(thee, (thee->pos[3*i+d] - node->center[d])*s[d],
+                             l[d]);
+        }
+        q = thee->charge[i];
+        if ((thee->dipole == VNULL) && (thee->quad == VNULL)) {
+            for (a=0; a<n; a++) {
+                for (b=0; b<n; b++) {
+                    lab = q*l[0][a]*l[1][b];
+                    for (c=0; c<n; c++) proxy[(a*n+b)*n+c] += lab*l[2][c];
+                }
+            }
+            continue;
+        }
+
+        for (d=0; d<3; d++) {
+            Vdhtree_lagrangeDeriv(thee, l[d], thee->dmat, s[d], dl[d]);
+            Vdhtree_lagrangeDeriv(thee, l[d], thee->dmat2, s[d]*s[d], ddl[d]);
+        }
+        p = (thee->dipole != VNULL) ? &(thee->dipole[3*i]) : VNULL;
+        Q = (thee->quad != VNULL) ? &(thee->quad[9*i]) : VNULL;
+        for (a=0; a<n; a++) {
+            for (b=0; b<n; b++) {
+                lab = l[0][a]*l[1][b];
+                dab = dl[0][a]*l[1][b];
+                adb = l[0][a]*dl[1][b];
+                ddab = ddl[0][a]*l[1][b];
+                addb = l[0][a]*ddl[1][b];
+                aab = dl[0][a]*dl[1][b];
+                for (c=0; c<n; c++) {
+                    proxy[(a*n+b)*n+c] += q*lab*l[2][c];
+                    if (p != VNULL) {
+                        proxy[(a*n+b)*n+c] += p[0]*dab*l[2][c]
+                                              + p[1]*adb*l[2][c]
+                                              + p[2]*lab*dl[2][c];
+                    }
+                    if (Q != VNULL) {
+                        proxy[(a*n+b)*n+c] += Q[0]*ddab*l[2][c]
+                                              + Q[4]*addb*l[2][c]
+                                              + Q[8]*lab*ddl[2][c]
+                                              + (Q[1]+Q[3])*aab*l[2][c]
+                                              + (Q[2]+Q[6])*dab*dl[2][c]
+                                              + (Q[5]+Q[7])*adb*dl[2][c];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* exp(-kappa r)/r for n distances r, through the vectorized exponential
+ * where there is one */
+VPRIVATE void Vdhtree_kernel(Vdhtree *thee, int n, double *r, double *g) {
+
+    int i;
+
+    if (thee->kappa > 0.0) {
+        for (i=0; i<n; i++) g[i] = -thee->kappa*r[i];
+        if (!Vexp_simd(n, g, g)) {
+            for (i=0; i<n; i++) g[i] = VEXP(g[i]);
+        }
+        for (i=0; i<n; i++) g[i] = g[i]/r[i];
+    } else {
+        for (i=0; i<n; i++) g[i] = 1.0/r[i];
+    }
+}
+
+/* Potential of the proxy charges of a box at npts targets */
+VPRIVATE void Vdhtree_evalProxy(Vdhtree *thee, VdhtreeNode *node, int npts,
+                                double *pts, double *val) {
+
+    int i, a, b, c, k, n;
+    double sx[VDHTREE_MAXORDER+1], sy[VDHTREE_MAXORDER+1];
+    double sz[VDHTREE_MAXORDER+1], dx2, dxy2, sum;
+    double r[(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)];
+    double g[(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)];
+
+    n = thee->order + 1;
+    for (a=0; a<n; a++) {
+        sx[a] = node->center[0] + node->half[0]*thee->cheb[a];
+        sy[a] = node->center[1] + node->half[1]*thee->cheb[a];
+        sz[a] = node->center[2] + node->half[2]*thee->cheb[a];
+    }
+
+    for (i=0; i<npts; i++) {
+        k = 0;
+        for (a=0; a<n; a++) {
+            dx2 = VSQR(pts[3*i] - sx[a]);
+            for (b=0; b<n; b++) {
+                dxy2 = dx2 + VSQR(pts[3*i+1] - sy[b]);
+                for (c=0; c<n; c++) {
+                    r[k] = VSQRT(dxy2 + VSQR(pts[3*i+2] - sz[c]));
+                    k++;
+                }
+            }
+        }
+        Vdhtree_kernel(thee, k, r, g);
+        sum = 0.0;
+        for (k=0; k<thee->nproxy; k++) sum += node->proxy[k]*g[k];
+        val[i] += sum;
+    }
+}
+
+/* Potential of the sources of a leaf box at npts targets, summed directly.
+ * With R = x - y and G(r) = exp(-kappa r)/r, the terms are q G,
+ * p.grad_y G = -(p.R) G'/r and Q:grad_y grad_y G = (R.Q.R) h + tr(Q) G'/r
+ * where h = (G'' - G'/r)/r^2. */
+VPRIVATE void Vdhtree_evalDirect(Vdhtree *thee, VdhtreeNode *node, int npts,
+                                 double *pts, double *val) {
+
+    int i, j, m;
+    double R[3], r[VDHTREE_LEAF], g[VDHTREE_LEAF], r2, kr, g1r, h, sum;
+    double *y, *p, *Q;
+
+    m = node->iend - node->ibeg;
+    y = &(thee->pos[3*node->ibeg]);
+
+    for (i=0; i<npts; i++) {
+        for (j=0; j<m; j++) {
+            r[j] = VSQRT(VSQR(pts[3*i] - y[3*j]) + VSQR(pts[3*i+1] - y[3*j+1])
+                         + VSQR(pts[3*i+2] - y[3*j+2]));
+        }
+        Vdhtree_kernel(thee, m, r, g);
+        sum = 0.0;
+        for (j=0; j<m; j++) sum += thee->charge[node->ibeg+j]*g[j];
+
+        if ((thee->dipole != VNULL) || (thee->quad != VNULL)) {
+            for (j=0; j<m; j++) {
+                R[0] = pts[3*i] - y[3*j];
+                R[1] = pts[3*i+1] - y[3*j+1];
+                R[2] = pts[3*i+2] - y[3*j+2];
+                r2 = r[j]*r[j];
+                kr = thee->kappa*r[j];
+                g1r = -g[j]*(1.0 + kr)/r2;
+                h = g[j]*(3.0 + 3.0*kr + kr*kr)/(r2*r2);
+                if (thee->dipole != VNULL) {
+                    p = &(thee->dipole[3*(node->ibeg+j)]);
+                    sum -= (p[0]*R[0] + p[1]*R[1] + p[2]*R[2])*g1r;
+                }
+                if (thee->quad != VNULL) {
+                    Q = &(thee->quad[9*(node->ibeg+j)]);
+                    sum += h*(R[0]*(Q[0]*R[0] + Q[1]*R[1] + Q[2]*R[2])
+                              + R[1]*(Q[3]*R[0] + Q[4]*R[1] + Q[5]*R[2])
+                              + R[2]*(Q[6]*R[0] + Q[7]*R[1] + Q[8]*R[2]))
+                           + g1r*(Q[0] + Q[4] + Q[8]);
+                }
+            }
+        }
+        val[i] += sum;
+    }
+}
+
+/* ///////////////////////////////////////////////////////////////////////////
+// Class Vdhtree: Non-inlineable methods
+/////////////////////////////////////////////////////////////////////////// */
+
+VPUBLIC Vdhtree* Vdhtree_ctor(int nsrc, double *pos, double *charge,
+                              double *dipole, double *quad, double kappa,
+                              double tol) {
+
+    Vdhtree *thee = VNULL;
+
+    thee = (Vdhtree *)Vmem_malloc(VNULL, 1, sizeof(Vdhtree));
+    VASSERT(thee != VNULL);
+    VASSERT(Vdhtree_ctor2(thee, nsrc, pos, charge, dipole, quad, kappa,
+                          tol));
+
+    return thee;
+}
+
+VPUBLIC int Vdhtree_ctor2(Vdhtree *thee, int nsrc, double *pos,
+                          double *charge, double *dipole, double *quad,
+                          double kappa, double tol) {
+
+    int i, j, inode, *perm, *work;
+    VdhtreeNode *node;
+
+    if ((thee == VNULL) || (nsrc < 1) || (tol <= 0.0)) return 0;
+
+    thee->vmem = Vmem_ctor("APBS:VDHTREE");
+    thee->nsrc = nsrc;
+    thee->kappa = kappa;
+    thee->tol = tol;
+    Vdhtree_setAccuracy(thee, tol);
+    Vdhtree_setCheb(thee);
+
+    /* Sort the sources into boxes */
+    perm = (int *)Vmem_malloc(thee->vmem, nsrc, sizeof(int));
+    work = (int *)Vmem_malloc(thee->vmem, nsrc, sizeof(int));
+    for (i=0; i<nsrc; i++) perm[i] = i;
+    thee->nnode = 0;
+    thee->maxnode = 64;
+    thee->nodes = (VdhtreeNode *)Vmem_malloc(thee->vmem, thee->maxnode,
+                                             sizeof(VdhtreeNode));
+    Vdhtree_build(thee, pos, perm, work, 0, nsrc);
+
+    /* Keep the sources in tree order, so every box is a contiguous range */
+    thee->pos = (double *)Vmem_malloc(thee->vmem, 3*nsrc, sizeof(double));
+    thee->charge = (double *)Vmem_malloc(thee->vmem, nsrc, sizeof(double));
+    thee->dipole = VNULL;
+    thee->quad = VNULL;
+    if (dipole != VNULL) {
+        thee->dipole = (double *)Vmem_malloc(thee->vmem, 3*nsrc,
+                                             sizeof(double));
+    }
+    if (quad != VNULL) {
+        thee->quad = (double *)Vmem_malloc(thee->vmem, 9*nsrc,
+                                           sizeof(double));
+    }
+    for (i=0; i<nsrc; i++) {
+        for (j=0; j<3; j++) thee->pos[3*i+j] = pos[3*perm[i]+j];
+        thee->charge[i] = charge[perm[i]];
+        if (dipole != VNULL) {
+            for (j=0; j<3; j++) thee->dipole[3*i+j] = dipole[3*perm[i]+j];
+        }
+        if (quad != VNULL) {
+            for (j=0; j<9; j++) thee->quad[9*i+j] = quad[9*perm[i]+j];
+        }
+    }
+    Vmem_free(thee->vmem, nsrc, sizeof(int), (void **)&perm);
+    Vmem_free(thee->vmem, nsrc, sizeof(int), (void **)&work);
+
+    /* Proxy charges for the boxes holding more sources than proxies; any
+     * smaller box is cheaper to sum directly */
+    for (inode=0; inode<thee->nnode; inode++) {
+        node = &(thee->nodes[inode]);
+        if (node->iend - node->ibeg <= thee->nproxy) continue;
+        node->proxy = (double *)Vmem_malloc(thee->vmem, thee->nproxy,
+                                            sizeof(double));
+    }
+    #pragma omp parallel for private(inode) schedule(dynamic)
+    for (inode=0; inode<thee->nnode; inode++) {
+        if (thee->nodes[inode].proxy != VNULL) {
+            Vdhtree_setProxy(thee, &(thee->nodes[inode]));
+        }
+    }
+
+    return 1;
+}
+
+VPUBLIC void Vdhtree_dtor(Vdhtree **thee) {
+
+    if ((*thee) != VNULL) {
+        Vdhtree_dtor2(*thee);
+        Vmem_free(VNULL, 1, sizeof(Vdhtree), (void **)thee);
+        (*thee) = VNULL;
+    }
+}
+
+VPUBLIC void Vdhtree_dtor2(Vdhtree *thee) {
+
+    int inode;
+
+    for (inode=0; inode<thee->nnode; inode++) {
+        if (thee->nodes[inode].proxy != VNULL) {
+            Vmem_free(thee->vmem, thee->nproxy, sizeof(double),
+                      (void **)&(thee->nodes[inode].proxy));
+        }
+    }
+    Vmem_free(thee->vmem, thee->maxnode, sizeof(VdhtreeNode),
+              (void **)&(thee->nodes));
+    Vmem_free(thee->vmem, 3*thee->nsrc, sizeof(double),
+              (void **)&(thee->pos));
+    Vmem_free(thee->vmem, thee->nsrc, sizeof(double),
+              (void **)&(thee->charge));
+    if (thee->dipole != VNULL) {
+        Vmem_free(thee->vmem, 3*thee->nsrc, sizeof(double),
+                  (void **)&(thee->dipole));
+    }
+    if (thee->quad != VNULL) {
+        Vmem_free(thee->vmem, 9*thee->nsrc, sizeof(double),
+                  (void **)&(thee->quad));
+    }
+
+    Vmem_dtor(&(thee->vmem));
+}
+
+VPUBLIC void Vdhtree_eval(Vdhtree *thee, int npts, double *pts,
+                          double *val) {
+
+    int i, d, nstack, stack[VDHTREE_MAXSTACK];
+    double lo[3], hi[3], center[3], radius, dist;
+    VdhtreeNode *node;
+
+    if (npts < 1) return;
+
+    /* Bounding sphere of the batch */
+    for (d=0; d<3; d++) {
+        lo[d] = pts[d];
+        hi[d] = pts[d];
+    }
+    for (i=0; i<npts; i++) {
+        val[i] = 0.0;
+        for (d=0; d<3; d++) {
+            lo[d] = VMIN2(lo[d], pts[3*i+d]);
+            hi[d] = VMAX2(hi[d], pts[3*i+d]);
+        }
+    }
+    for (d=0; d<3; d++) center[d] = 0.5*(lo[d] + hi[d]);
+    radius = 0.5*VSQRT(VSQR(hi[0]-lo[0]) + VSQR(hi[1]-lo[1])
+                       + VSQR(hi[2]-lo[2]));
+
+    nstack = 1;
+    stack[0] = 0;
+    while (nstack > 0) {
+        nstack--;
+        node = &(thee->nodes[stack[nstack]]);
+        dist = VSQRT(VSQR(center[0] - node->center[0])
+                     + VSQR(center[1] - node->center[1])
+                     + VSQR(center[2] - node->center[2]));
+        if ((node->proxy != VNULL) &&
+            (node->radius + radius < thee->theta*dist)) {
+            Vdhtree_evalProxy(thee, node, npts, pts, val);
+        } else if (node->nchild == 0) {
+            Vdhtree_evalDirect(thee, node, npts, pts, val);
+        } else {
+            VASSERT(nstack + node->nchild <= VDHTREE_MAXSTACK);
+            for (i=0; i<node->nchild; i++) {
+                stack[nstack] = node->child[i];
+                nstack++;
+            }
+        }
+    }
+}
@@ -0,0 +1,204 @@
+/** @defgroup Vdhtree Vdhtree class
+ *  @brief  Treecode for screened Coulomb (Debye-Huckel) potentials
+ */
+
+/**
+ *  @file     vdhtree.h
+ *  @ingroup  Vdhtree
+ *  @brief    Contains declarations for class Vdhtree
+ *  @version  $Id$
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ *  Nathan A. Baker (nathan.baker@pnnl.gov)
+ *  Pacific Northwest National Laboratory
+ *
+ *  Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the
+ * Pacific Northwest National Laboratory, operated by Battelle Memorial
+ * Institute, Pacific Northwest Division for the U.S. Department of Energy.
+ *
+ * Portions Copyright (c) 2002-2010, Washington University in St. Louis.
+ * Portions Copyright (c) 2002-2010, Nathan A. Baker.
+ * Portions Copyright (c) 1999-2002, The Regents of the University of
+ * California.
+ * Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * Neither the name of the developer nor the names of its contributors may be
+ * used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+#ifndef _VDHTREE_H_
+#define _VDHTREE_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+
+/** @brief   Highest interpolation degree Vdhtree uses
+ *  @ingroup Vdhtree */
+#define VDHTREE_MAXORDER 10
+
+/**
+ *  @ingroup Vdhtree
+ *  @brief   One box of sources in a Vdhtree
+ */
+struct sVdhtreeNode {
+    int ibeg;  /**< First source of the box (in tree order) */
+    int iend;  /**< One past the last source of the box */
+    int nchild;  /**< Number of child boxes (0 for a leaf) */
+    int child[8];  /**< Indices of the child boxes */
+    double center[3];  /**< Center of the box */
+    double half[3];  /**< Half widths of the box */
+    double radius;  /**< Half diagonal of the box */
+    double *proxy;  /**< Charges at the (order+1)^3 Chebyshev points of the
+                     * box, or VNULL for boxes too small to be worth
+                     * approximating */
+};
+
+/**
+ *  @ingroup Vdhtree
+ *  @brief   Declaration of the VdhtreeNode structure
+ */
+typedef struct sVdhtreeNode VdhtreeNode;
+
+/**
+ *  @ingroup Vdhtree
+ *  @brief   Treecode for screened Coulomb potentials
+ *
+ *  Sums the potential
+ *  \f[ \phi(x) = \sum_i q_i G(x - y_i) + p_i \cdot \nabla_{y} G(x - y_i)
+ *      + Q_i : \nabla_{y} \nabla_{y} G(x - y_i), \quad
+ *      G(r) = \frac{e^{-\kappa r}}{r} \f]
+ *  of point charges, dipoles and quadrupoles.  The sources are sorted into
+ *  an adaptive octree.  A box that is well separated from a batch of
+ *  targets (box radius plus batch radius less than theta times their
+ *  distance) is replaced by the charges at a tensor grid of Chebyshev points
+ *  that reproduce its potential by polynomial interpolation of G over the
+ *  box (a barycentric Lagrange treecode); nearer boxes are summed directly.
+ *  Only G itself is needed, so screening costs nothing extra, and the
+ *  dipoles and quadrupoles fold into the same proxy charges through the
+ *  derivatives of the interpolating polynomials.
+ */
+struct sVdhtree {
+    Vmem *vmem;  /**< Memory management object for this class */
+    int nsrc;  /**< Number of sources */
+    double kappa;  /**< Screening parameter (&Aring;^{-1}) */
+    double tol;  /**< Requested relative accuracy */
+    int order;  /**< Interpolation degree */
+    int nproxy;  /**< Proxy charges per box, (order+1)^3 */
+    double theta;  /**< Opening ratio of the separation test */
+    double *pos;  /**< Source positions (3 per source, tree order) */
+    double *charge;  /**< Source charges (tree order) */
+    double *dipole;  /**< Source dipoles (3 per source, tree order) or
+                      * VNULL */
+    double *quad;  /**< Source quadrupoles (9 per source, tree order) or
+                    * VNULL */
+    int nnode;  /**< Number of boxes */
+    int maxnode;  /**< Length of the box array */
+    VdhtreeNode *nodes;  /**< Boxes; the root is box 0 */
+    double cheb[VDHTREE_MAXORDER+1];  /**< Chebyshev points on [-1,1] */
+    double dmat[(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)];  /**< Chebyshev
+                      * differentiation matrix */
+    double dmat2[(VDHTREE_MAXORDER+1)*(VDHTREE_MAXORDER+1)];  /**< Its
+                      * square */
+};
+
+/**
+ *  @ingroup Vdhtree
+ *  @brief   Declaration of the Vdhtree class as the Vdhtree structure
+ */
+typedef struct sVdhtree Vdhtree;
+
+/** @brief   Construct the tree for a set of sources
+ *  @ingroup Vdhtree
+ *  @note    The source arrays are copied.  tol is the relative accuracy
+ *           asked of the potential; the interpolation degree and the
+ *           opening ratio are chosen from it.
+ *  @param   nsrc  Number of sources
+ *  @param   pos  Source positions (3 per source, &Aring;)
+ *  @param   charge  Source charges
+ *  @param   dipole  Source dipoles (3 per source) or VNULL
+ *  @param   quad  Source quadrupoles (9 per source, symmetric) or VNULL
+ *  @param   kappa  Screening parameter (&Aring;^{-1})
+ *  @param   tol  Relative accuracy (> 0)
+ *  @returns Newly allocated Vdhtree object
+ */
+VEXTERNC Vdhtree* Vdhtree_ctor(int nsrc, double *pos, double *charge,
+                               double *dipole, double *quad, double kappa,
+                               double tol);
+
+/** @brief   FORTRAN stub to construct the tree for a set of sources
+ *  @ingroup Vdhtree
+ *  @param   thee  Pointer to allocated Vdhtree object
+ *  @param   nsrc  Number of sources
+ *  @param   pos  Source positions (3 per source, &Aring;)
+ *  @param   charge  Source charges
+ *  @param   dipole  Source dipoles (3 per source) or VNULL
+ *  @param   quad  Source quadrupoles (9 per source, symmetric) or VNULL
+ *  @param   kappa  Screening parameter (&Aring;^{-1})
+ *  @param   tol  Relative accuracy (> 0)
+ *  @returns 1 if successful, 0 otherwise
+ */
+VEXTERNC int Vdhtree_ctor2(Vdhtree *thee, int nsrc, double *pos,
+                           double *charge, double *dipole, double *quad,
+                           double kappa, double tol);
+
+/** @brief   Object destructor
+ *  @ingroup Vdhtree
+ *  @param   thee  Pointer to memory location of object to be destroyed
+ */
+VEXTERNC void Vdhtree_dtor(Vdhtree **thee);
+
+/** @brief   FORTRAN stub object destructor
+ *  @ingroup Vdhtree
+ *  @param   thee  Pointer to object to be destroyed
+ */
+VEXTERNC void Vdhtree_dtor2(Vdhtree *thee);
+
+/** @brief   Evaluate the potential at a batch of targets
+ *  @ingroup Vdhtree
+ *  @note    The batch is tested against the boxes as a whole, so it should
+ *           be compact (a tile of a grid face, say).  Safe to call from
+ *           several threads at once.
+ *  @param   thee  Vdhtree object
+ *  @param   npts  Number of targets
+ *  @param   pts  Target positions (3 per target, &Aring;)
+ *  @param   val  Set to the potential at each target
+ */
+VEXTERNC void Vdhtree_eval(Vdhtree *thee, int npts, double *pts,
+                           double *val);
+
+#endif    /* ifndef _VDHTREE_H_ */
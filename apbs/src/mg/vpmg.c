@@ -150,6 +150,78 @@ VPUBLIC Vpmg* Vpmg_ctor(Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
     return thee;
 }
 
+/* First and one-past-last index of z-plane k (k = 1..nz-2) under the static
+ * schedule of the OpenMP stencil kernels, which run over the interior planes
+ * only; the two boundary planes go with their neighbors */
+#define PLANE0(k)  (((k) == 1) ? 0 : (size_t)(k)*nxy)
+#define PLANE1(k)  (((k) == nz-2) ? (size_t)nz*nxy : (size_t)((k)+1)*nxy)
+
+/* Clear a grid array from the threads that will work on it.  Each stretch of
+ * nx*ny*nz entries is split by z-plane like the stencil kernels split the
+ * grid, so on a NUMA machine every plane is first touched, and placed, next
+ * to the thread that later updates it; a shorter tail (the coarse levels) is
+ * split into plane-sized chunks. */
+VPRIVATE void Vpmg_firstTouch(Vpmg *thee, double *ram, size_t num) {
+
+    int k, c, nc, nz;
+    size_t nxy, nf, s, i0, i1;
+
+    nz = thee->pmgp->nz;
+    nxy = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny);
+    nf = nxy*nz;
+
+    s = 0;
+    if (nz >= 3) {
+        for (s=0; s+nf<=num; s+=nf) {
+            #pragma omp parallel for private(k)
+            for (k=1; k<nz-1; k++) {
+                memset(ram + s + PLANE0(k), 0,
+                       (PLANE1(k) - PLANE0(k))*sizeof(double));
+            }
+        }
+    }
+    nc = (int)((num - s + nxy - 1)/nxy);
+    #pragma omp parallel for private(c, i0, i1)
+    for (c=0; c<nc; c++) {
+        i0 = s + (size_t)c*nxy;
+        i1 = VMIN2(i0 + nxy, num);
+        memset(ram + i0, 0, (i1 - i0)*sizeof(double));
+    }
+}
+
+/* Grid-sized arrays come from the driver's arena when it set one up, so that
+ * a later Vpmg on the same mesh gets back pages that are already mapped */
+VPRIVATE double* Vpmg_gridMalloc(Vpmg *thee, size_t num) {
+
+    double *ram;
+
+    if (thee->arena != VNULL) ram = Varena_malloc(thee->arena, num);
+    else ram = (double *)Vmem_malloc(thee->vmem, num, sizeof(double));
+    Vpmg_firstTouch(thee, ram, num);
+
+    return ram;
+}
+
+VPRIVATE void Vpmg_gridFree(Vpmg *thee, size_t num, double **ram) {
+
+    if (thee->arena != VNULL) Varena_free(thee->arena, ram);
+    else Vmem_free(thee->vmem, num, sizeof(double), (void **)ram);
+}
+
+/* The matrix-free operator reads the shifted dielectric straight out of the
+ * fine operator slot of rwork, so there is no separate copy to keep */
+VPRIVATE void Vpmg_placeFaces(Vpmg *thee) {
+
+    size_t nf;
+
+    if (thee->pmgp->mgdisc != 2) return;
+
+    nf = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz);
+    thee->epsx = Vmgfineop(thee->iparm, thee->rwork);
+    thee->epsy = thee->epsx + nf;
+    thee->epsz = thee->epsy + nf;
+}
+
 VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
                        Vpmg *pmgOLD, MGparm *mgparm, PBEparm_calcEnergy energyFlag) {
 
@@ -157,6 +229,7 @@ VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
     double ionConc[MAXION], ionQ[MAXION], ionRadii[MAXION], zkappa2, zks2;
     double ionstr, partMin[3], partMax[3];
 	size_t size;
+    Vgrid *guess;
 
     /* Get the parameters */
     VASSERT(pmgp != VNULL);
@@ -166,7 +239,11 @@ VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
 
     /* Set up the memory */
     thee->vmem = Vmem_ctor("APBS:VPMG");
+    thee->arena = pmgp->arena;
 
+    /* The kernel level is process-wide; each calculation sets its own */
+    if (pmgp->simd < 0) Vsimd_setLevel(VSIMD_AVX512);
+    else Vsimd_setLevel((Vsimd_Level)pmgp->simd);
 
 
     /// @note  this is common to both replace/noreplace options
@@ -284,32 +361,48 @@ VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
         thee->extQfEnergy = 0;
     }
 
+    /* The boundary values and external energies are in place, so all the
+     * fine level still needs from the coarse one is its potential for a
+     * warm start.  Keep a copy of that and release the coarse level before
+     * the fine grid arrays are allocated (with an arena, the fine level
+     * then reuses its pages). */
+    guess = VNULL;
+    if (focusFlag && (pmgOLD != VNULL) && mgparm->warmstart) {
+        guess = Vpmg_focusHandoff(pmgOLD);
+    }
+
+    /*
+     * TODO: Move the dtor out of here. The current ctor is done in routines.c,
+     *       This was originally moved out to kill a memory leak. The dtor has
+     *       has been removed from initMG and placed back here to keep memory
+     *       usage low. killMG has been modified accordingly.
+     */
+    Vpmg_dtor(&pmgOLD);
+
     /* Allocate partition vector storage */
     size = (thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz);
-    thee->pvec = (double *)Vmem_malloc(
-        thee->vmem,
-        size,
-        sizeof(double)
-        );
+    thee->pvec = Vpmg_gridMalloc(thee, size);
 
     /* Allocate remaining storage */
     thee->iparm  = (   int *)Vmem_malloc(thee->vmem,                100, sizeof(   int));
     thee->rparm  = (double *)Vmem_malloc(thee->vmem,                100, sizeof(double));
     thee->iwork  = (   int *)Vmem_malloc(thee->vmem,   thee->pmgp->niwk, sizeof(   int));
-    thee->rwork  = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->nrwk, sizeof(double));
-    thee->charge = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->kappa  = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->pot    = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->epsx   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->epsy   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->epsz   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->a1cf   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->a2cf   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->a3cf   = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->ccf    = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->fcf    = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->tcf    = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
-    thee->u      = (double *)Vmem_malloc(thee->vmem,   thee->pmgp->narr, sizeof(double));
+    thee->rwork  = Vpmg_gridMalloc(thee, thee->pmgp->nrwk);
+    thee->charge = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->kappa  = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->pot    = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    if (thee->pmgp->mgdisc != 2) {
+        thee->epsx   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+        thee->epsy   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+        thee->epsz   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    }
+    thee->a1cf   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->a2cf   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->a3cf   = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->ccf    = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->fcf    = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->tcf    = Vpmg_gridMalloc(thee, thee->pmgp->narr);
+    thee->u      = Vpmg_gridMalloc(thee, thee->pmgp->narr);
     thee->xf     = (double *)Vmem_malloc(thee->vmem, 5*(thee->pmgp->nx), sizeof(double));
     thee->yf     = (double *)Vmem_malloc(thee->vmem, 5*(thee->pmgp->ny), sizeof(double));
     thee->zf     = (double *)Vmem_malloc(thee->vmem, 5*(thee->pmgp->nz), sizeof(double));
@@ -325,7 +418,9 @@ VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
             &(thee->pmgp->mgprol), &(thee->pmgp->mgcoar), &(thee->pmgp->mgsolv),
             &(thee->pmgp->mgdisc), &(thee->pmgp->iinfo), &(thee->pmgp->errtol),
             &(thee->pmgp->ipkey), &(thee->pmgp->omegal), &(thee->pmgp->omegan),
-            &(thee->pmgp->irite), &(thee->pmgp->iperf));
+            &(thee->pmgp->irite), &(thee->pmgp->iperf), &(thee->pmgp->mgprec));
+    VAT(thee->iparm, 26) = thee->pmgp->inewt;
+    Vpmg_placeFaces(thee);
 
 
 
@@ -385,68 +480,347 @@ VPUBLIC int Vpmg_ctor2(Vpmg *thee, Vpmgp *pmgp, Vpbe *pbe, int focusFlag,
 
     /* The coefficient arrays have not been filled */
     thee->filled = 0;
+    thee->nsnap = 0;
+    thee->snap = VNULL;
 
+    /* No operator hierarchy is kept yet */
+    thee->opsBuilt = 0;
+    thee->opsKey = 0;
 
-    /*
-     * TODO: Move the dtor out of here. The current ctor is done in routines.c,
-     *       This was originally moved out to kill a memory leak. The dtor has
-     *       has been removed from initMG and placed back here to keep memory
-     *       usage low. killMG has been modified accordingly.
-     */
-    Vpmg_dtor(&pmgOLD);
+    /* Solves start from zero unless given a guess; a focused warm start
+     * begins from the parent potential handed over above */
+    thee->useGuess = 0;
+    if (guess != VNULL) {
+        Vpmg_setGuessGrid(thee, guess);
+        Vgrid_dtor(&guess);
+    }
 
     return 1;
 }
 
-VPUBLIC int Vpmg_solve(Vpmg *thee) {
+VPRIVATE uint64_t Vpmg_coefKey(Vpmg *thee) {
 
-    int i,
-        nx,
-        ny,
-        nz,
-        n;
-    double zkappa2;
+    int i, j, k, nxy, nz;
+    uint64_t key, pkey, *plane;
+    double parm[4];
+    double *coef[4];
+    union { double d; uint64_t u; } word;
 
-    nx = thee->pmgp->nx;
-    ny = thee->pmgp->ny;
+    nxy = (thee->pmgp->nx)*(thee->pmgp->ny);
     nz = thee->pmgp->nz;
-    n = nx*ny*nz;
 
-    if (!(thee->filled)) {
-        Vnm_print(2, "Vpmg_solve:  Need to call Vpmg_fillco()!\n");
-        return 0;
+    parm[0] = Vpbe_getZkappa2(thee->pbe);
+    parm[1] = thee->pmgp->hx;
+    parm[2] = thee->pmgp->hy;
+    parm[3] = thee->pmgp->hzed;
+
+    coef[0] = thee->epsx;
+    coef[1] = thee->epsy;
+    coef[2] = thee->epsz;
+    coef[3] = thee->kappa;
+
+    /* 64-bit FNV-1a over the bit patterns; each step is invertible, so any
+     * single changed coefficient changes the key.  Every z-plane of every
+     * map is hashed on its own and the plane keys are then hashed in order,
+     * which keeps the key independent of the thread count */
+    plane = (uint64_t *)Vmem_malloc(thee->vmem, 4*nz, sizeof(uint64_t));
+    #pragma omp parallel for private(i, j, k, pkey, word)
+    for (k=0; k<4*nz; k++) {
+        j = k / nz;
+        pkey = 14695981039346656037ULL;
+        for (i=(k%nz)*nxy; i<(k%nz+1)*nxy; i++) {
+            word.d = coef[j][i];
+            pkey = (pkey ^ word.u) * 1099511628211ULL;
+        }
+        plane[k] = pkey;
+    }
+
+    key = 14695981039346656037ULL;
+    for (j=0; j<4; j++) {
+        word.d = parm[j];
+        key = (key ^ word.u) * 1099511628211ULL;
+    }
+    for (k=0; k<4*nz; k++) key = (key ^ plane[k]) * 1099511628211ULL;
+
+    Vmem_free(thee->vmem, 4*nz, sizeof(uint64_t), (void **)&plane);
+
+    return key;
+}
+
+VPUBLIC int Vpmg_adoptOps(Vpmg *thee, Vpmg *pmgOLD) {
+
+    /* iparm entries that fix the layout and content of the hierarchy */
+    static const int same[12] = {1, 2, 3, 4, 5, 6, 14, 17, 18, 19, 21, 23};
+    int i;
+    int *itmp;
+    double *rtmp;
+    uint64_t key;
+
+    VASSERT(thee != VNULL);
+
+    if ((pmgOLD == VNULL) || !(pmgOLD->opsBuilt)) return 0;
+    if (!(thee->pmgp->reuseops) || !(thee->filled)) return 0;
+    /* rwork goes back to whichever allocator its new owner uses */
+    if (thee->arena != pmgOLD->arena) return 0;
+    for (i=0; i<12; i++) {
+        if (VAT(thee->iparm, same[i]) != VAT(pmgOLD->iparm, same[i])) {
+            return 0;
+        }
     }
+    key = Vpmg_coefKey(thee);
+    if (key != pmgOLD->opsKey) return 0;
+
+    /* Same sizes, so the work arrays can simply change hands */
+    itmp = thee->iwork;
+    thee->iwork = pmgOLD->iwork;
+    pmgOLD->iwork = itmp;
+    rtmp = thee->rwork;
+    thee->rwork = pmgOLD->rwork;
+    pmgOLD->rwork = rtmp;
+    Vpmg_placeFaces(thee);
+    Vpmg_placeFaces(pmgOLD);
+
+    thee->opsBuilt = 1;
+    thee->opsKey = key;
+    pmgOLD->opsBuilt = 0;
+
+    Vnm_print(0, "Vpmg_adoptOps:  reusing the operator hierarchy\n");
 
-    /* Fill the "true solution" array */
-    for (i=0; i<n; i++) {
-        thee->tcf[i] = 0.0;
+    return 1;
+}
+
+VPUBLIC void Vpmg_setGuess(Vpmg *thee, double *guess) {
+
+    int i, n;
+
+    VASSERT(thee != VNULL);
+
+    if (guess == VNULL) {
+        thee->useGuess = 0;
+        return;
     }
 
-    /* Fill the RHS array */
-    for (i=0; i<n; i++) {
-        thee->fcf[i] = thee->charge[i];
+    n = thee->pmgp->nx * thee->pmgp->ny * thee->pmgp->nz;
+    if (guess != thee->u) {
+        for (i=0; i<n; i++) thee->u[i] = guess[i];
     }
+    thee->useGuess = 1;
+}
 
-    /* Fill the operator coefficient array. */
-    for (i=0; i<n; i++) {
-        thee->a1cf[i] = thee->epsx[i];
-        thee->a2cf[i] = thee->epsy[i];
-        thee->a3cf[i] = thee->epsz[i];
+VPUBLIC void Vpmg_setGuessGrid(Vpmg *thee, Vgrid *grid) {
+
+    int i, j, k, nx, ny, nz;
+    double hx, hy, hzed, xmin, ymin, zmin, pt[3], val;
+
+    VASSERT(thee != VNULL);
+    VASSERT(grid != VNULL);
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - ((double)(nx-1)*hx)/2.0;
+    ymin = thee->pmgp->ycent - ((double)(ny-1)*hy)/2.0;
+    zmin = thee->pmgp->zcent - ((double)(nz-1)*hzed)/2.0;
+
+#pragma omp parallel for default(shared) private(i,j,k,pt,val)
+    for (k=0; k<nz; k++) {
+        pt[2] = zmin + k*hzed;
+        for (j=0; j<ny; j++) {
+            pt[1] = ymin + j*hy;
+            for (i=0; i<nx; i++) {
+                pt[0] = xmin + i*hx;
+                /* Vgrid_value does not reject points below the minima */
+                val = 0.0;
+                if ((pt[0] >= grid->xmin) && (pt[1] >= grid->ymin) &&
+                    (pt[2] >= grid->zmin)) {
+                    if (!Vgrid_value(grid, pt, &val)) val = 0.0;
+                }
+                thee->u[IJK(i,j,k)] = val;
+            }
+        }
+    }
+    thee->useGuess = 1;
+}
+
+VPUBLIC Vgrid* Vpmg_focusHandoff(Vpmg *thee) {
+
+    int nx, ny, nz;
+    double hx, hy, hzed;
+    Vgrid *grid;
+
+    VASSERT(thee != VNULL);
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+
+    /* The grid owns its copy (readdata), so Vgrid_dtor frees it */
+    grid = Vgrid_ctor(nx, ny, nz, hx, hy, hzed,
+            thee->pmgp->xcent - ((double)(nx-1)*hx)/2.0,
+            thee->pmgp->ycent - ((double)(ny-1)*hy)/2.0,
+            thee->pmgp->zcent - ((double)(nz-1)*hzed)/2.0,
+            VNULL);
+    grid->data = (double *)Vmem_malloc(grid->mem, nx*ny*nz, sizeof(double));
+    grid->readdata = 1;
+    memcpy(grid->data, thee->u, (size_t)nx*ny*nz*sizeof(double));
+
+    return grid;
+}
+
+VPUBLIC void Vpmg_setGuessPmg(Vpmg *thee, Vpmg *pmgOLD) {
+
+    int nx, ny, nz;
+    double hx, hy, hzed;
+    Vgrid *grid;
+
+    VASSERT(thee != VNULL);
+    VASSERT(pmgOLD != VNULL);
+
+    nx = pmgOLD->pmgp->nx;
+    ny = pmgOLD->pmgp->ny;
+    nz = pmgOLD->pmgp->nz;
+    hx = pmgOLD->pmgp->hx;
+    hy = pmgOLD->pmgp->hy;
+    hzed = pmgOLD->pmgp->hzed;
+
+    if ((nx == thee->pmgp->nx) && (ny == thee->pmgp->ny) &&
+        (nz == thee->pmgp->nz) && (hx == thee->pmgp->hx) &&
+        (hy == thee->pmgp->hy) && (hzed == thee->pmgp->hzed) &&
+        (pmgOLD->pmgp->xcent == thee->pmgp->xcent) &&
+        (pmgOLD->pmgp->ycent == thee->pmgp->ycent) &&
+        (pmgOLD->pmgp->zcent == thee->pmgp->zcent)) {
+        Vpmg_setGuess(thee, pmgOLD->u);
+        return;
     }
 
-    /* Fill the nonlinear coefficient array by multiplying the kappa
-     * accessibility array (containing values between 0 and 1) by zkappa2. */
+    grid = Vgrid_ctor(nx, ny, nz, hx, hy, hzed,
+            pmgOLD->pmgp->xcent - ((double)(nx-1)*hx)/2.0,
+            pmgOLD->pmgp->ycent - ((double)(ny-1)*hy)/2.0,
+            pmgOLD->pmgp->zcent - ((double)(nz-1)*hzed)/2.0,
+            pmgOLD->u);
+    Vpmg_setGuessGrid(thee, grid);
+    Vgrid_dtor(&grid);
+}
+
+/* Set up the solver arrays from the coefficients fillco left behind; the
+ * loop runs over the same z-planes as the stencil kernels */
+VPRIVATE void Vpmg_fillSolve(Vpmg *thee, int fillRHS) {
+
+    int k, nz, matfree;
+    size_t i, nxy;
+    double zkappa2;
+
+    nz = thee->pmgp->nz;
+    nxy = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny);
+    /* The matrix-free operator reads the faces from rwork directly */
+    matfree = (thee->pmgp->mgdisc == 2);
+
+    /* The nonlinear coefficient array is the kappa accessibility array
+     * (containing values between 0 and 1) times zkappa2 */
     zkappa2 = Vpbe_getZkappa2(thee->pbe);
-    if (zkappa2 > VPMGSMALL) {
-        for (i=0; i<n; i++) {
-            thee->ccf[i] = zkappa2*thee->kappa[i];
+    if (zkappa2 <= VPMGSMALL) zkappa2 = 0.0;
+
+    #pragma omp parallel for private(k, i)
+    for (k=1; k<nz-1; k++) {
+        for (i=PLANE0(k); i<PLANE1(k); i++) {
+            /* "True solution", RHS and operator coefficients */
+            thee->tcf[i] = 0.0;
+            if (fillRHS) thee->fcf[i] = thee->charge[i];
+            if (!matfree) {
+                thee->a1cf[i] = thee->epsx[i];
+                thee->a2cf[i] = thee->epsy[i];
+                thee->a3cf[i] = thee->epsz[i];
+            }
+            thee->ccf[i] = (zkappa2 > 0.0) ? zkappa2*thee->kappa[i] : 0.0;
         }
-    } else {
-        for (i=0; i<n; i++) {
-            thee->ccf[i] = 0.0;
+    }
+}
+
+/* Print how the pages of the grid arrays are spread over the NUMA nodes */
+VPRIVATE void Vpmg_printPages(Vpmg *thee) {
+
+    int i, j, npage, count[VARENA_MAXNODE];
+    size_t narr, nf, neps;
+    const char *name[15] = {"u", "rwork", "a1cf", "a2cf", "a3cf", "ccf",
+                            "fcf", "tcf", "charge", "kappa", "epsx", "epsy",
+                            "epsz", "pot", "pvec"};
+    double *array[15];
+    size_t num[15];
+
+    narr = thee->pmgp->narr;
+    nf = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz);
+    array[0] = thee->u;      num[0] = narr;
+    array[1] = thee->rwork;  num[1] = thee->pmgp->nrwk;
+    array[2] = thee->a1cf;   num[2] = narr;
+    array[3] = thee->a2cf;   num[3] = narr;
+    array[4] = thee->a3cf;   num[4] = narr;
+    array[5] = thee->ccf;    num[5] = narr;
+    array[6] = thee->fcf;    num[6] = narr;
+    array[7] = thee->tcf;    num[7] = narr;
+    array[8] = thee->charge; num[8] = narr;
+    array[9] = thee->kappa;  num[9] = narr;
+    /* Matrix-free faces are part of rwork */
+    neps = (thee->pmgp->mgdisc == 2) ? 0 : narr;
+    array[10] = thee->epsx;  num[10] = neps;
+    array[11] = thee->epsy;  num[11] = neps;
+    array[12] = thee->epsz;  num[12] = neps;
+    array[13] = thee->pot;   num[13] = narr;
+    array[14] = thee->pvec;  num[14] = nf;
+
+    Vnm_print(1, "Vpmg_printPages:  grid array pages per NUMA node:\n");
+    for (i=0; i<15; i++) {
+        npage = Varena_placement(array[i], num[i], count);
+        if (npage < 0) {
+            Vnm_print(1, "Vpmg_printPages:  page placement is not available on \
+this system\n");
+            return;
+        }
+        Vnm_print(1, "    %-7s %7d pages:", name[i], npage);
+        for (j=0; j<VARENA_MAXNODE; j++) {
+            if (count[j] == 0) continue;
+            Vnm_print(1, "  node %d %5.1f%%", j,
+                      100.0*(double)count[j]/(double)npage);
+        }
+        Vnm_print(1, "\n");
+    }
+}
+
+VPUBLIC int Vpmg_solve(Vpmg *thee) {
+
+    uint64_t key = 0;
+
+    if (!(thee->filled)) {
+        Vnm_print(2, "Vpmg_solve:  Need to call Vpmg_fillco()!\n");
+        return 0;
+    }
+
+    /* Fill the "true solution", RHS, operator and nonlinear coefficient
+     * arrays */
+    Vpmg_fillSolve(thee, 1);
+
+    /* A kept hierarchy is only valid for the coefficients it was built
+     * from; otherwise build a new one (and keep it if asked to) */
+    if (thee->pmgp->reuseops) {
+        key = Vpmg_coefKey(thee);
+        if (thee->opsBuilt && (key == thee->opsKey)) {
+            VAT(thee->iparm, 24) = 2;
+        } else {
+            if (thee->opsBuilt) Vmgfree(thee->iparm, thee->iwork);
+            thee->opsBuilt = 0;
+            VAT(thee->iparm, 24) = 1;
         }
     }
 
+    /* Start from u only if a guess was set for this solve */
+    VAT(thee->iparm, 25) = thee->useGuess;
+    thee->useGuess = 0;
+
     switch(thee->pmgp->meth) {
         /* CGMG (linear) */
         case VSOL_CGMG:
@@ -454,7 +828,10 @@ VPUBLIC int Vpmg_solve(Vpmg *thee) {
             if (thee->pmgp->iinfo > 1)
                 Vnm_print(2, "Driving with CGMGDRIV\n");
 
-            VABORT_MSG0("CGMGDRIV is not currently supported");
+            Vcgmgdriv(thee->iparm, thee->rparm, thee->iwork, thee->rwork,
+                      thee->u, thee->xf, thee->yf, thee->zf, thee->gxcf, thee->gycf,
+                      thee->gzcf, thee->a1cf, thee->a2cf, thee->a3cf, thee->ccf,
+                      thee->fcf, thee->tcf);
             break;
 
         /* Newton (nonlinear) */
@@ -553,10 +930,190 @@ VPUBLIC int Vpmg_solve(Vpmg *thee) {
             break;
     }
 
+    if (thee->pmgp->reuseops) {
+        thee->opsBuilt = 1;
+        thee->opsKey = key;
+    }
+
+    if (thee->pmgp->pagemap) Vpmg_printPages(thee);
+
+    return 1;
+
+}
+
+VPUBLIC int Vpmg_solveBlock(Vpmg *thee, int nrhs, double *charge,
+        double *gxcf, double *gycf, double *gzcf, double *pot) {
+
+    int i,
+        r,
+        nx,
+        ny,
+        nz,
+        n,
+        ngx,
+        ngy,
+        ngz,
+        narr,
+        nbw,
+        ownFaces;
+    double *bw;
+    uint64_t key = 0;
+
+    VASSERT(thee != VNULL);
+    VASSERT(charge != VNULL);
+    VASSERT(pot != VNULL);
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    n = nx*ny*nz;
+    ngx = 2*ny*nz;
+    ngy = 2*nx*nz;
+    ngz = 2*nx*ny;
+
+    if (!(thee->filled)) {
+        Vnm_print(2, "Vpmg_solveBlock:  Need to call Vpmg_fillco()!\n");
+        return 0;
+    }
+    if ((nrhs < 1) || (nrhs > VBLK_MAXRHS)) {
+        Vnm_print(2, "Vpmg_solveBlock:  Need 1 to %d right-hand sides (got %d)!\n",
+          VBLK_MAXRHS, nrhs);
+        return 0;
+    }
+    if ((thee->pmgp->nonlin != NONLIN_LPBE) ||
+        ((thee->pmgp->meth != VSOL_MG) && (thee->pmgp->meth != VSOL_CGMG))) {
+        Vnm_print(2, "Vpmg_solveBlock:  Only the linear multigrid solvers \
+take several right-hand sides!\n");
+        return 0;
+    }
+    if ((thee->pmgp->mgdisc == 2) || (thee->pmgp->nlev < 2)) {
+        Vnm_print(2, "Vpmg_solveBlock:  Need assembled operators on at \
+least two levels!\n");
+        return 0;
+    }
+    if (thee->pmgp->mgprec != 0) {
+        /* Vmvmix keeps part of its hierarchy in single precision */
+        Vnm_print(2, "Vpmg_solveBlock:  Need a double-precision \
+hierarchy!\n");
+        return 0;
+    }
+    if (thee->pmgp->mgsmoo != 1) {
+        Vnm_print(0, "Vpmg_solveBlock:  Smoothing with red/black \
+Gauss-Seidel (mgsmoo %d ignored)\n", thee->pmgp->mgsmoo);
+    }
+
+    /* Fill the "true solution", operator and nonlinear coefficient arrays;
+     * the right-hand sides are loaded per solve */
+    Vpmg_fillSolve(thee, 0);
+
+    /* Same hierarchy bookkeeping as Vpmg_solve */
+    if (thee->pmgp->reuseops) {
+        key = Vpmg_coefKey(thee);
+        if (thee->opsBuilt && (key == thee->opsKey)) {
+            VAT(thee->iparm, 24) = 2;
+        } else {
+            if (thee->opsBuilt) Vmgfree(thee->iparm, thee->iwork);
+            thee->opsBuilt = 0;
+            VAT(thee->iparm, 24) = 1;
+        }
+    }
+
+    /* Without boundary values of their own, every right-hand side takes the
+     * ones set up by Vpmg_fillco */
+    ownFaces = (gxcf == VNULL);
+    if (ownFaces) {
+        gxcf = (double *)Vmem_malloc(thee->vmem, nrhs*ngx, sizeof(double));
+        gycf = (double *)Vmem_malloc(thee->vmem, nrhs*ngy, sizeof(double));
+        gzcf = (double *)Vmem_malloc(thee->vmem, nrhs*ngz, sizeof(double));
+        for (r=0; r<nrhs; r++) {
+            for (i=0; i<ngx; i++) gxcf[r*ngx+i] = thee->gxcf[i];
+            for (i=0; i<ngy; i++) gycf[r*ngy+i] = thee->gycf[i];
+            for (i=0; i<ngz; i++) gzcf[r*ngz+i] = thee->gzcf[i];
+        }
+    }
+    VASSERT((gycf != VNULL) && (gzcf != VNULL));
+
+    /* Interleaved multilevel vectors for all right-hand sides */
+    narr = thee->pmgp->narr;
+    nbw = Vblksz(&nrhs, &n, &narr);
+    bw = (double *)Vmem_malloc(thee->vmem, nbw, sizeof(double));
+
+    if (thee->pmgp->iinfo > 1)
+        Vnm_print(2, "Driving with BLKDRIV (%d right-hand sides)\n", nrhs);
+
+    Vblkdriv(thee->iparm, thee->rparm, thee->iwork, thee->rwork,
+             &nrhs, pot, bw, thee->xf, thee->yf, thee->zf,
+             gxcf, gycf, gzcf, thee->a1cf, thee->a2cf, thee->a3cf,
+             thee->ccf, charge, thee->tcf);
+
+    Vmem_free(thee->vmem, nbw, sizeof(double), (void **)&bw);
+    if (ownFaces) {
+        Vmem_free(thee->vmem, nrhs*ngx, sizeof(double), (void **)&gxcf);
+        Vmem_free(thee->vmem, nrhs*ngy, sizeof(double), (void **)&gycf);
+        Vmem_free(thee->vmem, nrhs*ngz, sizeof(double), (void **)&gzcf);
+    }
+
+    if (thee->pmgp->reuseops) {
+        thee->opsBuilt = 1;
+        thee->opsKey = key;
+    }
+
+    if (thee->pmgp->pagemap) Vpmg_printPages(thee);
+
     return 1;
 
 }
 
+VPUBLIC int Vpmg_solveMaps(Vpmg *thee, int nmap, Vgrid *map[],
+        double *energy) {
+
+    int r, rc;
+    size_t n;
+    double *charge, *pot, *u, *chg;
+
+    VASSERT(thee != VNULL);
+    VASSERT(energy != VNULL);
+
+    if ((nmap < 1) || (nmap > VBLK_MAXRHS)) {
+        Vnm_print(2, "Vpmg_solveMaps:  Need 1 to %d charge maps (got %d)!\n",
+          VBLK_MAXRHS, nmap);
+        return 0;
+    }
+
+    n = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz);
+    charge = (double *)Vmem_malloc(thee->vmem, nmap*n, sizeof(double));
+    pot = (double *)Vmem_malloc(thee->vmem, nmap*n, sizeof(double));
+
+    rc = 1;
+    for (r=0; r<nmap; r++) {
+        if (fillcoChargeGrid(thee, map[r], charge + r*n) != VRC_SUCCESS) {
+            rc = 0;
+            break;
+        }
+    }
+    if (rc) rc = Vpmg_solveBlock(thee, nmap, charge, VNULL, VNULL, VNULL,
+                                 pot);
+
+    /* The q-phi energy of each map with its own potential, as Vpmg_energy
+     * gives it for a linear problem */
+    if (rc) {
+        u = thee->u;
+        chg = thee->charge;
+        for (r=0; r<nmap; r++) {
+            thee->u = pot + r*n;
+            thee->charge = charge + r*n;
+            energy[r] = 0.5*Vpmg_qfEnergyVolume(thee, 1);
+        }
+        thee->u = u;
+        thee->charge = chg;
+    }
+
+    Vmem_free(thee->vmem, nmap*n, sizeof(double), (void **)&charge);
+    Vmem_free(thee->vmem, nmap*n, sizeof(double), (void **)&pot);
+
+    return rc;
+}
+
 
 VPUBLIC void Vpmg_dtor(Vpmg **thee) {
 
@@ -570,6 +1127,9 @@ VPUBLIC void Vpmg_dtor(Vpmg **thee) {
 
 VPUBLIC void Vpmg_dtor2(Vpmg *thee) {
 
+    /* Release what a kept hierarchy holds outside the work arrays */
+    if (thee->opsBuilt) Vmgfree(thee->iparm, thee->iwork);
+
     /* Clean up the storage */
 
     Vmem_free(thee->vmem,              100, sizeof(int),
@@ -578,34 +1138,26 @@ VPUBLIC void Vpmg_dtor2(Vpmg *thee) {
         (void **)&(thee->rparm));
     Vmem_free(thee->vmem, thee->pmgp->niwk, sizeof(int),
       (void **)&(thee->iwork));
-    Vmem_free(thee->vmem, thee->pmgp->nrwk, sizeof(double),
-      (void **)&(thee->rwork));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->charge));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->kappa));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-              (void **)&(thee->pot));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->epsx));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->epsy));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->epsz));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->a1cf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->a2cf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->a3cf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->ccf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->fcf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->tcf));
-    Vmem_free(thee->vmem, thee->pmgp->narr, sizeof(double),
-      (void **)&(thee->u));
+    Vpmg_gridFree(thee, thee->pmgp->nrwk, &(thee->rwork));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->charge));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->kappa));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->pot));
+    if (thee->pmgp->mgdisc != 2) {
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsx));
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsy));
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsz));
+    } else {
+        thee->epsx = VNULL;
+        thee->epsy = VNULL;
+        thee->epsz = VNULL;
+    }
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a1cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a2cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a3cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->ccf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->fcf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->tcf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->u));
     Vmem_free(thee->vmem, 5*(thee->pmgp->nx), sizeof(double),
       (void **)&(thee->xf));
     Vmem_free(thee->vmem, 5*(thee->pmgp->ny), sizeof(double),
@@ -618,12 +1170,43 @@ VPUBLIC void Vpmg_dtor2(Vpmg *thee) {
       (void **)&(thee->gycf));
     Vmem_free(thee->vmem, 10*(thee->pmgp->nx)*(thee->pmgp->ny), sizeof(double),
       (void **)&(thee->gzcf));
-    Vmem_free(thee->vmem, (thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz),
-      sizeof(double), (void **)&(thee->pvec));
+    Vpmg_gridFree(thee, (thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz),
+      &(thee->pvec));
+    if (thee->snap != VNULL) {
+        Vmem_free(thee->vmem, VPMGSNAP*thee->nsnap, sizeof(double),
+          (void **)&(thee->snap));
+    }
 
     Vmem_dtor(&(thee->vmem));
 }
 
+VPUBLIC void Vpmg_releaseFine(Vpmg *thee, int keepPot) {
+
+    VASSERT(thee != VNULL);
+
+    /* Everything a later adoption or warm start reads is kept: the
+     * parameters, the work arrays with the hierarchy and, if asked, u */
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->charge));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->kappa));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->pot));
+    if (thee->pmgp->mgdisc != 2) {
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsx));
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsy));
+        Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->epsz));
+    }
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a1cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a2cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->a3cf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->ccf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->fcf));
+    Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->tcf));
+    Vpmg_gridFree(thee, (thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz),
+      &(thee->pvec));
+    if (!keepPot) Vpmg_gridFree(thee, thee->pmgp->narr, &(thee->u));
+
+    thee->filled = 0;
+}
+
 VPUBLIC void Vpmg_setPart(Vpmg *thee, double lowerCorner[3],
         double upperCorner[3], int bflags[6]) {
 
@@ -1245,60 +1828,61 @@ VPRIVATE double Vpmg_polarizEnergy(Vpmg *thee,
     return pre*energy;
 }
 
-VPUBLIC double Vpmg_energy(Vpmg *thee,
-                           int extFlag
-                          ) {
-
-    double totEnergy = 0.0,
-           dielEnergy = 0.0,
-           qmEnergy = 0.0,
-           qfEnergy = 0.0;
+/* Add up n plane sums in a fixed pairwise order (a is overwritten), so the
+ * result does not depend on how the planes were split among threads */
+VPRIVATE double Vpmg_pairSum(double *a, int n) {
 
-    VASSERT(thee != VNULL);
+    int i, w;
 
-    if ((thee->pmgp->nonlin) && (Vpbe_getBulkIonicStrength(thee->pbe) > 0.)) {
-        Vnm_print(0, "Vpmg_energy:  calculating full PBE energy\n");
-        qmEnergy = Vpmg_qmEnergy(thee, extFlag);
-        Vnm_print(0, "Vpmg_energy:  qmEnergy = %1.12E kT\n", qmEnergy);
-        qfEnergy = Vpmg_qfEnergy(thee, extFlag);
-        Vnm_print(0, "Vpmg_energy:  qfEnergy = %1.12E kT\n", qfEnergy);
-        dielEnergy = Vpmg_dielEnergy(thee, extFlag);
-        Vnm_print(0, "Vpmg_energy:  dielEnergy = %1.12E kT\n", dielEnergy);
-        totEnergy = qfEnergy - dielEnergy - qmEnergy;
-    } else {
-        Vnm_print(0, "Vpmg_energy:  calculating only q-phi energy\n");
-        qfEnergy = Vpmg_qfEnergy(thee, extFlag);
-        Vnm_print(0, "Vpmg_energy:  qfEnergy = %1.12E kT\n", qfEnergy);
-        totEnergy = 0.5*qfEnergy;
+    if (n < 1) return 0.0;
+    for (w=1; w<n; w*=2) {
+        for (i=0; i+w<n; i+=2*w) a[i] += a[i+w];
     }
-
-    return totEnergy;
-
+    return a[0];
 }
 
-VPUBLIC double Vpmg_dielEnergy(Vpmg *thee,
-                               int extFlag
-                              ) {
+VPRIVATE void Vpmg_energySweep(Vpmg *thee, int extFlag, int qfFlag,
+                               int qmFlag, int dielFlag, double *qfEnergy,
+                               double *qmEnergy, double *dielEnergy) {
 
     double hx,
            hy,
            hzed,
-           energy,
-           nrgx,
-           nrgy,
-           nrgz,
+           zkappa2,
+           ionstr,
+           zks2,
+           ionConc[MAXION],
+           ionRadii[MAXION],
+           ionQ[MAXION],
+           sqf,
+           sqm,
+           sdi,
+           pk,
            pvecx,
            pvecy,
-           pvecz;
+           pvecz,
+           *part;
     int i,
         j,
         k,
+        l,
         nx,
         ny,
-        nz;
+        nz,
+        nion,
+        ichop,
+        nchop,
+        *chop;
+    size_t m,
+           nxy;
 
     VASSERT(thee != VNULL);
 
+    if (!thee->filled) {
+        Vnm_print(2, "Vpmg_energySweep:  Need to call Vpmg_fillco!\n");
+        VASSERT(0);
+    }
+
     /* Get the mesh information */
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
@@ -1306,35 +1890,177 @@ VPUBLIC double Vpmg_dielEnergy(Vpmg *thee,
     hx = thee->pmgp->hx;
     hy = thee->pmgp->hy;
     hzed = thee->pmgp->hzed;
+    nxy = (size_t)nx*ny;
 
-    energy = 0.0;
+    zkappa2 = Vpbe_getZkappa2(thee->pbe);
+    ionstr = Vpbe_getBulkIonicStrength(thee->pbe);
+    zks2 = (ionstr > 0.0) ? 0.5*zkappa2/ionstr : 0.0;
+    Vpbe_getIons(thee->pbe, &nion, ionConc, ionRadii, ionQ);
 
-    if (!thee->filled) {
-        Vnm_print(2, "Vpmg_dielEnergy:  Need to call Vpmg_fillco!\n");
-        VASSERT(0);
-    }
+    part = (double *)Vmem_malloc(thee->vmem, 3*nz, sizeof(double));
+    chop = (int *)Vmem_malloc(thee->vmem, nz, sizeof(int));
 
-    for (k=0; k<(nz-1); k++) {
-        for (j=0; j<(ny-1); j++) {
-            for (i=0; i<(nx-1); i++) {
-                pvecx = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i+1,j,k)]);
-                pvecy = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i,j+1,k)]);
-                pvecz = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i,j,k+1)]);
-                nrgx = thee->epsx[IJK(i,j,k)]*pvecx
-                  * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i+1,j,k)])/hx);
-                nrgy = thee->epsy[IJK(i,j,k)]*pvecy
-                  * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i,j+1,k)])/hy);
-                nrgz = thee->epsz[IJK(i,j,k)]*pvecz
-                  * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i,j,k+1)])/hzed);
-                energy += (nrgx + nrgy + nrgz);
+    /* One pass per z-plane; each plane is summed in the order of the
+     * original serial loops */
+    #pragma omp parallel for default(shared) \
+        private(i, j, k, l, m, ichop, sqf, sqm, sdi, pk, pvecx, pvecy, pvecz)
+    for (k=0; k<nz; k++) {
+        sqf = 0.0;
+        sqm = 0.0;
+        sdi = 0.0;
+        chop[k] = 0;
+        if (qfFlag || qmFlag) {
+            for (m=k*nxy; m<(k+1)*nxy; m++) {
+                if (qfFlag) sqf += (thee->pvec[m]*thee->u[m]*thee->charge[m]);
+                pk = thee->pvec[m]*thee->kappa[m];
+                if ((qmFlag == 2) && (pk > VSMALL)) {
+                    for (l=0; l<nion; l++) {
+                        sqm += (pk*zks2
+                          * ionConc[l]
+                          * (Vcap_exp(-ionQ[l]*thee->u[m], &ichop)-1.0));
+                        chop[k] += ichop;
+                    }
+                } else if ((qmFlag == 1) && (pk > VSMALL)) {
+                    sqm += (thee->pvec[m]*zkappa2*thee->kappa[m]
+                            *VSQR(thee->u[m]));
+                }
+            }
+        }
+        if (dielFlag && (k < nz-1)) {
+            for (j=0; j<(ny-1); j++) {
+                for (i=0; i<(nx-1); i++) {
+                    pvecx = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i+1,j,k)]);
+                    pvecy = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i,j+1,k)]);
+                    pvecz = 0.5*(thee->pvec[IJK(i,j,k)]+thee->pvec[IJK(i,j,k+1)]);
+                    sdi += (thee->epsx[IJK(i,j,k)]*pvecx
+                      * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i+1,j,k)])/hx)
+                      + thee->epsy[IJK(i,j,k)]*pvecy
+                      * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i,j+1,k)])/hy)
+                      + thee->epsz[IJK(i,j,k)]*pvecz
+                      * VSQR((thee->u[IJK(i,j,k)]-thee->u[IJK(i,j,k+1)])/hzed));
+                }
             }
         }
+        part[k] = sqf;
+        part[nz+k] = sqm;
+        part[2*nz+k] = sdi;
+    }
+
+    if (qfFlag) {
+        *qfEnergy = Vpmg_pairSum(part, nz)*hx*hy*hzed
+            /Vpbe_getZmagic(thee->pbe);
+        if (extFlag == 1) *qfEnergy += thee->extQfEnergy;
+    }
+
+    if (qmFlag) {
+        nchop = 0;
+        for (k=0; k<nz; k++) nchop += chop[k];
+        if (nchop > 0){
+            Vnm_print(2, "Vpmg_qmEnergy:  Chopped EXP %d times!\n",nchop);
+            Vnm_print(2, "\nERROR!  Detected large potential values in energy evaluation! \nERROR!  This calculation failed -- please report to the APBS developers!\n\n");
+            VASSERT(0);
+        }
+        *qmEnergy = Vpmg_pairSum(part+nz, nz);
+        if (qmFlag == 1) *qmEnergy = 0.5*(*qmEnergy);
+        *qmEnergy = (*qmEnergy)*hx*hy*hzed/Vpbe_getZmagic(thee->pbe);
+        if (extFlag == 1) *qmEnergy += thee->extQmEnergy;
+    }
+
+    if (dielFlag) {
+        *dielEnergy = 0.5*Vpmg_pairSum(part+2*nz, nz)*hx*hy*hzed;
+        *dielEnergy = (*dielEnergy)/Vpbe_getZmagic(thee->pbe);
+        if (extFlag == 1) *dielEnergy += (thee->extDiEnergy);
+    }
+
+    Vmem_free(thee->vmem, 3*nz, sizeof(double), (void **)&part);
+    Vmem_free(thee->vmem, nz, sizeof(int), (void **)&chop);
+}
+
+VPUBLIC double Vpmg_energyComps(Vpmg *thee,
+                                int extFlag,
+                                double *qfEnergy,
+                                double *qmEnergy,
+                                double *dielEnergy
+                               ) {
+
+    int qfFlag,
+        qmFlag;
+
+    VASSERT(thee != VNULL);
+
+    /* Point charges and the SMPBE functional are not grid sums */
+    *qfEnergy = 0.0;
+    *qmEnergy = 0.0;
+    *dielEnergy = 0.0;
+    qfFlag = ((thee->useChargeMap) || (thee->chargeMeth == VCM_BSPL2));
+    if (!qfFlag) *qfEnergy = Vpmg_qfEnergyPoint(thee, extFlag);
+    qmFlag = 0;
+    if (thee->pbe->ipkey == IPKEY_SMPBE) {
+        *qmEnergy = Vpmg_qmEnergySMPBE(thee, extFlag);
+    } else if (Vpbe_getZkappa2(thee->pbe) < VSMALL) {
+#ifndef VAPBSQUIET
+        Vnm_print(0, "Vpmg_qmEnergy:  Zero energy for zero ionic strength!\n");
+#endif
+    } else if (thee->pmgp->nonlin) {
+        Vnm_print(0, "Vpmg_qmEnergy:  Calculating nonlinear energy\n");
+        qmFlag = 2;
+    } else {
+        Vnm_print(0, "Vpmg_qmEnergy:  Calculating linear energy\n");
+        qmFlag = 1;
+    }
+
+    Vpmg_energySweep(thee, extFlag, qfFlag, qmFlag, 1, qfEnergy, qmEnergy,
+                     dielEnergy);
+
+    if ((thee->pmgp->nonlin) && (Vpbe_getBulkIonicStrength(thee->pbe) > 0.)) {
+        return (*qfEnergy) - (*dielEnergy) - (*qmEnergy);
+    }
+    return 0.5*(*qfEnergy);
+}
+
+VPUBLIC double Vpmg_energy(Vpmg *thee,
+                           int extFlag
+                          ) {
+
+    double totEnergy = 0.0,
+           dielEnergy = 0.0,
+           qmEnergy = 0.0,
+           qfEnergy = 0.0;
+
+    VASSERT(thee != VNULL);
+
+    if ((thee->pmgp->nonlin) && (Vpbe_getBulkIonicStrength(thee->pbe) > 0.)) {
+        Vnm_print(0, "Vpmg_energy:  calculating full PBE energy\n");
+        totEnergy = Vpmg_energyComps(thee, extFlag, &qfEnergy, &qmEnergy,
+                                     &dielEnergy);
+        Vnm_print(0, "Vpmg_energy:  qmEnergy = %1.12E kT\n", qmEnergy);
+        Vnm_print(0, "Vpmg_energy:  qfEnergy = %1.12E kT\n", qfEnergy);
+        Vnm_print(0, "Vpmg_energy:  dielEnergy = %1.12E kT\n", dielEnergy);
+    } else {
+        Vnm_print(0, "Vpmg_energy:  calculating only q-phi energy\n");
+        qfEnergy = Vpmg_qfEnergy(thee, extFlag);
+        Vnm_print(0, "Vpmg_energy:  qfEnergy = %1.12E kT\n", qfEnergy);
+        totEnergy = 0.5*qfEnergy;
     }
 
-    energy = 0.5*energy*hx*hy*hzed;
-    energy = energy/Vpbe_getZmagic(thee->pbe);
+    return totEnergy;
+
+}
+
+VPUBLIC double Vpmg_dielEnergy(Vpmg *thee,
+                               int extFlag
+                              ) {
+
+    double energy = 0.0;
+
+    VASSERT(thee != VNULL);
+
+    if (!thee->filled) {
+        Vnm_print(2, "Vpmg_dielEnergy:  Need to call Vpmg_fillco!\n");
+        VASSERT(0);
+    }
 
-    if (extFlag == 1) energy += (thee->extDiEnergy);
+    Vpmg_energySweep(thee, extFlag, 0, 0, 1, VNULL, VNULL, &energy);
 
     return energy;
 }
@@ -1402,37 +2128,12 @@ VPRIVATE double Vpmg_qmEnergyNONLIN(Vpmg *thee,
                                     int extFlag
                                    ) {
 
-    double hx,
-           hy,
-           hzed,
-           energy,
-           ionConc[MAXION],
-           ionRadii[MAXION],
-           ionQ[MAXION],
-           zkappa2,
-           ionstr,
-           zks2;
-    int i, /* Loop variable */
-        j,
-        nx,
-        ny,
-        nz,
-        nion,
-        ichop,
-        nchop,
-        len; /* Stores number of iterations for loops to avoid multiple recalculations */
+    double energy,
+           zkappa2;
 
     VASSERT(thee != VNULL);
 
-    /* Get the mesh information */
-    nx = thee->pmgp->nx;
-    ny = thee->pmgp->ny;
-    nz = thee->pmgp->nz;
-    hx = thee->pmgp->hx;
-    hy = thee->pmgp->hy;
-    hzed = thee->pmgp->hzed;
     zkappa2 = Vpbe_getZkappa2(thee->pbe);
-    ionstr = Vpbe_getBulkIonicStrength(thee->pbe);
 
     /* Bail if we're at zero ionic strength */
     if (zkappa2 < VSMALL) {
@@ -1443,7 +2144,6 @@ VPRIVATE double Vpmg_qmEnergyNONLIN(Vpmg *thee,
 
         return 0.0;
     }
-    zks2 = 0.5*zkappa2/ionstr;
 
     if (!thee->filled) {
         Vnm_print(2, "Vpmg_qmEnergy:  Need to call Vpmg_fillco()!\n");
@@ -1451,38 +2151,14 @@ VPRIVATE double Vpmg_qmEnergyNONLIN(Vpmg *thee,
     }
 
     energy = 0.0;
-    nchop = 0;
-    Vpbe_getIons(thee->pbe, &nion, ionConc, ionRadii, ionQ);
     if (thee->pmgp->nonlin) {
         Vnm_print(0, "Vpmg_qmEnergy:  Calculating nonlinear energy\n");
-        for (i=0, len=nx*ny*nz; i<len; i++) {
-            if (thee->pvec[i]*thee->kappa[i] > VSMALL) {
-                for (j=0; j<nion; j++) {
-                    energy += (thee->pvec[i]*thee->kappa[i]*zks2
-                      * ionConc[j]
-                      * (Vcap_exp(-ionQ[j]*thee->u[i], &ichop)-1.0));
-                    nchop += ichop;
-                }
-            }
-        }
-        if (nchop > 0){
-            Vnm_print(2, "Vpmg_qmEnergy:  Chopped EXP %d times!\n",nchop);
-            Vnm_print(2, "\nERROR!  Detected large potential values in energy evaluation! \nERROR!  This calculation failed -- please report to the APBS developers!\n\n");
-            VASSERT(0);
-        }
+        Vpmg_energySweep(thee, extFlag, 0, 2, 0, VNULL, &energy, VNULL);
     } else {
         /* Zkappa2 OK here b/c LPBE approx */
         Vnm_print(0, "Vpmg_qmEnergy:  Calculating linear energy\n");
-        for (i=0, len=nx*ny*nz; i<len; i++) {
-            if (thee->pvec[i]*thee->kappa[i] > VSMALL)
-              energy += (thee->pvec[i]*zkappa2*thee->kappa[i]*VSQR(thee->u[i]));
-        }
-        energy = 0.5*energy;
+        Vpmg_energySweep(thee, extFlag, 0, 1, 0, VNULL, &energy, VNULL);
     }
-    energy = energy*hx*hy*hzed;
-    energy = energy/Vpbe_getZmagic(thee->pbe);
-
-    if (extFlag == 1) energy += thee->extQmEnergy;
 
     return energy;
 }
@@ -1860,32 +2536,17 @@ VPUBLIC double Vpmg_qfAtomEnergy(Vpmg *thee, Vatom *atom) {
 
 VPRIVATE double Vpmg_qfEnergyVolume(Vpmg *thee, int extFlag) {
 
-    double hx, hy, hzed, energy;
-    int i, nx, ny, nz;
+    double energy = 0.0;
 
     VASSERT(thee != VNULL);
 
-    /* Get the mesh information */
-    nx = thee->pmgp->nx;
-    ny = thee->pmgp->ny;
-    nz = thee->pmgp->nz;
-    hx = thee->pmgp->hx;
-    hy = thee->pmgp->hy;
-    hzed = thee->pmgp->hzed;
-
     if (!thee->filled) {
         Vnm_print(2, "Vpmg_qfEnergyVolume:  need to call Vpmg_fillco!\n");
         VASSERT(0);
     }
 
-    energy = 0.0;
     Vnm_print(0, "Vpmg_qfEnergyVolume:  Calculating energy\n");
-    for (i=0; i<(nx*ny*nz); i++) {
-        energy += (thee->pvec[i]*thee->u[i]*thee->charge[i]);
-    }
-    energy = energy*hx*hy*hzed/Vpbe_getZmagic(thee->pbe);
-
-    if (extFlag == 1) energy += thee->extQfEnergy;
+    Vpmg_energySweep(thee, extFlag, 1, 0, 0, &energy, VNULL, VNULL);
 
     return energy;
 }
@@ -1911,11 +2572,54 @@ VPRIVATE void Vpmg_splineSelect(int srfm,Vacc *acc,double *gpos,double win,
     return;
 }
 
+VPRIVATE int focusInterp(double *data, int nx, int ny, int nz,
+                         double hx, double hy, double hz,
+                         double xmin, double ymin, double zmin,
+                         double xmax, double ymax, double zmax,
+                         double x, double y, double z, double *uval) {
+
+    double ifloat, jfloat, kfloat, dx, dy, dz;
+    int ihi, ilo, jhi, jlo, khi, klo;
+
+    if ((x < (xmin-VSMALL)) || (y < (ymin-VSMALL)) || (z < (zmin-VSMALL)) ||
+        (x > (xmax+VSMALL)) || (y > (ymax+VSMALL)) || (z > (zmax+VSMALL))) {
+        return 0;
+    }
+
+    ifloat = (x - xmin)/hx;
+    jfloat = (y - ymin)/hy;
+    kfloat = (z - zmin)/hz;
+    ihi = (int)ceil(ifloat);
+    if (ihi > (nx-1)) ihi = nx-1;
+    ilo = (int)floor(ifloat);
+    if (ilo < 0) ilo = 0;
+    jhi = (int)ceil(jfloat);
+    if (jhi > (ny-1)) jhi = ny-1;
+    jlo = (int)floor(jfloat);
+    if (jlo < 0) jlo = 0;
+    khi = (int)ceil(kfloat);
+    if (khi > (nz-1)) khi = nz-1;
+    klo = (int)floor(kfloat);
+    if (klo < 0) klo = 0;
+    dx = ifloat - (double)(ilo);
+    dy = jfloat - (double)(jlo);
+    dz = kfloat - (double)(klo);
+    *uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
+    + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
+    + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
+    + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
+    + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
+    + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
+    + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
+    + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
+
+    return 1;
+}
+
 VPRIVATE void focusFillBound(Vpmg *thee,
                              Vpmg *pmgOLD
                             ) {
 
-    Vpbe *pbe;
     double hxOLD,
            hyOLD,
            hzOLD,
@@ -1937,24 +2641,15 @@ VPRIVATE void focusFillBound(Vpmg *thee,
            x,
            y,
            z,
-           dx,
-           dy,
-           dz,
-           ifloat,
-           jfloat,
-           kfloat,
            uval,
-           eps_w,
-           T,
-           pre1,
-           xkappa,
-           size,
-           *apos,
-           charge,
-           //pos[3], // gcc: not used
            uvalMin,
            uvalMax,
-           *data;
+           *data,
+           *gx,
+           *gy,
+           *gz,
+           *val,
+           **dst;
     int nxOLD,
         nyOLD,
         nzOLD,
@@ -1964,12 +2659,9 @@ VPRIVATE void focusFillBound(Vpmg *thee,
         i,
         j,
         k,
-        ihi,
-        ilo,
-        jhi,
-        jlo,
-        khi,
-        klo,
+        side,
+        offMesh,
+        noff,
         nx,
         ny,
         nz;
@@ -2024,31 +2716,6 @@ VPRIVATE void focusFillBound(Vpmg *thee,
 
         data = thee->potMap->data;
     }
-    /* BOUNDARY CONDITION SETUP FOR POINTS OFF OLD MESH:
-     * For each "atom" (only one for bcfl=1), we use the following formula to
-     * calculate the boundary conditions:
-     *    g(x) = \frac{q e_c}{4*\pi*\eps_0*\eps_w*k_b*T}
-     *          * \frac{exp(-xkappa*(d - a))}{1+xkappa*a}
-     *          * 1/d
-     * where d = ||x - x_0|| (in m) and a is the size of the atom (in m).
-     * We only need to evaluate some of these prefactors once:
-     *    pre1 = \frac{e_c}{4*\pi*\eps_0*\eps_w*k_b*T}
-     * which gives the potential as
-     *    g(x) = pre1 * q/d * \frac{exp(-xkappa*(d - a))}{1+xkappa*a}
-     */
-    pbe = thee->pbe;
-    eps_w = Vpbe_getSolventDiel(pbe);           /* Dimensionless */
-    T = Vpbe_getTemperature(pbe);               /* K             */
-    pre1 = (Vunit_ec)/(4*VPI*Vunit_eps0*eps_w*Vunit_kb*T);
-
-    /* Finally, if we convert keep xkappa in A^{-1} and scale pre1 by
-     * m/A, then we will only need to deal with distances and sizes in
-     * Angstroms rather than meters.                                       */
-    xkappa = Vpbe_getXkappa(pbe);              /* A^{-1}        */
-    pre1 = pre1*(1.0e10);
-    size = Vpbe_getSoluteRadius(pbe);
-    apos = Vpbe_getSoluteCenter(pbe);
-    charge = Vunit_ec*Vpbe_getSoluteCharge(pbe);
 
     /* Check for rounding error */
     if (VABS(xminOLD-xminNEW) < VSMALL) xminNEW = xminOLD;
@@ -2069,11 +2736,11 @@ VPRIVATE void focusFillBound(Vpmg *thee,
     Vnm_print(0, "VPMG::focusFillBound -- Old mesh maxs = %g, %g, %g\n",
               xmaxOLD, ymaxOLD, zmaxOLD);
 
-    /* The following is obsolete; we'll substitute analytical boundary
-     * condition values when the new mesh falls outside the old */
-    if ((xmaxNEW>xmaxOLD) || (ymaxNEW>ymaxOLD) || (zmaxNEW>zmaxOLD) ||
-        (xminOLD>xminNEW) || (yminOLD>yminNEW) || (zminOLD>zminNEW)) {
-
+    /* Boundary points that fall outside the old mesh get multiple
+     * Debye-Huckel values (mdhPoints) instead of interpolated ones */
+    offMesh = ((xmaxNEW>xmaxOLD) || (ymaxNEW>ymaxOLD) || (zmaxNEW>zmaxOLD) ||
+               (xminOLD>xminNEW) || (yminOLD>yminNEW) || (zminOLD>zminNEW));
+    if (offMesh) {
         Vnm_print(2, "Vpmg::focusFillBound -- new mesh not contained in old!\n");
         Vnm_print(2, "Vpmg::focusFillBound -- old mesh min = (%g, %g, %g)\n",
                   xminOLD, yminOLD, zminOLD);
@@ -2083,345 +2750,209 @@ VPRIVATE void focusFillBound(Vpmg *thee,
                   xminNEW, yminNEW, zminNEW);
         Vnm_print(2, "Vpmg::focusFillBound -- new mesh max = (%g, %g, %g)\n",
                   xmaxNEW, ymaxNEW, zmaxNEW);
-        fflush(stderr);
-        VASSERT(0);
+        Vnm_print(2, "Vpmg::focusFillBound -- using multiple Debye-Huckel \
+values off the old mesh\n");
     }
 
-    uvalMin	= VPMGSMALL;
-    uvalMax = -VPMGSMALL;
-
-    /* Fill the "i" boundaries (dirichlet) */
+    /* Fill the "i" boundaries (dirichlet); each thread takes whole rows */
+#pragma omp parallel for default(shared) private(j,k,y,z,uval)
     for (k=0; k<nzNEW; k++) {
+        z = zminNEW + k*hzNEW;
         for (j=0; j<nyNEW; j++) {
-            /* Low X face */
-            x = xminNEW;
             y = yminNEW + j*hyNEW;
-            z = zminNEW + k*hzNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+
+            /* Low X face */
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             xminNEW, y, z, &uval)) uval = 0.0;
             thee->gxcf[IJKx(j,k,0)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* High X face */
-            x = xmaxNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             xmaxNEW, y, z, &uval)) uval = 0.0;
             thee->gxcf[IJKx(j,k,1)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* Zero Neumann conditions */
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gxcf[IJKx(j,k,2)] = 0.0;
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gxcf[IJKx(j,k,3)] = 0.0;
         }
     }
 
     /* Fill the "j" boundaries (dirichlet) */
+#pragma omp parallel for default(shared) private(i,k,x,z,uval)
     for (k=0; k<nzNEW; k++) {
+        z = zminNEW + k*hzNEW;
         for (i=0; i<nxNEW; i++) {
-            /* Low Y face */
             x = xminNEW + i*hxNEW;
-            y = yminNEW;
-            z = zminNEW + k*hzNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+
+            /* Low Y face */
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             x, yminNEW, z, &uval)) uval = 0.0;
             thee->gycf[IJKy(i,k,0)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* High Y face */
-            y = ymaxNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             x, ymaxNEW, z, &uval)) uval = 0.0;
             thee->gycf[IJKy(i,k,1)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* Zero Neumann conditions */
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gycf[IJKy(i,k,2)] = 0.0;
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gycf[IJKy(i,k,3)] = 0.0;
         }
     }
 
     /* Fill the "k" boundaries (dirichlet) */
+#pragma omp parallel for default(shared) private(i,j,x,y,uval)
     for (j=0; j<nyNEW; j++) {
+        y = yminNEW + j*hyNEW;
         for (i=0; i<nxNEW; i++) {
-            /* Low Z face */
             x = xminNEW + i*hxNEW;
-            y = yminNEW + j*hyNEW;
-            z = zminNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+
+            /* Low Z face */
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             x, y, zminNEW, &uval)) uval = 0.0;
             thee->gzcf[IJKz(i,j,0)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* High Z face */
-            z = zmaxNEW;
-            if ((x >= (xminOLD-VSMALL)) && (y >= (yminOLD-VSMALL)) && (z >= (zminOLD-VSMALL)) &&
-                (x <= (xmaxOLD+VSMALL)) && (y <= (ymaxOLD+VSMALL)) && (z <= (zmaxOLD+VSMALL))) {
-                ifloat = (x - xminOLD)/hxOLD;
-                jfloat = (y - yminOLD)/hyOLD;
-                kfloat = (z - zminOLD)/hzOLD;
-                ihi = (int)ceil(ifloat);
-                if (ihi > (nxOLD-1)) ihi = nxOLD-1;
-                ilo = (int)floor(ifloat);
-                if (ilo < 0) ilo = 0;
-                jhi = (int)ceil(jfloat);
-                if (jhi > (nyOLD-1)) jhi = nyOLD-1;
-                jlo = (int)floor(jfloat);
-                if (jlo < 0) jlo = 0;
-                khi = (int)ceil(kfloat);
-                if (khi > (nzOLD-1)) khi = nzOLD-1;
-                klo = (int)floor(kfloat);
-                if (klo < 0) klo = 0;
-                dx = ifloat - (double)(ilo);
-                dy = jfloat - (double)(jlo);
-                dz = kfloat - (double)(klo);
-                nx = nxOLD; ny = nyOLD; nz = nzOLD;
-                uval =  dx*dy*dz*(data[IJK(ihi,jhi,khi)])
-                + dx*(1.0-dy)*dz*(data[IJK(ihi,jlo,khi)])
-                + dx*dy*(1.0-dz)*(data[IJK(ihi,jhi,klo)])
-                + dx*(1.0-dy)*(1.0-dz)*(data[IJK(ihi,jlo,klo)])
-                + (1.0-dx)*dy*dz*(data[IJK(ilo,jhi,khi)])
-                + (1.0-dx)*(1.0-dy)*dz*(data[IJK(ilo,jlo,khi)])
-                + (1.0-dx)*dy*(1.0-dz)*(data[IJK(ilo,jhi,klo)])
-                + (1.0-dx)*(1.0-dy)*(1.0-dz)*(data[IJK(ilo,jlo,klo)]);
-                nx = nxNEW; ny = nyNEW; nz = nzNEW;
-            } else {
-                Vnm_print(2, "focusFillBound (%s, %d):  Off old mesh at %g, %g \
-                          %g!\n", __FILE__, __LINE__, x, y, z);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh lower corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xminOLD, yminOLD, zminOLD);
-                Vnm_print(2, "focusFillBound (%s, %d):  old mesh upper corner at \
-                          %g %g %g.\n", __FILE__, __LINE__, xmaxOLD, ymaxOLD, zmaxOLD);
-                VASSERT(0);
-            }
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
+            if (!focusInterp(data, nxOLD, nyOLD, nzOLD, hxOLD, hyOLD, hzOLD,
+                             xminOLD, yminOLD, zminOLD,
+                             xmaxOLD, ymaxOLD, zmaxOLD,
+                             x, y, zmaxNEW, &uval)) uval = 0.0;
             thee->gzcf[IJKz(i,j,1)] = uval;
-            if(uval < uvalMin) uvalMin = uval;
-            if(uval > uvalMax) uvalMax = uval;
 
             /* Zero Neumann conditions */
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gzcf[IJKz(i,j,2)] = 0.0;
-            nx = nxNEW; ny = nyNEW; nz = nzNEW;
             thee->gzcf[IJKz(i,j,3)] = 0.0;
         }
     }
 
-    VWARN_MSG0(
-        uvalMin >= SINH_MIN && uvalMax <= SINH_MAX,
-        "Unusually large potential values\n"
-        "    detected on the focusing boundary!\n"
-        "    Convergence not guaranteed for NPBE/NRPBE calculations!"
-        );
-}
-
-VPRIVATE void extEnergy(Vpmg *thee, Vpmg *pmgOLD, PBEparm_calcEnergy extFlag,
-                        double partMin[3], double partMax[3], int bflags[6]) {
-
-    Vatom *atom;
-    double hxNEW, hyNEW, hzNEW;
-    double lowerCorner[3], upperCorner[3];
-    int nxNEW, nyNEW, nzNEW;
-    int nxOLD, nyOLD, nzOLD;
-    int i,j,k;
+    /* Collect the points off the old mesh and evaluate them in one batch */
+    if (offMesh) {
+        noff = 2*(nyNEW*nzNEW + nxNEW*nzNEW + nxNEW*nyNEW);
+        gx = (double*)Vmem_malloc(thee->vmem, noff, sizeof(double));
+        gy = (double*)Vmem_malloc(thee->vmem, noff, sizeof(double));
+        gz = (double*)Vmem_malloc(thee->vmem, noff, sizeof(double));
+        val = (double*)Vmem_malloc(thee->vmem, noff, sizeof(double));
+        dst = (double**)Vmem_malloc(thee->vmem, noff, sizeof(double*));
+
+        noff = 0;
+        for (k=0; k<nzNEW; k++) {
+            for (j=0; j<nyNEW; j++) {
+                for (side=0; side<2; side++) {
+                    gx[noff] = (side == 0) ? xminNEW : xmaxNEW;
+                    gy[noff] = yminNEW + j*hyNEW;
+                    gz[noff] = zminNEW + k*hzNEW;
+                    if (!focusInterp(data, nxOLD, nyOLD, nzOLD,
+                                     hxOLD, hyOLD, hzOLD,
+                                     xminOLD, yminOLD, zminOLD,
+                                     xmaxOLD, ymaxOLD, zmaxOLD,
+                                     gx[noff], gy[noff], gz[noff], &uval)) {
+                        dst[noff++] = &(thee->gxcf[IJKx(j,k,side)]);
+                    }
+                }
+            }
+        }
+        for (k=0; k<nzNEW; k++) {
+            for (i=0; i<nxNEW; i++) {
+                for (side=0; side<2; side++) {
+                    gx[noff] = xminNEW + i*hxNEW;
+                    gy[noff] = (side == 0) ? yminNEW : ymaxNEW;
+                    gz[noff] = zminNEW + k*hzNEW;
+                    if (!focusInterp(data, nxOLD, nyOLD, nzOLD,
+                                     hxOLD, hyOLD, hzOLD,
+                                     xminOLD, yminOLD, zminOLD,
+                                     xmaxOLD, ymaxOLD, zmaxOLD,
+                                     gx[noff], gy[noff], gz[noff], &uval)) {
+                        dst[noff++] = &(thee->gycf[IJKy(i,k,side)]);
+                    }
+                }
+            }
+        }
+        for (j=0; j<nyNEW; j++) {
+            for (i=0; i<nxNEW; i++) {
+                for (side=0; side<2; side++) {
+                    gx[noff] = xminNEW + i*hxNEW;
+                    gy[noff] = yminNEW + j*hyNEW;
+                    gz[noff] = (side == 0) ? zminNEW : zmaxNEW;
+                    if (!focusInterp(data, nxOLD, nyOLD, nzOLD,
+                                     hxOLD, hyOLD, hzOLD,
+                                     xminOLD, yminOLD, zminOLD,
+                                     xmaxOLD, ymaxOLD, zmaxOLD,
+                                     gx[noff], gy[noff], gz[noff], &uval)) {
+                        dst[noff++] = &(thee->gzcf[IJKz(i,j,side)]);
+                    }
+                }
+            }
+        }
+
+        Vnm_print(2, "Vpmg::focusFillBound -- %d boundary points off the \
+old mesh\n", noff);
+        for (i=0; i<noff; i++) val[i] = 0.0;
+        mdhPoints(thee, noff, gx, gy, gz, val);
+        for (i=0; i<noff; i++) *(dst[i]) = val[i];
+
+        i = 2*(nyNEW*nzNEW + nxNEW*nzNEW + nxNEW*nyNEW);
+        Vmem_free(thee->vmem, i, sizeof(double), (void **)&gx);
+        Vmem_free(thee->vmem, i, sizeof(double), (void **)&gy);
+        Vmem_free(thee->vmem, i, sizeof(double), (void **)&gz);
+        Vmem_free(thee->vmem, i, sizeof(double), (void **)&val);
+        Vmem_free(thee->vmem, i, sizeof(double*), (void **)&dst);
+    }
+
+    uvalMin = VPMGSMALL;
+    uvalMax = -VPMGSMALL;
+    for (k=0; k<nzNEW; k++) {
+        for (j=0; j<nyNEW; j++) {
+            for (side=0; side<2; side++) {
+                uval = thee->gxcf[IJKx(j,k,side)];
+                if(uval < uvalMin) uvalMin = uval;
+                if(uval > uvalMax) uvalMax = uval;
+            }
+        }
+        for (i=0; i<nxNEW; i++) {
+            for (side=0; side<2; side++) {
+                uval = thee->gycf[IJKy(i,k,side)];
+                if(uval < uvalMin) uvalMin = uval;
+                if(uval > uvalMax) uvalMax = uval;
+            }
+        }
+    }
+    for (j=0; j<nyNEW; j++) {
+        for (i=0; i<nxNEW; i++) {
+            for (side=0; side<2; side++) {
+                uval = thee->gzcf[IJKz(i,j,side)];
+                if(uval < uvalMin) uvalMin = uval;
+                if(uval > uvalMax) uvalMax = uval;
+            }
+        }
+    }
+
+    VWARN_MSG0(
+        uvalMin >= SINH_MIN && uvalMax <= SINH_MAX,
+        "Unusually large potential values\n"
+        "    detected on the focusing boundary!\n"
+        "    Convergence not guaranteed for NPBE/NRPBE calculations!"
+        );
+}
+
+VPRIVATE void extEnergy(Vpmg *thee, Vpmg *pmgOLD, PBEparm_calcEnergy extFlag,
+                        double partMin[3], double partMax[3], int bflags[6]) {
+
+    Vatom *atom;
+    double hxNEW, hyNEW, hzNEW;
+    double lowerCorner[3], upperCorner[3];
+    int nxNEW, nyNEW, nzNEW;
+    int nxOLD, nyOLD, nzOLD;
+    int i,j,k;
     double xmin, xmax, ymin, ymax, zmin, zmax;
     double hxOLD, hyOLD, hzOLD;
     double xval, yval, zval;
@@ -3142,13 +3673,8 @@ VPRIVATE int gridPointIsValid(int i, int j, int k, int nx, int ny, int nz){
     return isValid;
 }
 
-/*
- Used by bcflnew
- */
-#ifdef DEBUG_MAC_OSX_OCL
-#include "mach_chud.h"
-VPRIVATE void packAtomsOpenCL(float *ax, float *ay, float *az,
-                        float *charge, float *size, Vpmg *thee){
+VPRIVATE void packAtoms(double *ax, double *ay, double *az,
+                        double *charge, double *size, Vpmg *thee){
 
     int i;
     int natoms;
@@ -3172,14 +3698,14 @@ VPRIVATE void packAtomsOpenCL(float *ax, float *ay, float *az,
 /*
  Used by bcflnew
  */
-VPRIVATE void packUnpackOpenCL(int nx, int ny, int nz, int ngrid,
-                         float *gx, float *gy, float *gz, float *value,
+VPRIVATE void packUnpack(int nx, int ny, int nz, int ngrid,
+                         double *gx, double *gy, double *gz, double *value,
                          Vpmg *thee, int pack){
 
     int i,j,k,igrid;
     int x0,x1,y0,y1,z0,z1;
 
-    float gpos[3];
+    double gpos[3];
     double *xf, *yf, *zf;
     double *gxcf, *gycf, *gzcf;
 
@@ -3241,243 +3767,114 @@ VPRIVATE void packUnpackOpenCL(int nx, int ny, int nz, int ngrid,
 
 }
 
-/*
- bcflnew is an optimized replacement for bcfl1. bcfl1 is still used when TINKER
- support is compiled in.
- bcflnew uses: packUnpack, packAtoms, gridPointIsValid
- */
-VPRIVATE void bcflnewOpenCL(Vpmg *thee){
-
-    int i,j,k, iatom, igrid;
-    int x0, x1, y0, y1, z0, z1;
-
-    int nx, ny, nz;
-    int natoms, ngrid, ngadj;
+VPRIVATE void mdhPoints(Vpmg *thee, int npts,
+                        double *gx, double *gy, double *gz, double *val){
 
-    float dist, pre1, eps_w, eps_p, T, xkappa;
+    int iatom, igrid;
+    int natoms;
+    int itile, ntile, ig0, ig1, ia0, ia1;
 
-    float *ax, *ay, *az;
-    float *charge, *size, *val;
+    double dist, pre1, eps_w, T, xkappa, kappa;
 
-    float *gx, *gy, *gz;
+    double *ax, *ay, *az;
+    double *charge, *size, *w;
 
     Vpbe *pbe = thee->pbe;
 
-    nx = thee->pmgp->nx;
-    ny = thee->pmgp->ny;
-    nz = thee->pmgp->nz;
-
     eps_w = Vpbe_getSolventDiel(pbe);           /* Dimensionless */
-    eps_p = Vpbe_getSoluteDiel(pbe);           /* Dimensionless */
     T = Vpbe_getTemperature(pbe);               /* K             */
     pre1 = ((Vunit_ec)/(4*VPI*Vunit_eps0*eps_w*Vunit_kb*T))*(1.0e10);
     xkappa = Vpbe_getXkappa(pbe);
 
     natoms = Valist_getNumberAtoms(thee->pbe->alist);
-    ngrid = 2*((nx*ny) + (ny*nz) + (nx*nz));
-    ngadj = ngrid + (512 - (ngrid & 511));
 
-    ax = (float*)malloc(natoms * sizeof(float));
-    ay = (float*)malloc(natoms * sizeof(float));
-    az = (float*)malloc(natoms * sizeof(float));
-
-    charge = (float*)malloc(natoms * sizeof(float));
-    size = (float*)malloc(natoms * sizeof(float));
-
-    gx = (float*)malloc(ngrid * sizeof(float));
-    gy = (float*)malloc(ngrid * sizeof(float));
-    gz = (float*)malloc(ngrid * sizeof(float));
+    ax = (double*)malloc(natoms * sizeof(double));
+    ay = (double*)malloc(natoms * sizeof(double));
+    az = (double*)malloc(natoms * sizeof(double));
 
-    val = (float*)malloc(ngrid * sizeof(float));
+    charge = (double*)malloc(natoms * sizeof(double));
+    size = (double*)malloc(natoms * sizeof(double));
+    w = (double*)malloc(natoms * sizeof(double));
 
-    packAtomsOpenCL(ax,ay,az,charge,size,thee);
-    packUnpackOpenCL(nx,ny,nz,ngrid,gx,gy,gz,val,thee,1);
+    packAtoms(ax,ay,az,charge,size,thee);
 
-    runMDHCL(ngrid,natoms,ngadj,ax,ay,az,gx,gy,gz,charge,size,xkappa,pre1,val);
+    /* The vector kernel sums w exp(-kappa r)/r, so the Debye-Hueckel factor
+     * exp(kappa a)/(1 + kappa a) of each atom goes into its weight */
+    kappa = (xkappa > VSMALL) ? xkappa : 0.0;
+    for(iatom=0; iatom<natoms; iatom++){
+        w[iatom] = pre1*charge[iatom];
+        if(kappa > 0.0){
+            w[iatom] *= VEXP(kappa*size[iatom])/(1+kappa*size[iatom]);
+        }
+    }
 
-    packUnpackOpenCL(nx,ny,nz,ngrid,gx,gy,gz,val,thee,0);
+    /* Tiles of points are swept over blocks of atoms, so a block is reused
+     * from cache by every point of the tile.  The scalar loop adds the
+     * atoms of each point in the original order. */
+    ntile = (npts + VPMGMDHTILE - 1)/VPMGMDHTILE;
+#pragma omp parallel for default(shared) schedule(dynamic) \
+        private(itile,ig0,ig1,ia0,ia1,igrid,iatom,dist)
+    for(itile=0; itile<ntile; itile++){
+        ig0 = itile*VPMGMDHTILE;
+        ig1 = VMIN2(npts, ig0 + VPMGMDHTILE);
+        if(Vmdh_simd(ig1-ig0, gx+ig0, gy+ig0, gz+ig0, natoms,
+                     ax, ay, az, w, kappa, val+ig0)) continue;
+        for(ia0=0; ia0<natoms; ia0+=VPMGMDHBLOCK){
+            ia1 = VMIN2(natoms, ia0 + VPMGMDHBLOCK);
+            for(igrid=ig0; igrid<ig1; igrid++){
+                for(iatom=ia0; iatom<ia1; iatom++){
+                    dist = VSQRT(VSQR(gx[igrid]-ax[iatom])
+                                 + VSQR(gy[igrid]-ay[iatom])
+                                 + VSQR(gz[igrid]-az[iatom]));
+                    if(kappa > 0.0){
+                        val[igrid] += pre1*(charge[iatom]/dist)
+                            *VEXP(-xkappa*(dist-size[iatom]))
+                            / (1+xkappa*size[iatom]);
+                    }else{
+                        val[igrid] += pre1*(charge[iatom]/dist);
+                    }
+                }
+            }
+        }
+    }
 
     free(ax);
     free(ay);
     free(az);
     free(charge);
     free(size);
-
-    free(gx);
-    free(gy);
-    free(gz);
-    free(val);
-}
-#endif
-
-VPRIVATE void packAtoms(double *ax, double *ay, double *az,
-                        double *charge, double *size, Vpmg *thee){
-
-    int i;
-    int natoms;
-
-    Vatom *atom = VNULL;
-    Valist *alist = VNULL;
-
-    alist = thee->pbe->alist;
-    natoms = Valist_getNumberAtoms(alist);
-
-    for(i=0;i<natoms;i++){
-        atom = &(alist->atoms[i]);
-        charge[i] = Vunit_ec*atom->charge;
-        ax[i] = atom->position[0];
-        ay[i] = atom->position[1];
-        az[i] = atom->position[2];
-        size[i] = atom->radius;
-    }
+    free(w);
 }
 
 /*
- Used by bcflnew
+ bcflnew is an optimized replacement for bcfl1. bcfl1 is still used when TINKER
+ support is compiled in.
+ bcflnew uses: packUnpack, mdhPoints, gridPointIsValid
  */
-VPRIVATE void packUnpack(int nx, int ny, int nz, int ngrid,
-                         double *gx, double *gy, double *gz, double *value,
-                         Vpmg *thee, int pack){
-
-    int i,j,k,igrid;
-    int x0,x1,y0,y1,z0,z1;
-
-    double gpos[3];
-    double *xf, *yf, *zf;
-    double *gxcf, *gycf, *gzcf;
-
-    xf = thee->xf;
-    yf = thee->yf;
-    zf = thee->zf;
-
-    gxcf = thee->gxcf;
-    gycf = thee->gycf;
-    gzcf = thee->gzcf;
-
-    igrid = 0;
-    for(k=0;k<nz;k++){
-        gpos[2] = zf[k];
-        for(j=0;j<ny;j++){
-            gpos[1] = yf[j];
-            for(i=0;i<nx;i++){
-                gpos[0] = xf[i];
-                if(gridPointIsValid(i, j, k, nx, ny, nz)){
-                    if(pack != 0){
-                        gx[igrid] = gpos[0];
-                        gy[igrid] = gpos[1];
-                        gz[igrid] = gpos[2];
-
-                        value[igrid] = 0.0;
-                    }else{
-                        x0 = IJKx(j,k,0);
-                        x1 = IJKx(j,k,1);
-                        y0 = IJKy(i,k,0);
-                        y1 = IJKy(i,k,1);
-                        z0 = IJKz(i,j,0);
-                        z1 = IJKz(i,j,1);
-
-                        if(i==0){
-                            gxcf[x0] += value[igrid];
-                        }
-                        if(i==nx-1){
-                            gxcf[x1] += value[igrid];
-                        }
-                        if(j==0){
-                            gycf[y0] += value[igrid];
-                        }
-                        if(j==ny-1){
-                            gycf[y1] += value[igrid];
-                        }
-                        if(k==0){
-                            gzcf[z0] += value[igrid];
-                        }
-                        if(k==nz-1){
-                            gzcf[z1] += value[igrid];
-                        }
-                    }
-
-                    igrid++;
-                } //end is valid point
-            } //end i
-        } //end j
-    } //end k
-
-}
-
 VPRIVATE void bcflnew(Vpmg *thee){
 
-    int i,j,k, iatom, igrid;
-    int x0, x1, y0, y1, z0, z1;
-
     int nx, ny, nz;
-    int natoms, ngrid;
-
-    double dist, pre1, eps_w, eps_p, T, xkappa;
-
-    double *ax, *ay, *az;
-    double *charge, *size, *val;
+    int ngrid;
 
+    double *val;
     double *gx, *gy, *gz;
 
-    Vpbe *pbe = thee->pbe;
-
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
     nz = thee->pmgp->nz;
 
-    eps_w = Vpbe_getSolventDiel(pbe);           /* Dimensionless */
-    eps_p = Vpbe_getSoluteDiel(pbe);           /* Dimensionless */
-    T = Vpbe_getTemperature(pbe);               /* K             */
-    pre1 = ((Vunit_ec)/(4*VPI*Vunit_eps0*eps_w*Vunit_kb*T))*(1.0e10);
-    xkappa = Vpbe_getXkappa(pbe);
-
-    natoms = Valist_getNumberAtoms(thee->pbe->alist);
     ngrid = 2*((nx*ny) + (ny*nz) + (nx*nz));
 
-    ax = (double*)malloc(natoms * sizeof(double));
-    ay = (double*)malloc(natoms * sizeof(double));
-    az = (double*)malloc(natoms * sizeof(double));
-
-    charge = (double*)malloc(natoms * sizeof(double));
-    size = (double*)malloc(natoms * sizeof(double));
-
     gx = (double*)malloc(ngrid * sizeof(double));
     gy = (double*)malloc(ngrid * sizeof(double));
     gz = (double*)malloc(ngrid * sizeof(double));
 
     val = (double*)malloc(ngrid * sizeof(double));
 
-    packAtoms(ax,ay,az,charge,size,thee);
     packUnpack(nx,ny,nz,ngrid,gx,gy,gz,val,thee,1);
-
-    if(xkappa > VSMALL){
-#pragma omp parallel for default(shared) private(igrid,iatom,dist)
-        for(igrid=0;igrid<ngrid;igrid++){
-            for(iatom=0; iatom<natoms; iatom++){
-                dist = VSQRT(VSQR(gx[igrid]-ax[iatom]) + VSQR(gy[igrid]-ay[iatom])
-                             + VSQR(gz[igrid]-az[iatom]));
-                val[igrid] += pre1*(charge[iatom]/dist)*VEXP(-xkappa*(dist-size[iatom]))
-                / (1+xkappa*size[iatom]);
-            }
-        }
-    }else{
-#pragma omp parallel for default(shared) private(igrid,iatom,dist)
-        for(igrid=0;igrid<ngrid;igrid++){
-            for(iatom=0; iatom<natoms; iatom++){
-                dist = VSQRT(VSQR(gx[igrid]-ax[iatom]) + VSQR(gy[igrid]-ay[iatom])
-                             + VSQR(gz[igrid]-az[iatom]));
-                val[igrid] += pre1*(charge[iatom]/dist);
-            }
-        }
-    }
+    mdhPoints(thee,ngrid,gx,gy,gz,val);
     packUnpack(nx,ny,nz,ngrid,gx,gy,gz,val,thee,0);
 
-    free(ax);
-    free(ay);
-    free(az);
-    free(charge);
-    free(size);
-
     free(gx);
     free(gy);
     free(gz);
@@ -4379,32 +4776,186 @@ VPRIVATE void bcfl_mdh_tinker(Vpmg *thee){
 }
 #endif
 
-VPRIVATE void bcCalc(Vpmg *thee){
-
-    int i, j, k;
-    int nx, ny, nz;
+VPRIVATE void bcflTree(Vpmg *thee){
 
-    double zmem, eps_m, Lmem, memv, eps_w, xkappa;
+    int i, j, iatom, natoms, nx, ny, nz, nu, nv, face, axis, side;
+    int itile, ntile, tile0[7], tu, tv, u, v, m, idx[VPMGBCTILE*VPMGBCTILE];
+    double eps_w, T, pre1, xkappa, ka, eka, c0;
+    double *pos, *charge, *dipole, *quad, *apos;
+    double pts[3*VPMGBCTILE*VPMGBCTILE], val[VPMGBCTILE*VPMGBCTILE];
+    double *xf, *yf, *zf, *gxcf, *gycf, *gzcf;
+#if defined(WITH_TINKER)
+    double eps_p, eps_r, c1, c2, *mu, *qpole;
+#endif
+    Vpbe *pbe;
+    Valist *alist;
+    Vatom *atom;
+    Vdhtree *tree;
 
+    pbe = thee->pbe;
+    alist = pbe->alist;
+    natoms = Valist_getNumberAtoms(alist);
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
     nz = thee->pmgp->nz;
+    xf = thee->xf;
+    yf = thee->yf;
+    zf = thee->zf;
+    gxcf = thee->gxcf;
+    gycf = thee->gycf;
+    gzcf = thee->gzcf;
 
-    /* Zero out the boundaries */
-    /* the "i" boundaries (dirichlet) */
-    for (k=0; k<nz; k++) {
-        for (j=0; j<ny; j++) {
-            thee->gxcf[IJKx(j,k,0)] = 0.0;
-            thee->gxcf[IJKx(j,k,1)] = 0.0;
-            thee->gxcf[IJKx(j,k,2)] = 0.0;
-            thee->gxcf[IJKx(j,k,3)] = 0.0;
-        }
-    }
-
-    /* the "j" boundaries (dirichlet) */
-    for (k=0; k<nz; k++) {
-        for (i=0; i<nx; i++) {
-            thee->gycf[IJKy(i,k,0)] = 0.0;
+    eps_w = Vpbe_getSolventDiel(pbe);           /* Dimensionless */
+    T = Vpbe_getTemperature(pbe);               /* K             */
+    pre1 = (Vunit_ec*Vunit_ec)/(4*VPI*Vunit_eps0*Vunit_kb*T)*(1.0e10);
+    xkappa = Vpbe_getXkappa(pbe);              /* A^{-1}        */
+    if (xkappa < VSMALL) xkappa = 0.0;
+
+    /* Fold the radius dependence of multipolebc into the weights, which
+     * leaves exp(-xkappa*r)/r and its derivatives as the kernel */
+    pos = (double *)Vmem_malloc(thee->vmem, 3*natoms, sizeof(double));
+    charge = (double *)Vmem_malloc(thee->vmem, natoms, sizeof(double));
+    dipole = VNULL;
+    quad = VNULL;
+#if defined(WITH_TINKER)
+    eps_p = Vpbe_getSoluteDiel(pbe);           /* Dimensionless */
+    eps_r = eps_w/eps_p;
+    dipole = (double *)Vmem_malloc(thee->vmem, 3*natoms, sizeof(double));
+    quad = (double *)Vmem_malloc(thee->vmem, 9*natoms, sizeof(double));
+#endif
+    for (iatom=0; iatom<natoms; iatom++) {
+        atom = Valist_getAtom(alist, iatom);
+        apos = Vatom_getPosition(atom);
+        for (i=0; i<3; i++) pos[3*iatom+i] = apos[i];
+        ka = xkappa*Vatom_getRadius(atom);
+        eka = VEXP(ka);
+        c0 = eka/(1.0 + ka)/eps_w;
+        charge[iatom] = c0*Vatom_getCharge(atom);
+#if defined(WITH_TINKER)
+        c1 = 3.0*eps_r*eka/(1.0 + ka + eps_r*(2.0 + 2.0*ka + ka*ka))/eps_w;
+        c2 = 15.0*eps_r*eka/(6.0 + 6.0*ka + 2.0*ka*ka
+             + eps_r*(9.0 + 9.0*ka + 4.0*ka*ka + ka*ka*ka))/eps_w;
+        qpole = VNULL;
+        if (thee->chargeSrc == VCM_PERMANENT) {
+            mu = Vatom_getDipole(atom);
+            qpole = Vatom_getQuadrupole(atom);
+        } else if (thee->chargeSrc == VCM_INDUCED) {
+            charge[iatom] = 0.0;
+            mu = Vatom_getInducedDipole(atom);
+        } else {
+            charge[iatom] = 0.0;
+            mu = Vatom_getNLInducedDipole(atom);
+        }
+        for (i=0; i<3; i++) dipole[3*iatom+i] = c1*mu[i];
+        /* The factor of 1/3 is that of the traceless quadrupole definition
+         * in bcfl_mdh_tinker */
+        for (i=0; i<9; i++) {
+            quad[9*iatom+i] = (qpole != VNULL) ? c2*qpole[i]/3.0 : 0.0;
+        }
+#endif
+    }
+
+    tree = Vdhtree_ctor(natoms, pos, charge, dipole, quad, xkappa,
+                        thee->pmgp->bctol);
+    Vnm_print(0, "bcflTree:  %d atoms in %d boxes, interpolation degree \
+%d\n", natoms, tree->nnode, tree->order);
+
+    /* Number the tiles of the six faces; face 2*axis+side is the face at
+     * the low (side 0) or high (side 1) end of axis */
+    tile0[0] = 0;
+    for (face=0; face<6; face++) {
+        axis = face/2;
+        nu = (axis == 0) ? ny : nx;
+        nv = (axis == 2) ? ny : nz;
+        tile0[face+1] = tile0[face] + ((nu + VPMGBCTILE - 1)/VPMGBCTILE)
+                        *((nv + VPMGBCTILE - 1)/VPMGBCTILE);
+    }
+    ntile = tile0[6];
+
+    #pragma omp parallel for default(shared) schedule(dynamic) \
+        private(itile, face, axis, side, nu, nv, tu, tv, u, v, m, i, idx, \
+                pts, val)
+    for (itile=0; itile<ntile; itile++) {
+        for (face=0; itile>=tile0[face+1]; face++);
+        axis = face/2;
+        side = face%2;
+        nu = (axis == 0) ? ny : nx;
+        nv = (axis == 2) ? ny : nz;
+        tu = (itile - tile0[face])%((nu + VPMGBCTILE - 1)/VPMGBCTILE);
+        tv = (itile - tile0[face])/((nu + VPMGBCTILE - 1)/VPMGBCTILE);
+
+        m = 0;
+        for (v=tv*VPMGBCTILE; v<VMIN2(nv, (tv+1)*VPMGBCTILE); v++) {
+            for (u=tu*VPMGBCTILE; u<VMIN2(nu, (tu+1)*VPMGBCTILE); u++) {
+                switch (axis) {
+                    case 0:
+                        pts[3*m] = side ? xf[nx-1] : xf[0];
+                        pts[3*m+1] = yf[u];
+                        pts[3*m+2] = zf[v];
+                        idx[m] = IJKx(u,v,side);
+                        break;
+                    case 1:
+                        pts[3*m] = xf[u];
+                        pts[3*m+1] = side ? yf[ny-1] : yf[0];
+                        pts[3*m+2] = zf[v];
+                        idx[m] = IJKy(u,v,side);
+                        break;
+                    default:
+                        pts[3*m] = xf[u];
+                        pts[3*m+1] = yf[v];
+                        pts[3*m+2] = side ? zf[nz-1] : zf[0];
+                        idx[m] = IJKz(u,v,side);
+                        break;
+                }
+                m++;
+            }
+        }
+
+        Vdhtree_eval(tree, m, pts, val);
+        for (i=0; i<m; i++) {
+            if (axis == 0) gxcf[idx[i]] = pre1*val[i];
+            else if (axis == 1) gycf[idx[i]] = pre1*val[i];
+            else gzcf[idx[i]] = pre1*val[i];
+        }
+    }
+
+    Vdhtree_dtor(&tree);
+    Vmem_free(thee->vmem, 3*natoms, sizeof(double), (void **)&pos);
+    Vmem_free(thee->vmem, natoms, sizeof(double), (void **)&charge);
+    if (dipole != VNULL) {
+        Vmem_free(thee->vmem, 3*natoms, sizeof(double), (void **)&dipole);
+    }
+    if (quad != VNULL) {
+        Vmem_free(thee->vmem, 9*natoms, sizeof(double), (void **)&quad);
+    }
+}
+
+VPRIVATE void bcCalc(Vpmg *thee){
+
+    int i, j, k;
+    int nx, ny, nz;
+
+    double zmem, eps_m, Lmem, memv, eps_w, xkappa;
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+
+    /* Zero out the boundaries */
+    /* the "i" boundaries (dirichlet) */
+    for (k=0; k<nz; k++) {
+        for (j=0; j<ny; j++) {
+            thee->gxcf[IJKx(j,k,0)] = 0.0;
+            thee->gxcf[IJKx(j,k,1)] = 0.0;
+            thee->gxcf[IJKx(j,k,2)] = 0.0;
+            thee->gxcf[IJKx(j,k,3)] = 0.0;
+        }
+    }
+
+    /* the "j" boundaries (dirichlet) */
+    for (k=0; k<nz; k++) {
+        for (i=0; i<nx; i++) {
+            thee->gycf[IJKy(i,k,0)] = 0.0;
             thee->gycf[IJKy(i,k,1)] = 0.0;
             thee->gycf[IJKy(i,k,2)] = 0.0;
             thee->gycf[IJKy(i,k,3)] = 0.0;
@@ -4429,26 +4980,16 @@ VPRIVATE void bcCalc(Vpmg *thee){
             bcfl_sdh(thee);
             break;
         case BCFL_MDH:
+            if (thee->pmgp->bctol > 0.0) {
+                bcflTree(thee);
+                break;
+            }
 #if defined(WITH_TINKER)
             bcfl_mdh_tinker(thee);
 #else
 
-#ifdef DEBUG_MAC_OSX_OCL
-#include "mach_chud.h"
-            uint64_t mbeg = mach_absolute_time();
-
-            /*
-             * If OpenCL is available we use it, otherwise fall back to
-             * normal route (CPU multithreaded w/ OpenMP)
-             */
-            if (kOpenCLAvailable == 1) bcflnewOpenCL(thee);
-            else bcflnew(thee);
-
-            mets_(&mbeg, "MDH");
-#else
             /* bcfl_mdh(thee); */
             bcflnew(thee);
-#endif	/* DEBUG_MAC_OSX_OCL */
 
 #endif	/* WITH_TINKER */
             break;
@@ -4729,23 +5270,55 @@ VPRIVATE void fillcoCoefMolDiel(Vpmg *thee) {
     fillcoCoefMolDielNoSmooth(thee);
 
     /* Call the smoothing algorithm as needed */
-    if (thee->surfMeth == VSM_MOLSMOOTH) {
+    if ((thee->surfMeth == VSM_MOLSMOOTH) ||
+        (thee->surfMeth == VSM_MOLSMOOTHEDT)) {
         fillcoCoefMolDielSmooth(thee);
     }
 }
 
+/* Sort objects into the z-slabs they reach, keeping them in index order
+ * within a slab so that marking a slab repeats the serial order */
+VPRIVATE int* binSlabs(Vmem *vmem, int nobj, int *klo, int *khi, int nslab,
+                       int *start) {
+
+    int i, s, *list;
+
+    for (s=0; s<=nslab; s++) start[s] = 0;
+    for (i=0; i<nobj; i++) {
+        if (khi[i] < klo[i]) continue;
+        for (s=klo[i]/VPMGMARKSLAB; s<=khi[i]/VPMGMARKSLAB; s++) {
+            start[s+1]++;
+        }
+    }
+    for (s=0; s<nslab; s++) start[s+1] += start[s];
+
+    list = (int *)Vmem_malloc(vmem, VMAX2(1, start[nslab]), sizeof(int));
+    for (i=0; i<nobj; i++) {
+        if (khi[i] < klo[i]) continue;
+        for (s=klo[i]/VPMGMARKSLAB; s<=khi[i]/VPMGMARKSLAB; s++) {
+            list[start[s]++] = i;
+        }
+    }
+    for (s=nslab; s>0; s--) start[s] = start[s-1];
+    start[0] = 0;
+
+    return list;
+}
+
 VPRIVATE void fillcoCoefMolDielNoSmooth(Vpmg *thee) {
 
     Vacc *acc;
-    VaccSurf *asurf;
+    VaccSurf *asurf, **surf;
     Valist *alist;
     Vpbe *pbe;
     Vatom *atom;
     double xmin, xmax, ymin, ymax, zmin, zmax;
     double xlen, ylen, zlen, position[3];
     double srad, epsw, epsp, deps, area;
-    double hx, hy, hzed, *apos, arad;
-    int i, nx, ny, nz, ntot, iatom, ipt;
+    double hx, hy, hzed, *apos, arad, zpos;
+    int i, nx, ny, nz, iatom, ipt, natoms;
+    int s, n, k, k0, k1, nslab, *klo, *khi, *start, *list;
+    size_t j, nxy;
 
     /* Get PBE info */
     pbe = thee->pbe;
@@ -4777,21 +5350,35 @@ VPRIVATE void fillcoCoefMolDielNoSmooth(Vpmg *thee) {
     zmax = thee->pmgp->zcent + (zlen/2.0);
 
     /* Reset the arrays */
-    ntot = nx*ny*nz;
-    for (i=0; i<ntot; i++) {
-        thee->epsx[i] = epsw;
-        thee->epsy[i] = epsw;
-        thee->epsz[i] = epsw;
+    nxy = (size_t)nx*ny;
+    #pragma omp parallel for private(k, j)
+    for (k=1; k<nz-1; k++) {
+        for (j=PLANE0(k); j<PLANE1(k); j++) {
+            thee->epsx[j] = epsw;
+            thee->epsy[j] = epsw;
+            thee->epsz[j] = epsw;
+        }
     }
 
+    /* The marking is split into slabs of z-planes.  Every sphere is binned
+     * into the slabs it reaches and each slab is marked by one thread, in
+     * atom order and only within its own planes, so no two threads write
+     * the same point and the result does not depend on the thread count */
+    natoms = Valist_getNumberAtoms(alist);
+    nslab = (nz + VPMGMARKSLAB - 1)/VPMGMARKSLAB;
+    klo = (int *)Vmem_malloc(thee->vmem, VMAX2(1, natoms), sizeof(int));
+    khi = (int *)Vmem_malloc(thee->vmem, VMAX2(1, natoms), sizeof(int));
+    start = (int *)Vmem_malloc(thee->vmem, nslab+1, sizeof(int));
+
     /* Loop through the atoms and set a{123}cf = 0.0 (inaccessible)
      * if a point is inside the solvent-inflated van der Waals radii */
-#pragma omp parallel for default(shared) private(iatom,atom,apos,arad)
-    for (iatom=0; iatom<Valist_getNumberAtoms(alist); iatom++) {
+    for (iatom=0; iatom<natoms; iatom++) {
 
         atom = Valist_getAtom(alist, iatom);
         apos = Vatom_getPosition(atom);
         arad = Vatom_getRadius(atom);
+        klo[iatom] = 0;
+        khi[iatom] = -1;
 
         /* Make sure we're on the grid */
         if ((apos[0]<=xmin) || (apos[0]>=xmax)  || \
@@ -4811,47 +5398,102 @@ VPRIVATE void fillcoCoefMolDielNoSmooth(Vpmg *thee) {
             }
             fflush(stderr);
 
-        } else { /* if we're on the mesh */
-
-            if (arad > VSMALL) {
-                /* Mark x-shifted dielectric */
-                markSphere((arad+srad), apos,
-                        nx, ny, nz,
-                        hx, hy, hzed,
-                        (xmin+0.5*hx), ymin, zmin,
-                        thee->epsx, epsp);
-
-                /* Mark y-shifted dielectric */
-                markSphere((arad+srad), apos,
-                        nx, ny, nz,
-                        hx, hy, hzed,
-                        xmin, (ymin+0.5*hy), zmin,
-                        thee->epsy, epsp);
+        } else if (arad > VSMALL) { /* if we're on the mesh */
 
-                /* Mark z-shifted dielectric */
-                markSphere((arad+srad), apos,
-                        nx, ny, nz,
-                        hx, hy, hzed,
-                        xmin, ymin, (zmin+0.5*hzed),
-                        thee->epsz, epsp);
-            }
+            /* Planes reached by any of the three shifted grids */
+            zpos = apos[2] - zmin;
+            klo[iatom] = VMAX2(0,
+                    (int)floor((zpos - (arad+srad) - hzed)/hzed));
+            khi[iatom] = VMIN2(nz-1,
+                    (int)ceil((zpos + (arad+srad) + hzed)/hzed));
 
         } /* endif (on the mesh) */
     } /* endfor (over all atoms) */
+    list = binSlabs(thee->vmem, natoms, klo, khi, nslab, start);
+
+#pragma omp parallel for schedule(dynamic, 1) default(shared) private(s,n,k0,k1,iatom,atom,apos,arad)
+    for (s=0; s<nslab; s++) {
+        k0 = s*VPMGMARKSLAB;
+        k1 = VMIN2(nz-1, k0+VPMGMARKSLAB-1);
+        for (n=start[s]; n<start[s+1]; n++) {
+
+            iatom = list[n];
+            atom = Valist_getAtom(alist, iatom);
+            apos = Vatom_getPosition(atom);
+            arad = Vatom_getRadius(atom);
+
+            /* Mark x-shifted dielectric */
+            markSphereSlab((arad+srad), apos,
+                    nx, ny, nz,
+                    hx, hy, hzed,
+                    (xmin+0.5*hx), ymin, zmin,
+                    k0, k1, thee->epsx, epsp);
+
+            /* Mark y-shifted dielectric */
+            markSphereSlab((arad+srad), apos,
+                    nx, ny, nz,
+                    hx, hy, hzed,
+                    xmin, (ymin+0.5*hy), zmin,
+                    k0, k1, thee->epsy, epsp);
+
+            /* Mark z-shifted dielectric */
+            markSphereSlab((arad+srad), apos,
+                    nx, ny, nz,
+                    hx, hy, hzed,
+                    xmin, ymin, (zmin+0.5*hzed),
+                    k0, k1, thee->epsz, epsp);
+        }
+    }
+    Vmem_free(thee->vmem, VMAX2(1, start[nslab]), sizeof(int), (void **)&list);
+
+    /* The distance transform finds the probe-accessible points from the
+     * grid alone and does not need the SAS points */
+    if ((thee->surfMeth == VSM_MOLEDT) ||
+        (thee->surfMeth == VSM_MOLSMOOTHEDT)) {
+        if (srad > VSMALL) fillcoCoefMolDielEDT(thee);
+        Vmem_free(thee->vmem, nslab+1, sizeof(int), (void **)&start);
+        Vmem_free(thee->vmem, VMAX2(1, natoms), sizeof(int), (void **)&khi);
+        Vmem_free(thee->vmem, VMAX2(1, natoms), sizeof(int), (void **)&klo);
+        return;
+    }
 
     area = Vacc_SASA(acc, srad);
 
     /* We only need to do the next step for non-zero solvent radii */
     if (srad > VSMALL) {
 
-        /* Now loop over the solvent accessible surface points */
-
-#pragma omp parallel for default(shared) private(iatom,atom,area,asurf,ipt,position)
-        for (iatom=0; iatom<Valist_getNumberAtoms(alist); iatom++) {
+        /* Now loop over the solvent accessible surface points, binned the
+         * same way: the SAS points of an atom lie arad+srad from its
+         * center and each resets a sphere of radius srad */
+        surf = (VaccSurf **)Vmem_malloc(thee->vmem, VMAX2(1, natoms),
+                                        sizeof(VaccSurf *));
+        for (iatom=0; iatom<natoms; iatom++) {
             atom = Valist_getAtom(alist, iatom);
+            apos = Vatom_getPosition(atom);
+            arad = Vatom_getRadius(atom);
             area = Vacc_atomSASA(acc, srad, atom);
+            surf[iatom] = VNULL;
+            klo[iatom] = 0;
+            khi[iatom] = -1;
             if (area > 0.0 ) {
-                asurf = Vacc_atomSASPoints(acc, srad, atom);
+                surf[iatom] = Vacc_atomSASPoints(acc, srad, atom);
+                zpos = apos[2] - zmin;
+                klo[iatom] = VMAX2(0,
+                        (int)floor((zpos - (arad+2*srad) - hzed)/hzed));
+                khi[iatom] = VMIN2(nz-1,
+                        (int)ceil((zpos + (arad+2*srad) + hzed)/hzed));
+            }
+        }
+        list = binSlabs(thee->vmem, natoms, klo, khi, nslab, start);
+
+#pragma omp parallel for schedule(dynamic, 1) default(shared) private(s,n,k0,k1,iatom,asurf,ipt,position)
+        for (s=0; s<nslab; s++) {
+            k0 = s*VPMGMARKSLAB;
+            k1 = VMIN2(nz-1, k0+VPMGMARKSLAB-1);
+            for (n=start[s]; n<start[s+1]; n++) {
+
+                iatom = list[n];
+                asurf = surf[iatom];
 
                 /* Use each point on the SAS to reset the solvent accessibility */
                 /* TODO:  Make sure we're not still wasting time here. */
@@ -4862,32 +5504,411 @@ VPRIVATE void fillcoCoefMolDielNoSmooth(Vpmg *thee) {
                     position[2] = asurf->zpts[ipt];
 
                     /* Mark x-shifted dielectric */
-                    markSphere(srad, position,
+                    markSphereSlab(srad, position,
                                nx, ny, nz,
                                hx, hy, hzed,
                                (xmin+0.5*hx), ymin, zmin,
-                               thee->epsx, epsw);
+                               k0, k1, thee->epsx, epsw);
 
                     /* Mark y-shifted dielectric */
-                    markSphere(srad, position,
+                    markSphereSlab(srad, position,
                                nx, ny, nz,
                                hx, hy, hzed,
                                xmin, (ymin+0.5*hy), zmin,
-                               thee->epsy, epsw);
+                               k0, k1, thee->epsy, epsw);
 
                     /* Mark z-shifted dielectric */
-                    markSphere(srad, position,
+                    markSphereSlab(srad, position,
                                nx, ny, nz,
                                hx, hy, hzed,
                                xmin, ymin, (zmin+0.5*hzed),
-                               thee->epsz, epsw);
+                               k0, k1, thee->epsz, epsw);
 
                 }
             }
         }
+        Vmem_free(thee->vmem, VMAX2(1, start[nslab]), sizeof(int),
+                  (void **)&list);
+        Vmem_free(thee->vmem, VMAX2(1, natoms), sizeof(VaccSurf *),
+                  (void **)&surf);
+    }
+
+    Vmem_free(thee->vmem, nslab+1, sizeof(int), (void **)&start);
+    Vmem_free(thee->vmem, VMAX2(1, natoms), sizeof(int), (void **)&khi);
+    Vmem_free(thee->vmem, VMAX2(1, natoms), sizeof(int), (void **)&klo);
+}
+
+VPRIVATE void edtLine(double *f, size_t *feat, size_t stride, int n,
+                      double h, double *g, size_t *gf, int *v, double *z) {
+
+    int q, k, j;
+    double hh, s;
+
+    hh = h*h;
+    for (q=0; q<n; q++) {
+        g[q] = f[q*stride];
+        gf[q] = feat[q*stride];
+    }
+
+    /* Lower envelope of the parabolas hh*(x - q)^2 + g[q]; v holds their
+     * vertices and z[k] the point where parabola k takes over, both in
+     * grid units */
+    k = -1;
+    s = 0.0;
+    for (q=0; q<n; q++) {
+        if (g[q] == HUGE_VAL) continue;
+        while (k >= 0) {
+            s = ((g[q]/hh + (double)q*q) - (g[v[k]]/hh + (double)v[k]*v[k]))
+                / (2.0*(q - v[k]));
+            if (s > z[k]) break;
+            k--;
+        }
+        k++;
+        v[k] = q;
+        z[k] = (k == 0) ? -HUGE_VAL : s;
+    }
+
+    /* No sources on this line */
+    if (k < 0) return;
+
+    j = 0;
+    for (q=0; q<n; q++) {
+        while ((j < k) && (z[j+1] < (double)q)) j++;
+        f[q*stride] = hh*(double)(q - v[j])*(q - v[j]) + g[v[j]];
+        feat[q*stride] = gf[v[j]];
+    }
+}
+
+VPRIVATE void edtGrid(double *f, size_t *feat, int nx, int ny, int nz,
+                      double hx, double hy, double hzed) {
+
+    int i, j, k, nmax, *v;
+    size_t nxy, *gf;
+    double *g, *z;
+
+    nxy = (size_t)nx*ny;
+    nmax = VMAX2(nx, VMAX2(ny, nz));
+
+    /* Each thread gets its own line work space.  The x and y passes run
+     * over z-planes, the z pass over y-rows; every line is independent */
+    #pragma omp parallel default(shared) private(i, j, k, v, g, gf, z)
+    {
+        g = (double *)malloc(nmax*sizeof(double));
+        z = (double *)malloc(nmax*sizeof(double));
+        gf = (size_t *)malloc(nmax*sizeof(size_t));
+        v = (int *)malloc(nmax*sizeof(int));
+        VASSERT((g != VNULL) && (z != VNULL) && (gf != VNULL) && (v != VNULL));
+
+        #pragma omp for
+        for (k=0; k<nz; k++) {
+            for (j=0; j<ny; j++) {
+                edtLine(f + k*nxy + (size_t)j*nx, feat + k*nxy + (size_t)j*nx,
+                        1, nx, hx, g, gf, v, z);
+            }
+            for (i=0; i<nx; i++) {
+                edtLine(f + k*nxy + i, feat + k*nxy + i, (size_t)nx, ny, hy,
+                        g, gf, v, z);
+            }
+        }
+
+        #pragma omp for
+        for (j=0; j<ny; j++) {
+            for (i=0; i<nx; i++) {
+                edtLine(f + (size_t)j*nx + i, feat + (size_t)j*nx + i, nxy, nz,
+                        hzed, g, gf, v, z);
+            }
+        }
+
+        free(v);
+        free(gf);
+        free(z);
+        free(g);
     }
 }
 
+/* Lower bound on how far pos is from every inflated sphere, at most cap.
+ * The cell of pos lists every atom whose inflated sphere comes within the
+ * clist reach of it, so cap must not exceed that reach */
+VPRIVATE double edtGap(Vacc *acc, double *pos, double srad, double cap) {
+
+    int iatom;
+    double gap, d, arad, *apos;
+    VclistCell *cell;
+    Vatom *atom;
+
+    gap = cap;
+    cell = Vclist_getCell(acc->clist, pos);
+    if (cell == VNULL) return gap;
+
+    for (iatom=0; iatom<cell->natoms; iatom++) {
+        atom = cell->atoms[iatom];
+        arad = Vatom_getRadius(atom);
+        if (arad <= VSMALL) continue;
+        apos = Vatom_getPosition(atom);
+        d = VSQRT(VSQR(pos[0]-apos[0]) + VSQR(pos[1]-apos[1])
+                  + VSQR(pos[2]-apos[2])) - (arad + srad);
+        if (d < gap) gap = d;
+    }
+
+    return VMAX2(gap, 0.0);
+}
+
+/* Whether a probe centered at c overlaps no atom other than the skipped ones;
+ * atoms missing from the clist cell of c cannot reach it */
+VPRIVATE int edtFits(Vacc *acc, double *c, double srad,
+                     Vatom *skip1, Vatom *skip2, Vatom *skip3) {
+
+    int iatom;
+    double *apos;
+    VclistCell *cell;
+    Vatom *atom;
+
+    cell = Vclist_getCell(acc->clist, c);
+    if (cell == VNULL) return 1;
+    for (iatom=0; iatom<cell->natoms; iatom++) {
+        atom = cell->atoms[iatom];
+        if ((atom == skip1) || (atom == skip2) || (atom == skip3)) continue;
+        if (Vatom_getRadius(atom) <= VSMALL) continue;
+        apos = Vatom_getPosition(atom);
+        if ((VSQR(c[0]-apos[0]) + VSQR(c[1]-apos[1]) + VSQR(c[2]-apos[2]))
+            < VSQR(Vatom_getRadius(atom) + srad)) return 0;
+    }
+
+    return 1;
+}
+
+/* Whether a probe touching one, two or three atoms reaches pos.  The
+ * closest allowed probe center is on the SAS: the projection of pos onto one
+ * inflated sphere, the projection onto the circle where two of them meet,
+ * or a point where three of them meet, and it counts only if no other atom
+ * is in the way.  Checking all three gives the excluded surface exactly,
+ * where the nearest probe center usually lies between grid points */
+VPRIVATE int edtContact(Vacc *acc, double *pos, double srad) {
+
+    int iatom, ia, ib, ic, side, nnear, i, lo[3], hi[3], ijk[3];
+    double d, t, h, x, y, dd, rho2, r2, len, ext, rin[VPMGEDTNEAR];
+    double c[3], n[3], m[3], u[3], e[3];
+    double *apos, *bpos, *cpos;
+    Vclist *clist;
+    VclistCell *cell;
+    Vatom *atom, *near[VPMGEDTNEAR];
+
+    /* A cell lists the atoms within max_radius of their radius, but the
+     * probe centers in question reach atoms 2 srad away: take every cell
+     * within the difference of pos */
+    clist = acc->clist;
+    ext = VMAX2(2.0*srad - Vclist_maxRadius(clist), 0.0);
+    for (i=0; i<3; i++) {
+        lo[i] = (int)((pos[i] - ext - clist->lower_corner[i])/clist->spacs[i]);
+        hi[i] = (int)((pos[i] + ext - clist->lower_corner[i])/clist->spacs[i]);
+        if ((hi[i] < 0) || (lo[i] >= clist->npts[i])) return 0;
+        lo[i] = VMAX2(lo[i], 0);
+        hi[i] = VMIN2(hi[i], clist->npts[i] - 1);
+    }
+
+    /* Inflated spheres whose surface is within srad of pos */
+    nnear = 0;
+    for (ijk[0]=lo[0]; ijk[0]<=hi[0]; ijk[0]++)
+    for (ijk[1]=lo[1]; ijk[1]<=hi[1]; ijk[1]++)
+    for (ijk[2]=lo[2]; ijk[2]<=hi[2]; ijk[2]++) {
+        cell = &(clist->cells[(clist->npts[2])*(clist->npts[1])*ijk[0]
+                              + (clist->npts[2])*ijk[1] + ijk[2]]);
+        for (iatom=0; iatom<cell->natoms; iatom++) {
+            atom = cell->atoms[iatom];
+            if (Vatom_getRadius(atom) <= VSMALL) continue;
+            apos = Vatom_getPosition(atom);
+            d = VSQRT(VSQR(pos[0]-apos[0]) + VSQR(pos[1]-apos[1])
+                      + VSQR(pos[2]-apos[2]));
+            if (VABS(d - (Vatom_getRadius(atom) + srad)) > srad) continue;
+            for (ia=0; ia<nnear; ia++)
+                if (near[ia] == atom) break;
+            if ((ia < nnear) || (nnear == VPMGEDTNEAR)) continue;
+            near[nnear] = atom;
+            rin[nnear] = Vatom_getRadius(atom) + srad;
+            nnear++;
+
+            if (d < VSMALL) continue;
+            c[0] = apos[0] + (pos[0]-apos[0])*rin[nnear-1]/d;
+            c[1] = apos[1] + (pos[1]-apos[1])*rin[nnear-1]/d;
+            c[2] = apos[2] + (pos[2]-apos[2])*rin[nnear-1]/d;
+            if (edtFits(acc, c, srad, atom, VNULL, VNULL)) return 1;
+        }
+    }
+
+    for (ia=0; ia<nnear; ia++) {
+        apos = Vatom_getPosition(near[ia]);
+        for (ib=ia+1; ib<nnear; ib++) {
+            bpos = Vatom_getPosition(near[ib]);
+            n[0] = bpos[0] - apos[0];
+            n[1] = bpos[1] - apos[1];
+            n[2] = bpos[2] - apos[2];
+            d = VSQRT(VSQR(n[0]) + VSQR(n[1]) + VSQR(n[2]));
+            if ((d < VSMALL) || (d >= rin[ia] + rin[ib]) ||
+                (d <= VABS(rin[ia] - rin[ib]))) continue;
+            n[0] /= d;
+            n[1] /= d;
+            n[2] /= d;
+
+            /* Circle of radius sqrt(rho2) around m in the plane normal to n */
+            t = (VSQR(d) + VSQR(rin[ia]) - VSQR(rin[ib]))/(2.0*d);
+            rho2 = VSQR(rin[ia]) - VSQR(t);
+            m[0] = apos[0] + t*n[0];
+            m[1] = apos[1] + t*n[1];
+            m[2] = apos[2] + t*n[2];
+            t = (pos[0]-m[0])*n[0] + (pos[1]-m[1])*n[1] + (pos[2]-m[2])*n[2];
+            u[0] = pos[0] - m[0] - t*n[0];
+            u[1] = pos[1] - m[1] - t*n[1];
+            u[2] = pos[2] - m[2] - t*n[2];
+            len = VSQRT(VSQR(u[0]) + VSQR(u[1]) + VSQR(u[2]));
+            if (len >= VSMALL) {
+                c[0] = m[0] + u[0]*VSQRT(rho2)/len;
+                c[1] = m[1] + u[1]*VSQRT(rho2)/len;
+                c[2] = m[2] + u[2]*VSQRT(rho2)/len;
+                if (((VSQR(c[0]-pos[0]) + VSQR(c[1]-pos[1])
+                      + VSQR(c[2]-pos[2])) <= VSQR(srad)) &&
+                    edtFits(acc, c, srad, near[ia], near[ib], VNULL))
+                    return 1;
+            }
+
+            /* Where a third inflated sphere cuts the circle */
+            for (ic=ib+1; ic<nnear; ic++) {
+                cpos = Vatom_getPosition(near[ic]);
+                h = (cpos[0]-m[0])*n[0] + (cpos[1]-m[1])*n[1]
+                    + (cpos[2]-m[2])*n[2];
+                r2 = VSQR(rin[ic]) - VSQR(h);
+                if (r2 <= 0.0) continue;
+                e[0] = cpos[0] - h*n[0] - m[0];
+                e[1] = cpos[1] - h*n[1] - m[1];
+                e[2] = cpos[2] - h*n[2] - m[2];
+                dd = VSQRT(VSQR(e[0]) + VSQR(e[1]) + VSQR(e[2]));
+                if ((dd < VSMALL) || (dd >= VSQRT(rho2) + VSQRT(r2)) ||
+                    (dd <= VABS(VSQRT(rho2) - VSQRT(r2)))) continue;
+                e[0] /= dd;
+                e[1] /= dd;
+                e[2] /= dd;
+                x = (VSQR(dd) + rho2 - r2)/(2.0*dd);
+                y = VSQRT(VMAX2(rho2 - VSQR(x), 0.0));
+                for (side=-1; side<=1; side+=2) {
+                    c[0] = m[0] + x*e[0] + side*y*(n[1]*e[2] - n[2]*e[1]);
+                    c[1] = m[1] + x*e[1] + side*y*(n[2]*e[0] - n[0]*e[2]);
+                    c[2] = m[2] + x*e[2] + side*y*(n[0]*e[1] - n[1]*e[0]);
+                    if (((VSQR(c[0]-pos[0]) + VSQR(c[1]-pos[1])
+                          + VSQR(c[2]-pos[2])) <= VSQR(srad)) &&
+                        edtFits(acc, c, srad, near[ia], near[ib], near[ic]))
+                        return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+VPRIVATE void fillcoCoefMolDielEDT(Vpmg *thee) {
+
+    Vacc *acc;
+    Vpbe *pbe;
+    double srad, srad2, far2, epsw, epsp, hx, hy, hzed, hmax, reach, d2;
+    double xmin, ymin, zmin, org[3], pos[3], *eps[3];
+    int a, k, nx, ny, nz;
+    size_t j, q, nxy, *feat;
+
+    pbe = thee->pbe;
+    acc = pbe->acc;
+    srad = Vpbe_getSolventRadius(pbe);
+    epsw = Vpbe_getSolventDiel(pbe);
+    epsp = Vpbe_getSoluteDiel(pbe);
+
+    /* Nothing to tell apart */
+    if (VABS(epsp - epsw) < VSMALL) return;
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+    nxy = (size_t)nx*ny;
+
+    /* Points further than srad from every probe center grid point can
+     * still be within srad of a probe center between the grid points, but
+     * not if they are more than a grid spacing further */
+    hmax = VMAX2(hx, VMAX2(hy, hzed));
+    srad2 = VSQR(srad);
+    far2 = VSQR(srad + hmax);
+
+    /* Atoms missing from a clist cell are at least this far beyond their
+     * inflated radius from every point of it (or off the clist entirely) */
+    reach = VMIN2(hmax, Vclist_maxRadius(acc->clist) - srad);
+
+    eps[0] = thee->epsx;
+    eps[1] = thee->epsy;
+    eps[2] = thee->epsz;
+    feat = (size_t *)Vmem_malloc(thee->vmem, nxy*nz, sizeof(size_t));
+
+    /* Each shifted grid is transformed on its own points.  The points left
+     * at epsw by the inflated spheres are where a probe center fits; every
+     * point within srad of one of them is solvent */
+    for (a=0; a<3; a++) {
+
+        org[0] = xmin + ((a == 0) ? 0.5*hx : 0.0);
+        org[1] = ymin + ((a == 1) ? 0.5*hy : 0.0);
+        org[2] = zmin + ((a == 2) ? 0.5*hzed : 0.0);
+
+        #pragma omp parallel for private(k, j)
+        for (k=0; k<nz; k++) {
+            for (j=k*nxy; j<(k+1)*nxy; j++) {
+                if (eps[a][j] == epsw) {
+                    eps[a][j] = 0.0;
+                    feat[j] = j;
+                } else {
+                    eps[a][j] = HUGE_VAL;
+                }
+            }
+        }
+
+        edtGrid(eps[a], feat, nx, ny, nz, hx, hy, hzed);
+
+        /* In the band just beyond srad, the nearest probe center grid point
+         * q is moved by the gap between it and the inflated spheres, which
+         * the segment to the point has to cross before the probe would
+         * overlap an atom.  Band points still left get the exact test
+         * against the probes touching one, two or three atoms; points past
+         * the band, the interior included, are solute */
+        #pragma omp parallel for schedule(dynamic, 1) private(k, j, q, d2, pos)
+        for (k=0; k<nz; k++) {
+            for (j=k*nxy; j<(k+1)*nxy; j++) {
+                d2 = eps[a][j];
+                if (d2 <= srad2) {
+                    eps[a][j] = epsw;
+                    continue;
+                }
+                if (d2 > far2) {
+                    eps[a][j] = epsp;
+                    continue;
+                }
+                q = feat[j];
+                pos[0] = org[0] + (double)(q%nx)*hx;
+                pos[1] = org[1] + (double)((q/nx)%ny)*hy;
+                pos[2] = org[2] + (double)(q/nxy)*hzed;
+                if ((VSQRT(d2) - edtGap(acc, pos, srad, reach)) <= srad) {
+                    eps[a][j] = epsw;
+                    continue;
+                }
+                pos[0] = org[0] + (double)(j%nx)*hx;
+                pos[1] = org[1] + (double)((j/nx)%ny)*hy;
+                pos[2] = org[2] + (double)(j/nxy)*hzed;
+                eps[a][j] = edtContact(acc, pos, srad) ? epsw : epsp;
+            }
+        }
+    }
+
+    Vmem_free(thee->vmem, nxy*nz, sizeof(size_t), (void **)&feat);
+}
+
 VPRIVATE void fillcoCoefMolDielSmooth(Vpmg *thee) {
 
   /* This function smoothes using a 9 point method based on
@@ -4899,8 +5920,8 @@ VPRIVATE void fillcoCoefMolDielSmooth(Vpmg *thee) {
      dielectric arrays by the fillcoCoefMolDielNoSmooth function.*/
 
     Vpbe *pbe;
-    double frac, epsw;
-    int i, j, k, nx, ny, nz, numpts;
+    double epsw;
+    int i, nx, ny, nz, lo[3], hi[3];
 
     /* Mesh info */
     nx = thee->pmgp->nx;
@@ -4921,9 +5942,28 @@ VPRIVATE void fillcoCoefMolDielSmooth(Vpmg *thee) {
     }
 
     /* Smooth the dielectric values */
-    for (i=0; i<nx; i++) {
-        for (j=0; j<ny; j++) {
-            for (k=0; k<nz; k++) {
+    lo[0] = 0;
+    lo[1] = 0;
+    lo[2] = 0;
+    hi[0] = nx-1;
+    hi[1] = ny-1;
+    hi[2] = nz-1;
+    fillcoCoefMolDielSmoothBox(thee, lo, hi);
+}
+
+VPRIVATE void fillcoCoefMolDielSmoothBox(Vpmg *thee, int *lo, int *hi) {
+
+    double frac;
+    int i, j, k, nx, ny, nz, numpts;
+
+    /* Mesh info */
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+
+    for (i=lo[0]; i<=hi[0]; i++) {
+        for (j=lo[1]; j<=hi[1]; j++) {
+            for (k=lo[2]; k<=hi[2]; k++) {
 
                 /* Get the 8 points that are 1/sqrt(2) grid spacings away */
 
@@ -5263,6 +6303,14 @@ VPRIVATE void fillcoCoef(Vpmg *thee) {
             Vnm_print(0, "fillcoCoef:  Calling fillcoCoefMol...\n");
             fillcoCoefMol(thee);
             break;
+        case VSM_MOLEDT:
+            Vnm_print(0, "fillcoCoef:  Calling fillcoCoefMol...\n");
+            fillcoCoefMol(thee);
+            break;
+        case VSM_MOLSMOOTHEDT:
+            Vnm_print(0, "fillcoCoef:  Calling fillcoCoefMol...\n");
+            fillcoCoefMol(thee);
+            break;
         case VSM_SPLINE:
             Vnm_print(0, "fillcoCoef:  Calling fillcoCoefSpline...\n");
             fillcoCoefSpline(thee);
@@ -5342,8 +6390,13 @@ VPRIVATE Vrc_Codes fillcoCharge(Vpmg *thee) {
 
 VPRIVATE Vrc_Codes fillcoChargeMap(Vpmg *thee) {
 
+    return fillcoChargeGrid(thee, thee->chargeMap, thee->charge);
+}
+
+VPRIVATE Vrc_Codes fillcoChargeGrid(Vpmg *thee, Vgrid *map, double *chg) {
+
     Vpbe *pbe;
-    double position[3], charge, zmagic, hx, hy, hzed;
+    double position[3], charge, zmagic;
     int i, j, k, nx, ny, nz, rc;
 
 
@@ -5357,12 +6410,9 @@ VPRIVATE Vrc_Codes fillcoChargeMap(Vpmg *thee) {
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
     nz = thee->pmgp->nz;
-    hx = thee->pmgp->hx;
-    hy = thee->pmgp->hy;
-    hzed = thee->pmgp->hzed;
 
     /* Reset the charge array */
-    for (i=0; i<(nx*ny*nz); i++) thee->charge[i] = 0.0;
+    for (i=0; i<(nx*ny*nz); i++) chg[i] = 0.0;
 
     /* Fill in the source term (atomic charges) */
     Vnm_print(0, "Vpmg_fillco:  filling in source term.\n");
@@ -5372,7 +6422,7 @@ VPRIVATE Vrc_Codes fillcoChargeMap(Vpmg *thee) {
                 position[0] = thee->xf[i];
                 position[1] = thee->yf[j];
                 position[2] = thee->zf[k];
-                rc = Vgrid_value(thee->chargeMap, position, &charge);
+                rc = Vgrid_value(map, position, &charge);
                 if (!rc) {
                     Vnm_print(2, "fillcoChargeMap:  Error -- fell off of charge map at (%g, %g, %g)!\n",
                           position[0], position[1], position[2]);
@@ -5380,7 +6430,7 @@ VPRIVATE Vrc_Codes fillcoChargeMap(Vpmg *thee) {
                 }
                 /* Scale the charge to internal units */
                 charge = charge*zmagic;
-                thee->charge[IJK(i,j,k)] = charge;
+                chg[IJK(i,j,k)] = charge;
             }
         }
     }
@@ -5394,9 +6444,9 @@ VPRIVATE void fillcoChargeSpline1(Vpmg *thee) {
     Vpbe *pbe;
     Vatom *atom;
     double xmin, xmax, ymin, ymax, zmin, zmax;
-    double xlen, ylen, zlen, position[3], ifloat, jfloat, kfloat;
-    double charge, dx, dy, dz, zmagic, hx, hy, hzed, *apos;
-    int i, nx, ny, nz, iatom, ihi, ilo, jhi, jlo, khi, klo;
+    double xlen, ylen, zlen;
+    double charge, *apos;
+    int i, nx, ny, nz, iatom;
 
 
     VASSERT(thee != VNULL);
@@ -5404,15 +6454,11 @@ VPRIVATE void fillcoChargeSpline1(Vpmg *thee) {
     /* Get PBE info */
     pbe = thee->pbe;
     alist = pbe->alist;
-    zmagic = Vpbe_getZmagic(pbe);
 
     /* Mesh info */
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
     nz = thee->pmgp->nz;
-    hx = thee->pmgp->hx;
-    hy = thee->pmgp->hy;
-    hzed = thee->pmgp->hzed;
 
     /* Define the total domain size */
     xlen = thee->pmgp->xlen;
@@ -5457,40 +6503,60 @@ VPRIVATE void fillcoChargeSpline1(Vpmg *thee) {
             fflush(stderr);
         } else {
 
-            /* Convert the atom position to grid reference frame */
-            position[0] = apos[0] - xmin;
-            position[1] = apos[1] - ymin;
-            position[2] = apos[2] - zmin;
+            chargeSpline1(thee, apos, charge);
 
-            /* Scale the charge to be a delta function */
-            charge = charge*zmagic/(hx*hy*hzed);
+        } /* endif (on the mesh) */
+    } /* endfor (each atom) */
+}
 
-            /* Figure out which vertices we're next to */
-            ifloat = position[0]/hx;
-            jfloat = position[1]/hy;
-            kfloat = position[2]/hzed;
+VPRIVATE void chargeSpline1(Vpmg *thee, double *apos, double charge) {
 
-            ihi = (int)ceil(ifloat);
-            ilo = (int)floor(ifloat);
-            jhi = (int)ceil(jfloat);
-            jlo = (int)floor(jfloat);
-            khi = (int)ceil(kfloat);
-            klo = (int)floor(kfloat);
+    double xmin, ymin, zmin, position[3], ifloat, jfloat, kfloat;
+    double dx, dy, dz, zmagic, hx, hy, hzed;
+    int nx, ny, ihi, ilo, jhi, jlo, khi, klo;
 
-            /* Now assign fractions of the charge to the nearby verts */
-            dx = ifloat - (double)(ilo);
-            dy = jfloat - (double)(jlo);
-            dz = kfloat - (double)(klo);
-            thee->charge[IJK(ihi,jhi,khi)] += (dx*dy*dz*charge);
-            thee->charge[IJK(ihi,jlo,khi)] += (dx*(1.0-dy)*dz*charge);
-            thee->charge[IJK(ihi,jhi,klo)] += (dx*dy*(1.0-dz)*charge);
-            thee->charge[IJK(ihi,jlo,klo)] += (dx*(1.0-dy)*(1.0-dz)*charge);
-            thee->charge[IJK(ilo,jhi,khi)] += ((1.0-dx)*dy*dz *charge);
-            thee->charge[IJK(ilo,jlo,khi)] += ((1.0-dx)*(1.0-dy)*dz *charge);
-            thee->charge[IJK(ilo,jhi,klo)] += ((1.0-dx)*dy*(1.0-dz)*charge);
-            thee->charge[IJK(ilo,jlo,klo)] += ((1.0-dx)*(1.0-dy)*(1.0-dz)*charge);
-        } /* endif (on the mesh) */
-    } /* endfor (each atom) */
+    zmagic = Vpbe_getZmagic(thee->pbe);
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+
+    /* Convert the atom position to grid reference frame */
+    position[0] = apos[0] - xmin;
+    position[1] = apos[1] - ymin;
+    position[2] = apos[2] - zmin;
+
+    /* Scale the charge to be a delta function */
+    charge = charge*zmagic/(hx*hy*hzed);
+
+    /* Figure out which vertices we're next to */
+    ifloat = position[0]/hx;
+    jfloat = position[1]/hy;
+    kfloat = position[2]/hzed;
+
+    ihi = (int)ceil(ifloat);
+    ilo = (int)floor(ifloat);
+    jhi = (int)ceil(jfloat);
+    jlo = (int)floor(jfloat);
+    khi = (int)ceil(kfloat);
+    klo = (int)floor(kfloat);
+
+    /* Now assign fractions of the charge to the nearby verts */
+    dx = ifloat - (double)(ilo);
+    dy = jfloat - (double)(jlo);
+    dz = kfloat - (double)(klo);
+    thee->charge[IJK(ihi,jhi,khi)] += (dx*dy*dz*charge);
+    thee->charge[IJK(ihi,jlo,khi)] += (dx*(1.0-dy)*dz*charge);
+    thee->charge[IJK(ihi,jhi,klo)] += (dx*dy*(1.0-dz)*charge);
+    thee->charge[IJK(ihi,jlo,klo)] += (dx*(1.0-dy)*(1.0-dz)*charge);
+    thee->charge[IJK(ilo,jhi,khi)] += ((1.0-dx)*dy*dz *charge);
+    thee->charge[IJK(ilo,jlo,khi)] += ((1.0-dx)*(1.0-dy)*dz *charge);
+    thee->charge[IJK(ilo,jhi,klo)] += ((1.0-dx)*dy*(1.0-dz)*charge);
+    thee->charge[IJK(ilo,jlo,klo)] += ((1.0-dx)*(1.0-dy)*(1.0-dz)*charge);
 }
 
 VPRIVATE double bspline2(double x) {
@@ -5530,11 +6596,10 @@ VPRIVATE void fillcoChargeSpline2(Vpmg *thee) {
     Valist *alist;
     Vpbe *pbe;
     Vatom *atom;
-    double xmin, xmax, ymin, ymax, zmin, zmax, zmagic;
-    double xlen, ylen, zlen, position[3], ifloat, jfloat, kfloat;
-    double charge, hx, hy, hzed, *apos, mx, my, mz;
-    int i, ii, jj, kk, nx, ny, nz, iatom;
-    int im2, im1, ip1, ip2, jm2, jm1, jp1, jp2, km2, km1, kp1, kp2;
+    double xmin, xmax, ymin, ymax, zmin, zmax;
+    double xlen, ylen, zlen;
+    double charge, hx, hy, hzed, *apos;
+    int i, nx, ny, nz, iatom;
 
 
     VASSERT(thee != VNULL);
@@ -5542,7 +6607,6 @@ VPRIVATE void fillcoChargeSpline2(Vpmg *thee) {
     /* Get PBE info */
     pbe = thee->pbe;
     alist = pbe->alist;
-    zmagic = Vpbe_getZmagic(pbe);
 
     /* Mesh info */
     nx = thee->pmgp->nx;
@@ -5595,61 +6659,243 @@ VPRIVATE void fillcoChargeSpline2(Vpmg *thee) {
             fflush(stderr);
         } else {
 
-            /* Convert the atom position to grid reference frame */
-            position[0] = apos[0] - xmin;
-            position[1] = apos[1] - ymin;
-            position[2] = apos[2] - zmin;
+            chargeSpline2(thee, apos, charge);
 
-            /* Scale the charge to be a delta function */
-            charge = charge*zmagic/(hx*hy*hzed);
+        } /* endif (on the mesh) */
+    } /* endfor (each atom) */
+}
 
-            /* Figure out which vertices we're next to */
-            ifloat = position[0]/hx;
-            jfloat = position[1]/hy;
-            kfloat = position[2]/hzed;
+VPRIVATE void chargeSpline2(Vpmg *thee, double *apos, double charge) {
 
-            ip1   = (int)ceil(ifloat);
-            ip2   = ip1 + 1;
-            im1   = (int)floor(ifloat);
-            im2   = im1 - 1;
-            jp1   = (int)ceil(jfloat);
-            jp2   = jp1 + 1;
-            jm1   = (int)floor(jfloat);
-            jm2   = jm1 - 1;
-            kp1   = (int)ceil(kfloat);
-            kp2   = kp1 + 1;
-            km1   = (int)floor(kfloat);
-            km2   = km1 - 1;
+    double xmin, ymin, zmin, zmagic, position[3], ifloat, jfloat, kfloat;
+    double hx, hy, hzed, mx, my, mz;
+    int ii, jj, kk, nx, ny, nz;
+    int im2, im1, ip1, ip2, jm2, jm1, jp1, jp2, km2, km1, kp1, kp2;
+
+    zmagic = Vpbe_getZmagic(thee->pbe);
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+
+    /* Convert the atom position to grid reference frame */
+    position[0] = apos[0] - xmin;
+    position[1] = apos[1] - ymin;
+    position[2] = apos[2] - zmin;
+
+    /* Scale the charge to be a delta function */
+    charge = charge*zmagic/(hx*hy*hzed);
+
+    /* Figure out which vertices we're next to */
+    ifloat = position[0]/hx;
+    jfloat = position[1]/hy;
+    kfloat = position[2]/hzed;
+
+    ip1   = (int)ceil(ifloat);
+    ip2   = ip1 + 1;
+    im1   = (int)floor(ifloat);
+    im2   = im1 - 1;
+    jp1   = (int)ceil(jfloat);
+    jp2   = jp1 + 1;
+    jm1   = (int)floor(jfloat);
+    jm2   = jm1 - 1;
+    kp1   = (int)ceil(kfloat);
+    kp2   = kp1 + 1;
+    km1   = (int)floor(kfloat);
+    km2   = km1 - 1;
+
+    /* This step shouldn't be necessary, but it saves nasty debugging
+     * later on if something goes wrong */
+    ip2 = VMIN2(ip2,nx-1);
+    ip1 = VMIN2(ip1,nx-1);
+    im1 = VMAX2(im1,0);
+    im2 = VMAX2(im2,0);
+    jp2 = VMIN2(jp2,ny-1);
+    jp1 = VMIN2(jp1,ny-1);
+    jm1 = VMAX2(jm1,0);
+    jm2 = VMAX2(jm2,0);
+    kp2 = VMIN2(kp2,nz-1);
+    kp1 = VMIN2(kp1,nz-1);
+    km1 = VMAX2(km1,0);
+    km2 = VMAX2(km2,0);
+
+    /* Now assign fractions of the charge to the nearby verts */
+    for (ii=im2; ii<=ip2; ii++) {
+        mx = bspline2(VFCHI(ii,ifloat));
+        for (jj=jm2; jj<=jp2; jj++) {
+            my = bspline2(VFCHI(jj,jfloat));
+            for (kk=km2; kk<=kp2; kk++) {
+                mz = bspline2(VFCHI(kk,kfloat));
+                thee->charge[IJK(ii,jj,kk)] += (charge*mx*my*mz);
+            }
+        }
+    }
+}
+
+/* fillcoCoefMolDielNoSmooth restricted to a box of grid points, writing
+ * the three shifted maps to ex, ey and ez.  Marks only set values, so
+ * refilling a box from every sphere that reaches it gives the same values
+ * as the full fill. */
+VPRIVATE void fillcoCoefMolDielBox(Vpmg *thee, int *lo, int *hi,
+                                   double *ex, double *ey, double *ez) {
+
+    Vacc *acc;
+    VaccSurf *asurf;
+    Valist *alist;
+    Vatom *atom;
+    double xmin, ymin, zmin, blo[3], bhi[3], position[3];
+    double srad, epsw, epsp, hx, hy, hzed, *apos, arad, reach;
+    int i, j, k, nx, ny, nz, iatom, ipt;
+
+    acc = thee->pbe->acc;
+    alist = thee->pbe->alist;
+    srad = Vpbe_getSolventRadius(thee->pbe);
+    epsw = Vpbe_getSolventDiel(thee->pbe);
+    epsp = Vpbe_getSoluteDiel(thee->pbe);
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+
+    for (k=lo[2]; k<=hi[2]; k++) {
+        for (j=lo[1]; j<=hi[1]; j++) {
+            for (i=lo[0]; i<=hi[0]; i++) {
+                ex[IJK(i,j,k)] = epsw;
+                ey[IJK(i,j,k)] = epsw;
+                ez[IJK(i,j,k)] = epsw;
+            }
+        }
+    }
+
+    /* The box with a grid spacing to spare, for picking the spheres */
+    blo[0] = xmin + (lo[0]-1)*hx;
+    blo[1] = ymin + (lo[1]-1)*hy;
+    blo[2] = zmin + (lo[2]-1)*hzed;
+    bhi[0] = xmin + (hi[0]+1)*hx;
+    bhi[1] = ymin + (hi[1]+1)*hy;
+    bhi[2] = zmin + (hi[2]+1)*hzed;
+
+    for (iatom=0; iatom<Valist_getNumberAtoms(alist); iatom++) {
+
+        atom = Valist_getAtom(alist, iatom);
+        apos = Vatom_getPosition(atom);
+        arad = Vatom_getRadius(atom);
+        if (!Vpmg_onMesh(thee, apos, 0.0) || (arad <= VSMALL)) continue;
+
+        reach = arad + srad;
+        if ((apos[0] < blo[0]-reach) || (apos[0] > bhi[0]+reach) ||
+            (apos[1] < blo[1]-reach) || (apos[1] > bhi[1]+reach) ||
+            (apos[2] < blo[2]-reach) || (apos[2] > bhi[2]+reach)) continue;
+
+        markSphereBox(reach, apos, nx, ny, nz, hx, hy, hzed,
+                      (xmin+0.5*hx), ymin, zmin, lo, hi, ex, epsp);
+        markSphereBox(reach, apos, nx, ny, nz, hx, hy, hzed,
+                      xmin, (ymin+0.5*hy), zmin, lo, hi, ey, epsp);
+        markSphereBox(reach, apos, nx, ny, nz, hx, hy, hzed,
+                      xmin, ymin, (zmin+0.5*hzed), lo, hi, ez, epsp);
+    }
+
+    if (srad <= VSMALL) return;
+
+    /* The SAS points of an atom lie arad + srad from its center */
+    for (iatom=0; iatom<Valist_getNumberAtoms(alist); iatom++) {
+
+        atom = Valist_getAtom(alist, iatom);
+        apos = Vatom_getPosition(atom);
+        reach = Vatom_getRadius(atom) + 2.0*srad;
+        if ((apos[0] < blo[0]-reach) || (apos[0] > bhi[0]+reach) ||
+            (apos[1] < blo[1]-reach) || (apos[1] > bhi[1]+reach) ||
+            (apos[2] < blo[2]-reach) || (apos[2] > bhi[2]+reach)) continue;
+        if (Vacc_atomSASA(acc, srad, atom) <= 0.0) continue;
+
+        asurf = Vacc_atomSASPoints(acc, srad, atom);
+        for (ipt=0; ipt<(asurf->npts); ipt++) {
+            position[0] = asurf->xpts[ipt];
+            position[1] = asurf->ypts[ipt];
+            position[2] = asurf->zpts[ipt];
+            markSphereBox(srad, position, nx, ny, nz, hx, hy, hzed,
+                          (xmin+0.5*hx), ymin, zmin, lo, hi, ex, epsw);
+            markSphereBox(srad, position, nx, ny, nz, hx, hy, hzed,
+                          xmin, (ymin+0.5*hy), zmin, lo, hi, ey, epsw);
+            markSphereBox(srad, position, nx, ny, nz, hx, hy, hzed,
+                          xmin, ymin, (zmin+0.5*hzed), lo, hi, ez, epsw);
+        }
+    }
+}
+
+/* fillcoCoefMolIon restricted to a box of grid points */
+VPRIVATE void fillcoCoefMolIonBox(Vpmg *thee, int *lo, int *hi) {
+
+    Valist *alist;
+    Vatom *atom;
+    double xmin, xmax, ymin, ymax, zmin, zmax, ionmask, ionstr;
+    double irad, hx, hy, hzed, *apos, arad, reach;
+    int i, j, k, nx, ny, nz, iatom;
+
+    alist = thee->pbe->alist;
+    irad = Vpbe_getMaxIonRadius(thee->pbe);
+    ionstr = Vpbe_getBulkIonicStrength(thee->pbe);
+
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+    xmax = thee->pmgp->xcent + (thee->pmgp->xlen/2.0);
+    ymax = thee->pmgp->ycent + (thee->pmgp->ylen/2.0);
+    zmax = thee->pmgp->zcent + (thee->pmgp->zlen/2.0);
+
+    if (ionstr > VPMGSMALL) ionmask = 1.0;
+    else ionmask = 0.0;
+
+    for (k=lo[2]; k<=hi[2]; k++) {
+        for (j=lo[1]; j<=hi[1]; j++) {
+            for (i=lo[0]; i<=hi[0]; i++) thee->kappa[IJK(i,j,k)] = ionmask;
+        }
+    }
+
+    if (ionstr < VPMGSMALL) return;
+
+    for (iatom=0; iatom<Valist_getNumberAtoms(alist); iatom++) {
 
-            /* This step shouldn't be necessary, but it saves nasty debugging
-             * later on if something goes wrong */
-            ip2 = VMIN2(ip2,nx-1);
-            ip1 = VMIN2(ip1,nx-1);
-            im1 = VMAX2(im1,0);
-            im2 = VMAX2(im2,0);
-            jp2 = VMIN2(jp2,ny-1);
-            jp1 = VMIN2(jp1,ny-1);
-            jm1 = VMAX2(jm1,0);
-            jm2 = VMAX2(jm2,0);
-            kp2 = VMIN2(kp2,nz-1);
-            kp1 = VMIN2(kp1,nz-1);
-            km1 = VMAX2(km1,0);
-            km2 = VMAX2(km2,0);
+        atom = Valist_getAtom(alist, iatom);
+        apos = Vatom_getPosition(atom);
+        arad = Vatom_getRadius(atom);
+        if (arad <= VSMALL) continue;
 
-            /* Now assign fractions of the charge to the nearby verts */
-            for (ii=im2; ii<=ip2; ii++) {
-                mx = bspline2(VFCHI(ii,ifloat));
-                for (jj=jm2; jj<=jp2; jj++) {
-                    my = bspline2(VFCHI(jj,jfloat));
-                    for (kk=km2; kk<=kp2; kk++) {
-                        mz = bspline2(VFCHI(kk,kfloat));
-                        thee->charge[IJK(ii,jj,kk)] += (charge*mx*my*mz);
-                    }
-                }
-            }
+        /* Same off-mesh test as fillcoCoefMolIon */
+        if ((apos[0]<(xmin-irad-arad)) || (apos[0]>(xmax+irad+arad))  || \
+            (apos[1]<(ymin-irad-arad)) || (apos[1]>(ymax+irad+arad))  || \
+            (apos[2]<(zmin-irad-arad)) || (apos[2]>(zmax+irad+arad))) {
+            continue;
+        }
 
-        } /* endif (on the mesh) */
-    } /* endfor (each atom) */
+        reach = irad + arad;
+        if ((apos[0] < xmin+(lo[0]-1)*hx-reach) ||
+            (apos[0] > xmin+(hi[0]+1)*hx+reach) ||
+            (apos[1] < ymin+(lo[1]-1)*hy-reach) ||
+            (apos[1] > ymin+(hi[1]+1)*hy+reach) ||
+            (apos[2] < zmin+(lo[2]-1)*hzed-reach) ||
+            (apos[2] > zmin+(hi[2]+1)*hzed+reach)) continue;
+
+        markSphereBox(reach, apos, nx, ny, nz, hx, hy, hzed,
+                      xmin, ymin, zmin, lo, hi, thee->kappa, 0.0);
+    }
 }
 
 VPUBLIC int Vpmg_fillco(Vpmg *thee,
@@ -5671,26 +6917,16 @@ VPUBLIC int Vpmg_fillco(Vpmg *thee,
                        ) {
 
     Vpbe *pbe;
-    double xmin,
-           xmax,
-           ymin,
-           ymax,
-           zmin,
-           zmax,
-           xlen,
-           ylen,
-           zlen,
-           hx,
-           hy,
-           hzed,
-           epsw,
+    double epsw,
            epsp,
            ionstr;
-    int i,
+    int k,
         nx,
         ny,
         nz,
         islap;
+    size_t j,
+           nxy;
     Vrc_Codes rc;
 
     if (thee == VNULL) {
@@ -5724,34 +6960,7 @@ VPUBLIC int Vpmg_fillco(Vpmg *thee,
     nx = thee->pmgp->nx;
     ny = thee->pmgp->ny;
     nz = thee->pmgp->nz;
-    hx = thee->pmgp->hx;
-    hy = thee->pmgp->hy;
-    hzed = thee->pmgp->hzed;
-
-    /* Define the total domain size */
-    xlen = thee->pmgp->xlen;
-    ylen = thee->pmgp->ylen;
-    zlen = thee->pmgp->zlen;
-
-    /* Define the min/max dimensions */
-    xmin = thee->pmgp->xcent - (xlen/2.0);
-    thee->pmgp->xmin = xmin;
-    ymin = thee->pmgp->ycent - (ylen/2.0);
-    thee->pmgp->ymin = ymin;
-    zmin = thee->pmgp->zcent - (zlen/2.0);
-    thee->pmgp->zmin = zmin;
-    xmax = thee->pmgp->xcent + (xlen/2.0);
-    thee->pmgp->xmax = xmax;
-    ymax = thee->pmgp->ycent + (ylen/2.0);
-    thee->pmgp->ymax = ymax;
-    zmax = thee->pmgp->zcent + (zlen/2.0);
-    thee->pmgp->zmax = zmax;
-    thee->rparm[2] = xmin;
-    thee->rparm[3] = xmax;
-    thee->rparm[4] = ymin;
-    thee->rparm[5] = ymax;
-    thee->rparm[6] = zmin;
-    thee->rparm[7] = zmax;
+    nxy = (size_t)nx*ny;
 
     /* This is a flag that gets set if the operator is a simple Laplacian;
      * i.e., in the case of a homogenous dielectric and zero ionic strength
@@ -5765,13 +6974,7 @@ VPUBLIC int Vpmg_fillco(Vpmg *thee,
         islap = 0;
     }
 
-    /* Fill the mesh point coordinate arrays */
-    for (i=0; i<nx; i++) thee->xf[i] = xmin + i*hx;
-    for (i=0; i<ny; i++) thee->yf[i] = ymin + i*hy;
-    for (i=0; i<nz; i++) thee->zf[i] = zmin + i*hzed;
-
-    /* Reset the tcf array */
-    for (i=0; i<(nx*ny*nz); i++) thee->tcf[i] = 0.0;
+    fillcoMesh(thee);
 
     /* Fill in the source term (atomic charges) */
     Vnm_print(0, "Vpmg_fillco:  filling in source term.\n");
@@ -5797,11 +7000,14 @@ VPUBLIC int Vpmg_fillco(Vpmg *thee,
 
     } else { /* else (!islap) ==> It's a Laplacian operator! */
 
-        for (i=0; i<(nx*ny*nz); i++) {
-            thee->kappa[i] = 0.0;
-            thee->epsx[i] = epsp;
-            thee->epsy[i] = epsp;
-            thee->epsz[i] = epsp;
+        #pragma omp parallel for private(k, j)
+        for (k=1; k<nz-1; k++) {
+            for (j=PLANE0(k); j<PLANE1(k); j++) {
+                thee->kappa[j] = 0.0;
+                thee->epsx[j] = epsp;
+                thee->epsy[j] = epsp;
+                thee->epsz[j] = epsp;
+            }
         }
 
     } /* endif (!islap) */
@@ -5813,11 +7019,496 @@ VPUBLIC int Vpmg_fillco(Vpmg *thee,
         Vnm_print(0, "Vpmg_fillco:  done filling boundary arrays\n");
     }
 
+    Vpmg_snapAtoms(thee);
     thee->filled = 1;
 
     return 1;
 }
 
+/* Set up the mesh coordinates and domain bounds for a fill */
+VPRIVATE void fillcoMesh(Vpmg *thee) {
+
+    double xmin,
+           xmax,
+           ymin,
+           ymax,
+           zmin,
+           zmax,
+           xlen,
+           ylen,
+           zlen,
+           hx,
+           hy,
+           hzed;
+    int i,
+        k,
+        nx,
+        ny,
+        nz;
+    size_t j,
+           nxy;
+
+    /* Mesh info */
+    nx = thee->pmgp->nx;
+    ny = thee->pmgp->ny;
+    nz = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+
+    /* Define the total domain size */
+    xlen = thee->pmgp->xlen;
+    ylen = thee->pmgp->ylen;
+    zlen = thee->pmgp->zlen;
+
+    /* Define the min/max dimensions */
+    xmin = thee->pmgp->xcent - (xlen/2.0);
+    thee->pmgp->xmin = xmin;
+    ymin = thee->pmgp->ycent - (ylen/2.0);
+    thee->pmgp->ymin = ymin;
+    zmin = thee->pmgp->zcent - (zlen/2.0);
+    thee->pmgp->zmin = zmin;
+    xmax = thee->pmgp->xcent + (xlen/2.0);
+    thee->pmgp->xmax = xmax;
+    ymax = thee->pmgp->ycent + (ylen/2.0);
+    thee->pmgp->ymax = ymax;
+    zmax = thee->pmgp->zcent + (zlen/2.0);
+    thee->pmgp->zmax = zmax;
+    thee->rparm[2] = xmin;
+    thee->rparm[3] = xmax;
+    thee->rparm[4] = ymin;
+    thee->rparm[5] = ymax;
+    thee->rparm[6] = zmin;
+    thee->rparm[7] = zmax;
+
+    /* Fill the mesh point coordinate arrays */
+    for (i=0; i<nx; i++) thee->xf[i] = xmin + i*hx;
+    for (i=0; i<ny; i++) thee->yf[i] = ymin + i*hy;
+    for (i=0; i<nz; i++) thee->zf[i] = zmin + i*hzed;
+
+    /* Reset the tcf array */
+    nxy = (size_t)nx*ny;
+    #pragma omp parallel for private(k, j)
+    for (k=1; k<nz-1; k++) {
+        for (j=PLANE0(k); j<PLANE1(k); j++) thee->tcf[j] = 0.0;
+    }
+}
+
+/* Remember the atoms the coefficient arrays were filled for */
+VPRIVATE void Vpmg_snapAtoms(Vpmg *thee) {
+
+    Valist *alist;
+    Vatom *atom;
+    double *apos, *snap;
+    int i, natoms;
+
+    alist = thee->pbe->alist;
+    natoms = Valist_getNumberAtoms(alist);
+    if (thee->nsnap != natoms) {
+        if (thee->snap != VNULL) {
+            Vmem_free(thee->vmem, VPMGSNAP*thee->nsnap, sizeof(double),
+              (void **)&(thee->snap));
+        }
+        thee->snap = (double *)Vmem_malloc(thee->vmem, VPMGSNAP*natoms,
+                                           sizeof(double));
+        thee->nsnap = natoms;
+    }
+
+    for (i=0; i<natoms; i++) {
+        atom = Valist_getAtom(alist, i);
+        apos = Vatom_getPosition(atom);
+        snap = thee->snap + VPMGSNAP*i;
+        snap[0] = apos[0];
+        snap[1] = apos[1];
+        snap[2] = apos[2];
+        snap[3] = Vatom_getRadius(atom);
+        snap[4] = Vatom_getCharge(atom);
+    }
+}
+
+/* The test the charge and dielectric fills use to skip atoms off the mesh,
+ * with the mesh grown by pad grid spacings */
+VPRIVATE int Vpmg_onMesh(Vpmg *thee, double *pos, double pad) {
+
+    double xmin, xmax, ymin, ymax, zmin, zmax;
+
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0) - pad*thee->pmgp->hx;
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0) - pad*thee->pmgp->hy;
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0) - pad*thee->pmgp->hzed;
+    xmax = thee->pmgp->xcent + (thee->pmgp->xlen/2.0) + pad*thee->pmgp->hx;
+    ymax = thee->pmgp->ycent + (thee->pmgp->ylen/2.0) + pad*thee->pmgp->hy;
+    zmax = thee->pmgp->zcent + (thee->pmgp->zlen/2.0) + pad*thee->pmgp->hzed;
+
+    return ((pos[0] > xmin) && (pos[0] < xmax) &&
+            (pos[1] > ymin) && (pos[1] < ymax) &&
+            (pos[2] > zmin) && (pos[2] < zmax));
+}
+
+VPUBLIC int Vpmg_fillcoAtoms(Vpmg *thee, int nchange, int *ichange) {
+
+    Vpbe *pbe;
+    Vacc *acc;
+    Valist *alist;
+    Vatom *atom, *other;
+    double *snap, *apos, *opos, arad, srad, irad, reach, ionstr, epsw, epsp;
+    double dist2, hx, hy, hzed, xmin, ymin, zmin, h[3], org[3], lo3, hi3;
+    int i, n, d, natoms, moved, recharge, islap, nn[3];
+    int lo[3], hi[3], slo[3], shi[3];
+    char *near;
+
+    VASSERT(thee != VNULL);
+
+    if (!(thee->filled)) {
+        Vnm_print(2, "Vpmg_fillcoAtoms:  Need to call Vpmg_fillco()!\n");
+        return 0;
+    }
+
+    pbe = thee->pbe;
+    acc = pbe->acc;
+    alist = pbe->alist;
+    natoms = Valist_getNumberAtoms(alist);
+
+    /* Each atom may be listed once; its old charge is taken out per entry */
+    near = (char *)Vmem_malloc(thee->vmem, natoms, sizeof(char));
+    for (n=0; n<nchange; n++) {
+        if ((ichange[n] < 0) || (ichange[n] >= natoms) || near[ichange[n]]) {
+            Vnm_print(2, "Vpmg_fillcoAtoms:  No atom #%d, or listed twice!\n",
+                      ichange[n]);
+            Vmem_free(thee->vmem, natoms, sizeof(char), (void **)&near);
+            return 0;
+        }
+        near[ichange[n]] = 1;
+    }
+    Vmem_free(thee->vmem, natoms, sizeof(char), (void **)&near);
+
+    /* Only coefficients marked from the atom spheres are patched */
+    if ((thee->nsnap != natoms) || thee->useDielXMap || thee->useDielYMap ||
+        thee->useDielZMap || thee->useKappaMap || thee->useChargeMap ||
+        ((thee->surfMeth != VSM_MOL) && (thee->surfMeth != VSM_MOLSMOOTH))) {
+        Vnm_print(0, "Vpmg_fillcoAtoms:  refilling all coefficients\n");
+        return Vpmg_fillco(thee, thee->surfMeth, thee->splineWin,
+                           thee->chargeMeth, thee->useDielXMap,
+                           thee->dielXMap, thee->useDielYMap, thee->dielYMap,
+                           thee->useDielZMap, thee->dielZMap,
+                           thee->useKappaMap, thee->kappaMap,
+                           thee->usePotMap, thee->potMap,
+                           thee->useChargeMap, thee->chargeMap);
+    }
+
+    srad = Vpbe_getSolventRadius(pbe);
+    irad = Vpbe_getMaxIonRadius(pbe);
+    ionstr = Vpbe_getBulkIonicStrength(pbe);
+    epsw = Vpbe_getSolventDiel(pbe);
+    epsp = Vpbe_getSoluteDiel(pbe);
+
+    nn[0] = thee->pmgp->nx;
+    nn[1] = thee->pmgp->ny;
+    nn[2] = thee->pmgp->nz;
+    hx = thee->pmgp->hx;
+    hy = thee->pmgp->hy;
+    hzed = thee->pmgp->hzed;
+    xmin = thee->pmgp->xcent - (thee->pmgp->xlen/2.0);
+    ymin = thee->pmgp->ycent - (thee->pmgp->ylen/2.0);
+    zmin = thee->pmgp->zcent - (thee->pmgp->zlen/2.0);
+    h[0] = hx;
+    h[1] = hy;
+    h[2] = hzed;
+    org[0] = xmin;
+    org[1] = ymin;
+    org[2] = zmin;
+
+    /* Move the atoms in the cell list; the SAS points are tested against
+     * it, so it has to be current before any of them are rebuilt */
+    moved = 0;
+    recharge = 0;
+    for (n=0; n<nchange; n++) {
+        atom = Valist_getAtom(alist, ichange[n]);
+        apos = Vatom_getPosition(atom);
+        snap = thee->snap + VPMGSNAP*ichange[n];
+        if ((apos[0] != snap[0]) || (apos[1] != snap[1]) ||
+            (apos[2] != snap[2]) || (Vatom_getRadius(atom) != snap[3])) {
+            if (Vclist_moveAtom(acc->clist, atom, snap, snap[3])
+                != VRC_SUCCESS) {
+                Vnm_print(2, "Vpmg_fillcoAtoms:  Unable to move atom #%d in \
+the cell list!\n", ichange[n]);
+                return 0;
+            }
+            moved = 1;
+        }
+        if (moved || (Vatom_getCharge(atom) != snap[4])) recharge = 1;
+    }
+
+    /* A SAS point can be buried or uncovered by an atom within
+     * arad + srad of it, so the points of every atom within
+     * arad + aradj + 2*srad of an old or new position are rebuilt */
+    if (moved && (srad > VSMALL)) {
+        near = (char *)Vmem_malloc(thee->vmem, natoms, sizeof(char));
+        for (n=0; n<nchange; n++) {
+            atom = Valist_getAtom(alist, ichange[n]);
+            apos = Vatom_getPosition(atom);
+            snap = thee->snap + VPMGSNAP*ichange[n];
+            arad = VMAX2(Vatom_getRadius(atom), snap[3]);
+            for (i=0; i<natoms; i++) {
+                if (near[i]) continue;
+                other = Valist_getAtom(alist, i);
+                opos = Vatom_getPosition(other);
+                reach = VSQR(arad + Vatom_getRadius(other) + 2.0*srad);
+                dist2 = VSQR(opos[0]-apos[0]) + VSQR(opos[1]-apos[1])
+                        + VSQR(opos[2]-apos[2]);
+                if (dist2 <= reach) near[i] = 1;
+                dist2 = VSQR(opos[0]-snap[0]) + VSQR(opos[1]-snap[1])
+                        + VSQR(opos[2]-snap[2]);
+                if (dist2 <= reach) near[i] = 1;
+            }
+        }
+        for (i=0; i<natoms; i++) {
+            if (near[i]) Vacc_atomSASReset(acc, srad, Valist_getAtom(alist, i));
+        }
+        Vmem_free(thee->vmem, natoms, sizeof(char), (void **)&near);
+    }
+
+    /* Take each changed atom's old charge out of the source term and put
+     * the new one in, with the on-mesh tests of the full fill */
+    if (recharge) {
+        switch (thee->chargeMeth) {
+            case VCM_TRIL:
+            case VCM_BSPL2:
+                for (n=0; n<nchange; n++) {
+                    atom = Valist_getAtom(alist, ichange[n]);
+                    snap = thee->snap + VPMGSNAP*ichange[n];
+                    if (thee->chargeMeth == VCM_TRIL) {
+                        if (Vpmg_onMesh(thee, snap, 0.0)) {
+                            chargeSpline1(thee, snap, -snap[4]);
+                        }
+                        if (Vpmg_onMesh(thee, Vatom_getPosition(atom), 0.0)) {
+                            chargeSpline1(thee, Vatom_getPosition(atom),
+                                          Vatom_getCharge(atom));
+                        }
+                    } else {
+                        if (Vpmg_onMesh(thee, snap, 1.0)) {
+                            chargeSpline2(thee, snap, -snap[4]);
+                        }
+                        if (Vpmg_onMesh(thee, Vatom_getPosition(atom), 1.0)) {
+                            chargeSpline2(thee, Vatom_getPosition(atom),
+                                          Vatom_getCharge(atom));
+                        }
+                    }
+                }
+                break;
+            default:
+                if (fillcoCharge(thee) == VRC_FAILURE) return 0;
+                break;
+        }
+    }
+
+    /* Refill the dielectric and kappa maps in a box around the old and new
+     * spheres of each moved atom.  A moved atom changes points up to
+     * arad + 2*srad away (its own SAS points and the ones it buries) and
+     * kappa up to arad + irad; one more point covers the half-spacing shift
+     * of the dielectric grids */
+    islap = ((ionstr < VPMGSMALL) && (VABS(epsp-epsw) < VPMGSMALL));
+    for (n=0; (n<nchange) && moved && !islap; n++) {
+
+        atom = Valist_getAtom(alist, ichange[n]);
+        apos = Vatom_getPosition(atom);
+        snap = thee->snap + VPMGSNAP*ichange[n];
+        if ((apos[0] == snap[0]) && (apos[1] == snap[1]) &&
+            (apos[2] == snap[2]) && (Vatom_getRadius(atom) == snap[3])) {
+            continue;
+        }
+
+        reach = VMAX2(Vatom_getRadius(atom), snap[3])
+                + VMAX2(2.0*srad, irad);
+        for (d=0; d<3; d++) {
+            lo3 = VMIN2(apos[d], snap[d]) - reach - org[d];
+            hi3 = VMAX2(apos[d], snap[d]) + reach - org[d];
+            lo[d] = VMAX2(0, (int)floor(lo3/h[d]) - 1);
+            hi[d] = VMIN2(nn[d]-1, (int)ceil(hi3/h[d]) + 1);
+        }
+        if ((lo[0] > hi[0]) || (lo[1] > hi[1]) || (lo[2] > hi[2])) continue;
+
+        if (thee->surfMeth == VSM_MOLSMOOTH) {
+            /* Smoothing spreads the change by one more point and reads
+             * one point beyond that */
+            for (d=0; d<3; d++) {
+                lo[d] = VMAX2(0, lo[d]-1);
+                hi[d] = VMIN2(nn[d]-1, hi[d]+1);
+                slo[d] = VMAX2(0, lo[d]-1);
+                shi[d] = VMIN2(nn[d]-1, hi[d]+1);
+            }
+            fillcoCoefMolDielBox(thee, slo, shi, thee->a1cf, thee->a2cf,
+                                 thee->a3cf);
+            fillcoCoefMolDielSmoothBox(thee, lo, hi);
+        } else {
+            fillcoCoefMolDielBox(thee, lo, hi, thee->epsx, thee->epsy,
+                                 thee->epsz);
+        }
+        fillcoCoefMolIonBox(thee, lo, hi);
+    }
+
+    if (recharge && (thee->pmgp->bcfl != BCFL_FOCUS)) bcCalc(thee);
+
+    Vpmg_snapAtoms(thee);
+
+    return 1;
+}
+
+/* Give pbe the accessibility objects of pbeOLD, whose Valist has as many
+ * atoms.  The cell list points into the atom storage of pbeOLD's Valist, so
+ * the two Valists trade storage as well, swapping the atoms back so that
+ * each keeps its own.  pbeOLD is left with pbe's objects, which no longer
+ * match its atoms; it can only be destroyed */
+VPRIVATE void Vpmg_tradeAcc(Vpbe *pbe, Vpbe *pbeOLD) {
+
+    int i;
+    Vatom tatom, *tatoms;
+    Vacc *tacc;
+    Vclist *tclist;
+
+    for (i=0; i<pbe->alist->number; i++) {
+        tatom = pbe->alist->atoms[i];
+        pbe->alist->atoms[i] = pbeOLD->alist->atoms[i];
+        pbeOLD->alist->atoms[i] = tatom;
+    }
+    tatoms = pbe->alist->atoms;
+    pbe->alist->atoms = pbeOLD->alist->atoms;
+    pbeOLD->alist->atoms = tatoms;
+
+    tacc = pbe->acc;
+    pbe->acc = pbeOLD->acc;
+    pbeOLD->acc = tacc;
+    tclist = pbe->clist;
+    pbe->clist = pbeOLD->clist;
+    pbeOLD->clist = tclist;
+
+    pbe->acc->alist = pbe->alist;
+    pbe->clist->alist = pbe->alist;
+    pbeOLD->acc->alist = pbeOLD->alist;
+    pbeOLD->clist->alist = pbeOLD->alist;
+}
+
+VPUBLIC int Vpmg_fillcoFrom(Vpmg *thee, Vpmg *pmgOLD, Vsurf_Meth surfMeth,
+                            double splineWin, Vchrg_Meth chargeMeth) {
+
+    Vpbe *pbe, *pbeOLD;
+    Vatom *atom;
+    double *apos, *snap;
+    double conc[MAXION], radii[MAXION], q[MAXION];
+    double concOLD[MAXION], radiiOLD[MAXION], qOLD[MAXION];
+    int i, natoms, nion, nionOLD, nchange, *ichange, rc;
+    size_t num;
+
+    VASSERT(thee != VNULL);
+
+    if ((pmgOLD == VNULL) || !(pmgOLD->filled)) return 0;
+    pbe = thee->pbe;
+    pbeOLD = pmgOLD->pbe;
+    natoms = Valist_getNumberAtoms(pbe->alist);
+
+    /* The old maps must have come from the atoms alone, with the same
+     * surface, mesh and physics */
+    if ((pbe == pbeOLD) || (pmgOLD->nsnap != natoms) ||
+        (Valist_getNumberAtoms(pbeOLD->alist) != natoms) ||
+        pmgOLD->useDielXMap || pmgOLD->useDielYMap || pmgOLD->useDielZMap ||
+        pmgOLD->useKappaMap || pmgOLD->useChargeMap ||
+        ((surfMeth != VSM_MOL) && (surfMeth != VSM_MOLSMOOTH)) ||
+        (pmgOLD->surfMeth != surfMeth) || (pmgOLD->splineWin != splineWin) ||
+        (pmgOLD->chargeMeth != chargeMeth)) return 0;
+    if ((thee->pmgp->nx != pmgOLD->pmgp->nx) ||
+        (thee->pmgp->ny != pmgOLD->pmgp->ny) ||
+        (thee->pmgp->nz != pmgOLD->pmgp->nz) ||
+        (thee->pmgp->hx != pmgOLD->pmgp->hx) ||
+        (thee->pmgp->hy != pmgOLD->pmgp->hy) ||
+        (thee->pmgp->hzed != pmgOLD->pmgp->hzed) ||
+        (thee->pmgp->xcent != pmgOLD->pmgp->xcent) ||
+        (thee->pmgp->ycent != pmgOLD->pmgp->ycent) ||
+        (thee->pmgp->zcent != pmgOLD->pmgp->zcent) ||
+        (thee->pmgp->bcfl != pmgOLD->pmgp->bcfl) ||
+        (thee->pmgp->bcfl == BCFL_FOCUS) ||
+        (thee->pmgp->nonlin != pmgOLD->pmgp->nonlin) ||
+        (thee->pmgp->ipkey != pmgOLD->pmgp->ipkey)) return 0;
+    Vpbe_getIons(pbe, &nion, conc, radii, q);
+    Vpbe_getIons(pbeOLD, &nionOLD, concOLD, radiiOLD, qOLD);
+    if ((nion != nionOLD) ||
+        (Vpbe_getSolventRadius(pbe) != Vpbe_getSolventRadius(pbeOLD)) ||
+        (Vpbe_getSoluteDiel(pbe) != Vpbe_getSoluteDiel(pbeOLD)) ||
+        (Vpbe_getSolventDiel(pbe) != Vpbe_getSolventDiel(pbeOLD)) ||
+        (Vpbe_getTemperature(pbe) != Vpbe_getTemperature(pbeOLD)) ||
+        (pbe->acc->surf_density != pbeOLD->acc->surf_density)) return 0;
+    for (i=0; i<nion; i++) {
+        if ((conc[i] != concOLD[i]) || (radii[i] != radiiOLD[i]) ||
+            (q[i] != qOLD[i])) return 0;
+    }
+
+    /* Patching costs about a box per changed atom; past a few of them a
+     * full fill is cheaper */
+    ichange = (int *)Vmem_malloc(thee->vmem, natoms, sizeof(int));
+    nchange = 0;
+    for (i=0; i<natoms; i++) {
+        atom = Valist_getAtom(pbe->alist, i);
+        apos = Vatom_getPosition(atom);
+        snap = pmgOLD->snap + VPMGSNAP*i;
+        if ((apos[0] != snap[0]) || (apos[1] != snap[1]) ||
+            (apos[2] != snap[2]) || (Vatom_getRadius(atom) != snap[3]) ||
+            (Vatom_getCharge(atom) != snap[4])) {
+            ichange[nchange] = i;
+            nchange++;
+        }
+    }
+    if (nchange > VPMGREUSEFRAC*natoms) {
+        Vmem_free(thee->vmem, natoms, sizeof(int), (void **)&ichange);
+        return 0;
+    }
+    Vnm_print(0, "Vpmg_fillcoFrom:  patching the maps for %d of %d atoms\n",
+              nchange, natoms);
+
+    Vpmg_tradeAcc(pbe, pbeOLD);
+
+    thee->surfMeth = surfMeth;
+    thee->splineWin = splineWin;
+    thee->chargeMeth = chargeMeth;
+    thee->useDielXMap = 0;
+    thee->useDielYMap = 0;
+    thee->useDielZMap = 0;
+    thee->useKappaMap = 0;
+    thee->usePotMap = 0;
+    thee->useChargeMap = 0;
+    fillcoMesh(thee);
+
+    num = (size_t)(thee->pmgp->nx)*(thee->pmgp->ny)*(thee->pmgp->nz);
+    memcpy(thee->epsx, pmgOLD->epsx, num*sizeof(double));
+    memcpy(thee->epsy, pmgOLD->epsy, num*sizeof(double));
+    memcpy(thee->epsz, pmgOLD->epsz, num*sizeof(double));
+    memcpy(thee->kappa, pmgOLD->kappa, num*sizeof(double));
+    memcpy(thee->charge, pmgOLD->charge, num*sizeof(double));
+    memcpy(thee->gxcf, pmgOLD->gxcf,
+           10*(thee->pmgp->ny)*(thee->pmgp->nz)*sizeof(double));
+    memcpy(thee->gycf, pmgOLD->gycf,
+           10*(thee->pmgp->nx)*(thee->pmgp->nz)*sizeof(double));
+    memcpy(thee->gzcf, pmgOLD->gzcf,
+           10*(thee->pmgp->nx)*(thee->pmgp->ny)*sizeof(double));
+
+    /* The maps are those of the old atoms until they are patched */
+    if (thee->nsnap != natoms) {
+        if (thee->snap != VNULL) {
+            Vmem_free(thee->vmem, VPMGSNAP*thee->nsnap, sizeof(double),
+              (void **)&(thee->snap));
+        }
+        thee->snap = (double *)Vmem_malloc(thee->vmem, VPMGSNAP*natoms,
+                                           sizeof(double));
+        thee->nsnap = natoms;
+    }
+    memcpy(thee->snap, pmgOLD->snap, VPMGSNAP*natoms*sizeof(double));
+    thee->filled = 1;
+
+    rc = Vpmg_fillcoAtoms(thee, nchange, ichange);
+    if (!rc) thee->filled = 0;
+
+    Vmem_free(thee->vmem, natoms, sizeof(int), (void **)&ichange);
+
+    return rc;
+}
+
 
 VPUBLIC int Vpmg_force(Vpmg *thee, double *force, int atomID,
   Vsurf_Meth srfm, Vchrg_Meth chgm) {
@@ -6852,6 +8543,36 @@ VPRIVATE void markSphere(double rtot, double *tpos,
                          double xmin, double ymin, double zmin,
                          double *array, double markVal) {
 
+    markSphereSlab(rtot, tpos, nx, ny, nz, hx, hy, hz, xmin, ymin, zmin,
+                   0, nz-1, array, markVal);
+}
+
+VPRIVATE void markSphereSlab(double rtot, double *tpos,
+                             int nx, int ny, int nz,
+                             double hx, double hy, double hz,
+                             double xmin, double ymin, double zmin,
+                             int k0, int k1,
+                             double *array, double markVal) {
+
+    int lo[3], hi[3];
+
+    lo[0] = 0;
+    lo[1] = 0;
+    lo[2] = k0;
+    hi[0] = nx-1;
+    hi[1] = ny-1;
+    hi[2] = k1;
+    markSphereBox(rtot, tpos, nx, ny, nz, hx, hy, hz, xmin, ymin, zmin,
+                  lo, hi, array, markVal);
+}
+
+VPRIVATE void markSphereBox(double rtot, double *tpos,
+                            int nx, int ny, int nz,
+                            double hx, double hy, double hz,
+                            double xmin, double ymin, double zmin,
+                            int *lo, int *hi,
+                            double *array, double markVal) {
+
     int i, j, k;
     double fi,fj,fk;
     int imin, imax;
@@ -6872,21 +8593,25 @@ VPRIVATE void markSphere(double rtot, double *tpos,
     yrange = rtot + 0.5 * hy;
     zrange = rtot + 0.5 * hz;
 
-    imin = VMAX2(0, (int)ceil((posx - xrange)/hx));
-    jmin = VMAX2(0, (int)ceil((posy - yrange)/hy));
-    kmin = VMAX2(0, (int)ceil((posz - zrange)/hz));
+    imin = VMAX2(lo[0], (int)ceil((posx - xrange)/hx));
+    jmin = VMAX2(lo[1], (int)ceil((posy - yrange)/hy));
+    kmin = VMAX2(lo[2], (int)ceil((posz - zrange)/hz));
 
-    imax = VMIN2(nx-1, (int)floor((posx + xrange)/hx));
-    jmax = VMIN2(ny-1, (int)floor((posy + yrange)/hy));
-    kmax = VMIN2(nz-1, (int)floor((posz + zrange)/hz));
+    imax = VMIN2(hi[0], (int)floor((posx + xrange)/hx));
+    jmax = VMIN2(hi[1], (int)floor((posy + yrange)/hy));
+    kmax = VMIN2(hi[2], (int)floor((posz + zrange)/hz));
 
-    for (i=imin,fi=imin; i<=imax; i++, fi+=1.) {
-        dx2 = VSQR(posx - hx*fi);
+    /* Planes outermost so that a slab only visits its own planes; the test
+     * is the same sum in the same order as always, so the marked set does
+     * not depend on the box boundaries */
+    for (k=kmin, fk=kmin; k<=kmax; k++, fk+=1.) {
+        dz2 = VSQR(posz - hz*fk);
+        if (dz2 > rtot2) continue;
         for (j=jmin,fj=jmin; j<=jmax; j++, fj+=1.) {
             dy2 = VSQR(posy - hy*fj);
-            if((dx2 + dy2) > rtot2) continue;
-            for (k=kmin, fk=kmin; k<=kmax; k++, fk+=1.) {
-                dz2 = VSQR(posz - hz*fk);
+            if ((dz2 + dy2) > rtot2) continue;
+            for (i=imin,fi=imin; i<=imax; i++, fi+=1.) {
+                dx2 = VSQR(posx - hx*fi);
                 if ((dz2 + dy2 + dx2) <= rtot2) {
                     array[IJK(i,j,k)] = markVal;
                 }
@@ -10837,6 +12562,10 @@ VPRIVATE void bcolcomp3(int *nx, int *ny, int *nz,
 
     WARN_UNTESTED;
 
+    if (VAT(ipc, 13) == 1) {
+        VABORT_MSG0("Cannot print a matrix-free operator; use mgdisc 0");
+    }
+
     bcolcomp4(nx, ny, nz,
             ipc, rpc,
             RAT2(ac, 1, 1), cc,
@@ -82,6 +82,8 @@
 
 #include "apbscfg.h"
 
+#include <stdint.h>
+
 #include "maloc/maloc.h"
 
 #include "generic/vhal.h"
@@ -93,17 +95,63 @@
 #include "generic/vmatrix.h"
 #include "pmgc/mgdrvd.h"
 #include "pmgc/newdrvd.h"
+#include "pmgc/cgmgdrvd.h"
+#include "pmgc/mgblkd.h"
 #include "pmgc/mgsubd.h"
 #include "pmgc/mikpckd.h"
 #include "pmgc/matvecd.h"
 #include "mg/vpmgp.h"
 #include "mg/vgrid.h"
+#include "mg/vdhtree.h"
 
 /** @def VPMGMAXPART The maximum number of partitions the mesh can be divided into
  *  @ingroup Vpmg
  */
 #define VPMGMAXPART 2000
 
+/** @def VPMGBCTILE Side (in grid points) of the tiles of a boundary face
+ *       that bcflTree hands to the treecode as one batch
+ *  @ingroup Vpmg
+ */
+#define VPMGBCTILE 8
+
+/** @def VPMGMDHTILE Number of points mdhPoints sums as one batch
+ *  @ingroup Vpmg
+ */
+#define VPMGMDHTILE 64
+
+/** @def VPMGMDHBLOCK Number of atoms the scalar mdhPoints loop sweeps a
+ *       batch of points over before moving to the next atoms
+ *  @ingroup Vpmg
+ */
+#define VPMGMDHBLOCK 256
+
+/** @def VPMGMARKSLAB Thickness (in z-planes) of the slabs the dielectric
+ *       marking is split into; each slab is marked by one thread
+ *  @ingroup Vpmg
+ */
+#define VPMGMARKSLAB 2
+
+/** @def VPMGEDTNEAR Most atoms the mol-edt contact test projects a grid
+ *       point onto; further ones are ignored, which only leaves the point
+ *       to the dielectric
+ *  @ingroup Vpmg
+ */
+#define VPMGEDTNEAR 32
+
+/** @def VPMGREUSEFRAC Largest fraction of the atoms that may differ for
+ *       Vpmg_fillcoFrom to patch the maps of the previous calculation rather
+ *       than fill them anew
+ *  @ingroup Vpmg
+ */
+#define VPMGREUSEFRAC 0.1
+
+/** @def VPMGSNAP Values kept per atom by Vpmg::snap (position, radius and
+ *       charge)
+ *  @ingroup Vpmg
+ */
+#define VPMGSNAP 5
+
 /**
  *  @ingroup Vpmg
  *  @author  Nathan Baker
@@ -116,6 +164,9 @@
 struct sVpmg {
 
   Vmem *vmem;  /**< Memory management object for this class */
+  Varena *arena;  /**< Arena holding the grid arrays (rwork, the narr
+                   * coefficient arrays and pvec), or VNULL if they come
+                   * from vmem; see Vpmgp::arena */
   Vpmgp *pmgp;  /**< Parameters */
   Vpbe *pbe;  /**< Information about the PBE system */
 
@@ -124,7 +175,8 @@ struct sVpmg {
   Vmgdriver *mgdriver;  /**< @todo doc */
 #endif
 
-  double *epsx;  /**< X-shifted dielectric map */
+  double *epsx;  /**< X-shifted dielectric map; with mgdisc 2 this and
+                   * epsy/epsz point into the fine operator slot of rwork */
   double *epsy;  /**< Y-shifted dielectric map */
   double *epsz;  /**< Y-shifted dielectric map */
   double *kappa;  /**< Ion accessibility map (0 <= kappa(x) <= 1) */
@@ -166,6 +218,16 @@ struct sVpmg {
   Vchrg_Src chargeSrc;  /**< Charge source */
 
   int filled;  /**< Indicates whether Vpmg_fillco has been called */
+  int nsnap;  /**< Number of atoms in snap */
+  double *snap;  /**< Atoms as the coefficient arrays were last filled for
+                  * them, VPMGSNAP values each (see Vpmg_fillcoAtoms) */
+
+  int opsBuilt;  /**< Indicates whether iwork/rwork hold an operator
+                  * hierarchy kept for reuse (see Vpmgp::reuseops) */
+  uint64_t opsKey;  /**< Coefficient hash the kept hierarchy was built from */
+
+  int useGuess;  /**< Indicates whether u holds an initial guess for the
+                  * next Vpmg_solve (see Vpmg_setGuess) */
 
   int useDielXMap;  /**< Indicates whether Vpmg_fillco was called with an
                       external x-shifted dielectric map */
@@ -237,6 +299,10 @@ VEXTERNC Vpmg* Vpmg_ctor(
  *         previously-allocated memory)
  *  @author  Nathan Baker
  *  @ingroup Vpmg
+ *  @note    pmgOLD is destroyed once the boundary values and external
+ *           energies are taken from it, before the new grid arrays are
+ *           allocated; only a copy of its potential is kept for a warm
+ *           start (Vpmg_focusHandoff).
  *  @returns 1 if successful, 0 otherwise
  */
 VEXTERNC int Vpmg_ctor2(
@@ -298,6 +364,52 @@ VEXTERNC int Vpmg_fillco(
         Vgrid *chargeMap  /**< External charge map */
         );
 
+/** @brief   Update the coefficient arrays for a few changed atoms
+ *  @ingroup Vpmg
+ *  @returns  1 if successful, 0 otherwise
+ *  @note    For atoms of the Valist that were moved or given a new radius or
+ *           charge since the last Vpmg_fillco (or Vpmg_fillcoAtoms).  The
+ *           charge map is updated by taking out each atom's old charge and
+ *           putting in the new one.  The dielectric and kappa maps are
+ *           refilled only inside boxes around the old and new spheres of the
+ *           moved atoms, which gives the same maps as a full refill.  The
+ *           cell list and the cached SAS points of the moved atoms and their
+ *           neighbors are brought up to date first; the other SAS points
+ *           are reused.  The boundary values are recomputed, but the solute
+ *           summary of the Vpbe (used by bcfl sdh) is not.  Coefficients from
+ *           maps or spline surfaces are refilled in full.
+ */
+VEXTERNC int Vpmg_fillcoAtoms(
+        Vpmg *thee,  /**< Vpmg object filled by Vpmg_fillco */
+        int nchange,  /**< Number of changed atoms */
+        int *ichange  /**< Indices of the changed atoms in the Valist, each
+                       * listed once */
+        );
+
+/** @brief   Fill the coefficient arrays by patching those of a previous
+ *           calculation on a variant of the molecule
+ *  @ingroup Vpmg
+ *  @returns  1 if the arrays were filled, 0 if thee still needs Vpmg_fillco
+ *  @note    For scans over molecules with the same atoms in the same order,
+ *           a few of them moved or given a new radius or charge (titration
+ *           states, ligand poses).  The mesh, surface, charge method and
+ *           Vpbe parameters must match those of pmgOLD, which must have been
+ *           filled from the atoms alone with VSM_MOL or VSM_MOLSMOOTH, and at
+ *           most VPMGREUSEFRAC of the atoms may differ.  thee's Vpbe then
+ *           takes over the accessibility objects of pmgOLD's, with their
+ *           cached SAS points, and the maps of pmgOLD are copied and updated
+ *           with Vpmg_fillcoAtoms.  pmgOLD's Vpbe is left with accessibility
+ *           objects that do not match its atoms and should only be
+ *           destroyed; the two Valists keep their own atoms.
+ */
+VEXTERNC int Vpmg_fillcoFrom(
+        Vpmg *thee,  /**< Vpmg object */
+        Vpmg *pmgOLD,  /**< Filled Vpmg object of the previous calculation */
+        Vsurf_Meth surfMeth,  /**< Surface discretization method */
+        double splineWin,  /**< Spline window (in A) */
+        Vchrg_Meth chargeMeth  /**< Charge discretization method */
+        );
+
 /** @brief   Solve the PBE using PMG
  *  @ingroup Vpmg
  *  @author  Nathan Baker
@@ -307,6 +419,129 @@ VEXTERNC int Vpmg_solve(
         Vpmg *thee  /**< Vpmg object */
         );
 
+/** @brief   Solve the linearized PBE for several charge distributions with
+ *           one operator hierarchy
+ *  @ingroup Vpmg
+ *  @returns  1 if successful, 0 otherwise
+ *  @note    The right-hand sides share the dielectric and kappa maps of the
+ *           last Vpmg_fillco; each v-cycle of Vmvblk loads the operator of a
+ *           point once for all of them.  Needs a linear problem solved by
+ *           mg or cgmg (the block cycle is plain multigrid either way) with
+ *           assembled operators.  The potentials are not copied to
+ *           thee->u.
+ */
+VEXTERNC int Vpmg_solveBlock(
+        Vpmg *thee,  /**< Vpmg object */
+        int nrhs,  /**< Number of right-hand sides (at most VBLK_MAXRHS) */
+        double *charge,  /**< nrhs charge maps laid out as thee->charge,
+                          * one after another */
+        double *gxcf,  /**< nrhs x-face boundary blocks of 2*ny*nz, or VNULL
+                        * to use the boundary of thee for every map */
+        double *gycf,  /**< nrhs y-face blocks of 2*nx*nz (VNULL with
+                        * gxcf) */
+        double *gzcf,  /**< nrhs z-face blocks of 2*nx*ny (VNULL with
+                        * gxcf) */
+        double *pot  /**< Output: nrhs potential maps, one after another */
+        );
+
+/** @brief   Solve the linearized PBE for several charge maps with one
+ *           operator hierarchy and return their energies
+ *  @ingroup Vpmg
+ *  @returns  1 if successful, 0 otherwise
+ *  @note    The maps are discretized as for usemap charge and solved
+ *           together by Vpmg_solveBlock, with the boundary values of the
+ *           last Vpmg_fillco.  Each energy is the one Vpmg_energy returns
+ *           for that map alone; thee->u and thee->charge are left as they
+ *           were.
+ */
+VEXTERNC int Vpmg_solveMaps(
+        Vpmg *thee,  /**< Vpmg object */
+        int nmap,  /**< Number of charge maps (at most VBLK_MAXRHS) */
+        Vgrid *map[],  /**< Charge maps */
+        double *energy  /**< Output: nmap energies (kT) */
+        );
+
+/** @brief   Take over the operator hierarchy kept by a previous Vpmg object
+ *  @ingroup Vpmg
+ *  @returns  1 if the hierarchy was adopted, 0 otherwise
+ *  @note    Both objects must have been filled; the hierarchy is only taken
+ *           when the solver parameters match and the coefficients hash to
+ *           the same key, so that the next Vpmg_solve only rebuilds the
+ *           source term.  pmgOLD is left without a hierarchy.
+ */
+VEXTERNC int Vpmg_adoptOps(
+        Vpmg *thee,  /**< Vpmg object */
+        Vpmg *pmgOLD  /**< Filled Vpmg object whose hierarchy is taken */
+        );
+
+/** @brief   Free the fine-grid arrays of a finished calculation
+ *  @ingroup Vpmg
+ *  @note    Keeps only what Vpmg_adoptOps and Vpmg_setGuessPmg read from
+ *           an old object: the parameters, the work arrays and, if keepPot
+ *           is set, the potential u.  Called on the previous calculation
+ *           before the next one is constructed, so that both never hold
+ *           their coefficient maps at once; with an arena the freed
+ *           arrays are the ones the next calculation picks up.  Only
+ *           Vpmg_adoptOps, Vpmg_setGuessPmg and Vpmg_dtor may follow.
+ */
+VEXTERNC void Vpmg_releaseFine(
+        Vpmg *thee,  /**< Solved Vpmg object */
+        int keepPot  /**< 1 to keep u for a warm start, 0 to free it */
+        );
+
+/** @brief   Start the next solve from the given potential instead of zero
+ *  @ingroup Vpmg
+ *  @note    guess is a map on the grid of thee in the units of Vpmg::u; only
+ *           its interior is used since the boundary is fixed by the
+ *           Dirichlet data.  The guess only changes where the iteration
+ *           starts: the stopping tests are still relative to the right-hand
+ *           side.  It applies to the next Vpmg_solve only; VNULL withdraws
+ *           a pending guess.
+ */
+VEXTERNC void Vpmg_setGuess(
+        Vpmg *thee,  /**< Vpmg object */
+        double *guess  /**< Potential on the grid of thee, or VNULL */
+        );
+
+/** @brief   Start the next solve from a potential map on another grid
+ *  @ingroup Vpmg
+ *  @note    The map is interpolated trilinearly onto the grid points of
+ *           thee (see Vgrid_value); points outside of it start from zero.
+ *           @see Vpmg_setGuess
+ */
+VEXTERNC void Vpmg_setGuessGrid(
+        Vpmg *thee,  /**< Vpmg object */
+        Vgrid *grid  /**< Potential map in the units of Vpmg::u */
+        );
+
+/** @brief   Copy the potential of a Vpmg object into a stand-alone map
+ *  @ingroup Vpmg
+ *  @note    This is all a focused level keeps of its parent once the
+ *           boundary values and external energies are computed, so the
+ *           parent can be destroyed before the new grid arrays are
+ *           allocated.  @see Vpmg_setGuessGrid
+ *  @returns A new Vgrid that owns its data; free it with Vgrid_dtor
+ */
+VEXTERNC Vgrid* Vpmg_focusHandoff(
+        Vpmg *thee  /**< Vpmg object holding a solution */
+        );
+
+/** @brief   Start the next solve from the solution of another Vpmg object
+ *  @ingroup Vpmg
+ *  @note    Meant for a sequence of related problems (focusing, or the
+ *           frames of a trajectory), where the previous potential is
+ *           already close.  The grids may differ; an identical grid is
+ *           copied directly.  @see Vpmg_setGuessGrid
+ *  @note    Experimental.  Measured savings are modest and uneven: 22% of
+ *           the v-cycles for born apbs-mol-auto, 3% for hca-bind, none for
+ *           FKBP.  Since the stopping test is relative to the right-hand
+ *           side, energies also move within the solver tolerance.
+ */
+VEXTERNC void Vpmg_setGuessPmg(
+        Vpmg *thee,  /**< Vpmg object */
+        Vpmg *pmgOLD  /**< Solved Vpmg object */
+        );
+
 /** @brief   Solve Poisson's equation with a homogeneous Laplacian operator
  *           using the solvent dielectric constant.  This solution is
  *           performed by a sine wave decomposition.
@@ -339,6 +574,29 @@ VEXTERNC double Vpmg_energy(
                       * focusing domain */
         );
 
+/** @brief   Get the total electrostatic energy and its fixed charge,
+ *           mobile ion and dielectric parts in one pass over the grid
+ *  @ingroup Vpmg
+ *  @note    The components equal those of Vpmg_qfEnergy, Vpmg_qmEnergy
+ *           and Vpmg_dielEnergy, and the total that of Vpmg_energy.  The
+ *           grid is swept once by z-plane (in parallel with OpenMP) and the
+ *           plane sums are added in a fixed pairwise order, so the results
+ *           do not depend on the number of threads.
+ *  @returns The electrostatic energy in units of k_B T.
+ */
+VEXTERNC double Vpmg_energyComps(
+        Vpmg *thee,  /**< Vpmg object */
+        int extFlag,  /**< Include (1) or ignore (0) energy contributions
+                       * from outside the focusing domain; @see
+                       * Vpmg_energy */
+        double *qfEnergy,  /**< Set to the fixed charge energy (as
+                            * Vpmg_qfEnergy) */
+        double *qmEnergy,  /**< Set to the mobile charge energy (as
+                            * Vpmg_qmEnergy) */
+        double *dielEnergy  /**< Set to the dielectric energy (as
+                             * Vpmg_dielEnergy) */
+        );
+
 /** @brief   Get the "fixed charge" contribution to the electrostatic energy
  *
  *           Using the solution at the finest mesh level, get the
@@ -1023,6 +1281,33 @@ VPRIVATE double Vpmg_qfEnergyVolume(
                        result */
         );
 
+/**
+ * @brief  Sum the requested grid energies in one pass over the z-planes
+ * @note  The plane sums are combined with Vpmg_pairSum, so the energies do
+ *        not depend on the number of threads.  Each energy is scaled and
+ *        given its external contribution as in the single-component
+ *        functions; outputs of components not requested are untouched.
+ */
+VPRIVATE void Vpmg_energySweep(
+        Vpmg *thee,
+        int extFlag,  /** If 1, add external energy contributions */
+        int qfFlag,  /** If 1, sum the volume fixed charge energy */
+        int qmFlag,  /** 1 for the linear, 2 for the nonlinear mobile ion
+                       energy, 0 for none */
+        int dielFlag,  /** If 1, sum the dielectric energy */
+        double *qfEnergy,  /** Set to the fixed charge energy */
+        double *qmEnergy,  /** Set to the mobile ion energy */
+        double *dielEnergy  /** Set to the dielectric energy */
+        );
+
+/**
+ * @brief  Add up an array in a fixed pairwise order (overwrites it)
+ */
+VPRIVATE double Vpmg_pairSum(
+        double *a,  /** Values to add */
+        int n  /** Number of values */
+        );
+
 /**
 * @brief Selects a spline based surface method from either VSM_SPLINE,
  *        VSM_SPLINE5 or VSM_SPLINE7
@@ -1042,6 +1327,8 @@ VPRIVATE void Vpmg_splineSelect(
 /**
  * @brief  For focusing, fill in the boundaries of the new mesh based on the
  * potential values in the old mesh
+ * @note  Points that fall outside the old mesh are given multiple
+ *        Debye-Huckel values (mdhPoints) with a warning.
  * @author  Nathan Baker
  */
 VPRIVATE void focusFillBound(
@@ -1049,6 +1336,31 @@ VPRIVATE void focusFillBound(
         Vpmg *pmg  /** Old PMG object */
         );
 
+/**
+ * @brief  Trilinearly interpolate a potential grid at one point
+ * @returns  1 if the point lies on the grid (to within VSMALL), 0 otherwise
+ *           (uval is then untouched)
+ */
+VPRIVATE int focusInterp(
+        double *data,  /** Grid values */
+        int nx,  /** Number of grid points in x-direction */
+        int ny,  /** Number of grid points in y-direction */
+        int nz,  /** Number of grid points in z-direction */
+        double hx,  /** Grid spacing in x-direction */
+        double hy,  /** Grid spacing in y-direction */
+        double hz,  /** Grid spacing in z-direction */
+        double xmin,  /** Lower grid corner */
+        double ymin,  /** Lower grid corner */
+        double zmin,  /** Lower grid corner */
+        double xmax,  /** Upper grid corner */
+        double ymax,  /** Upper grid corner */
+        double zmax,  /** Upper grid corner */
+        double x,  /** Evaluation point */
+        double y,  /** Evaluation point */
+        double z,  /** Evaluation point */
+        double *uval  /** Set to the interpolated value */
+        );
+
 /**
  * @brief  Increment all boundary points by
  *         pre1*(charge/d)*(exp(-xkappa*(d-size))/(1+xkappa*size) to add the
@@ -1132,6 +1444,34 @@ VPRIVATE double bcfl1sp(
         double *pos  /** Function evaluation position */
         );
 
+/**
+ * @brief  Add the multiple Debye-Huckel potential of all atoms,
+ *         pre1*(charge/d)*(exp(-xkappa*(d-size))/(1+xkappa*size), to each
+ *         of a batch of points
+ * @note  Used by bcflnew for the boundary and by focusFillBound for points
+ *        off the old mesh.  Tiles of VPMGMDHTILE points go to Vmdh_simd
+ *        when vector kernels are available.
+ */
+VPRIVATE void mdhPoints(
+        Vpmg *thee,  /** PMG object (supplies the atoms and the PBE) */
+        int npts,  /** Number of points */
+        double *gx,  /** Point x-coordinates */
+        double *gy,  /** Point y-coordinates */
+        double *gz,  /** Point z-coordinates */
+        double *val  /** Potential values (accumulated into) */
+        );
+
+/**
+ * @brief  Fill the bcfl mdh boundary values with a treecode (Vdhtree)
+ * @note  Each atom is given the charge, dipole and quadrupole weights of
+ *        multipolebc, so the sum equals that of bcflnew (or
+ *        bcfl_mdh_tinker) to the relative accuracy Vpmgp::bctol.  The
+ *        faces are evaluated in VPMGBCTILE x VPMGBCTILE tiles.
+ */
+VPRIVATE void bcflTree(
+        Vpmg *thee
+        );
+
 /**
  * @brief  Fill boundary condition arrays
  * @author  Nathan Baker
@@ -1192,6 +1532,109 @@ VPRIVATE void fillcoCoefMolDielNoSmooth(
         Vpmg *thee
         );
 
+/**
+ * @brief  Reset the probe-accessible points of the molecular dielectric
+ *         arrays to the solvent value with a distance transform
+ *
+ *         Called by fillcoCoefMolDielNoSmooth once the solvent-inflated
+ *         spheres are marked.  A point is solvent if it lies within srad of
+ *         an unmarked (probe center) point of the same shifted grid, or of
+ *         the probe-accessible space between that point and the inflated
+ *         spheres.  Undecided points within a grid spacing of that band
+ *         are settled by edtContact; points further out are solute.  This
+ *         needs no SAS points, and gives the surface VSM_MOL tends to as
+ *         sdens grows.
+ * @ingroup  Vpmg
+ */
+VPRIVATE void fillcoCoefMolDielEDT(
+        Vpmg *thee
+        );
+
+/**
+ * @brief  Squared Euclidean distance and feature transform of a grid
+ *
+ *         Each value becomes min over grid points q of
+ *         (|x - x_q|^2 + f(q)), computed one axis at a time with the
+ *         lower-envelope-of-parabolas method of Felzenszwalb and
+ *         Huttenlocher, Theory of Computing 8 415-428 (2012).  Points set to
+ *         HUGE_VAL are not sources.
+ * @ingroup  Vpmg
+ */
+VPRIVATE void edtGrid(
+        double *f,  /** Grid values, transformed in place */
+        size_t *feat,  /** Index of each source point; set to the index of
+                         the minimizing source */
+        int nx,  /** Number of grid points */
+        int ny,  /** Number of grid points */
+        int nz,  /** Number of grid points */
+        double hx,  /** Grid spacing */
+        double hy,  /** Grid spacing */
+        double hzed  /** Grid spacing */
+        );
+
+/**
+ * @brief  One-dimensional squared distance and feature transform of a grid
+ *         line
+ * @ingroup  Vpmg
+ */
+VPRIVATE void edtLine(
+        double *f,  /** First value of the line, transformed in place */
+        size_t *feat,  /** First feature of the line, transformed in place */
+        size_t stride,  /** Distance between neighboring values of the line */
+        int n,  /** Number of values */
+        double h,  /** Grid spacing */
+        double *g,  /** Work space [n] */
+        size_t *gf,  /** Work space [n] */
+        int *v,  /** Work space [n] */
+        double *z  /** Work space [n] */
+        );
+
+/**
+ * @brief  Distance from a probe center outside the solvent-inflated
+ *         spheres to the nearest of them
+ * @ingroup  Vpmg
+ * @returns  The distance, limited to cap
+ */
+VPRIVATE double edtGap(
+        Vacc *acc,  /** Accessibility object */
+        double *pos,  /** Probe center */
+        double srad,  /** Probe radius */
+        double cap  /** Largest distance of interest */
+        );
+
+/**
+ * @brief  Whether a probe centered at c overlaps no atom but the skipped
+ *         ones
+ * @ingroup  Vpmg
+ * @returns  1 if the probe fits, 0 otherwise
+ */
+VPRIVATE int edtFits(
+        Vacc *acc,  /** Accessibility object */
+        double *c,  /** Probe center */
+        double srad,  /** Probe radius */
+        Vatom *skip1,  /** Atom the probe touches, or VNULL */
+        Vatom *skip2,  /** Atom the probe touches, or VNULL */
+        Vatom *skip3  /** Atom the probe touches, or VNULL */
+        );
+
+/**
+ * @brief  Whether a probe touching one, two or three atoms without
+ *         overlapping any reaches a point
+ *
+ *         Tries the nearest probe centers on the SAS: the projection onto
+ *         each inflated sphere, onto each circle where two of them meet and
+ *         the points where three of them meet.  Only atoms whose inflated
+ *         surface is within srad of the point take part, at most
+ *         VPMGEDTNEAR of them.
+ * @ingroup  Vpmg
+ * @returns  1 if the point is solvent, 0 otherwise
+ */
+VPRIVATE int edtContact(
+        Vacc *acc,  /** Accessibility object */
+        double *pos,  /** Grid point */
+        double srad  /** Probe radius */
+        );
+
 /**
  * @brief  Fill differential operator coefficient arrays from a molecular
  *         surface calculation with smoothing.
@@ -1209,6 +1652,18 @@ VPRIVATE void fillcoCoefMolDielSmooth(
         Vpmg *thee
         );
 
+/**
+ * @brief  Smooth the dielectric arrays inside a box of grid points
+ * @ingroup  Vpmg
+ * @note   Reads the unsmoothed values from thee->a1cf, thee->a2cf and
+ *         thee->a3cf, which must be filled one point beyond the box.
+ */
+VPRIVATE void fillcoCoefMolDielSmoothBox(
+        Vpmg *thee,
+        int *lo,  /** Lowest grid indices of the box */
+        int *hi  /** Highest grid indices of the box */
+        );
+
 /**
  * @brief  Fill operator coefficient arrays from a spline-based surface
  *         calculation
@@ -1254,6 +1709,16 @@ VPRIVATE Vrc_Codes fillcoChargeMap(
         Vpmg *thee
         );
 
+/**
+ * @brief  Fill a source term array from a charge map
+ * @returns  Success/failure status
+ */
+VPRIVATE Vrc_Codes fillcoChargeGrid(
+        Vpmg *thee,
+        Vgrid *map,  /**< Charge map */
+        double *charge  /**< Output: source term on the mesh of thee */
+        );
+
 /**
  * @brief  Fill source term charge array from linear interpolation
  * @author  Nathan Baker
@@ -1377,12 +1842,91 @@ VPRIVATE void markSphere(
         double markVal  /** Value to mark with */
         );
 
+/**
+ * @brief  Mark the grid points of a sphere that lie in the z-planes k0..k1
+ * @ingroup  Vpmg
+ * @note  Marks exactly the points markSphere marks in those planes, so a
+ *        sphere split over several slabs gives the same result as one call
+ */
+VPRIVATE void markSphereSlab(
+        double rtot,  /** Sphere radius */
+        double *tpos,  /** Sphere position */
+        int nx,  /** Number of grid points */
+        int ny,  /** Number of grid points */
+        int nz,  /** Number of grid points */
+        double hx,  /** Grid spacing */
+        double hy,  /** Grid spacing */
+        double hzed,  /** Grid spacing */
+        double xmin,  /** Grid lower corner */
+        double ymin,  /** Grid lower corner */
+        double zmin,  /** Grid lower corner */
+        int k0,  /** First z-plane to mark */
+        int k1,  /** Last z-plane to mark */
+        double *array,  /** Grid values */
+        double markVal  /** Value to mark with */
+        );
+
+/**
+ * @brief  Mark the grid points of a sphere that lie in a box of grid points
+ * @ingroup  Vpmg
+ * @note  Marks exactly the points markSphere marks in the box
+ */
+VPRIVATE void markSphereBox(
+        double rtot,  /** Sphere radius */
+        double *tpos,  /** Sphere position */
+        int nx,  /** Number of grid points */
+        int ny,  /** Number of grid points */
+        int nz,  /** Number of grid points */
+        double hx,  /** Grid spacing */
+        double hy,  /** Grid spacing */
+        double hzed,  /** Grid spacing */
+        double xmin,  /** Grid lower corner */
+        double ymin,  /** Grid lower corner */
+        double zmin,  /** Grid lower corner */
+        int *lo,  /** Lowest grid indices of the box */
+        int *hi,  /** Highest grid indices of the box */
+        double *array,  /** Grid values */
+        double markVal  /** Value to mark with */
+        );
+
+/**
+ * @brief  Sort objects into the z-slabs of VPMGMARKSLAB planes they touch
+ * @ingroup  Vpmg
+ * @returns  Object indices, slab by slab and in increasing order within a
+ *           slab (slab s holds entries start[s]..start[s+1]-1); free with
+ *           Vmem_free(vmem, start[nslab], sizeof(int), ...)
+ */
+VPRIVATE int* binSlabs(
+        Vmem *vmem,  /** Memory management object for the result */
+        int nobj,  /** Number of objects */
+        int *klo,  /** First z-plane touched by each object */
+        int *khi,  /** Last z-plane touched by each object (khi < klo for
+                     objects that touch none) */
+        int nslab,  /** Number of slabs */
+        int *start  /** Set to the slab offsets into the result [nslab+1] */
+        );
+
 /**
  * @brief Vpmg_qmEnergy for SMPBE
  * @author Vincent Chu
  */
 VPRIVATE double Vpmg_qmEnergySMPBE(Vpmg *thee, int extFlag);
 VPRIVATE double Vpmg_qmEnergyNONLIN(Vpmg *thee, int extFlag);
+VPRIVATE uint64_t Vpmg_coefKey(Vpmg *thee);
+VPRIVATE double* Vpmg_gridMalloc(Vpmg *thee, size_t num);
+VPRIVATE void Vpmg_firstTouch(Vpmg *thee, double *ram, size_t num);
+VPRIVATE void Vpmg_gridFree(Vpmg *thee, size_t num, double **ram);
+VPRIVATE void Vpmg_fillSolve(Vpmg *thee, int fillRHS);
+VPRIVATE void Vpmg_printPages(Vpmg *thee);
+VPRIVATE void Vpmg_snapAtoms(Vpmg *thee);
+VPRIVATE void Vpmg_tradeAcc(Vpbe *pbe, Vpbe *pbeOLD);
+VPRIVATE void fillcoMesh(Vpmg *thee);
+VPRIVATE int Vpmg_onMesh(Vpmg *thee, double *pos, double pad);
+VPRIVATE void chargeSpline1(Vpmg *thee, double *apos, double charge);
+VPRIVATE void chargeSpline2(Vpmg *thee, double *apos, double charge);
+VPRIVATE void fillcoCoefMolDielBox(Vpmg *thee, int *lo, int *hi,
+                                   double *ex, double *ey, double *ez);
+VPRIVATE void fillcoCoefMolIonBox(Vpmg *thee, int *lo, int *hi);
 
 
 
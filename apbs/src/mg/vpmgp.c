@@ -151,6 +151,54 @@ value: %g \n", thee->errtol);
 
     /* Default value for all APBS runs */
     thee->mgsmoo = 1;
+    if (mgparm->setmgsmoo) thee->mgsmoo = mgparm->mgsmoo;
+    if (mgparm->setmgdisc) thee->mgdisc = mgparm->mgdisc;
+    thee->mgprec = 0;
+    if (mgparm->setmgprec) thee->mgprec = mgparm->mgprec;
+    if ((thee->mgdisc == 2) && ((thee->nlev < 2) || (thee->mgprol != 0) ||
+        (thee->mgcoar != 2))) {
+        /* The matrix-free fine operator is only read by the smoother,
+         * residual and Galerkin setup; anything else needs it assembled */
+        Vnm_print(2, "Vpmgp_ctor2:  Matrix-free operator needs nlev > 1, \
+trilinear prolongation and Galerkin coarsening; using mgdisc = 0\n");
+        thee->mgdisc = 0;
+    }
+    if ((thee->mgprec == 1) && ((thee->nonlin != NONLIN_LPBE) ||
+        (thee->meth != VSOL_MG) || (thee->mgsmoo != 1) ||
+        (thee->mgdisc == 2) || (thee->nlev < 2))) {
+        /* The single-precision v-cycle only implements the linear box
+         * operator with red/black Gauss-Seidel */
+        Vnm_print(2, "Vpmgp_ctor2:  Mixed precision needs the linear PBE, \
+the mg solver, mgsmoo gs, an assembled operator and nlev > 1; using double \
+precision\n");
+        thee->mgprec = 0;
+    }
+    if (mgparm->setmgkey) thee->mgkey = mgparm->mgkey;
+    if ((thee->mgkey == 1) && ((thee->nonlin != NONLIN_LPBE) ||
+        (thee->meth != VSOL_MG) || (thee->mgprec != 0) || (thee->nlev < 2))) {
+        /* Only the linear double-precision v-cycle has a nested iteration
+         * start (Vfmvcs) */
+        Vnm_print(2, "Vpmgp_ctor2:  Nested iteration needs the linear PBE, \
+the mg solver, double precision and nlev > 1; using v-cycles\n");
+        thee->mgkey = 0;
+    }
+    thee->reuseops = 0;
+    if (mgparm->setreuseops) thee->reuseops = mgparm->reuseops;
+    if (thee->reuseops && ((thee->nonlin != NONLIN_LPBE) ||
+        ((thee->meth != VSOL_MG) && (thee->meth != VSOL_CGMG)))) {
+        /* Newton rebuilds the Jacobian hierarchy every step */
+        Vnm_print(2, "Vpmgp_ctor2:  Operator reuse needs the linear PBE and \
+the mg or cgmg solver; rebuilding operators for every solve\n");
+        thee->reuseops = 0;
+    }
+    thee->inewt = 0;
+    thee->arena = VNULL;
+    thee->pagemap = 0;
+    if (mgparm->setpagemap) thee->pagemap = mgparm->pagemap;
+    thee->bctol = 0.0;
+    if (mgparm->setbctol) thee->bctol = mgparm->bctol;
+    thee->simd = -1;
+    if (mgparm->setsimd) thee->simd = mgparm->simd;
     if (thee->nonlin == NONLIN_NPBE || thee->nonlin == NONLIN_SMPBE) {
         /* SMPBE Added - SMPBE needs to mimic NPBE */
         Vnm_print(0, "Vpmp_ctor2:  Using meth = 1, mgsolv = 0\n");
@@ -159,6 +207,11 @@ value: %g \n", thee->errtol);
         /* Most rigorous (good for testing) */
         Vnm_print(0, "Vpmp_ctor2:  Using meth = 2, mgsolv = 1\n");
         thee->mgsolv = 1;
+        if (mgparm->setmgsolv) thee->mgsolv = mgparm->mgsolv;
+    }
+    if (mgparm->setmgsolv && (thee->mgsolv != mgparm->mgsolv)) {
+        Vnm_print(2, "Vpmgp_ctor2:  Nonlinear problems use the iterative \
+coarse solver; ignoring mgsolv %d\n", mgparm->mgsolv);
     }
 
     /* TEMPORARY USEAQUA */
@@ -228,6 +281,9 @@ VPUBLIC void Vpmgp_size(
     case 0:
         num_nf_oper = 4;
         break;
+    case 2:
+        num_nf_oper = 3;
+        break;
     case 1:
         num_nf_oper = 14;
         break;
@@ -239,15 +295,15 @@ VPUBLIC void Vpmgp_size(
     /* Galerkin or standard coarsening? */
     switch (thee->mgcoar) { /* NAB TO-DO:  This needs to be changed into an enumeration */
     case 0:
-        if (thee->mgdisc != 0) {
-            Vnm_print(2, "Vpmgp_size:  Invalid mgcoar value (%d); must be used with mgdisc 0!\n", thee->mgcoar);
+        if (thee->mgdisc == 1) {
+            Vnm_print(2, "Vpmgp_size:  Invalid mgcoar value (%d); must be used with mgdisc 0 or 2!\n", thee->mgcoar);
             VASSERT(0);
         }
         num_narrc_oper = 4;
         break;
     case 1:
-        if (thee->mgdisc != 0) {
-            Vnm_print(2, "Vpmgp_size:  Invalid mgcoar value (%d); must be used with mgdisc 0!\n", thee->mgcoar);
+        if (thee->mgdisc == 1) {
+            Vnm_print(2, "Vpmgp_size:  Invalid mgcoar value (%d); must be used with mgdisc 0 or 2!\n", thee->mgcoar);
             VASSERT(0);
         }
         num_narrc_oper = 14;
@@ -266,7 +322,7 @@ VPUBLIC void Vpmgp_size(
         n_band = 0;
         break;
     case 1:
-        if ( ( (thee->mgcoar == 0) || (thee->mgcoar == 1)) && (thee->mgdisc == 0) ) {
+        if ( ( (thee->mgcoar == 0) || (thee->mgcoar == 1)) && (thee->mgdisc != 1) ) {
             num_band = 1 + (thee->nxc-2)*(thee->nyc-2);
         } else {
             num_band = 1 + (thee->nxc-2)*(thee->nyc-2) + (thee->nxc-2) + 1;
@@ -274,6 +330,10 @@ VPUBLIC void Vpmgp_size(
         nc_band = (thee->nxc-2)*(thee->nyc-2)*(thee->nzc-2);
         n_band  = nc_band * num_band;
         break;
+    case 2:
+        /* The sparse factor is allocated by Eigen, outside rwork */
+        n_band = 0;
+        break;
     default:
         Vnm_print(2, "Vpmgp_size:  Invalid mgsolv value (%d)!\n", thee->mgsolv);
         VASSERT(0);
@@ -285,6 +345,19 @@ VPUBLIC void Vpmgp_size(
     /* Resulting total required for real storage */
     thee->nrwk = num_narr*thee->narr + (size_t)(num_nf + num_nf_oper)*thee->nf + (size_t)(num_narrc + num_narrc_oper)*thee->narrc + n_band + thee->n_rpc;
 
+    /* Single-precision fine operator, two floats per double, when it does
+     * not fit in the coarse fc and pc (see Vmixsz) */
+    if ((thee->mgprec == 1) &&
+        ((size_t)num_nf_oper*thee->nf > (size_t)29*thee->narrc)) {
+        thee->nrwk += ((size_t)num_nf_oper*thee->nf + 1) / 2;
+    }
+
+    /* Krylov vectors of the inexact Newton solves: r, p and ap on the fine
+     * level and a multilevel preconditioned residual */
+    if (thee->inewt == 1) {
+        thee->nrwk += (size_t)3*thee->nf + thee->narr;
+    }
+
     /* Integer storage parameters */
     thee->n_iz = 50*(thee->nlev+1);
     thee->n_ipc = 100*(thee->nlev+1);
@@ -70,6 +70,7 @@
 
 #include "generic/vhal.h"
 #include "generic/mgparm.h"
+#include "mg/varena.h"
 
 /**
  *  @ingroup Vpmgp
@@ -142,7 +143,8 @@ struct sVpmgp {
                  * \li   2: spectral radius
                  * \li   3: cond. number & spectral radius */
     int meth;  /**< Solution method [default = 2]
-                * \li   0: conjugate gradient multigrid
+                * \li   0: conjugate gradient multigrid (linear only; CG
+                *          preconditioned by one symmetric v-cycle)
                 * \li   1: newton
                 * \li   2: multigrid
                 * \li   3: conjugate gradient
@@ -154,7 +156,10 @@ struct sVpmgp {
                 * \li   9: newton aqua */
     int mgkey;  /**< Multigrid method [default = 0]
                  * \li   0: variable v-cycle
-                 * \li   1: nested iteration */
+                 * \li   1: nested iteration (full multigrid: solve on the
+                 *          coarsest level, then interpolate and v-cycle on
+                 *          each finer level before cycling on the finest;
+                 *          linear PBE with the mg solver only) */
     int nu1;  /**< Number of pre-smoothings [default = 2] */
     int nu2;  /**< Number of post-smoothings [default = 2] */
     int mgsmoo;  /**< Smoothing method [default = 1]
@@ -162,7 +167,10 @@ struct sVpmgp {
                   * \li   1: gauss-seidel
                   * \li   2: SOR
                   * \li   3: richardson
-                  * \li   4: cghs */
+                  * \li   4: cghs
+                  * \li   5: multicolor gauss-seidel (race-free under
+                  *            OpenMP for 27-point operators)
+                  * \li   6: Jacobi-preconditioned Chebyshev */
     int mgprol;  /**< Prolongation method [default = 0]
                   * \li   0: trilinear
                   * \li   1: operator-based
@@ -173,10 +181,39 @@ struct sVpmgp {
                   * \li   2: galerkin */
     int mgsolv;  /**< Coarse equation solve method [default = 1]
                   * \li   0: cghs
-                  * \li   1: banded linpack */
+                  * \li   1: banded linpack
+                  * \li   2: sparse Cholesky (Eigen) */
     int mgdisc;  /**< Discretization method [default = 0]
                   * \li   0: finite volume
-                  * \li   1: finite element */
+                  * \li   1: finite element
+                  * \li   2: finite volume, matrix-free on the finest level
+                  *            (the stencil is read from the dielectric
+                  *            maps; coarse levels stay assembled) */
+    int mgprec;  /**< Precision of the linear multigrid solve [default = 0]
+                  * \li   0: double
+                  * \li   1: single-precision v-cycles inside double-precision
+                  *            iterative refinement (meth 2, LPBE only) */
+    int reuseops;  /**< Keep the operator hierarchy for the next solve on
+                    * the same coefficients [default = 0]; LPBE with meth 0
+                    * or 2 only */
+    int inewt;  /**< Newton variant for meth 1 [default = 0]
+                 * \li   0: Jacobian solves by v-cycles to a tight absolute
+                 *          tolerance
+                 * \li   1: inexact Newton-Krylov: MG-preconditioned CG to
+                 *          an Eisenstat-Walker relative tolerance */
+    Varena *arena;  /**< Arena the Vpmg grid arrays are taken from and
+                     * given back to [default = VNULL: plain Vmem] */
+    int pagemap;  /**< Print the NUMA node placement of the grid arrays after
+                   * each solve [default = 0] */
+    double bctol;  /**< Relative accuracy of the bcfl mdh boundary values;
+                    * above 0 they come from a treecode (Vdhtree) instead
+                    * of a sum over every atom [default = 0] */
+    int simd;  /**< Highest instruction set for the vectorized kernels,
+                * capped at what the processor supports [default = -1]
+                * \li  -1: the detected level
+                * \li   0: scalar loops only
+                * \li   1: AVX2
+                * \li   2: AVX-512 */
     double omegal;  /**< Linear relax parameter [default = 8e-1] */
     double omegan;  /**< Nonlin relax parameter [default = 9e-1] */
     int irite;  /**< FORTRAN output unit [default = 8] */
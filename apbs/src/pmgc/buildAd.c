@@ -72,6 +72,18 @@ VPUBLIC void VbuildA(int* nx, int* ny, int* nz,
                 a1cf, a2cf, a3cf,
                 ccf, fcf);
 
+    } else if (*mgdisc == 2) {
+
+        // The operator slot already holds the dielectric faces
+        VbuildA_mf(nx, ny, nz,
+                ipkey, numdia,
+                ipc, rpc,
+                cc, fc,
+                RAT2(ac, 1,1), RAT2(ac, 1,2), RAT2(ac, 1,3),
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                ccf, fcf);
+
     } else if (*mgdisc == 1) {
 
         VbuildA_fe(nx, ny, nz,
@@ -167,6 +179,8 @@ VPUBLIC void VbuildA_fv(int *nx, int *ny, int *nz,
     // Note how many nonzeros in this discretization stencil
     VAT(ipc, 11) = 7;
     VAT(ipc, 12) = 1;
+    VAT(ipc, 13) = 0;
+    VAT(ipc, 14) = 0;
     *numdia = 4;
 
     // Define n and determine number of mesh points
@@ -277,6 +291,215 @@ VPUBLIC void VbuildA_fv(int *nx, int *ny, int *nz,
 
 
 
+VPUBLIC void VbuildA_mf(int *nx, int *ny, int *nz,
+        int *ipkey, int *numdia,
+        int *ipc, double *rpc,
+        double *cc, double *fc,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *xf, double *yf, double *zf,
+        double *gxcf, double *gycf, double *gzcf,
+        double *ccf,  double *fcf) {
+
+    int i, j, k;
+
+    double hx, hy, hz;
+    double hxm1, hym1, hzm1;
+
+    double coef_fc;
+    double diag;
+
+    MAT3(  cc, *nx, *ny, *nz);
+    MAT3( ccf, *nx, *ny, *nz);
+
+    // Save the problem key with this operator
+    VAT(ipc, 10) = *ipkey;
+
+    // Still a 7-point stencil, but only the dielectric faces are kept
+    VAT(ipc, 11) = 7;
+    VAT(ipc, 12) = 1;
+    VAT(ipc, 13) = 1;
+    VAT(ipc, 14) = 0;
+    *numdia = 3;
+
+    // Same scaling as VbuildA_fv
+    diag = 1.0;
+
+    /* Face scalings, as VbuildA_fv forms them at the first interior point;
+     * the mesh is uniform, so they hold everywhere */
+    hxm1 = VAT(xf, 2) - VAT(xf, 1);
+    hx   = VAT(xf, 3) - VAT(xf, 2);
+    hym1 = VAT(yf, 2) - VAT(yf, 1);
+    hy   = VAT(yf, 3) - VAT(yf, 2);
+    hzm1 = VAT(zf, 2) - VAT(zf, 1);
+    hz   = VAT(zf, 3) - VAT(zf, 2);
+    VAT(rpc, 2) = diag * (hym1 + hy) * (hzm1 + hz) / (4.0 * hx);
+    VAT(rpc, 3) = diag * (hxm1 + hx) * (hzm1 + hz) / (4.0 * hy);
+    VAT(rpc, 4) = diag * (hxm1 + hx) * (hym1 + hy) / (4.0 * hz);
+
+    // Helmholtz term
+    for (k=2; k<=*nz-1; k++) {
+
+        hzm1 = VAT(zf, k)   - VAT(zf, k-1);
+        hz   = VAT(zf, k+1) - VAT(zf, k);
+
+        for (j=2; j<=*ny-1; j++) {
+
+            hym1 = VAT(yf, j)   - VAT(yf, j-1);
+            hy   = VAT(yf, j+1) - VAT(yf, j);
+
+            for (i=2; i<=*nx-1; i++) {
+
+                hxm1 = VAT(xf, i)   - VAT(xf, i-1);
+                hx   = VAT(xf, i+1) - VAT(xf, i);
+
+                coef_fc = diag * (hxm1 + hx) * (hym1 + hy) * (hzm1 + hz) / 8.0;
+                VAT3(cc, i, j, k) = coef_fc * VAT3(ccf, i, j, k);
+            }
+        }
+    }
+
+    // Source term with the Dirichlet boundary contributions
+    VbuildF(nx, ny, nz, fc,
+            xf, yf, zf,
+            gxcf, gycf, gzcf,
+            a1cf, a2cf, a3cf,
+            fcf);
+}
+
+
+
+VPUBLIC void VexpandA_mf(int *nx, int *ny, int *nz,
+        int *k0, int *nzw, double *rpc,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *oC, double *oE, double *oN, double *uC) {
+
+    int i, j, k, kw;
+    double sE, sN, sU;
+    double aE, aW, aN, aS, aU, aD;
+
+    MAT3(a1cf, *nx, *ny, *nz);
+    MAT3(a2cf, *nx, *ny, *nz);
+    MAT3(a3cf, *nx, *ny, *nz);
+    MAT3(  oC, *nx, *ny, *nzw);
+    MAT3(  oE, *nx, *ny, *nzw);
+    MAT3(  oN, *nx, *ny, *nzw);
+    MAT3(  uC, *nx, *ny, *nzw);
+
+    sE = VAT(rpc, 2);
+    sN = VAT(rpc, 3);
+    sU = VAT(rpc, 4);
+
+    // Start from zero so the boundary layers match VbuildA_fv
+    Vazeros(nx, ny, nzw, oC);
+    Vazeros(nx, ny, nzw, oE);
+    Vazeros(nx, ny, nzw, oN);
+    Vazeros(nx, ny, nzw, uC);
+
+    // The same sums as Vmatvec7_mf, so both see one operator
+    #pragma omp parallel for private(i, j, k, kw, aE, aW, aN, aS, aU, aD)
+    for (kw=1; kw<=*nzw; kw++) {
+        k = *k0 + kw - 1;
+        if ((k < 2) || (k > *nz-1))
+            continue;
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+                aE = sE * VAT3(a1cf,   i,   j,   k);
+                aW = sE * VAT3(a1cf, i-1,   j,   k);
+                aN = sN * VAT3(a2cf,   i,   j,   k);
+                aS = sN * VAT3(a2cf,   i, j-1,   k);
+                aU = sU * VAT3(a3cf,   i,   j,   k);
+                aD = sU * VAT3(a3cf,   i,   j, k-1);
+                VAT3(oC, i, j, kw) = aE + aW + aN + aS + aU + aD;
+                if (i < *nx-1)
+                    VAT3(oE, i, j, kw) = aE;
+                if (j < *ny-1)
+                    VAT3(oN, i, j, kw) = aN;
+                if (k < *nz-1)
+                    VAT3(uC, i, j, kw) = aU;
+            }
+        }
+    }
+}
+
+
+
+VPUBLIC void VbuildF(int *nx, int *ny, int *nz,
+        double *fc,
+        double *xf, double *yf, double *zf,
+        double *gxcf, double *gycf, double *gzcf,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *fcf) {
+
+    int i, j, k;
+    int nxm1, nym1, nzm1;
+
+    double hx, hy, hz;
+    double hxm1, hym1, hzm1;
+
+    double coef_fc;
+    double diag;
+
+    MAT3(  fc, *nx, *ny, *nz);
+    MAT3( fcf, *nx, *ny, *nz);
+    MAT3(a1cf, *nx, *ny, *nz);
+    MAT3(a2cf, *nx, *ny, *nz);
+    MAT3(a3cf, *nx, *ny, *nz);
+    MAT3(gxcf, *ny, *nz,   2);
+    MAT3(gycf, *nx, *nz,   2);
+    MAT3(gzcf, *nx, *ny,   2);
+
+    nxm1 = *nx - 1;
+    nym1 = *ny - 1;
+    nzm1 = *nz - 1;
+
+    // Same scaling as VbuildA_fv
+    diag = 1.0;
+
+    for (k=2; k<=*nz-1; k++) {
+
+        hzm1 = VAT(zf, k)   - VAT(zf, k-1);
+        hz   = VAT(zf, k+1) - VAT(zf, k);
+
+        for (j=2; j<=*ny-1; j++) {
+
+            hym1 = VAT(yf, j)   - VAT(yf, j-1);
+            hy   = VAT(yf, j+1) - VAT(yf, j);
+
+            for (i=2; i<=*nx-1; i++) {
+
+                hxm1 = VAT(xf, i)   - VAT(xf, i-1);
+                hx   = VAT(xf, i+1) - VAT(xf, i);
+
+                coef_fc = diag * (hxm1 + hx) * (hym1 + hy) * (hzm1 + hz) / 8.0;
+                VAT3(fc, i, j, k) = coef_fc * VAT3(fcf, i, j, k);
+
+                /* Dirichlet boundary contributions, added in the order of
+                 * VbuildA_fv so the result is the same to the last bit */
+                if (i == nxm1)
+                    VAT3(fc, i, j, k) += diag * (hym1 + hy) * (hzm1 + hz) / (4.0 * hx)
+                        * VAT3(a1cf, i, j, k) * VAT3(gxcf, j, k, 2);
+                if (j == nym1)
+                    VAT3(fc, i, j, k) += diag * (hxm1 + hx) * (hzm1 + hz) / (4.0 * hy)
+                        * VAT3(a2cf, i, j, k) * VAT3(gycf, i, k, 2);
+                if (k == nzm1)
+                    VAT3(fc, i, j, k) += diag * (hxm1 + hx) * (hym1 + hy) / (4.0 * hz)
+                        * VAT3(a3cf, i, j, k) * VAT3(gzcf, i, j, 2);
+                if (i == 2)
+                    VAT3(fc, i, j, k) += diag * (hym1 + hy) * (hzm1 + hz) / (4.0 * hxm1)
+                        * VAT3(a1cf, i-1, j, k) * VAT3(gxcf, j, k, 1);
+                if (j == 2)
+                    VAT3(fc, i, j, k) += diag * (hxm1 + hx) * (hzm1 + hz) / (4.0 * hym1)
+                        * VAT3(a2cf, i, j-1, k) * VAT3(gycf, i, k, 1);
+                if (k == 2)
+                    VAT3(fc, i, j, k) += diag * (hxm1 + hx) * (hym1 + hy) / (4.0 * hzm1)
+                        * VAT3(a3cf, i, j, k-1) * VAT3(gzcf, i, j, 1);
+            }
+        }
+    }
+}
+
+
+
 VPUBLIC void VbuildA_fe(int *nx, int *ny, int *nz,
         int *ipkey, int *numdia,
         int *ipc, double *rpc,
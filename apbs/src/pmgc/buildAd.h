@@ -55,6 +55,7 @@
 
 #include "generic/vhal.h"
 #include "generic/vmatrix.h"
+#include "pmgc/mikpckd.h"
 
 /** @brief   Break the matrix data-structure into diagonals and then call the
  *           matrix build routine
@@ -186,6 +187,89 @@ VEXTERNC void VbuildA_fv(
         );
 
 
+/** @brief   Matrix-free variant of the box method discretization
+ *  @ingroup PMGC
+ *
+ *  Same discretization as VbuildA_fv on a uniform mesh, but no stencil is
+ *  stored: the operator slot of the fine level holds the dielectric faces
+ *  themselves (the caller keeps epsx, epsy and epsz there), and
+ *  Vmatvec7_mf, Vmresid7_mf and Vgsrb7_mf rebuild the stencil from them on
+ *  the fly.  Only the face scalings are saved, in rpc(2:4), together with
+ *  cc and fc.  Marks the operator with ipc(13) = 1 and returns numdia = 3.
+ */
+VEXTERNC void VbuildA_mf(
+        int*    nx,     /**< @todo:Doc */
+        int*    ny,     /**< @todo:Doc */
+        int*    nz,     /**< @todo:Doc */
+        int*    ipkey,  /**< @todo:Doc */
+        int*    numdia, /**< @todo:Doc */
+        int*    ipc,    /**< @todo:Doc */
+        double* rpc,    /**< @todo:Doc */
+        double* cc,     /**< @todo:Doc */
+        double* fc,     /**< @todo:Doc */
+        double* a1cf,   /**< Dielectric on the x-shifted mesh (not modified) */
+        double* a2cf,   /**< Dielectric on the y-shifted mesh (not modified) */
+        double* a3cf,   /**< Dielectric on the z-shifted mesh (not modified) */
+        double* xf,     /**< @todo:Doc */
+        double* yf,     /**< @todo:Doc */
+        double* zf,     /**< @todo:Doc */
+        double* gxcf,   /**< @todo:Doc */
+        double* gycf,   /**< @todo:Doc */
+        double* gzcf,   /**< @todo:Doc */
+        double* ccf,    /**< @todo:Doc */
+        double* fcf     /**< @todo:Doc */
+        );
+
+/** @brief   Assemble a band of z-planes of a matrix-free operator
+ *  @ingroup PMGC
+ *
+ *  Writes the 7-point diagonals VbuildA_fv would hold for planes k0 to
+ *  k0+nzw-1 of the nx x ny x nz grid into arrays of nzw planes, zero on
+ *  the box boundary.  Lets the Galerkin setup work through the fine level
+ *  a band at a time.
+ */
+VEXTERNC void VexpandA_mf(
+        int*    nx,     /**< @todo:Doc */
+        int*    ny,     /**< @todo:Doc */
+        int*    nz,     /**< @todo:Doc */
+        int*    k0,     /**< First plane of the band */
+        int*    nzw,    /**< Number of planes in the band */
+        double* rpc,    /**< Face scalings from VbuildA_mf in rpc(2:4) */
+        double* a1cf,   /**< Dielectric on the x-shifted mesh */
+        double* a2cf,   /**< Dielectric on the y-shifted mesh */
+        double* a3cf,   /**< Dielectric on the z-shifted mesh */
+        double* oC,     /**< Assembled diagonal of the band */
+        double* oE,     /**< Assembled east neighbor of the band */
+        double* oN,     /**< Assembled north neighbor of the band */
+        double* uC      /**< Assembled up neighbor of the band */
+        );
+
+/** @brief   Rebuild only the fine grid source term fc of VbuildA
+ *  @ingroup PMGC
+ *
+ *  Scales fcf and adds the Dirichlet boundary contributions exactly as
+ *  VbuildA_fv and VbuildA_mf do, leaving the operator untouched.  Used
+ *  when the operator hierarchy of an earlier solve is reused for a new
+ *  right-hand side.
+ */
+VEXTERNC void VbuildF(
+        int*    nx,     /**< @todo:Doc */
+        int*    ny,     /**< @todo:Doc */
+        int*    nz,     /**< @todo:Doc */
+        double* fc,     /**< Fine grid source term (output) */
+        double* xf,     /**< @todo:Doc */
+        double* yf,     /**< @todo:Doc */
+        double* zf,     /**< @todo:Doc */
+        double* gxcf,   /**< @todo:Doc */
+        double* gycf,   /**< @todo:Doc */
+        double* gzcf,   /**< @todo:Doc */
+        double* a1cf,   /**< @todo:Doc */
+        double* a2cf,   /**< @todo:Doc */
+        double* a3cf,   /**< @todo:Doc */
+        double* fcf     /**< @todo:Doc */
+        );
+
+
 /** @brief  Finite element method discretization
  *
  *    Finite element method discretization of a 3d pde on a
@@ -56,6 +56,12 @@
 #include "generic/vhal.h"
 #include "generic/vmatrix.h"
 
+/** @brief Coarse z-planes per thread work unit in VbuildG_7/VbuildG_27 */
+#define VBUILDG_KBLK 4
+
+/** @brief Coarse y-lines per cache tile in VbuildG_7/VbuildG_27 */
+#define VBUILDG_JBLK 8
+
 VEXTERNC void VbuildG(
         int    *nxf,    ///< @todo: doc
         int    *nyf,    ///< @todo: doc
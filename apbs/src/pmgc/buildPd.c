@@ -72,7 +72,9 @@ VPUBLIC void VbuildP(int *nxf, int *nyf, int *nzf,
 
         numdia = VAT(ipc, 11);
 
-        if (numdia == 7) {
+        if (numdia == 7 && VAT(ipc, 13) == 1) {
+            VABORT_MSG0("Operator-based prolongation needs an assembled fine operator");
+        } else if (numdia == 7) {
             VbuildP_op7(nxf, nyf, nzf,
                     nxc, nyc, nzc,
                     ipc, rpc,
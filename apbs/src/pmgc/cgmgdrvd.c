@@ -0,0 +1,489 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Driver for the multigrid-preconditioned conjugate gradient solver
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#include "cgmgdrvd.h"
+
+VPUBLIC void Vcgmgdriv(
+        int *iparm, double *rparm,
+        int *iwork, double *rwork,
+        double *u,
+        double *xf, double *yf, double *zf,
+        double *gxcf, double *gycf, double *gzcf,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *ccf, double *fcf, double *tcf) {
+
+    int nxc;    /// @todo: Doc
+    int nyc;    /// @todo: Doc
+    int nzc;    /// @todo: Doc
+    int nf;     /// @todo: Doc
+    int nc;     /// @todo: Doc
+    int narr;   /// @todo: Doc
+    int narrc;  /// @todo: Doc
+    int n_rpc;  /// @todo: Doc
+    int n_iz;   /// @todo: Doc
+    int n_ipc;  /// @todo: Doc
+    int iretot; /// @todo: Doc
+    int iintot; /// @todo: Doc
+
+    int nrwk;   /// @todo: Doc
+    int niwk;   /// @todo: Doc
+    int nx;     /// @todo: Doc
+    int ny;     /// @todo: Doc
+    int nz;     /// @todo: Doc
+    int nlev;   /// @todo: Doc
+    int mxlv;   /// @todo: Doc
+    int mgcoar; /// @todo: Doc
+    int mgdisc; /// @todo: Doc
+    int mgsolv; /// @todo: Doc
+    int k_iz;   /// @todo: Doc
+    int k_w1;   /// @todo: Doc
+    int k_w2;   /// @todo: Doc
+    int k_ipc;  /// @todo: Doc
+    int k_rpc;  /// @todo: Doc
+    int k_ac;   /// @todo: Doc
+    int k_cc;   /// @todo: Doc
+    int k_fc;   /// @todo: Doc
+    int k_pc;   /// @todo: Doc
+
+    // Decode some parameters
+    nrwk   = VAT(iparm, 1);
+    niwk   = VAT(iparm, 2);
+    nx     = VAT(iparm, 3);
+    ny     = VAT(iparm, 4);
+    nz     = VAT(iparm, 5);
+    nlev   = VAT(iparm, 6);
+
+    // Some checks on input
+    VASSERT_MSG0(nlev > 0, "The nlev parameter must be positive");
+    VASSERT_MSG0(nx > 0, "The nx parameter must be positive");
+    VASSERT_MSG0(ny > 0, "The ny parameter must be positive");
+    VASSERT_MSG0(nz > 0, "The nz parameter must be positive");
+
+    mxlv = Vmaxlev(nx, ny, nz);
+
+    VASSERT_MSG1(nlev <= mxlv, "Max lev for your grid size is: %d", mxlv);
+
+    // Basic grid sizes, etc.
+    mgcoar = VAT(iparm, 18);
+    mgdisc = VAT(iparm, 19);
+    mgsolv = VAT(iparm, 21);
+
+    Vmgsz(&mgcoar, &mgdisc, &mgsolv,
+            &nx, &ny, &nz,
+            &nlev,
+            &nxc, &nyc, &nzc,
+            &nf, &nc,
+            &narr, &narrc,
+            &n_rpc, &n_iz, &n_ipc,
+            &iretot, &iintot);
+
+    // Allocate space for two additional work vectors (residual, direction)
+    // after the Vmgsz layout, which keeps the operator slots where
+    // Vmgfineop expects them
+    k_w1   = iretot + 1;
+    k_w2   = k_w1   + nf;
+    iretot = iretot + 2 * nf;
+
+    // Some more checks on input
+    VASSERT_MSG1( nrwk >= iretot, "Real work space must be: %d", iretot );
+    VASSERT_MSG1( niwk >= iintot, "Integer work space must be: %d", iintot );
+
+    // Split up the integer work array
+    k_iz   = 1;
+    k_ipc  = k_iz   + n_iz;
+
+    // Split up the real work array
+    k_rpc  = 1;
+    k_cc   = k_rpc  + n_rpc;
+    k_fc   = k_cc   + narr;
+    k_pc   = k_fc   + narr;
+    k_ac   = k_pc   + 27 * narrc;
+
+    // Call the CG driver
+    Vcgmgdriv2(iparm, rparm,
+            &nx, &ny, &nz,
+            u, RAT(iwork, k_iz),
+            RAT(rwork, k_w1),  RAT(rwork, k_w2),
+            RAT(iwork, k_ipc), RAT(rwork, k_rpc),
+            RAT(rwork, k_pc),  RAT(rwork, k_ac), RAT(rwork, k_cc), RAT(rwork, k_fc),
+            xf, yf, zf,
+            gxcf, gycf, gzcf,
+            a1cf, a2cf, a3cf,
+            ccf, fcf, tcf);
+}
+
+
+
+VPUBLIC void Vcgmgdriv2(int *iparm, double *rparm,
+        int *nx, int *ny, int *nz,
+        double *u, int *iz,
+        double *w1, double *w2,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc, double *fc,
+        double *xf, double *yf, double *zf,
+        double *gxcf, double *gycf, double *gzcf,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *ccf, double *fcf, double *tcf) {
+
+    int mgkey   = 0;
+    int nlev    = 0;
+    int itmax   = 0;
+    int iok     = 0;
+    int iinfo   = 0;
+    int istop   = 0;
+    int ipkey   = 0;
+    int nu1     = 0;
+    int nu2     = 0;
+    int ido     = 0;
+    int iters   = 0;
+    int ierror  = 0;
+    int ibound  = 0;
+    int mgprol  = 0;
+    int mgcoar  = 0;
+    int mgsolv  = 0;
+    int mgdisc  = 0;
+    int mgsmoo  = 0;
+    int mode    = 0;
+    int ireuse  = 0;
+    int iguess  = 0;
+
+    double epsiln = 0.0;
+    double errtol = 0.0;
+    double omegal = 0.0;
+
+    // Decode the iparm array
+    nlev   = VAT(iparm,  6);
+    nu1    = VAT(iparm,  7);
+    nu2    = VAT(iparm,  8);
+    mgkey  = VAT(iparm,  9);
+    itmax  = VAT(iparm, 10);
+    istop  = VAT(iparm, 11);
+    iinfo  = VAT(iparm, 12);
+    ipkey  = VAT(iparm, 14);
+    mode   = VAT(iparm, 16);
+    mgprol = VAT(iparm, 17);
+    mgcoar = VAT(iparm, 18);
+    mgdisc = VAT(iparm, 19);
+    mgsmoo = VAT(iparm, 20);
+    mgsolv = VAT(iparm, 21);
+    ireuse = VAT(iparm, 24);
+    iguess = VAT(iparm, 25);
+
+    // Decode the rparm array
+    errtol = VAT(rparm,  1);
+    omegal = VAT(rparm,  9);
+
+    // CG needs a fixed symmetric operator
+    VASSERT_MSG1(mode == 0, "CGMG requires a linear problem; got mode %d",
+            mode);
+
+    if (mgkey != 0 && mgkey != 1) {
+        VABORT_MSG1("Bad mgkey given: %d", mgkey);
+    }
+
+    Vprtstp(0, -99, 0.0, 0.0, 0.0);
+
+    MAT2(iz, 50, nlev + 1);
+
+    if (ireuse == 2) {
+
+        // The hierarchy of the last solve is intact; only the source moved
+        Vnm_tstart(30, "Vcgmgdrv2: fine problem setup");
+        VbuildF(nx, ny, nz, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                fcf);
+        Vnm_tstop(30, "Vcgmgdrv2: fine problem setup");
+
+        // The coarse solver may have fallen back when first factored
+        mgsolv = VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6);
+
+    } else {
+
+        // Build the multigrid data structure in iz
+        Vbuildstr(nx, ny, nz, &nlev, iz);
+
+        // Start the timer
+        Vnm_tstart(30, "Vcgmgdrv2: fine problem setup");
+
+        // Build operator and rhs on fine grid
+        ido = 0;
+        Vbuildops(nx, ny, nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vcgmgdrv2: fine problem setup");
+
+        // Start the timer
+        Vnm_tstart(30, "Vcgmgdrv2: coarse problem setup");
+
+        // Build operator and rhs on all coarse grids
+        ido = 1;
+        Vbuildops(nx, ny, nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vcgmgdrv2: coarse problem setup");
+
+        // Keep any fallback of the coarse solver for later reuse
+        VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6) = mgsolv;
+    }
+
+    // Determine machine epsilon
+    epsiln = Vnm_epsmac();
+
+    // Zero initial guess unless the caller gave one; dirichlet values are
+    // folded into the source fcn (and cleared from u below)
+    if (iguess == 0) {
+        Vazeros(nx, ny, nz, u);
+    }
+    VfboundPMG00(nx, ny, nz, u);
+
+    // Start the timer
+    Vsmoothr_resetTraffic();
+    Vnm_tstart(30, "Vcgmgdrv2: solve");
+
+    /* The coefficient arrays are free once the operators are built:
+     * a1cf-ccf serve as v-cycle workspace as in Vmgdriv2, fcf holds the
+     * multilevel preconditioned residual and tcf the operator image */
+    iok  = 1;
+    Vcgmg(nx, ny, nz,
+            u, iz,
+            a1cf, a2cf, a3cf, ccf,
+            w1, w2, tcf, fcf,
+            &istop, &itmax, &iters, &ierror,
+            &nlev, &mgsolv,
+            &iok, &iinfo, &epsiln, &errtol, &omegal,
+            &nu1, &nu2, &mgsmoo,
+            ipc, rpc, pc, ac, cc, fc);
+
+    // Stop the timer
+    Vnm_tstop(30, "Vcgmgdrv2: solve");
+
+    // The sparse coarse factor is rebuilt by the next Vbuildops
+    if ((mgsolv == 2) && (ireuse == 0)) {
+        Vsparsefree(RAT(ipc, VAT2(iz, 5,nlev+1)));
+    }
+
+    // Memory traffic of the restriction leg, per level
+    if (iinfo > 0) {
+        Vsmoothr_printTraffic();
+    }
+
+    // Restore boundary conditions
+    ibound = 1;
+    VfboundPMG(&ibound, nx, ny, nz, u, gxcf, gycf, gzcf);
+}
+
+
+
+VPUBLIC void Vcgmg(int *nx, int *ny, int *nz,
+        double *x, int *iz,
+        double *w0, double *w1, double *w2, double *w3,
+        double *r, double *p, double *ap, double *z,
+        int *istop, int *itmax, int *iters, int *ierror,
+        int *nlev, int *mgsolv, int *iok, int *iinfo,
+        double *epsiln, double *errtol, double *omega,
+        int *nu1, int *nu2, int *mgsmoo,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc, double *fc) {
+
+    int ilev;        // @todo: doc
+    int nlev_real;   // @todo: doc
+    int istop_s;     // @todo: doc
+    int itmax_s;     // @todo: doc
+    int iters_s;     // @todo: doc
+    int ierror_s;    // @todo: doc
+    int iok_s;       // @todo: doc
+    int iinfo_s;     // @todo: doc
+    double rsden;    // @todo: doc
+    double rsnrm;    // @todo: doc
+    double orsnrm;   // @todo: doc
+    double rhok1;    // @todo: doc
+    double rhok2;    // @todo: doc
+    double pAp;      // @todo: doc
+    double alpha;    // @todo: doc
+    double beta;     // @todo: doc
+
+    double scal;      // A utility variable used to pass a parameter to xaxpy
+
+    MAT2(iz, 50, 1);
+
+    // The v-cycle runs from the finest level over all nlev levels
+    ilev = 1;
+    nlev_real = *nlev;
+
+    // One cycle from a zero guess, no stopping test and no i/o
+    istop_s = 0;
+    itmax_s = 1;
+    iok_s   = 0;
+    iinfo_s = 0;
+
+    // Do some i/o if requested
+    if (*iinfo > 1) {
+        VMESSAGE0("Starting cgmg operation");
+        VMESSAGE3("Fine Grid Size:   (%d, %d, %d)", *nx, *ny, *nz);
+    }
+
+    if (*iok != 0) {
+        Vprtstp(*iok, -1, 0.0, 0.0, 0.0);
+    }
+
+    // Boundary values of the work vectors are read by the stencil
+    Vazeros(nx, ny, nz, r);
+    Vazeros(nx, ny, nz, p);
+    Vazeros(nx, ny, nz, ap);
+
+    // Compute denominator for stopping criterion
+    if (*istop == 0) {
+        rsden = 1.0;
+    } else if (*istop == 1) {
+        rsden = Vxnrm1(nx, ny, nz, RAT(fc, VAT2(iz, 1, 1)));
+    } else {
+        VABORT_MSG1("Bad istop value: %d", *istop);
+    }
+
+    if (rsden == 0.0) {
+        rsden = 1.0;
+        VERRMSG0("rhs is zero on finest level");
+    }
+
+    // Initial residual
+    Vmresid(nx, ny, nz,
+            RAT(ipc, VAT2(iz, 5, 1)), RAT(rpc, VAT2(iz, 6, 1)),
+             RAT(ac, VAT2(iz, 7, 1)),  RAT(cc, VAT2(iz, 1, 1)),
+             RAT(fc, VAT2(iz, 1, 1)), x, r);
+    rsnrm = Vxnrm1(nx, ny, nz, r);
+    orsnrm = rsnrm;
+
+    if (*iok != 0) {
+        Vprtstp(*iok, 0, rsnrm, rsden, orsnrm);
+    }
+
+    *iters = 0;
+    rhok1 = 0.0;
+    alpha = 0.0;
+    while (1) {
+
+        // Check the current stopping test
+        if (rsnrm / rsden <= *errtol)
+            break;
+
+        if (*iters >= *itmax)
+            break;
+
+        // Precondition the residual with one v-cycle: z = B r
+        Vazeros(nx, ny, nz, z);
+        Vmvcs(nx, ny, nz,
+                z, iz, w0, w1, w2, w3,
+                &istop_s, &itmax_s, &iters_s, &ierror_s, nlev,
+                &ilev, &nlev_real, mgsolv,
+                &iok_s, &iinfo_s, epsiln, errtol, omega,
+                nu1, nu2, mgsmoo,
+                ipc, rpc, pc, ac, cc, r, VNULL);
+
+        rhok2 = Vxdot(nx, ny, nz, r, z);
+
+        // Form new direction vector from old one and z
+        if (*iters == 0) {
+            Vxcopy(nx, ny, nz, z, p);
+        } else {
+            // ap still holds A p_k; (z, r_k+1 - r_k) = -alpha (z, A p_k)
+            beta = -alpha * Vxdot(nx, ny, nz, z, ap) / rhok1;
+            Vxscal(nx, ny, nz, &beta, p);
+            scal = 1.0;
+            Vxaxpy(nx, ny, nz, &scal, z, p);
+        }
+
+        // Steplength which minimizes energy norm of error
+        Vmatvec(nx, ny, nz,
+                RAT(ipc, VAT2(iz, 5, 1)), RAT(rpc, VAT2(iz, 6, 1)),
+                 RAT(ac, VAT2(iz, 7, 1)),  RAT(cc, VAT2(iz, 1, 1)),
+                p, ap);
+        pAp = Vxdot(nx, ny, nz, p, ap);
+        if (pAp <= 0.0) {
+            VERRMSG0("Operator is not positive definite; stopping");
+            break;
+        }
+        alpha = rhok2 / pAp;
+
+        // Save rhok2 for next iteration
+        rhok1 = rhok2;
+
+        // Update solution in direction p of length alpha
+        Vxaxpy(nx, ny, nz, &alpha, p, x);
+
+        // Update residual
+        scal = -alpha;
+        Vxaxpy(nx, ny, nz, &scal, ap, r);
+
+        // Increment the iteration counter and do some i/o
+        (*iters)++;
+        orsnrm = rsnrm;
+        rsnrm = Vxnrm1(nx, ny, nz, r);
+
+        if (*iok != 0) {
+            Vprtstp(*iok, *iters, rsnrm, rsden, orsnrm);
+        }
+    }
+
+    *ierror = (rsnrm / rsden <= *errtol) ? 0 : 1;
+}
@@ -0,0 +1,187 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Driver for the multigrid-preconditioned conjugate gradient solver
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#ifndef _CGMGDRVD_H_
+#define _CGMGDRVD_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+#include "pmgc/mgsubd.h"
+#include "pmgc/mgcsd.h"
+#include "pmgc/mgdrvd.h"
+#include "pmgc/mikpckd.h"
+#include "pmgc/matvecd.h"
+
+/** @brief   Multilevel-preconditioned conjugate gradient driver
+ *  @ingroup PMGC
+ *
+ *  Splits the work arrays like Vnewdriv (two extra fine-grid vectors
+ *  after fc) and hands off to Vcgmgdriv2.
+ *
+ *  @note    Replaces cgmgdriv from cgmgdrvd.f
+ */
+VEXTERNC void Vcgmgdriv(
+        int    *iparm, ///< @todo:  Doc
+        double *rparm, ///< @todo:  Doc
+        int    *iwork, ///< @todo:  Doc
+        double *rwork, ///< @todo:  Doc
+        double *u,     ///< @todo:  Doc
+        double *xf,    ///< @todo:  Doc
+        double *yf,    ///< @todo:  Doc
+        double *zf,    ///< @todo:  Doc
+        double *gxcf,  ///< @todo:  Doc
+        double *gycf,  ///< @todo:  Doc
+        double *gzcf,  ///< @todo:  Doc
+        double *a1cf,  ///< @todo:  Doc
+        double *a2cf,  ///< @todo:  Doc
+        double *a3cf,  ///< @todo:  Doc
+        double *ccf,   ///< @todo:  Doc
+        double *fcf,   ///< @todo:  Doc
+        double *tcf    ///< @todo:  Doc
+        );
+
+/** @brief   Solves a linear problem with multilevel-preconditioned CG
+ *  @ingroup PMGC
+ *
+ *    This routine builds the same operator hierarchy as Vmgdriv2 and
+ *    then solves the linear fine grid problem
+ *
+ *         - \nabla \cdot (a \nabla u) + c u = f
+ *
+ *    with conjugate gradients, using one symmetric V-cycle of Vmvcs
+ *    as the preconditioner.  Only linear problems (mode 0) and the
+ *    residual-based stopping tests (istop 0 and 1) are supported.
+ *
+ *  @note    Replaces cgmgdriv2 from cgmgdrvd.f
+ */
+VEXTERNC void Vcgmgdriv2(
+        int    *iparm, ///< @todo:  Doc
+        double *rparm, ///< @todo:  Doc
+        int    *nx,    ///< @todo:  Doc
+        int    *ny,    ///< @todo:  Doc
+        int    *nz,    ///< @todo:  Doc
+        double *u,     ///< @todo:  Doc
+        int    *iz,    ///< @todo:  Doc
+        double *w1,    ///< @todo:  Doc
+        double *w2,    ///< @todo:  Doc
+        int    *ipc,   ///< @todo:  Doc
+        double *rpc,   ///< @todo:  Doc
+        double *pc,    ///< @todo:  Doc
+        double *ac,    ///< @todo:  Doc
+        double *cc,    ///< @todo:  Doc
+        double *fc,    ///< @todo:  Doc
+        double *xf,    ///< @todo:  Doc
+        double *yf,    ///< @todo:  Doc
+        double *zf,    ///< @todo:  Doc
+        double *gxcf,  ///< @todo:  Doc
+        double *gycf,  ///< @todo:  Doc
+        double *gzcf,  ///< @todo:  Doc
+        double *a1cf,  ///< @todo:  Doc
+        double *a2cf,  ///< @todo:  Doc
+        double *a3cf,  ///< @todo:  Doc
+        double *ccf,   ///< @todo:  Doc
+        double *fcf,   ///< @todo:  Doc
+        double *tcf    ///< @todo:  Doc
+        );
+
+/** @brief   Multilevel-preconditioned conjugate gradient iteration
+ *  @ingroup PMGC
+ *
+ *    algorithm:  preconditioned conjugate gradients on the fine grid,
+ *    z = B r applied as one v-cycle of Vmvcs from a zero initial guess.
+ *
+ *    Vmvcs damps each coarse grid correction with a residual-dependent
+ *    steplength, so B is not exactly a fixed linear operator; beta uses
+ *    the Polak-Ribiere form (z_k+1, r_k+1 - r_k) / (z_k, r_k), which
+ *    keeps the iteration stable under such a preconditioner and reduces
+ *    to standard PCG when B is linear.
+ *
+ *    x is a fine grid vector; z and w0 are multilevel vectors laid out
+ *    by iz; w1-w3, r, p and ap are fine grid work vectors.
+ */
+VEXTERNC void Vcgmg(
+        int    *nx,        ///< @todo:  Doc
+        int    *ny,        ///< @todo:  Doc
+        int    *nz,        ///< @todo:  Doc
+        double *x,         ///< @todo:  Doc
+        int    *iz,        ///< @todo:  Doc
+        double *w0,        ///< @todo:  Doc
+        double *w1,        ///< @todo:  Doc
+        double *w2,        ///< @todo:  Doc
+        double *w3,        ///< @todo:  Doc
+        double *r,         ///< @todo:  Doc
+        double *p,         ///< @todo:  Doc
+        double *ap,        ///< @todo:  Doc
+        double *z,         ///< @todo:  Doc
+        int    *istop,     ///< @todo:  Doc
+        int    *itmax,     ///< @todo:  Doc
+        int    *iters,     ///< @todo:  Doc
+        int    *ierror,    ///< @todo:  Doc
+        int    *nlev,      ///< @todo:  Doc
+        int    *mgsolv,    ///< @todo:  Doc
+        int    *iok,       ///< @todo:  Doc
+        int    *iinfo,     ///< @todo:  Doc
+        double *epsiln,    ///< @todo:  Doc
+        double *errtol,    ///< @todo:  Doc
+        double *omega,     ///< @todo:  Doc
+        int    *nu1,       ///< @todo:  Doc
+        int    *nu2,       ///< @todo:  Doc
+        int    *mgsmoo,    ///< @todo:  Doc
+        int    *ipc,       ///< @todo:  Doc
+        double *rpc,       ///< @todo:  Doc
+        double *pc,        ///< @todo:  Doc
+        double *ac,        ///< @todo:  Doc
+        double *cc,        ///< @todo:  Doc
+        double *fc         ///< @todo:  Doc
+        );
+
+#endif /* _CGMGDRVD_H_ */
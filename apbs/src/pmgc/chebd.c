@@ -0,0 +1,275 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Chebyshev polynomial smoother
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#include "chebd.h"
+
+/* d = alpha d + beta D^-1 (r - ad), storing r - ad back in r when ad is
+ * given, and x += d when x is given; D is the diagonal of the operator */
+VPRIVATE void Vcheb_step(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc, double *ac, double *cc,
+        double alpha, double beta,
+        double *ad, double *r, double *d, double *x) {
+
+    int i, j, k, mf;
+    double sE, sN, sU;
+    double diag, res, dold;
+
+    MAT2(ac, *nx * *ny * *nz, 1);
+
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(ad, *nx, *ny, *nz);
+    MAT3( r, *nx, *ny, *nz);
+    MAT3( d, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+
+    double *oC = RAT2(ac, 1, 1);
+    double *oE = RAT2(ac, 1, 1);
+    double *oN = RAT2(ac, 1, 2);
+    double *uC = RAT2(ac, 1, 3);
+
+    MAT3(oC, *nx, *ny, *nz);
+    MAT3(oE, *nx, *ny, *nz);
+    MAT3(oN, *nx, *ny, *nz);
+    MAT3(uC, *nx, *ny, *nz);
+
+    // The matrix-free operator keeps no diagonal; rebuild it as Vgsrb7_mf
+    mf = (VAT(ipc, 11) == 7) && (VAT(ipc, 13) == 1);
+    sE = mf ? VAT(rpc, 2) : 0.0;
+    sN = mf ? VAT(rpc, 3) : 0.0;
+    sU = mf ? VAT(rpc, 4) : 0.0;
+
+    #pragma omp parallel for private(i, j, k, diag, res, dold)
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                if (mf) {
+                    diag = sE * VAT3(oE, i, j, k) + sE * VAT3(oE, i-1,   j,   k)
+                         + sN * VAT3(oN, i, j, k) + sN * VAT3(oN,   i, j-1,   k)
+                         + sU * VAT3(uC, i, j, k) + sU * VAT3(uC,   i,   j, k-1);
+                } else {
+                    diag = VAT3(oC, i, j, k);
+                }
+                diag += VAT3(cc, i, j, k);
+
+                res = VAT3(r, i, j, k);
+                if (ad != VNULL) {
+                    res -= VAT3(ad, i, j, k);
+                    VAT3(r, i, j, k) = res;
+                }
+
+                dold = (alpha == 0.0) ? 0.0 : alpha * VAT3(d, i, j, k);
+                VAT3(d, i, j, k) = dold + beta * res / diag;
+
+                if (x != VNULL)
+                    VAT3(x, i, j, k) += VAT3(d, i, j, k);
+            }
+        }
+    }
+}
+
+/* Largest eigenvalue of the symmetric tridiagonal matrix (diag, off) by
+ * Sturm sequence bisection */
+VPRIVATE double Vcheb_tridmax(int n, double *diag, double *off) {
+
+    int i, it, count;
+    double lo, hi, mid, q, e;
+
+    // Gershgorin interval of the tridiagonal
+    lo = 0.0;
+    hi = 0.0;
+    for (i=0; i<n; i++) {
+        e = ((i > 0) ? VABS(off[i-1]) : 0.0) + ((i < n-1) ? VABS(off[i]) : 0.0);
+        hi = VMAX2(hi, diag[i] + e);
+    }
+
+    for (it=0; it<60; it++) {
+        mid = 0.5 * (lo + hi);
+
+        // Number of eigenvalues below mid
+        count = 0;
+        q = 1.0;
+        for (i=0; i<n; i++) {
+            q = diag[i] - mid - ((i > 0) ? off[i-1] * off[i-1] / q : 0.0);
+            if (q == 0.0)
+                q = -1.0e-300;
+            if (q < 0.0)
+                count++;
+        }
+
+        if (count == n) hi = mid;
+        else lo = mid;
+    }
+
+    return hi;
+}
+
+/* Largest eigenvalue of D^-1 A from the Lanczos matrix of a few steps of
+ * Jacobi-preconditioned CG; a plain power iteration converges far too
+ * slowly here, the top of the spectrum being tightly clustered */
+VPRIVATE double Vcheb_eigmax(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc, double *ac, double *cc,
+        double *r, double *p, double *ap) {
+
+    int i, j, k, n;
+    double alpha, alphaold, beta, rz, rzold, pap, fac;
+    double diag[VCHEB_NLANCZOS], off[VCHEB_NLANCZOS];
+
+    MAT3(r, *nx, *ny, *nz);
+
+    Vazeros(nx, ny, nz, r);
+    Vazeros(nx, ny, nz, p);
+    Vazeros(nx, ny, nz, ap);
+
+    // A fixed rough start: reproducible, and rich in the high frequencies
+    // the estimate is after
+    for (k=2; k<=*nz-1; k++)
+        for (j=2; j<=*ny-1; j++)
+            for (i=2; i<=*nx-1; i++)
+                VAT3(r, i, j, k) = 1.0 + (double)((7*i + 13*j + 29*k) % 17) / 17.0;
+
+    alphaold = 1.0;
+    beta = 0.0;
+    rzold = 1.0;
+    for (n=0; n<VCHEB_NLANCZOS; n++) {
+
+        // ap = D^-1 r for now, then p = D^-1 r + beta p
+        Vcheb_step(nx, ny, nz, ipc, rpc, ac, cc, 0.0, 1.0, VNULL, r, ap, VNULL);
+        rz = Vxdot(nx, ny, nz, r, ap);
+        if (rz <= 0.0)
+            break;
+        if (n > 0) {
+            beta = rz / rzold;
+            Vxscal(nx, ny, nz, &beta, p);
+        }
+        fac = 1.0;
+        Vxaxpy(nx, ny, nz, &fac, ap, p);
+
+        Vmatvec(nx, ny, nz, ipc, rpc, ac, cc, p, ap);
+        pap = Vxdot(nx, ny, nz, p, ap);
+        if (pap <= 0.0)
+            break;
+        alpha = rz / pap;
+
+        // Row n of the Lanczos matrix
+        diag[n] = 1.0 / alpha + ((n > 0) ? beta / alphaold : 0.0);
+        if (n > 0)
+            off[n-1] = VSQRT(beta) / alphaold;
+
+        fac = -alpha;
+        Vxaxpy(nx, ny, nz, &fac, ap, r);
+        alphaold = alpha;
+        rzold = rz;
+    }
+
+    if (n == 0)
+        return 1.0;
+
+    return Vcheb_tridmax(n, diag, off);
+}
+
+VPUBLIC void Vcheb(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc,
+        double *ac, double *cc, double *fc,
+        double *x, double *w1, double *w2, double *r,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iresid, int *iadjoint) {
+
+    double upper, lower, theta, delta, sigma, rho, rhonew, alpha;
+
+    // A smoother runs a fixed degree, so there is no tolerance to test
+    (void)errtol;
+    // The polynomial in D^-1 A is its own adjoint; no reversed sweep exists
+    (void)iadjoint;
+    // The damping is set by the eigenvalue interval, not by a relaxation factor
+    (void)omega;
+
+    // Spectral bound of this level, estimated once per operator
+    if (VAT(ipc, 14) != 1) {
+        VAT(rpc, 1) = Vcheb_eigmax(nx, ny, nz,
+                ipc, rpc, ac, cc,
+                w1, w2, r);
+        VAT(ipc, 14) = 1;
+    }
+
+    upper = VCHEB_UPPER * VAT(rpc, 1);
+    lower = VCHEB_LOWER * upper;
+    theta = 0.5 * (upper + lower);
+    delta = 0.5 * (upper - lower);
+    sigma = theta / delta;
+    rho   = 1.0 / sigma;
+
+    if (*itmax < 1) {
+        if (*iresid == 1)
+            Vmresid(nx, ny, nz, ipc, rpc, ac, cc, fc, x, r);
+        return;
+    }
+
+    // w1 carries the correction d, w2 its image A d
+    Vazeros(nx, ny, nz, w1);
+    Vazeros(nx, ny, nz, w2);
+
+    Vmresid(nx, ny, nz, ipc, rpc, ac, cc, fc, x, r);
+    Vcheb_step(nx, ny, nz, ipc, rpc, ac, cc, 0.0, 1.0 / theta, VNULL, r, w1, x);
+
+    // Three-term recurrence; r is kept as the residual of x throughout
+    for (*iters=2; *iters<=*itmax; (*iters)++) {
+        Vmatvec(nx, ny, nz, ipc, rpc, ac, cc, w1, w2);
+        rhonew = 1.0 / (2.0 * sigma - rho);
+        Vcheb_step(nx, ny, nz, ipc, rpc, ac, cc,
+                rhonew * rho, 2.0 * rhonew / delta, w2, r, w1, x);
+        rho = rhonew;
+    }
+
+    if (*iresid == 1) {
+        Vmatvec(nx, ny, nz, ipc, rpc, ac, cc, w1, w2);
+        alpha = -1.0;
+        Vxaxpy(nx, ny, nz, &alpha, w2, r);
+    }
+}
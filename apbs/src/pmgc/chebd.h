@@ -0,0 +1,109 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Chebyshev polynomial smoother
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#ifndef _CHEBD_H_
+#define _CHEBD_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+#include "pmgc/matvecd.h"
+#include "pmgc/mikpckd.h"
+
+/** @brief Number of CG steps used to estimate lambda_max(D^-1 A) */
+#define VCHEB_NLANCZOS 10
+
+/** @brief Safety factor applied to the lambda_max estimate */
+#define VCHEB_UPPER 1.1
+
+/** @brief Lower end of the damped interval, as a fraction of its upper end */
+#define VCHEB_LOWER 0.2
+
+/** @brief   Jacobi-preconditioned Chebyshev smoother
+ *  @ingroup PMGC
+ *
+ *  Applies the Chebyshev polynomial of degree itmax in D^-1 A that is
+ *  smallest on [VCHEB_LOWER * b, b], with D the diagonal of the operator
+ *  (including cc) and b = VCHEB_UPPER * lambda_max(D^-1 A).  Every step is
+ *  a matvec followed by one fused pointwise update, so the smoother needs
+ *  no coloring and runs the same in parallel as in serial.
+ *
+ *  lambda_max is estimated from a few Lanczos (CG) steps on the first call for a
+ *  level and kept in rpc(1); ipc(14) flags it as valid.  The operator
+ *  builders clear the flag, as does the Newton driver whenever it changes
+ *  the Jacobian's cc.
+ *
+ *  @note  Same calling sequence as Vgsrb.  errtol, omega and iadjoint are
+ *         ignored: the degree is fixed, the damping comes from the
+ *         eigenvalue interval, and the polynomial is its own adjoint.
+ */
+VEXTERNC void Vcheb(
+        int *nx,        ///< @todo  Document
+        int *ny,        ///< @todo  Document
+        int *nz,        ///< @todo  Document
+        int *ipc,       ///< @todo  Document
+        double *rpc,    ///< @todo  Document
+        double *ac,     ///< @todo  Document
+        double *cc,     ///< @todo  Document
+        double *fc,     ///< @todo  Document
+        double *x,      ///< @todo  Document
+        double *w1,     ///< @todo  Document
+        double *w2,     ///< @todo  Document
+        double *r,      ///< @todo  Document
+        int *itmax,     ///< Polynomial degree (number of matvecs)
+        int *iters,     ///< @todo  Document
+        double *errtol, ///< @todo  Document
+        double *omega,  ///< @todo  Document
+        int *iresid,    ///< @todo  Document
+        int *iadjoint   ///< @todo  Document
+        );
+
+#endif /* _CHEBD_H_ */
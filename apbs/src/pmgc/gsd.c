@@ -63,7 +63,14 @@ VPUBLIC void Vgsrb(int *nx, int *ny, int *nz,
 
     // Do in one step ***
     numdia = VAT(ipc, 11);
-    if (numdia == 7) {
+    if (numdia == 7 && VAT(ipc, 13) == 1) {
+        Vgsrb7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc, fc,
+                RAT2(ac, 1,1), RAT2(ac, 1,2), RAT2(ac, 1,3),
+                x, w1, w2, r,
+                itmax, iters, errtol, omega, iresid, iadjoint);
+    } else if (numdia == 7) {
         Vgsrb7x(nx, ny, nz,
                 ipc, rpc,
                 RAT2(ac, 1,1), cc, fc,
@@ -113,41 +120,47 @@ VPUBLIC void Vgsrb7x(int *nx,int *ny,int *nz,
     for (*iters=1; *iters<=*itmax; (*iters)++) {
 
         // Do the red points ***
-        #pragma omp parallel for private(i, j, k, ioff)
-        for (k=2; k<=*nz-1; k++) {
-            for (j=2; j<=*ny-1; j++) {
-                ioff = (1 - *iadjoint) * (    (j + k + 2) % 2)
-                     + (    *iadjoint) * (1 - (j + k + 2) % 2);
-                for (i=2+ioff; i<=*nx-1; i+=2) {
-                    VAT3(x, i, j, k) = (
-                            VAT3(fc,   i,  j,  k)
-                         +  VAT3(oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
-                         +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
-                         +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
-                         +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
-                         + VAT3( uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
-                         + VAT3( uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
-                         ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+        if (!Vgsrb7_simd(nx, ny, nz, oC, cc, fc, oE, oN, uC, x,
+                         *iadjoint)) {
+            #pragma omp parallel for private(i, j, k, ioff)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff = (1 - *iadjoint) * (    (j + k + 2) % 2)
+                         + (    *iadjoint) * (1 - (j + k + 2) % 2);
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+                        VAT3(x, i, j, k) = (
+                                VAT3(fc,   i,  j,  k)
+                             +  VAT3(oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                             +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                             +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                             +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                             + VAT3( uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                             + VAT3( uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                             ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+                    }
                 }
             }
         }
 
         // Do the black points
-        #pragma omp parallel for private(i, j, k, ioff)
-        for (k=2; k<=*nz-1; k++) {
-            for (j=2; j<=*ny-1; j++) {
-                ioff =   (    *iadjoint) * (    (j + k + 2) % 2 )
-                       + (1 - *iadjoint) * (1 - (j + k + 2) % 2 );
-                for (i=2+ioff;i<=*nx-1; i+=2) {
-                    VAT3(x, i, j, k) = (
-                            VAT3(fc,   i,   j,   k)
-                         +  VAT3(oN,   i,   j,   k) * VAT3(x,   i,j+1,  k)
-                         +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i,j-1,  k)
-                         +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,  j,  k)
-                         +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,  j,  k)
-                         + VAT3( uC,   i,   j, k-1) * VAT3(x,   i,  j,k-1)
-                         + VAT3( uC,   i,   j,   k) * VAT3(x,   i,  j,k+1)
-                         ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+        if (!Vgsrb7_simd(nx, ny, nz, oC, cc, fc, oE, oN, uC, x,
+                         1 - *iadjoint)) {
+            #pragma omp parallel for private(i, j, k, ioff)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff =   (    *iadjoint) * (    (j + k + 2) % 2 )
+                           + (1 - *iadjoint) * (1 - (j + k + 2) % 2 );
+                    for (i=2+ioff;i<=*nx-1; i+=2) {
+                        VAT3(x, i, j, k) = (
+                                VAT3(fc,   i,   j,   k)
+                             +  VAT3(oN,   i,   j,   k) * VAT3(x,   i,j+1,  k)
+                             +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i,j-1,  k)
+                             +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,  j,  k)
+                             +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,  j,  k)
+                             + VAT3( uC,   i,   j, k-1) * VAT3(x,   i,  j,k-1)
+                             + VAT3( uC,   i,   j,   k) * VAT3(x,   i,  j,k+1)
+                             ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+                    }
                 }
             }
         }
@@ -158,6 +171,225 @@ VPUBLIC void Vgsrb7x(int *nx,int *ny,int *nz,
 }
 
 
+/* One red/black half-sweep of plane k (points with i + j + k + parity
+ * even), with the same update as the loops of Vgsrb7x */
+VPRIVATE void Vgsrb7_plane(int *nx, int *ny, int *nz, int k, int parity,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x) {
+
+    int i, j, ioff;
+
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+
+    MAT3(oE, *nx, *ny, *nz);
+    MAT3(oN, *nx, *ny, *nz);
+    MAT3(uC, *nx, *ny, *nz);
+    MAT3(oC, *nx, *ny, *nz);
+
+    if (Vgsrb7_simdPlane(nx, ny, nz, k, oC, cc, fc, oE, oN, uC, x, parity))
+        return;
+
+    #pragma omp parallel for private(i, j, ioff)
+    for (j=2; j<=*ny-1; j++) {
+        ioff = (j + k + parity) % 2;
+        for (i=2+ioff; i<=*nx-1; i+=2) {
+            VAT3(x, i, j, k) = (
+                    VAT3(fc,   i,  j,  k)
+                 +  VAT3(oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                 +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                 +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                 +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                 + VAT3( uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                 + VAT3( uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                 ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+        }
+    }
+}
+
+/* Residual of plane k into the nx*ny plane rk, as in Vmresid7_1s */
+VPRIVATE void Vmresid7_plane(int *nx, int *ny, int *nz, int k,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *rk) {
+
+    int i, j;
+
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+
+    MAT3(oE, *nx, *ny, *nz);
+    MAT3(oN, *nx, *ny, *nz);
+    MAT3(uC, *nx, *ny, *nz);
+    MAT3(oC, *nx, *ny, *nz);
+
+    MAT2(rk, *nx, *ny);
+
+    if (Vmresid7_simdPlane(nx, ny, nz, k, oC, cc, fc, oE, oN, uC, x, rk))
+        return;
+
+    #pragma omp parallel for private(i, j)
+    for (j=2; j<=*ny-1; j++) {
+        for(i=2; i<=*nx-1; i++) {
+            VAT2(rk, i, j) =  VAT3(fc,   i,   j,   k)
+                     + VAT3( oN,   i,   j,   k)                * VAT3(x,   i, j+1,   k)
+                     + VAT3( oN,   i, j-1,   k)                * VAT3(x,   i, j-1,   k)
+                     + VAT3( oE,   i,   j,   k)                * VAT3(x, i+1,   j,   k)
+                     + VAT3( oE, i-1,   j,   k)                * VAT3(x, i-1,   j,   k)
+                     + VAT3( uC,   i,   j, k-1)                * VAT3(x,   i,   j, k-1)
+                     + VAT3( uC,   i,   j,   k)                * VAT3(x,   i,   j, k+1)
+                     - (VAT3(oC,   i,   j,   k) + VAT3(cc, i, j, k)) * VAT3(x,   i,   j,   k);
+        }
+    }
+}
+
+VPUBLIC void Vgsrb7rx(int *nx, int *ny, int *nz,
+        int *nxc, int *nyc, int *nzc,
+        int *ipc, double *rpc,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *w2, double *r,
+        double *rc, double *pc,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iadjoint) {
+
+    int k, kr, kc;
+    int nu, iresid;
+    int nxy;
+
+    nxy = *nx * *ny;
+
+    // All but the last iteration are ordinary sweeps
+    nu = *itmax - 1;
+    iresid = 0;
+    if (nu > 0) {
+        Vgsrb7x(nx, ny, nz,
+                ipc, rpc,
+                oC, cc, fc,
+                oE, oN, uC,
+                x, w1, w2, r,
+                &nu, iters, errtol, omega, &iresid, iadjoint);
+    }
+    *iters = *itmax + 1;
+
+    // First color of the last iteration
+    if (*itmax > 0) {
+        if (!Vgsrb7_simd(nx, ny, nz, oC, cc, fc, oE, oN, uC, x,
+                         *iadjoint)) {
+            for (k=2; k<=*nz-1; k++)
+                Vgsrb7_plane(nx, ny, nz, k, *iadjoint,
+                        oC, cc, fc, oE, oN, uC, x);
+        }
+    }
+
+    /* Second color, one plane at a time.  Once plane k is final the
+     * residual of plane k-1 is, so it goes into slot (k-1)%3 of r; and once
+     * fine plane 2kc is in, coarse plane kc can be restricted from the
+     * three slots.  Only three fine planes of residual ever exist. */
+    for (k=2; k<=*nz; k++) {
+
+        if (*itmax > 0 && k <= *nz-1)
+            Vgsrb7_plane(nx, ny, nz, k, 1 - *iadjoint,
+                    oC, cc, fc, oE, oN, uC, x);
+
+        kr = k - 1;
+        if (kr < 2)
+            continue;
+
+        Vmresid7_plane(nx, ny, nz, kr,
+                oC, cc, fc, oE, oN, uC, x, RAT(r, (kr % 3) * nxy + 1));
+
+        kc = kr / 2;
+        if ((kr % 2 == 0) && (kc >= 2) && (kc <= *nzc-1)) {
+            Vrestrcpl(nx, ny, nxc, nyc, nzc, kc,
+                    RAT(r, ((kr - 2) % 3) * nxy + 1),
+                    RAT(r, ((kr - 1) % 3) * nxy + 1),
+                    RAT(r, (kr % 3) * nxy + 1),
+                    rc, pc);
+        }
+    }
+
+    // Verify correctness of the output boundary points
+    VfboundPMG00(nxc, nyc, nzc, rc);
+}
+
+
+
+VPUBLIC void Vgsrb7_mf(int *nx,int *ny,int *nz,
+        int *ipc, double *rpc,
+        double *cc, double *fc,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *x, double *w1, double *w2, double *r,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iresid, int *iadjoint) {
+
+    int i, j, k, ioff, color;
+    double sE, sN, sU;
+    double aE, aW, aN, aS, aU, aD, oC;
+
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+
+    MAT3(a1cf, *nx, *ny, *nz);
+    MAT3(a2cf, *nx, *ny, *nz);
+    MAT3(a3cf, *nx, *ny, *nz);
+
+    // Face scalings of the uniform mesh, from VbuildA_mf
+    sE = VAT(rpc, 2);
+    sN = VAT(rpc, 3);
+    sU = VAT(rpc, 4);
+
+    for (*iters=1; *iters<=*itmax; (*iters)++) {
+
+        // Red points first (black first for the adjoint), as in Vgsrb7x
+        for (color=0; color<=1; color++) {
+            #pragma omp parallel for private(i, j, k, ioff, aE, aW, aN, aS, aU, aD, oC)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff = (j + k + *iadjoint + color) % 2;
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+
+                        aE = sE * VAT3(a1cf,   i,   j,   k);
+                        aW = sE * VAT3(a1cf, i-1,   j,   k);
+                        aN = sN * VAT3(a2cf,   i,   j,   k);
+                        aS = sN * VAT3(a2cf,   i, j-1,   k);
+                        aU = sU * VAT3(a3cf,   i,   j,   k);
+                        aD = sU * VAT3(a3cf,   i,   j, k-1);
+                        oC = aE + aW + aN + aS + aU + aD;
+                        if (i == *nx-1) aE = 0.0;
+                        if (i == 2)     aW = 0.0;
+                        if (j == *ny-1) aN = 0.0;
+                        if (j == 2)     aS = 0.0;
+                        if (k == *nz-1) aU = 0.0;
+                        if (k == 2)     aD = 0.0;
+
+                        VAT3(x, i, j, k) = (
+                                VAT3(fc, i, j, k)
+                             +  aN * VAT3(x,   i, j+1,   k)
+                             +  aS * VAT3(x,   i, j-1,   k)
+                             +  aE * VAT3(x, i+1,   j,   k)
+                             +  aW * VAT3(x, i-1,   j,   k)
+                             +  aD * VAT3(x,   i,   j, k-1)
+                             +  aU * VAT3(x,   i,   j, k+1)
+                             ) / (oC + VAT3(cc, i, j, k));
+                    }
+                }
+            }
+        }
+    }
+
+    if (*iresid == 1)
+        Vmresid7_mf(nx, ny, nz, ipc, rpc, cc, fc, a1cf, a2cf, a3cf, x, r, VNULL);
+}
+
+
+
 
 VPUBLIC void Vgsrb27x(int *nx,int *ny,int *nz,
         int *ipc, double *rpc,
@@ -333,3 +565,161 @@ VPUBLIC void Vgsrb27x(int *nx,int *ny,int *nz,
                      uNE, uNW, uSE, uSW,
                        x,   r);
 }
+
+
+
+VPUBLIC void Vgsmc(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc,
+        double *ac, double *cc, double *fc,
+        double *x, double *w1, double *w2, double *r,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iresid, int *iadjoint) {
+
+    int numdia; /// @todo: doc
+
+    MAT2(ac, *nx * *ny * *nz, 1);
+
+    // Red-black is already race-free for the 7-point stencil
+    numdia = VAT(ipc, 11);
+    if (numdia == 7 && VAT(ipc, 13) == 1) {
+        Vgsrb7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc, fc,
+                RAT2(ac, 1,1), RAT2(ac, 1,2), RAT2(ac, 1,3),
+                x, w1, w2, r,
+                itmax, iters, errtol, omega, iresid, iadjoint);
+    } else if (numdia == 7) {
+        Vgsrb7x(nx, ny, nz,
+                ipc, rpc,
+                RAT2(ac, 1,1), cc, fc,
+                RAT2(ac, 1,2), RAT2(ac, 1,3), RAT2(ac, 1,4),
+                x, w1, w2, r,
+                itmax, iters, errtol, omega, iresid, iadjoint);
+    } else if (numdia == 27) {
+        Vgsmc27x(nx, ny, nz,
+                 ipc, rpc,
+                 RAT2(ac, 1, 1), cc, fc,
+                 RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
+                 RAT2(ac, 1, 5), RAT2(ac, 1, 6),
+                 RAT2(ac, 1, 7), RAT2(ac, 1, 8), RAT2(ac, 1, 9), RAT2(ac, 1,10),
+                 RAT2(ac, 1,11), RAT2(ac, 1,12), RAT2(ac, 1,13), RAT2(ac, 1,14),
+                 x, w1, w2, r,
+                 itmax, iters, errtol, omega, iresid, iadjoint);
+    } else {
+        Vnm_print(2, "GSMC: invalid stencil type given...\n");
+    }
+}
+
+
+
+VPUBLIC void Vgsmc27x(int *nx,int *ny,int *nz,
+        int *ipc, double *rpc,
+        double  *oC, double  *cc, double  *fc,
+        double  *oE, double  *oN, double  *uC, double *oNE, double *oNW,
+        double  *uE, double  *uW, double  *uN, double  *uS,
+        double *uNE, double *uNW, double *uSE, double *uSW,
+        double *x, double *w1, double *w2, double *r,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iresid, int *iadjoint) {
+
+    int i, j, k;
+    int color, icolor;
+    int ioff, joff, koff;
+
+    double tmpO, tmpU, tmpD;
+
+    MAT3( cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+    MAT3(w1, *nx, *ny, *nz);
+    MAT3(w2, *nx, *ny, *nz);
+    MAT3( r, *nx, *ny, *nz);
+
+    MAT3(oE, *nx, *ny, *nz);
+    MAT3(oN, *nx, *ny, *nz);
+    MAT3(uC, *nx, *ny, *nz);
+    MAT3(oC, *nx, *ny, *nz);
+
+    MAT3(oNE, *nx, *ny, *nz);
+    MAT3(oNW, *nx, *ny, *nz);
+
+    MAT3( uE, *nx, *ny, *nz);
+    MAT3( uW, *nx, *ny, *nz);
+    MAT3( uN, *nx, *ny, *nz);
+    MAT3( uS, *nx, *ny, *nz);
+    MAT3(uNE, *nx, *ny, *nz);
+    MAT3(uNW, *nx, *ny, *nz);
+    MAT3(uSE, *nx, *ny, *nz);
+    MAT3(uSW, *nx, *ny, *nz);
+
+    // Do the gauss-seidel iteration itmax times
+    for (*iters=1; *iters<=*itmax; (*iters)++) {
+
+        for (icolor=0; icolor<8; icolor++) {
+
+            // The adjoint visits the colors in reverse order
+            color = (1 - *iadjoint) * icolor + (*iadjoint) * (7 - icolor);
+            ioff = color & 1;
+            joff = (color >> 1) & 1;
+            koff = (color >> 2) & 1;
+
+            #pragma omp parallel for private(i, j, k, tmpO, tmpU, tmpD)
+            for (k=2+koff; k<=*nz-1; k+=2) {
+
+                for (j=2+joff; j<=*ny-1; j+=2) {
+
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+
+                        tmpO =
+                             + VAT3(  oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                             + VAT3(  oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                             + VAT3(  oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                             + VAT3(  oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                             + VAT3( oNE,   i,   j,   k) * VAT3(x, i+1, j+1,   k)
+                             + VAT3( oNW,   i,   j,   k) * VAT3(x, i-1, j+1,   k)
+                             + VAT3( oNW, i+1, j-1,   k) * VAT3(x, i+1, j-1,   k)
+                             + VAT3( oNE, i-1, j-1,   k) * VAT3(x, i-1, j-1,   k);
+
+                        tmpU =
+                             + VAT3(  uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                             + VAT3(  uN,   i,   j,   k) * VAT3(x,   i, j+1, k+1)
+                             + VAT3(  uS,   i,   j,   k) * VAT3(x,   i, j-1, k+1)
+                             + VAT3(  uE,   i,   j,   k) * VAT3(x, i+1,   j, k+1)
+                             + VAT3(  uW,   i,   j,   k) * VAT3(x, i-1,   j, k+1)
+                             + VAT3( uNE,   i,   j,   k) * VAT3(x, i+1, j+1, k+1)
+                             + VAT3( uNW,   i,   j,   k) * VAT3(x, i-1, j+1, k+1)
+                             + VAT3( uSE,   i,   j,   k) * VAT3(x, i+1, j-1, k+1)
+                             + VAT3( uSW,   i,   j,   k) * VAT3(x, i-1, j-1, k+1);
+
+                        tmpD =
+                             + VAT3(  uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                             + VAT3(  uS,   i, j+1, k-1) * VAT3(x,   i, j+1, k-1)
+                             + VAT3(  uN,   i, j-1, k-1) * VAT3(x,   i, j-1, k-1)
+                             + VAT3(  uW, i+1,   j, k-1) * VAT3(x, i+1,   j, k-1)
+                             + VAT3(  uE, i-1,   j, k-1) * VAT3(x, i-1,   j, k-1)
+                             + VAT3( uSW, i+1, j+1, k-1) * VAT3(x, i+1, j+1, k-1)
+                             + VAT3( uSE, i-1, j+1, k-1) * VAT3(x, i-1, j+1, k-1)
+                             + VAT3( uNW, i+1, j-1, k-1) * VAT3(x, i+1, j-1, k-1)
+                             + VAT3( uNE, i-1, j-1, k-1) * VAT3(x, i-1, j-1, k-1);
+
+                        VAT3(x, i,j,k) = (VAT3(fc, i, j, k) + (tmpO + tmpU + tmpD))
+                                 / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+                    }
+                }
+            }
+        }
+    }
+
+    // If specified, return the new residual as well
+    if (*iresid == 1)
+        Vmresid27_1s(nx, ny, nz,
+                     ipc, rpc,
+                      oC,  cc,  fc,
+                      oE,  oN,  uC,
+                     oNE, oNW,
+                     uE,   uW,  uN,  uS,
+                     uNE, uNW, uSE, uSW,
+                       x,   r);
+}
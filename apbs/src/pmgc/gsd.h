@@ -108,6 +108,74 @@ VEXTERNC void Vgsrb7x(
         int    *iadjoint ///< @todo:  Doc
         );
 
+/** @brief   Red/black Gauss-Seidel with the residual restricted on the fly
+ *  @ingroup PMGC
+ *
+ *  Does what Vgsrb7x with iresid = 1 followed by Vrestrc does, in fewer
+ *  passes over the fine grid.  The second half-sweep of the last iteration
+ *  runs plane by plane; the residual of each plane is formed as soon as its
+ *  neighbors are final and is restricted into rc once the three fine planes
+ *  under a coarse plane are available.  The fine residual is never stored:
+ *  r only needs room for three planes (3*nx*ny).
+ */
+VEXTERNC void Vgsrb7rx(
+        int    *nx,      ///< @todo:  Doc
+        int    *ny,      ///< @todo:  Doc
+        int    *nz,      ///< @todo:  Doc
+        int    *nxc,     ///< Coarse grid size
+        int    *nyc,     ///< Coarse grid size
+        int    *nzc,     ///< Coarse grid size
+        int    *ipc,     ///< @todo:  Doc
+        double *rpc,     ///< @todo:  Doc
+        double *oC,      ///< @todo:  Doc
+        double *cc,      ///< @todo:  Doc
+        double *fc,      ///< @todo:  Doc
+        double *oE,      ///< @todo:  Doc
+        double *oN,      ///< @todo:  Doc
+        double *uC,      ///< @todo:  Doc
+        double *x,       ///< @todo:  Doc
+        double *w1,      ///< @todo:  Doc
+        double *w2,      ///< @todo:  Doc
+        double *r,       ///< Workspace for three residual planes
+        double *rc,      ///< Restricted residual on the coarse grid
+        double *pc,      ///< Prolongation operator of this level
+        int    *itmax,   ///< @todo:  Doc
+        int    *iters,   ///< @todo:  Doc
+        double *errtol,  ///< @todo:  Doc
+        double *omega,   ///< @todo:  Doc
+        int    *iadjoint ///< @todo:  Doc
+        );
+
+/** @brief   Red/black Gauss-Seidel for the matrix-free operator built by
+ *           VbuildA_mf.
+ *  @ingroup PMGC
+ *
+ *  Same sweep order as Vgsrb7x; the stencil is rebuilt on the fly from
+ *  the dielectric faces and the mesh scalings in rpc(2:4).
+ */
+VEXTERNC void Vgsrb7_mf(
+        int    *nx,        ///< @todo:  Doc
+        int    *ny,        ///< @todo:  Doc
+        int    *nz,        ///< @todo:  Doc
+        int    *ipc,       ///< @todo:  Doc
+        double *rpc,       ///< @todo:  Doc
+        double *cc,        ///< @todo:  Doc
+        double *fc,        ///< @todo:  Doc
+        double *a1cf,      ///< Dielectric on the x-shifted mesh
+        double *a2cf,      ///< Dielectric on the y-shifted mesh
+        double *a3cf,      ///< Dielectric on the z-shifted mesh
+        double *x,         ///< @todo:  Doc
+        double *w1,        ///< @todo:  Doc
+        double *w2,        ///< @todo:  Doc
+        double *r,         ///< @todo:  Doc
+        int    *itmax,     ///< @todo:  Doc
+        int    *iters,     ///< @todo:  Doc
+        double *errtol,    ///< @todo:  Doc
+        double *omega,     ///< @todo:  Doc
+        int    *iresid,    ///< @todo:  Doc
+        int    *iadjoint   ///< @todo:  Doc
+        );
+
 VEXTERNC void Vgsrb27x(
         int *nx,        ///< @todo:  Doc
         int *ny,        ///< @todo:  Doc
@@ -143,4 +211,74 @@ VEXTERNC void Vgsrb27x(
         );
 
 
+/** @brief   Call the multicolor Gauss-Seidel method.
+ *  @ingroup PMGC
+ *
+ *  Unlike Vgsrb, this smoother is race-free under threading for both
+ *  stencils:  the 7-point operator is swept in red-black order, and the
+ *  27-point operator in an 8-color order (see Vgsmc27x).
+ */
+VEXTERNC void Vgsmc(
+        int    *nx,      ///< @todo:  Doc
+        int    *ny,      ///< @todo:  Doc
+        int    *nz,      ///< @todo:  Doc
+        int    *ipc,     ///< @todo:  Doc
+        double *rpc,     ///< @todo:  Doc
+        double *ac,      ///< @todo:  Doc
+        double *cc,      ///< @todo:  Doc
+        double *fc,      ///< @todo:  Doc
+        double *x,       ///< @todo:  Doc
+        double *w1,      ///< @todo:  Doc
+        double *w2,      ///< @todo:  Doc
+        double *r,       ///< @todo:  Doc
+        int    *itmax,   ///< @todo:  Doc
+        int    *iters,   ///< @todo:  Doc
+        double *errtol,  ///< @todo:  Doc
+        double *omega,   ///< @todo:  Doc
+        int    *iresid,  ///< @todo:  Doc
+        int    *iadjoint ///< @todo:  Doc
+        );
+
+/** @brief   8-color Gauss-Seidel sweep for the 27-point operator.
+ *  @ingroup PMGC
+ *
+ *  Points are colored by the parity of (i, j, k).  No two points of the same
+ *  color are coupled by the 27-point stencil, so each color is updated in
+ *  parallel over z-planes.  The adjoint sweep visits the colors in reverse
+ *  order so that pre- and post-smoothing remain symmetric.
+ */
+VEXTERNC void Vgsmc27x(
+        int *nx,        ///< @todo:  Doc
+        int *ny,        ///< @todo:  Doc
+        int *nz,        ///< @todo:  Doc
+        int *ipc,       ///< @todo:  Doc
+        double *rpc,    ///< @todo:  Doc
+        double  *oC,    ///< @todo:  Doc
+        double  *cc,    ///< @todo:  Doc
+        double  *fc,    ///< @todo:  Doc
+        double  *oE,    ///< @todo:  Doc
+        double  *oN,    ///< @todo:  Doc
+        double  *uC,    ///< @todo:  Doc
+        double *oNE,    ///< @todo:  Doc
+        double *oNW,    ///< @todo:  Doc
+        double  *uE,    ///< @todo:  Doc
+        double  *uW,    ///< @todo:  Doc
+        double  *uN,    ///< @todo:  Doc
+        double  *uS,    ///< @todo:  Doc
+        double *uNE,    ///< @todo:  Doc
+        double *uNW,    ///< @todo:  Doc
+        double *uSE,    ///< @todo:  Doc
+        double *uSW,    ///< @todo:  Doc
+        double *x,      ///< @todo:  Doc
+        double *w1,     ///< @todo:  Doc
+        double *w2,     ///< @todo:  Doc
+        double *r,      ///< @todo:  Doc
+        int *itmax,     ///< @todo:  Doc
+        int *iters,     ///< @todo:  Doc
+        double *errtol, ///< @todo:  Doc
+        double *omega,  ///< @todo:  Doc
+        int *iresid,    ///< @todo:  Doc
+        int *iadjoint   ///< @todo:  Doc
+        );
+
 #endif /* _GSD_H_ */
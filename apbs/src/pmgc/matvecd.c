@@ -81,11 +81,19 @@ VPUBLIC void Vmatvec7(int *nx, int *ny, int *nz,
 
     MAT2(ac, *nx * *ny * *nz, 1);
 
-    Vmatvec7_1s(nx, ny, nz,
-                ipc,     rpc,
-            RAT2(ac, 1, 1),      cc,
-            RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
-                  x,      y);
+    if (VAT(ipc, 13) == 1) {
+        Vmatvec7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc,
+                RAT2(ac, 1, 1), RAT2(ac, 1, 2), RAT2(ac, 1, 3),
+                x, y, VNULL);
+    } else {
+        Vmatvec7_1s(nx, ny, nz,
+                    ipc,     rpc,
+                RAT2(ac, 1, 1),      cc,
+                RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
+                      x,      y);
+    }
 }
 
 
@@ -106,6 +114,10 @@ VEXTERNC void Vmatvec7_1s(int *nx, int *ny, int *nz,
     MAT3(x, *nx, *ny, *nz);
     MAT3(y, *nx, *ny, *nz);
 
+    // Use the vectorized kernel when the processor supports one
+    if (Vmatvec7_simd(nx, ny, nz, oC, cc, oE, oN, uC, x, y))
+        return;
+
     // Do it
     #pragma omp parallel for private(i, j, k)
     for (k=2; k<=*nz-1; k++) {
@@ -125,6 +137,76 @@ VEXTERNC void Vmatvec7_1s(int *nx, int *ny, int *nz,
 }
 
 
+VPUBLIC void Vmatvec7_mf(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc,
+        double *cc,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *x, double *y, double *w1) {
+
+    int i, j, k;
+    double sE, sN, sU;
+    double aE, aW, aN, aS, aU, aD, oC;
+
+    MAT3(a1cf, *nx, *ny, *nz);
+    MAT3(a2cf, *nx, *ny, *nz);
+    MAT3(a3cf, *nx, *ny, *nz);
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+    MAT3( y, *nx, *ny, *nz);
+    MAT3(w1, *nx, *ny, *nz);
+
+    // Face scalings of the uniform mesh, from VbuildA_mf
+    sE = VAT(rpc, 2);
+    sN = VAT(rpc, 3);
+    sU = VAT(rpc, 4);
+
+    #pragma omp parallel for private(i, j, k, aE, aW, aN, aS, aU, aD, oC)
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                // Rebuild the diagonal, then drop the boundary couplings
+                aE = sE * VAT3(a1cf,   i,   j,   k);
+                aW = sE * VAT3(a1cf, i-1,   j,   k);
+                aN = sN * VAT3(a2cf,   i,   j,   k);
+                aS = sN * VAT3(a2cf,   i, j-1,   k);
+                aU = sU * VAT3(a3cf,   i,   j,   k);
+                aD = sU * VAT3(a3cf,   i,   j, k-1);
+                oC = aE + aW + aN + aS + aU + aD;
+                if (i == *nx-1) aE = 0.0;
+                if (i == 2)     aW = 0.0;
+                if (j == *ny-1) aN = 0.0;
+                if (j == 2)     aS = 0.0;
+                if (k == *nz-1) aU = 0.0;
+                if (k == 2)     aD = 0.0;
+
+                if (w1 == VNULL) {
+                    VAT3(y, i, j, k) =
+                            - aN * VAT3(x,   i, j+1,   k)
+                            - aS * VAT3(x,   i, j-1,   k)
+                            - aE * VAT3(x, i+1,   j,   k)
+                            - aW * VAT3(x, i-1,   j,   k)
+                            - aD * VAT3(x,   i,   j, k-1)
+                            - aU * VAT3(x,   i,   j, k+1)
+                            + (oC + VAT3(cc, i, j, k)) * VAT3(x, i, j, k);
+                } else {
+                    VAT3(y, i, j, k) =
+                            - aN * VAT3(x,   i, j+1,   k)
+                            - aS * VAT3(x,   i, j-1,   k)
+                            - aE * VAT3(x, i+1,   j,   k)
+                            - aW * VAT3(x, i-1,   j,   k)
+                            - aD * VAT3(x,   i,   j, k-1)
+                            - aU * VAT3(x,   i,   j, k+1)
+                            + oC * VAT3(x, i, j, k)
+                            + VAT3(w1, i, j, k);
+                }
+            }
+        }
+    }
+}
+
+
+
 
 VPUBLIC void Vmatvec27(int *nx, int *ny, int *nz,
         int    *ipc, double *rpc,
@@ -255,15 +337,27 @@ VPUBLIC void Vnmatvec7(int *nx, int *ny, int *nz,
         double  *ac, double  *cc,
         double   *x, double   *y, double *w1) {
 
+    int ipkey;
+
     MAT2(ac, *nx * *ny * *nz, 1);
 
     WARN_UNTESTED;
 
-    Vnmatvecd7_1s(nx, ny, nz,
-            ipc, rpc,
-            RAT2(ac, 1, 1), cc,
-            RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
-            x, y, w1);
+    if (VAT(ipc, 13) == 1) {
+        ipkey = VAT(ipc, 10);
+        Vc_vec(cc, x, w1, nx, ny, nz, &ipkey);
+        Vmatvec7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc,
+                RAT2(ac, 1, 1), RAT2(ac, 1, 2), RAT2(ac, 1, 3),
+                x, y, w1);
+    } else {
+        Vnmatvecd7_1s(nx, ny, nz,
+                ipc, rpc,
+                RAT2(ac, 1, 1), cc,
+                RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
+                x, y, w1);
+    }
 }
 
 
@@ -446,11 +540,19 @@ VPUBLIC void Vmresid7(int *nx, int *ny, int *nz,
     MAT2(ac, *nx * *ny * *nz, 1);
 
     // Do in one step
-    Vmresid7_1s(nx, ny, nz,
-            ipc, rpc,
-            RAT2(ac, 1,1), cc, fc,
-            RAT2(ac, 1,2), RAT2(ac, 1,3), RAT2(ac, 1,4),
-            x,r);
+    if (VAT(ipc, 13) == 1) {
+        Vmresid7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc, fc,
+                RAT2(ac, 1,1), RAT2(ac, 1,2), RAT2(ac, 1,3),
+                x, r, VNULL);
+    } else {
+        Vmresid7_1s(nx, ny, nz,
+                ipc, rpc,
+                RAT2(ac, 1,1), cc, fc,
+                RAT2(ac, 1,2), RAT2(ac, 1,3), RAT2(ac, 1,4),
+                x,r);
+    }
 }
 
 VPUBLIC void Vmresid7_1s(int *nx, int *ny, int *nz,
@@ -470,6 +572,10 @@ VPUBLIC void Vmresid7_1s(int *nx, int *ny, int *nz,
     MAT3(x, *nx, *ny, *nz);
     MAT3(r, *nx, *ny, *nz);
 
+    // Use the vectorized kernel when the processor supports one
+    if (Vmresid7_simd(nx, ny, nz, oC, cc, fc, oE, oN, uC, x, r, VNULL))
+        return;
+
     // Do it
     #pragma omp parallel for private(i, j, k)
     for (k=2; k<=*nz-1; k++) {
@@ -488,6 +594,76 @@ VPUBLIC void Vmresid7_1s(int *nx, int *ny, int *nz,
     }
 }
 
+VPUBLIC void Vmresid7_mf(int *nx, int *ny, int *nz,
+        int *ipc, double *rpc,
+        double *cc, double *fc,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *x, double *r, double *w1) {
+
+    int i, j, k;
+    double sE, sN, sU;
+    double aE, aW, aN, aS, aU, aD, oC;
+
+    MAT3(a1cf, *nx, *ny, *nz);
+    MAT3(a2cf, *nx, *ny, *nz);
+    MAT3(a3cf, *nx, *ny, *nz);
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+    MAT3( r, *nx, *ny, *nz);
+    MAT3(w1, *nx, *ny, *nz);
+
+    // Face scalings of the uniform mesh, from VbuildA_mf
+    sE = VAT(rpc, 2);
+    sN = VAT(rpc, 3);
+    sU = VAT(rpc, 4);
+
+    #pragma omp parallel for private(i, j, k, aE, aW, aN, aS, aU, aD, oC)
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                // Rebuild the diagonal, then drop the boundary couplings
+                aE = sE * VAT3(a1cf,   i,   j,   k);
+                aW = sE * VAT3(a1cf, i-1,   j,   k);
+                aN = sN * VAT3(a2cf,   i,   j,   k);
+                aS = sN * VAT3(a2cf,   i, j-1,   k);
+                aU = sU * VAT3(a3cf,   i,   j,   k);
+                aD = sU * VAT3(a3cf,   i,   j, k-1);
+                oC = aE + aW + aN + aS + aU + aD;
+                if (i == *nx-1) aE = 0.0;
+                if (i == 2)     aW = 0.0;
+                if (j == *ny-1) aN = 0.0;
+                if (j == 2)     aS = 0.0;
+                if (k == *nz-1) aU = 0.0;
+                if (k == 2)     aD = 0.0;
+
+                if (w1 == VNULL) {
+                    VAT3(r, i, j, k) = VAT3(fc, i, j, k)
+                            + aN * VAT3(x,   i, j+1,   k)
+                            + aS * VAT3(x,   i, j-1,   k)
+                            + aE * VAT3(x, i+1,   j,   k)
+                            + aW * VAT3(x, i-1,   j,   k)
+                            + aD * VAT3(x,   i,   j, k-1)
+                            + aU * VAT3(x,   i,   j, k+1)
+                            - (oC + VAT3(cc, i, j, k)) * VAT3(x, i, j, k);
+                } else {
+                    VAT3(r, i, j, k) = VAT3(fc, i, j, k)
+                            + aN * VAT3(x,   i, j+1,   k)
+                            + aS * VAT3(x,   i, j-1,   k)
+                            + aE * VAT3(x, i+1,   j,   k)
+                            + aW * VAT3(x, i-1,   j,   k)
+                            + aD * VAT3(x,   i,   j, k-1)
+                            + aU * VAT3(x,   i,   j, k+1)
+                            - oC * VAT3(x, i, j, k)
+                            - VAT3(w1, i, j, k);
+                }
+            }
+        }
+    }
+}
+
+
 
 
 VPUBLIC void Vmresid27(int *nx, int *ny, int *nz,
@@ -615,14 +791,26 @@ VPUBLIC void Vnmresid7(int *nx, int *ny, int *nz,
         double *ac, double *cc, double *fc,
         double *x, double *r, double *w1) {
 
+    int ipkey;
+
     MAT2(ac, *nx * *ny * *nz, 1);
 
     // Do in oNe step
-    Vnmresid7_1s(nx, ny, nz,
-            ipc, rpc,
-            RAT2(ac, 1, 1), cc, fc,
-            RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
-            x, r, w1);
+    if (VAT(ipc, 13) == 1) {
+        ipkey = VAT(ipc, 10);
+        Vc_vec(cc, x, w1, nx, ny, nz, &ipkey);
+        Vmresid7_mf(nx, ny, nz,
+                ipc, rpc,
+                cc, fc,
+                RAT2(ac, 1, 1), RAT2(ac, 1, 2), RAT2(ac, 1, 3),
+                x, r, w1);
+    } else {
+        Vnmresid7_1s(nx, ny, nz,
+                ipc, rpc,
+                RAT2(ac, 1, 1), cc, fc,
+                RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4),
+                x, r, w1);
+    }
 }
 
 VPUBLIC void Vnmresid7_1s(int *nx, int *ny, int *nz,
@@ -648,6 +836,10 @@ VPUBLIC void Vnmresid7_1s(int *nx, int *ny, int *nz,
     ipkey = VAT(ipc, 10);
     Vc_vec(cc, x, w1, nx, ny, nz, &ipkey);
 
+    // Use the vectorized kernel when the processor supports one
+    if (Vmresid7_simd(nx, ny, nz, oC, cc, fc, oE, oN, uC, x, r, w1))
+        return;
+
     // The residual
     for (k=2; k<=*nz-1; k++) {
         for (j=2; j<=*ny-1; j++) {
@@ -907,6 +1099,72 @@ VEXTERNC void Vrestrc2(int *nxf, int *nyf, int *nzf,
 
 
 
+VPUBLIC void Vrestrcpl(int *nxf, int *nyf,
+        int *nxc, int *nyc, int *nzc, int k,
+        double *xind, double *xino, double *xinu,
+        double *xout, double *pc) {
+
+    int  i,  j;
+    int ii, jj;
+    int  q;
+
+    double tmpO, tmpU, tmpD;
+
+    MAT2(xind, *nxf, *nyf);
+    MAT2(xino, *nxf, *nyf);
+    MAT2(xinu, *nxf, *nyf);
+    MAT3(xout, *nxc, *nyc, *nzc);
+    MAT2(  pc, *nxc * *nyc * *nzc, 27);
+
+    // Same terms, in the same order, as the interior loop of Vrestrc2
+    #pragma omp parallel for private(j, jj, i, ii, q, tmpO, tmpU, tmpD)
+    for (j=2; j<=*nyc-1; j++) {
+        jj = (j - 1) * 2 + 1;
+
+        for (i=2; i<=*nxc-1; i++) {
+            ii = (i - 1) * 2 + 1;
+            q = i + (j - 1) * *nxc + (k - 1) * *nxc * *nyc;
+
+            tmpO =
+                 + VAT2(pc, q,  1) * VAT2(xino,   ii,   jj)
+                 + VAT2(pc, q,  2) * VAT2(xino,   ii, jj+1)
+                 + VAT2(pc, q,  3) * VAT2(xino,   ii, jj-1)
+                 + VAT2(pc, q,  4) * VAT2(xino, ii+1,   jj)
+                 + VAT2(pc, q,  5) * VAT2(xino, ii-1,   jj)
+                 + VAT2(pc, q,  6) * VAT2(xino, ii+1, jj+1)
+                 + VAT2(pc, q,  7) * VAT2(xino, ii-1, jj+1)
+                 + VAT2(pc, q,  8) * VAT2(xino, ii+1, jj-1)
+                 + VAT2(pc, q,  9) * VAT2(xino, ii-1, jj-1);
+
+            tmpU =
+                 + VAT2(pc, q, 10) * VAT2(xinu,   ii,   jj)
+                 + VAT2(pc, q, 11) * VAT2(xinu,   ii, jj+1)
+                 + VAT2(pc, q, 12) * VAT2(xinu,   ii, jj-1)
+                 + VAT2(pc, q, 13) * VAT2(xinu, ii+1,   jj)
+                 + VAT2(pc, q, 14) * VAT2(xinu, ii-1,   jj)
+                 + VAT2(pc, q, 15) * VAT2(xinu, ii+1, jj+1)
+                 + VAT2(pc, q, 16) * VAT2(xinu, ii-1, jj+1)
+                 + VAT2(pc, q, 17) * VAT2(xinu, ii+1, jj-1)
+                 + VAT2(pc, q, 18) * VAT2(xinu, ii-1, jj-1);
+
+            tmpD =
+                 + VAT2(pc, q, 19) * VAT2(xind,   ii,   jj)
+                 + VAT2(pc, q, 20) * VAT2(xind,   ii, jj+1)
+                 + VAT2(pc, q, 21) * VAT2(xind,   ii, jj-1)
+                 + VAT2(pc, q, 22) * VAT2(xind, ii+1,   jj)
+                 + VAT2(pc, q, 23) * VAT2(xind, ii-1,   jj)
+                 + VAT2(pc, q, 24) * VAT2(xind, ii+1, jj+1)
+                 + VAT2(pc, q, 25) * VAT2(xind, ii-1, jj+1)
+                 + VAT2(pc, q, 26) * VAT2(xind, ii+1, jj-1)
+                 + VAT2(pc, q, 27) * VAT2(xind, ii-1, jj-1);
+
+            VAT3(xout, i, j, k) = tmpO + tmpU + tmpD;
+        }
+    }
+}
+
+
+
 VPUBLIC void VinterpPMG(int *nxc, int *nyc, int *nzc,
         int *nxf, int *nyf, int *nzf,
         double *xin, double *xout,
@@ -55,6 +55,7 @@
 #include "generic/vmatrix.h"
 #include "pmgc/mikpckd.h"
 #include "pmgc/mypdec.h"
+#include "pmgc/simdd.h"
 
 /** @brief   Break the matrix data-structure into diagonals and
  *           then call the matrix-vector routine.
@@ -102,6 +103,29 @@ VEXTERNC void Vmatvec7_1s(
         double *y    ///< @todo:  Doc
         );
 
+/** @brief   Matrix-vector product for the matrix-free operator built by
+ *           VbuildA_mf.
+ *  @ingroup PMGC
+ *
+ *  The stencil is rebuilt on the fly from the dielectric faces and the
+ *  mesh scalings in rpc(2:4).  If w1 is VNULL the linear product (with cc)
+ *  is formed; otherwise w1 holds the nonlinear term from Vc_vec.
+ */
+VEXTERNC void Vmatvec7_mf(
+        int    *nx,  ///< @todo:  Doc
+        int    *ny,  ///< @todo:  Doc
+        int    *nz,  ///< @todo:  Doc
+        int    *ipc, ///< @todo:  Doc
+        double *rpc, ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *a1cf, ///< Dielectric on the x-shifted mesh
+        double *a2cf, ///< Dielectric on the y-shifted mesh
+        double *a3cf, ///< Dielectric on the z-shifted mesh
+        double *x,   ///< @todo:  Doc
+        double *y,   ///< @todo:  Doc
+        double *w1   ///< Nonlinear term, or VNULL
+        );
+
 
 
 VEXTERNC void Vmatvec27(
@@ -280,6 +304,29 @@ VEXTERNC void Vmresid7_1s(
         double *r    ///< @todo:  Doc
         );
 
+/** @brief   Residual for the matrix-free operator built by VbuildA_mf.
+ *  @ingroup PMGC
+ *
+ *  The stencil is rebuilt on the fly as in Vmatvec7_mf.  If w1 is VNULL
+ *  the linear residual (with cc) is formed; otherwise w1 holds the
+ *  nonlinear term from Vc_vec.
+ */
+VEXTERNC void Vmresid7_mf(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        int *ipc,    ///< @todo:  Doc
+        double *rpc, ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *fc,  ///< @todo:  Doc
+        double *a1cf, ///< Dielectric on the x-shifted mesh
+        double *a2cf, ///< Dielectric on the y-shifted mesh
+        double *a3cf, ///< Dielectric on the z-shifted mesh
+        double *x,   ///< @todo:  Doc
+        double *r,   ///< @todo:  Doc
+        double *w1   ///< Nonlinear term, or VNULL
+        );
+
 VEXTERNC void Vmresid27(
         int    *nx,  ///< @todo:  Doc
         int    *ny,  ///< @todo:  Doc
@@ -434,6 +481,28 @@ VEXTERNC void Vrestrc(
         double *pc    ///< @todo:  Doc
         );
 
+/** @brief   Restrict one coarse plane from three fine planes
+ *  @ingroup PMGC
+ *
+ *  Computes the interior of coarse plane k exactly as Vrestrc does, reading
+ *  the fine planes 2k-2, 2k-1 and 2k from separate nxf*nyf arrays.  This
+ *  lets a caller restrict a residual while it is still being produced
+ *  plane by plane, without storing the whole fine grid vector.
+ */
+VEXTERNC void Vrestrcpl(
+        int *nxf,      ///< @todo:  Doc
+        int *nyf,      ///< @todo:  Doc
+        int *nxc,      ///< @todo:  Doc
+        int *nyc,      ///< @todo:  Doc
+        int *nzc,      ///< @todo:  Doc
+        int k,         ///< Coarse plane to compute (2 <= k <= nzc-1)
+        double *xind,  ///< Fine plane 2k-2
+        double *xino,  ///< Fine plane 2k-1
+        double *xinu,  ///< Fine plane 2k
+        double *xout,  ///< @todo:  Doc
+        double *pc     ///< @todo:  Doc
+        );
+
 VEXTERNC void Vrestrc2(
         int    *nxf,///< @todo:  Doc
         int    *nyf,///< @todo:  Doc
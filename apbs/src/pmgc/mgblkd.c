@@ -0,0 +1,1113 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Block multigrid: one v-cycle hierarchy applied to several
+ *          right-hand sides stored interleaved per grid point
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+
+#include "mgblkd.h"
+
+/* Right-hand sides accumulated together by the 27-point kernels */
+#define VBLK_CHUNK 4
+
+/*
+ * Block vectors store the nrhs values of grid point p = (i-1) + (j-1)*nx +
+ * (k-1)*nx*ny at x[p*nrhs .. p*nrhs+nrhs-1].  The operator, Helmholtz and
+ * prolongation arrays keep their scalar layout (see Vgsrb and Vrestrc2);
+ * each kernel loads the coefficients of a point once and then sweeps the
+ * nrhs right-hand sides.
+ */
+
+/* Off-diagonal stencil of one level: coefficient array, offset of the
+ * coefficient from the center point, offset of the neighbor */
+typedef struct sVblkstencil {
+    int nnb;
+    double *oC;
+    double *coef[26];
+    int coff[26];
+    int xoff[26];
+} Vblkstencil;
+
+VPRIVATE void Vblkstencil_set(Vblkstencil *st, int m, double *coef,
+        int coff, int xoff) {
+
+    st->coef[m] = coef;
+    st->coff[m] = coff;
+    st->xoff[m] = xoff;
+}
+
+VPRIVATE void Vblkstencil_init(Vblkstencil *st, int *nx, int *ny, int *nz,
+        int *ipc, double *ac) {
+
+    int n  = *nx * *ny * *nz;
+    int sy = *nx;
+    int sz = *nx * *ny;
+
+    double  *oE = ac +      n;
+    double  *oN = ac +  2 * n;
+    double  *uC = ac +  3 * n;
+    double *oNE = ac +  4 * n;
+    double *oNW = ac +  5 * n;
+    double  *uE = ac +  6 * n;
+    double  *uW = ac +  7 * n;
+    double  *uN = ac +  8 * n;
+    double  *uS = ac +  9 * n;
+    double *uNE = ac + 10 * n;
+    double *uNW = ac + 11 * n;
+    double *uSE = ac + 12 * n;
+    double *uSW = ac + 13 * n;
+
+    VASSERT_MSG1(VAT(ipc, 11) == 27, "Invalid stencil type: %d", VAT(ipc, 11));
+
+    st->oC = ac;
+
+    // The 7-point neighbors, in the order of Vgsrb7x
+    Vblkstencil_set(st,  0,  oN,       0,  sy);
+    Vblkstencil_set(st,  1,  oN,     -sy, -sy);
+    Vblkstencil_set(st,  2,  oE,       0,   1);
+    Vblkstencil_set(st,  3,  oE,      -1,  -1);
+    Vblkstencil_set(st,  4,  uC,     -sz, -sz);
+    Vblkstencil_set(st,  5,  uC,       0,  sz);
+
+
+    // The rest of the 27-point stencil, as in Vgsrb27x
+    Vblkstencil_set(st,  6, oNE,       0,  1+sy);
+    Vblkstencil_set(st,  7, oNW,       0, -1+sy);
+    Vblkstencil_set(st,  8, oNW,  1-sy,     1-sy);
+    Vblkstencil_set(st,  9, oNE, -1-sy,    -1-sy);
+
+    Vblkstencil_set(st, 10,  uN,       0,    sy+sz);
+    Vblkstencil_set(st, 11,  uS,       0,   -sy+sz);
+    Vblkstencil_set(st, 12,  uE,       0,     1+sz);
+    Vblkstencil_set(st, 13,  uW,       0,    -1+sz);
+    Vblkstencil_set(st, 14, uNE,       0,  1+sy+sz);
+    Vblkstencil_set(st, 15, uNW,       0, -1+sy+sz);
+    Vblkstencil_set(st, 16, uSE,       0,  1-sy+sz);
+    Vblkstencil_set(st, 17, uSW,       0, -1-sy+sz);
+
+    Vblkstencil_set(st, 18,  uS,  sy-sz,    sy-sz);
+    Vblkstencil_set(st, 19,  uN, -sy-sz,   -sy-sz);
+    Vblkstencil_set(st, 20,  uW,   1-sz,     1-sz);
+    Vblkstencil_set(st, 21,  uE,  -1-sz,    -1-sz);
+    Vblkstencil_set(st, 22, uSW,  1+sy-sz,  1+sy-sz);
+    Vblkstencil_set(st, 23, uSE, -1+sy-sz, -1+sy-sz);
+    Vblkstencil_set(st, 24, uNW,  1-sy-sz,  1-sy-sz);
+    Vblkstencil_set(st, 25, uNE, -1-sy-sz, -1-sy-sz);
+
+    st->nnb = 26;
+}
+
+VPRIVATE void Vblkbound00(int *nx, int *ny, int *nz, int nrhs, double *x) {
+
+    int i, j, k, r;
+    int sy = *nx;
+    int sz = *nx * *ny;
+
+    for (k=0; k<*nz; k++) {
+        for (j=0; j<*ny; j++) {
+            for (r=0; r<nrhs; r++) {
+                x[(size_t)(k*sz + j*sy)         * nrhs + r] = 0.0;
+                x[(size_t)(k*sz + j*sy + *nx-1) * nrhs + r] = 0.0;
+            }
+        }
+        for (i=0; i<*nx; i++) {
+            for (r=0; r<nrhs; r++) {
+                x[(size_t)(k*sz + i)               * nrhs + r] = 0.0;
+                x[(size_t)(k*sz + (*ny-1)*sy + i) * nrhs + r] = 0.0;
+            }
+        }
+    }
+    for (j=0; j<*ny; j++) {
+        for (i=0; i<*nx; i++) {
+            for (r=0; r<nrhs; r++) {
+                x[(size_t)(j*sy + i)                 * nrhs + r] = 0.0;
+                x[(size_t)((*nz-1)*sz + j*sy + i) * nrhs + r] = 0.0;
+            }
+        }
+    }
+}
+
+VPRIVATE void Vblkzeros(int *nx, int *ny, int *nz, int nrhs, double *x) {
+
+    size_t i, n = (size_t)*nx * *ny * *nz * nrhs;
+
+    for (i=0; i<n; i++)
+        x[i] = 0.0;
+}
+
+/* Per right-hand side sums over the interior: xnrm1 (y == VNULL) or x.y */
+VPRIVATE void Vblkreduce(int *nx, int *ny, int *nz, int nrhs,
+        double *x, double *y, double *out) {
+
+    int i, j, k, r;
+    size_t p;
+
+    for (r=0; r<nrhs; r++)
+        out[r] = 0.0;
+
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+                p = (size_t)(((k - 1) * *ny + (j - 1)) * *nx + (i - 1)) * nrhs;
+                if (y == VNULL) {
+                    for (r=0; r<nrhs; r++)
+                        out[r] += VABS(x[p + r]);
+                } else {
+                    for (r=0; r<nrhs; r++)
+                        out[r] += x[p + r] * y[p + r];
+                }
+            }
+        }
+    }
+}
+
+/* Red/black Gauss-Seidel for the 7-point operator (Vgsrb7x) */
+VPRIVATE void Vblkgs7(int *nx, int *ny, int *nz, int nrhs,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC, double *x,
+        int itmax, int iadjoint) {
+
+    int i, j, k, r, ioff, iters, color;
+    int p;
+    int sy = *nx;
+    int sz = *nx * *ny;
+    int xy = sy * nrhs;
+    int xz = sz * nrhs;
+
+    double rdiag, cN, cS, cE, cW, cD, cU;
+    double *xp, *fp;
+
+    for (iters=1; iters<=itmax; iters++) {
+
+        // Red points first (black first for the adjoint)
+        for (color=0; color<=1; color++) {
+            #pragma omp parallel for private(i, j, k, r, p, ioff, rdiag, cN, cS, cE, cW, cD, cU, xp, fp)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff = (j + k + color + iadjoint) % 2;
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+
+                        p  = ((k - 1) * *ny + (j - 1)) * *nx + (i - 1);
+                        xp = x  + (size_t)p * nrhs;
+                        fp = fc + (size_t)p * nrhs;
+
+                        // Coefficients once, then every right-hand side
+                        cN = oN[p];
+                        cS = oN[p - sy];
+                        cE = oE[p];
+                        cW = oE[p - 1];
+                        cD = uC[p - sz];
+                        cU = uC[p];
+                        rdiag = 1.0 / (oC[p] + cc[p]);
+
+                        for (r=0; r<nrhs; r++) {
+                            xp[r] = (fp[r]
+                                  + cN * xp[ xy + r] + cS * xp[-xy + r]
+                                  + cE * xp[nrhs + r] + cW * xp[r - nrhs]
+                                  + cD * xp[-xz + r] + cU * xp[ xz + r])
+                                  * rdiag;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Red/black Gauss-Seidel on every right-hand side (Vgsrb) */
+VPRIVATE void Vblkgs(int *nx, int *ny, int *nz, int nrhs,
+        int *ipc, double *ac, double *cc, double *fc, double *x,
+        int itmax, int iadjoint) {
+
+    int i, j, k, m, r, t, ioff, iters, color;
+    int p;
+    int n = *nx * *ny * *nz;
+    int xo[26];
+
+    double acc, rdiag;
+    double acc4[VBLK_CHUNK];
+    double c[26];
+    double *xp, *xq, *fp;
+
+    Vblkstencil st;
+
+    if (VAT(ipc, 11) == 7) {
+        VASSERT_MSG0(VAT(ipc, 13) == 0,
+            "Block multigrid needs an assembled operator");
+        Vblkgs7(nx, ny, nz, nrhs, ac, cc, fc, ac + n, ac + 2 * n, ac + 3 * n,
+                x, itmax, iadjoint);
+        return;
+    }
+
+    Vblkstencil_init(&st, nx, ny, nz, ipc, ac);
+    for (m=0; m<st.nnb; m++)
+        xo[m] = st.xoff[m] * nrhs;
+
+    for (iters=1; iters<=itmax; iters++) {
+
+        // Red points first (black first for the adjoint)
+        for (color=0; color<=1; color++) {
+            #pragma omp parallel for private(i, j, k, m, r, t, p, ioff, acc, rdiag, acc4, c, xp, xq, fp)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff = (j + k + color + iadjoint) % 2;
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+
+                        p  = ((k - 1) * *ny + (j - 1)) * *nx + (i - 1);
+                        xp = x  + (size_t)p * nrhs;
+                        fp = fc + (size_t)p * nrhs;
+
+                        // Coefficients once, then every right-hand side
+                        for (m=0; m<st.nnb; m++)
+                            c[m] = st.coef[m][p + st.coff[m]];
+                        rdiag = 1.0 / (st.oC[p] + cc[p]);
+
+                        for (r=0; r+VBLK_CHUNK<=nrhs; r+=VBLK_CHUNK) {
+                            for (t=0; t<VBLK_CHUNK; t++)
+                                acc4[t] = fp[r+t];
+                            for (m=0; m<st.nnb; m++) {
+                                xq = xp + xo[m] + r;
+                                for (t=0; t<VBLK_CHUNK; t++)
+                                    acc4[t] += c[m] * xq[t];
+                            }
+                            for (t=0; t<VBLK_CHUNK; t++)
+                                xp[r+t] = acc4[t] * rdiag;
+                        }
+                        for (; r<nrhs; r++) {
+                            acc = fp[r];
+                            for (m=0; m<st.nnb; m++)
+                                acc += c[m] * xp[xo[m] + r];
+                            xp[r] = acc * rdiag;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* y = A x (fc == VNULL) or y = f - A x for the 7-point operator */
+VPRIVATE void Vblkapply7(int *nx, int *ny, int *nz, int nrhs,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC, double *x, double *y) {
+
+    int i, j, k, r;
+    int p;
+    int sy = *nx;
+    int sz = *nx * *ny;
+    int xy = sy * nrhs;
+    int xz = sz * nrhs;
+
+    double diag, cN, cS, cE, cW, cD, cU;
+    double *xp, *yp, *fp;
+
+    #pragma omp parallel for private(i, j, k, r, p, diag, cN, cS, cE, cW, cD, cU, xp, yp, fp)
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                p  = ((k - 1) * *ny + (j - 1)) * *nx + (i - 1);
+                xp = x + (size_t)p * nrhs;
+                yp = y + (size_t)p * nrhs;
+
+                cN = oN[p];
+                cS = oN[p - sy];
+                cE = oE[p];
+                cW = oE[p - 1];
+                cD = uC[p - sz];
+                cU = uC[p];
+                diag = oC[p] + cc[p];
+
+                if (fc == VNULL) {
+                    for (r=0; r<nrhs; r++) {
+                        yp[r] = diag * xp[r]
+                              - cN * xp[ xy + r] - cS * xp[-xy + r]
+                              - cE * xp[nrhs + r] - cW * xp[r - nrhs]
+                              - cD * xp[-xz + r] - cU * xp[ xz + r];
+                    }
+                } else {
+                    fp = fc + (size_t)p * nrhs;
+                    for (r=0; r<nrhs; r++) {
+                        yp[r] = fp[r] - diag * xp[r]
+                              + cN * xp[ xy + r] + cS * xp[-xy + r]
+                              + cE * xp[nrhs + r] + cW * xp[r - nrhs]
+                              + cD * xp[-xz + r] + cU * xp[ xz + r];
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* y = A x (fc == VNULL) or y = f - A x on every right-hand side */
+VPRIVATE void Vblkapply(int *nx, int *ny, int *nz, int nrhs,
+        int *ipc, double *ac, double *cc, double *fc, double *x, double *y) {
+
+    int i, j, k, m, r, t;
+    int p;
+    int n = *nx * *ny * *nz;
+    int xo[26];
+
+    double diag;
+    double acc, acc4[VBLK_CHUNK];
+    double c[26];
+    double *xp, *xq, *yp, *fp;
+
+    Vblkstencil st;
+
+    if (VAT(ipc, 11) == 7) {
+        VASSERT_MSG0(VAT(ipc, 13) == 0,
+            "Block multigrid needs an assembled operator");
+        Vblkapply7(nx, ny, nz, nrhs, ac, cc, fc, ac + n, ac + 2 * n, ac + 3 * n,
+                   x, y);
+        return;
+    }
+
+    Vblkstencil_init(&st, nx, ny, nz, ipc, ac);
+    for (m=0; m<st.nnb; m++)
+        xo[m] = st.xoff[m] * nrhs;
+
+    #pragma omp parallel for private(i, j, k, m, r, t, p, diag, acc, acc4, c, xp, xq, yp, fp)
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                p  = ((k - 1) * *ny + (j - 1)) * *nx + (i - 1);
+                xp = x + (size_t)p * nrhs;
+                yp = y + (size_t)p * nrhs;
+                fp = (fc == VNULL) ? VNULL : fc + (size_t)p * nrhs;
+
+                for (m=0; m<st.nnb; m++)
+                    c[m] = st.coef[m][p + st.coff[m]];
+                diag = st.oC[p] + cc[p];
+
+                for (r=0; r+VBLK_CHUNK<=nrhs; r+=VBLK_CHUNK) {
+                    for (t=0; t<VBLK_CHUNK; t++)
+                        acc4[t] = diag * xp[r+t];
+                    for (m=0; m<st.nnb; m++) {
+                        xq = xp + xo[m] + r;
+                        for (t=0; t<VBLK_CHUNK; t++)
+                            acc4[t] -= c[m] * xq[t];
+                    }
+                    if (fp == VNULL) {
+                        for (t=0; t<VBLK_CHUNK; t++)
+                            yp[r+t] = acc4[t];
+                    } else {
+                        for (t=0; t<VBLK_CHUNK; t++)
+                            yp[r+t] = fp[r+t] - acc4[t];
+                    }
+                }
+                for (; r<nrhs; r++) {
+                    acc = diag * xp[r];
+                    for (m=0; m<st.nnb; m++)
+                        acc -= c[m] * xp[xo[m] + r];
+                    yp[r] = (fp == VNULL) ? acc : fp[r] - acc;
+                }
+            }
+        }
+    }
+}
+
+/* Restriction with the 27 prolongation coefficients (Vrestrc2) */
+VPRIVATE void Vblkrestrc(int *nxf, int *nyf, int *nzf,
+        int *nxc, int *nyc, int *nzc, int nrhs,
+        double *xin, double *xout, double *pc) {
+
+    int i, j, k, m, r;
+    int ii, jj, kk;
+    int ip, pf, pcp;
+    int nc = *nxc * *nyc * *nzc;
+    int sy = *nxf;
+    int sz = *nxf * *nyf;
+    int xoff[27];
+    int xo[27];
+    int t;
+
+    double acc;
+    double acc4[VBLK_CHUNK];
+    double c[27];
+    double *xp, *xq, *yp;
+
+    MAT2(pc, nc, 27);
+
+    // Fine neighbors in the order of the 27 coefficients
+    xoff[ 0] =  0;       xoff[ 1] =  sy;      xoff[ 2] = -sy;
+    xoff[ 3] =  1;       xoff[ 4] = -1;       xoff[ 5] =  1+sy;
+    xoff[ 6] = -1+sy;    xoff[ 7] =  1-sy;    xoff[ 8] = -1-sy;
+    for (m=0; m<9; m++) {
+        xoff[ 9+m] = xoff[m] + sz;
+        xoff[18+m] = xoff[m] - sz;
+    }
+    for (m=0; m<27; m++)
+        xo[m] = xoff[m] * nrhs;
+
+    Vblkbound00(nxf, nyf, nzf, nrhs, xin);
+
+    #pragma omp parallel for private(i, j, k, ii, jj, kk, ip, pf, pcp, m, r, t, c, acc, acc4, xp, xq, yp)
+    for (k=2; k<=*nzc-1; k++) {
+        kk = (k - 1) * 2 + 1;
+
+        for (j=2; j<=*nyc-1; j++) {
+            jj = (j - 1) * 2 + 1;
+
+            for (i=2; i<=*nxc-1; i++) {
+                ii = (i - 1) * 2 + 1;
+                ip  = (k - 1) * *nyc * *nxc + (j - 1) * *nxc + i;
+                pf  = ((kk - 1) * *nyf + (jj - 1)) * *nxf + (ii - 1);
+                pcp = ip - 1;
+
+                for (m=0; m<27; m++)
+                    c[m] = VAT2(pc, ip, m+1);
+                xp = xin + (size_t)pf * nrhs;
+                yp = xout + (size_t)pcp * nrhs;
+                for (r=0; r+VBLK_CHUNK<=nrhs; r+=VBLK_CHUNK) {
+                    for (t=0; t<VBLK_CHUNK; t++)
+                        acc4[t] = c[0] * xp[r+t];
+                    for (m=1; m<27; m++) {
+                        xq = xp + xo[m] + r;
+                        for (t=0; t<VBLK_CHUNK; t++)
+                            acc4[t] += c[m] * xq[t];
+                    }
+                    for (t=0; t<VBLK_CHUNK; t++)
+                        yp[r+t] = acc4[t];
+                }
+                for (; r<nrhs; r++) {
+                    acc = 0.0;
+                    for (m=0; m<27; m++)
+                        acc += c[m] * xp[xo[m] + r];
+                    yp[r] = acc;
+                }
+            }
+        }
+    }
+
+    Vblkbound00(nxc, nyc, nzc, nrhs, xout);
+}
+
+/* xout = xout + scal * (prolongation of xin), scal per right-hand side
+ * (VinterpPMG2 followed by the damped update of Vmvcs) */
+VPRIVATE void Vblkinterp(int *nxc, int *nyc, int *nzc,
+        int *nxf, int *nyf, int *nzf, int nrhs,
+        double *xin, double *xout, double *pc, double *scal) {
+
+    int i, j, k, r;
+    int ii, jj, kk;
+    int pf, pcb;
+    int nc = *nxc * *nyc * *nzc;
+    int syc = *nxc * nrhs;
+    int szc = *nxc * *nyc * nrhs;
+    int syf = *nxf * nrhs;
+    int szf = *nxf * *nyf * nrhs;
+
+    double c[27];
+    double *x0, *y0;
+
+    Vblkbound00(nxc, nyc, nzc, nrhs, xin);
+
+    #pragma omp parallel for private(i, j, k, ii, jj, kk, pf, pcb, r, c, x0, y0)
+    for (k=1; k<=*nzf-2; k+=2) {
+        kk = (k - 1) / 2 + 1;
+
+        for (j=1; j<=*nyf-2; j+=2) {
+            jj = (j - 1) / 2 + 1;
+
+            for (i=1; i<=*nxf-2; i+=2) {
+                ii = (i - 1) / 2 + 1;
+
+                pf  = ((k - 1) * *nyf + (j - 1)) * *nxf + (i - 1);
+                pcb = ((kk - 1) * *nyc + (jj - 1)) * *nxc + (ii - 1);
+
+/* Coefficient m of coarse point pcb + (di, dj, dk) */
+#define VBLKPC(m, di, dj, dk) \
+    pc[(size_t)((m) - 1) * nc + pcb + (di) + (dj) * *nxc + (dk) * *nxc * *nyc]
+
+                // The 26 weights of the cell, in the order of VinterpPMG2
+                c[ 0] = VBLKPC( 4, 0, 0, 0);  c[ 1] = VBLKPC( 5, 1, 0, 0);
+                c[ 2] = VBLKPC( 2, 0, 0, 0);  c[ 3] = VBLKPC( 3, 0, 1, 0);
+                c[ 4] = VBLKPC(10, 0, 0, 0);  c[ 5] = VBLKPC(19, 0, 0, 1);
+                c[ 6] = VBLKPC( 6, 0, 0, 0);  c[ 7] = VBLKPC( 7, 1, 0, 0);
+                c[ 8] = VBLKPC( 8, 0, 1, 0);  c[ 9] = VBLKPC( 9, 1, 1, 0);
+                c[10] = VBLKPC(13, 0, 0, 0);  c[11] = VBLKPC(14, 1, 0, 0);
+                c[12] = VBLKPC(22, 0, 0, 1);  c[13] = VBLKPC(23, 1, 0, 1);
+                c[14] = VBLKPC(11, 0, 0, 0);  c[15] = VBLKPC(12, 0, 1, 0);
+                c[16] = VBLKPC(20, 0, 0, 1);  c[17] = VBLKPC(21, 0, 1, 1);
+                c[18] = VBLKPC(15, 0, 0, 0);  c[19] = VBLKPC(16, 1, 0, 0);
+                c[20] = VBLKPC(17, 0, 1, 0);  c[21] = VBLKPC(18, 1, 1, 0);
+                c[22] = VBLKPC(24, 0, 0, 1);  c[23] = VBLKPC(25, 1, 0, 1);
+                c[24] = VBLKPC(26, 0, 1, 1);  c[25] = VBLKPC(27, 1, 1, 1);
+
+#undef VBLKPC
+
+                x0 = xin  + (size_t)pcb * nrhs;
+                y0 = xout + (size_t)pf  * nrhs;
+
+                for (r=0; r<nrhs; r++) {
+
+                    // Type 1: the coinciding point
+                    y0[r] += scal[r] * x0[r];
+
+                    // Type 2: points on coarse grid lines
+                    y0[1*nrhs + r] += scal[r] * (c[ 0] * x0[r] + c[ 1] * x0[1*nrhs + r]);
+                    y0[syf + r]    += scal[r] * (c[ 2] * x0[r] + c[ 3] * x0[syc + r]);
+                    y0[szf + r]    += scal[r] * (c[ 4] * x0[r] + c[ 5] * x0[szc + r]);
+
+                    // Type 3: points on coarse grid faces
+                    y0[1*nrhs + syf + r] += scal[r] * (
+                              c[ 6] * x0[r]              + c[ 7] * x0[1*nrhs + r]
+                            + c[ 8] * x0[syc + r]        + c[ 9] * x0[1*nrhs + syc + r]);
+                    y0[1*nrhs + szf + r] += scal[r] * (
+                              c[10] * x0[r]              + c[11] * x0[1*nrhs + r]
+                            + c[12] * x0[szc + r]        + c[13] * x0[1*nrhs + szc + r]);
+                    y0[syf + szf + r] += scal[r] * (
+                              c[14] * x0[r]              + c[15] * x0[syc + r]
+                            + c[16] * x0[szc + r]        + c[17] * x0[syc + szc + r]);
+
+                    // Type 4: the cell center
+                    y0[1*nrhs + syf + szf + r] += scal[r] * (
+                              c[18] * x0[r]                     + c[19] * x0[1*nrhs + r]
+                            + c[20] * x0[syc + r]               + c[21] * x0[1*nrhs + syc + r]
+                            + c[22] * x0[szc + r]               + c[23] * x0[1*nrhs + szc + r]
+                            + c[24] * x0[syc + szc + r]         + c[25] * x0[1*nrhs + syc + szc + r]);
+                }
+            }
+        }
+    }
+
+    Vblkbound00(nxf, nyf, nzf, nrhs, xout);
+}
+
+/* Solve on the coarsest level, one right-hand side at a time */
+VPRIVATE void Vblkcoarse(int *nx, int *ny, int *nz, int nrhs,
+        int *iz, int lev, int *mgsolv, double *epsiln, double *omega,
+        int *ipc, double *rpc, double *ac, double *cc,
+        double *bf, double *bx, double *w2, double *w3) {
+
+    int i, r, n, m, lda, lpv;
+    int nc = *nx * *ny * *nz;
+    int iresid, iadjoint, itmax_s, iters_s, mgsmoo_s;
+
+    double errtol_s;
+    double *dfc = w2;
+    double *dx  = w2 + nc;
+
+    MAT2(iz, 50, 1);
+
+    for (r=0; r<nrhs; r++) {
+
+        for (i=0; i<nc; i++)
+            dfc[i] = bf[(size_t)i * nrhs + r];
+
+        if (*mgsolv == 0) {
+
+            // cghs, as in Vmvcs
+            iresid   = 0;
+            iadjoint = 0;
+            itmax_s  = 100;
+            iters_s  = 0;
+            errtol_s = *epsiln;
+            mgsmoo_s = 4;
+            Vazeros(nx, ny, nz, dx);
+            Vsmooth(nx, ny, nz,
+                    RAT(ipc, VAT2(iz, 5,lev)), RAT(rpc, VAT2(iz, 6,lev)),
+                     RAT(ac, VAT2(iz, 7,lev)),  RAT(cc, VAT2(iz, 1,lev)), dfc,
+                    dx, w3, w3 + nc, w3 + 2*nc,
+                    &itmax_s, &iters_s, &errtol_s, omega,
+                    &iresid, &iadjoint, &mgsmoo_s);
+            VWARN_MSG2(iters_s <= itmax_s,
+                "Exceeded maximum iterations: iters_s=%d, itmax_s=%d",
+                iters_s, itmax_s);
+
+        } else if (*mgsolv == 1) {
+
+            // Banded factorization from Vbuildops
+            lpv = lev + 1;
+            n   = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 1);
+            m   = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 2);
+            lda = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 3);
+
+            Vxcopy_small(nx, ny, nz, dfc, w3);
+            Vdpbsl(RAT(ac, VAT2(iz, 7,lpv)), &lda, &n, &m, w3);
+            Vxcopy_large(nx, ny, nz, w3, dx);
+            VfboundPMG00(nx, ny, nz, dx);
+
+        } else if (*mgsolv == 2) {
+
+            // Sparse factorization from Vbuildops
+            lpv = lev + 1;
+
+            Vxcopy_small(nx, ny, nz, dfc, w3);
+            Vsparsesl(RAT(ipc, VAT2(iz, 5,lpv)), w3);
+            Vxcopy_large(nx, ny, nz, w3, dx);
+            VfboundPMG00(nx, ny, nz, dx);
+
+        } else {
+            VABORT_MSG1("Invalid coarse solver requested: %d", *mgsolv);
+        }
+
+        for (i=0; i<nc; i++)
+            bx[(size_t)i * nrhs + r] = dx[i];
+    }
+}
+
+/* One v-cycle of Vmvcs for A x_r = w0_r (level 1), x_r = 0 */
+VPRIVATE void Vblkcycle(int *nx, int *ny, int *nz, int nrhs,
+        int *iz, int *nlev, int *mgsolv, double *epsiln, double *omega,
+        int *nu1, int *nu2,
+        int *ipc, double *rpc, double *pc, double *ac, double *cc,
+        double *bx, double *bw0, double *bw1, double *bw2,
+        double *w2, double *w3) {
+
+    int r, level, lev, nuuu, numlev;
+    int nxf, nyf, nzf;
+    int nxc, nyc, nzc;
+
+    double xnum[VBLK_MAXRHS], xden[VBLK_MAXRHS], xdamp[VBLK_MAXRHS];
+
+    MAT2(iz, 50, 1);
+
+/* Level lev of an interleaved multilevel vector */
+#define VBLKLEV(v, lev) ((v) + (size_t)nrhs * (VAT2(iz, 1,lev) - 1))
+
+    nxf = *nx;
+    nyf = *ny;
+    nzf = *nz;
+
+    // Go down grids: smooth, then restrict the residual
+    for (level=1; level<*nlev; level++) {
+
+        lev = level;
+        numlev = 1;
+        Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        Vblkzeros(&nxf, &nyf, &nzf, nrhs, VBLKLEV(bx, lev));
+        nuuu = Vivariv(nu1, &lev);
+        Vblkgs(&nxf, &nyf, &nzf, nrhs, RAT(ipc, VAT2(iz, 5,lev)),
+               RAT(ac, VAT2(iz, 7,lev)), RAT(cc, VAT2(iz, 1,lev)),
+               VBLKLEV(bw0, lev), VBLKLEV(bx, lev), nuuu, 0);
+        Vblkapply(&nxf, &nyf, &nzf, nrhs, RAT(ipc, VAT2(iz, 5,lev)),
+                  RAT(ac, VAT2(iz, 7,lev)), RAT(cc, VAT2(iz, 1,lev)),
+                  VBLKLEV(bw0, lev), VBLKLEV(bx, lev), bw1);
+        Vblkrestrc(&nxf, &nyf, &nzf, &nxc, &nyc, &nzc, nrhs,
+                   bw1, VBLKLEV(bw0, lev+1), RAT(pc, VAT2(iz, 11,lev)));
+
+        nxf = nxc;
+        nyf = nyc;
+        nzf = nzc;
+    }
+
+    // Coarsest level
+    lev = *nlev;
+    Vblkcoarse(&nxf, &nyf, &nzf, nrhs, iz, lev, mgsolv, epsiln, omega,
+               ipc, rpc, ac, cc, VBLKLEV(bw0, lev), VBLKLEV(bx, lev), w2, w3);
+
+    // Go up grids: damped coarse grid correction, then smooth
+    for (level=*nlev-1; level>=1; level--) {
+
+        lev = level;
+        numlev = 1;
+        Vmkfine(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        // Hackbusch/Reusken damping parameter, as in Vmvcs
+        Vblkapply(&nxf, &nyf, &nzf, nrhs, RAT(ipc, VAT2(iz, 5,lev+1)),
+                  RAT(ac, VAT2(iz, 7,lev+1)), RAT(cc, VAT2(iz, 1,lev+1)),
+                  VNULL, VBLKLEV(bx, lev+1), bw2);
+        Vblkreduce(&nxf, &nyf, &nzf, nrhs,
+                   VBLKLEV(bx, lev+1), VBLKLEV(bw0, lev+1), xnum);
+        Vblkreduce(&nxf, &nyf, &nzf, nrhs, VBLKLEV(bx, lev+1), bw2, xden);
+        for (r=0; r<nrhs; r++)
+            xdamp[r] = (xden[r] != 0.0) ? xnum[r] / xden[r] : 1.0;
+
+        Vblkinterp(&nxf, &nyf, &nzf, &nxc, &nyc, &nzc, nrhs,
+                   VBLKLEV(bx, lev+1), VBLKLEV(bx, lev),
+                   RAT(pc, VAT2(iz, 11,lev)), xdamp);
+
+        nxf = nxc;
+        nyf = nyc;
+        nzf = nzc;
+
+        nuuu = Vivariv(nu2, &lev);
+        Vblkgs(&nxf, &nyf, &nzf, nrhs, RAT(ipc, VAT2(iz, 5,lev)),
+               RAT(ac, VAT2(iz, 7,lev)), RAT(cc, VAT2(iz, 1,lev)),
+               VBLKLEV(bw0, lev), VBLKLEV(bx, lev), nuuu, 1);
+    }
+
+#undef VBLKLEV
+}
+
+VPUBLIC int Vblksz(int *nrhs, int *nf, int *narr) {
+
+    // bx, bw0 (multilevel); bw1, bw2, solutions and sources (fine)
+    return 2 * *nrhs * *narr + 4 * *nrhs * *nf;
+}
+
+VPUBLIC void Vmvblk(int *nx, int *ny, int *nz, int *nrhs,
+        double *x, double *f, int *iz,
+        double *bw, double *w2, double *w3,
+        int *istop, int *itmax, int *iters, int *ierror,
+        int *nlev, int *mgsolv, int *iok, int *iinfo,
+        double *epsiln, double *errtol, double *omega,
+        int *nu1, int *nu2,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc) {
+
+    int r, nf, narr, ncvg;
+    size_t i, nb;
+
+    double rsden[VBLK_MAXRHS];
+    double rsnrm[VBLK_MAXRHS];
+    double relres;   // Largest relative residual
+    double orelres;  // The same, one iteration earlier
+
+    double *bx, *bw0, *bw1, *bw2;
+
+    MAT2(iz, 50, 1);
+
+    VASSERT_MSG1(*nlev > 1, "Block multigrid needs nlev > 1: %d", *nlev);
+    VASSERT_MSG2((*nrhs > 0) && (*nrhs <= VBLK_MAXRHS),
+        "Block multigrid takes 1 to %d right-hand sides: %d",
+        VBLK_MAXRHS, *nrhs);
+
+    nf   = *nx * *ny * *nz;
+    narr = VAT2(iz, 1, *nlev+1) - 1;
+    nb   = (size_t)*nrhs * nf;
+
+    bx  = bw;
+    bw0 = bx  + (size_t)*nrhs * narr;
+    bw1 = bw0 + (size_t)*nrhs * narr;
+    bw2 = bw1 + nb;
+
+    if (*iinfo > 1) {
+        VMESSAGE0("Starting mvblk operation");
+        VMESSAGE3("Fine Grid Size:   (%d, %d, %d)", *nx, *ny, *nz);
+        VMESSAGE1("Right-hand sides: %d", *nrhs);
+    }
+
+    if (*iok != 0) {
+        Vprtstp(*iok, -1, 0.0, 0.0, 0.0);
+    }
+
+    // Compute denominators for the stopping criterion
+    if (*istop == 0) {
+        for (r=0; r<*nrhs; r++)
+            rsden[r] = 1.0;
+    } else if (*istop == 1) {
+        Vblkreduce(nx, ny, nz, *nrhs, f, VNULL, rsden);
+    } else {
+        VABORT_MSG1("Bad istop value: %d", *istop);
+    }
+    for (r=0; r<*nrhs; r++) {
+        if (rsden[r] == 0.0) {
+            rsden[r] = 1.0;
+            VERRMSG1("rhs %d is zero on finest level", r + 1);
+        }
+    }
+
+    // Initial residuals
+    Vblkapply(nx, ny, nz, *nrhs, ipc, ac, cc, f, x, bw0);
+    Vblkreduce(nx, ny, nz, *nrhs, bw0, VNULL, rsnrm);
+    relres = 0.0;
+    for (r=0; r<*nrhs; r++)
+        relres = VMAX2(relres, rsnrm[r] / rsden[r]);
+    orelres = relres;
+
+    if (*iok != 0) {
+        Vprtstp(*iok, 0, relres, 1.0, orelres);
+    }
+
+    *iters = 0;
+    do {
+
+        Vblkcycle(nx, ny, nz, *nrhs, iz, nlev, mgsolv, epsiln, omega,
+                  nu1, nu2, ipc, rpc, pc, ac, cc,
+                  bx, bw0, bw1, bw2, w2, w3);
+
+        for (i=0; i<nb; i++)
+            x[i] += bx[i];
+
+        (*iters)++;
+
+        // New residuals; the iteration ends when the worst one converged
+        orelres = relres;
+        Vblkapply(nx, ny, nz, *nrhs, ipc, ac, cc, f, x, bw0);
+        Vblkreduce(nx, ny, nz, *nrhs, bw0, VNULL, rsnrm);
+        relres = 0.0;
+        ncvg = 0;
+        for (r=0; r<*nrhs; r++) {
+            relres = VMAX2(relres, rsnrm[r] / rsden[r]);
+            if (rsnrm[r] / rsden[r] <= *errtol) ncvg++;
+        }
+
+        if (*iok != 0) {
+            Vprtstp(*iok, *iters, relres, 1.0, orelres);
+        }
+
+    } while (*iters < *itmax && ncvg < *nrhs);
+
+    *ierror = (ncvg < *nrhs) ? 1 : 0;
+}
+
+VPUBLIC void Vblkdriv(int *iparm, double *rparm, int *iwork, double *rwork,
+        int *nrhs, double *u, double *bw,
+        double *xf, double *yf, double *zf,
+        double *gxcf, double *gycf, double *gzcf,
+        double *a1cf, double *a2cf, double *a3cf,
+        double *ccf, double *fcf, double *tcf) {
+
+    // Storage parameters, as in Vmgdriv
+    int nxc    = 0;
+    int nyc    = 0;
+    int nzc    = 0;
+    int nf     = 0;
+    int nc     = 0;
+    int narr   = 0;
+    int narrc  = 0;
+    int n_rpc  = 0;
+    int n_iz   = 0;
+    int n_ipc  = 0;
+    int iretot = 0;
+    int iintot = 0;
+
+    // Miscellaneous variables
+    int nx     = 0;
+    int ny     = 0;
+    int nz     = 0;
+    int nlev   = 0;
+    int nu1    = 0;
+    int nu2    = 0;
+    int itmax  = 0;
+    int istop  = 0;
+    int iinfo  = 0;
+    int ipkey  = 0;
+    int mode   = 0;
+    int mgprol = 0;
+    int mgcoar = 0;
+    int mgdisc = 0;
+    int mgsolv = 0;
+    int ireuse = 0;
+    int ido    = 0;
+    int iok    = 0;
+    int iters  = 0;
+    int ierror = 0;
+    int ibound = 0;
+    int r      = 0;
+    int ngx, ngy, ngz;
+    size_t i;
+
+    double epsiln = 0.0;
+    double errtol = 0.0;
+    double omegal = 0.0;
+
+    // Utility pointers to help in passing values
+    int *iz     = VNULL;
+    int *ipc    = VNULL;
+    double *rpc = VNULL;
+    double *pc  = VNULL;
+    double *ac  = VNULL;
+    double *cc  = VNULL;
+    double *fc  = VNULL;
+    double *bx  = VNULL;
+    double *bf  = VNULL;
+    double *ur  = VNULL;
+
+    // Decode the iparm array
+    nx     = VAT(iparm,  3);
+    ny     = VAT(iparm,  4);
+    nz     = VAT(iparm,  5);
+    nlev   = VAT(iparm,  6);
+    nu1    = VAT(iparm,  7);
+    nu2    = VAT(iparm,  8);
+    itmax  = VAT(iparm, 10);
+    istop  = VAT(iparm, 11);
+    iinfo  = VAT(iparm, 12);
+    ipkey  = VAT(iparm, 14);
+    mode   = VAT(iparm, 16);
+    mgprol = VAT(iparm, 17);
+    mgcoar = VAT(iparm, 18);
+    mgdisc = VAT(iparm, 19);
+    mgsolv = VAT(iparm, 21);
+    ireuse = VAT(iparm, 24);
+
+    // Decode the rparm array
+    errtol = VAT(rparm,  1);
+    omegal = VAT(rparm,  9);
+
+    // One operator for every right-hand side
+    VASSERT_MSG1(mode == 0, "Block multigrid requires a linear problem; got mode %d",
+            mode);
+
+    // Split up the work arrays as in Vmgdriv
+    Vmgsz(&mgcoar, &mgdisc, &mgsolv,
+          &nx, &ny, &nz,
+          &nlev,
+          &nxc, &nyc, &nzc,
+          &nf, &nc,
+          &narr, &narrc,
+          &n_rpc, &n_iz, &n_ipc,
+          &iretot, &iintot);
+
+    iz  = RAT(iwork, 1);
+    ipc = RAT(iwork, 1 + n_iz);
+
+    rpc = RAT(rwork, 1);
+    cc  = RAT(rwork, 1 + n_rpc);
+    fc  = RAT(rwork, 1 + n_rpc + narr);
+    pc  = RAT(rwork, 1 + n_rpc + 2 * narr);
+    ac  = RAT(rwork, 1 + n_rpc + 2 * narr + 27 * narrc);
+
+    // Interleaved solutions and sources follow the Vmvblk workspace
+    bx = bw + 2 * (size_t)*nrhs * narr + 2 * (size_t)*nrhs * nf;
+    bf = bx + (size_t)*nrhs * nf;
+
+    // Sizes of one block of Dirichlet faces
+    ngx = 2 * ny * nz;
+    ngy = 2 * nx * nz;
+    ngz = 2 * nx * ny;
+
+    Vprtstp(0, -99, 0.0, 0.0, 0.0);
+
+    MAT2(iz, 50, nlev + 1);
+
+    if (ireuse != 2) {
+
+        // Build the multigrid data structure in iz
+        Vbuildstr(&nx, &ny, &nz, &nlev, iz);
+
+        // Start the timer
+        Vnm_tstart(30, "Vblkdrv: fine problem setup");
+
+        // Build operator on fine grid (and the source of the first rhs)
+        ido = 0;
+        Vbuildops(&nx, &ny, &nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vblkdrv: fine problem setup");
+
+        // Start the timer
+        Vnm_tstart(30, "Vblkdrv: coarse problem setup");
+
+        // Build operator on all coarse grids
+        ido = 1;
+        Vbuildops(&nx, &ny, &nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vblkdrv: coarse problem setup");
+
+        // Keep any fallback of the coarse solver for later reuse
+        VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6) = mgsolv;
+
+    } else {
+
+        // The coarse solver may have fallen back when first factored
+        mgsolv = VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6);
+    }
+
+    // Source term of every rhs, interleaved
+    Vnm_tstart(30, "Vblkdrv: sources");
+    for (r=0; r<*nrhs; r++) {
+        VbuildF(&nx, &ny, &nz, fc,
+                xf, yf, zf,
+                gxcf + (size_t)r * ngx, gycf + (size_t)r * ngy,
+                gzcf + (size_t)r * ngz,
+                a1cf, a2cf, a3cf,
+                fcf + (size_t)r * nf);
+        for (i=0; i<(size_t)nf; i++)
+            bf[i * *nrhs + r] = fc[i];
+    }
+    Vnm_tstop(30, "Vblkdrv: sources");
+
+    // Determine machine epsilon
+    epsiln = Vnm_epsmac();
+
+    // Zero initial guess; dirichlet values are folded into the sources
+    Vblkzeros(&nx, &ny, &nz, *nrhs, bx);
+
+    // Start the timer
+    Vnm_tstart(30, "Vblkdrv: solve");
+
+    // The coefficient arrays are free now and serve as coarse workspace
+    iok = 1;
+    Vmvblk(&nx, &ny, &nz, nrhs,
+            bx, bf, iz,
+            bw, tcf, a1cf,
+            &istop, &itmax, &iters, &ierror,
+            &nlev, &mgsolv, &iok, &iinfo,
+            &epsiln, &errtol, &omegal,
+            &nu1, &nu2,
+            ipc, rpc, pc, ac, cc);
+
+    // Stop the timer
+    Vnm_tstop(30, "Vblkdrv: solve");
+
+    // The sparse coarse factor is rebuilt by the next Vbuildops
+    if ((mgsolv == 2) && (ireuse == 0)) {
+        Vsparsefree(RAT(ipc, VAT2(iz, 5,nlev+1)));
+    }
+
+    // Scatter the solutions and restore their boundary conditions
+    ibound = 1;
+    for (r=0; r<*nrhs; r++) {
+        ur = u + (size_t)r * nf;
+        for (i=0; i<(size_t)nf; i++)
+            ur[i] = bx[i * *nrhs + r];
+        VfboundPMG(&ibound, &nx, &ny, &nz, ur,
+                   gxcf + (size_t)r * ngx, gycf + (size_t)r * ngy,
+                   gzcf + (size_t)r * ngz);
+    }
+}
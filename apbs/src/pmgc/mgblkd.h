@@ -0,0 +1,174 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Block multigrid: one v-cycle hierarchy applied to several
+ *          right-hand sides stored interleaved per grid point
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+
+#ifndef _MGBLKD_H_
+#define _MGBLKD_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+#include "pmgc/mgsubd.h"
+#include "pmgc/mgcsd.h"
+#include "pmgc/mgdrvd.h"
+#include "pmgc/mikpckd.h"
+#include "pmgc/matvecd.h"
+#include "pmgc/smoothd.h"
+#include "pmgc/mlinpckd.h"
+#include "pmgc/sparsed.h"
+
+/** @brief   Largest number of right-hand sides of one block solve
+ *  @ingroup PMGC
+ */
+#define VBLK_MAXRHS 64
+
+/** @brief   Real workspace needed by Vblkdriv, in doubles
+ *  @ingroup PMGC
+ *
+ *  Vmvblk uses two interleaved multilevel vectors (correction and level
+ *  right-hand sides) and two interleaved fine-grid temporaries at the start
+ *  of it; Vblkdriv keeps the interleaved solutions and sources after them.
+ *
+ *  @returns Number of doubles for the block workspace
+ */
+VEXTERNC int Vblksz(
+        int *nrhs,  ///< Number of right-hand sides
+        int *nf,    ///< Number of fine grid unknowns
+        int *narr   ///< Size of a multilevel vector
+        );
+
+/** @brief   Linear multigrid for several right-hand sides over one operator
+ *  @ingroup PMGC
+ *
+ *  Solves A x_r = f_r, r = 1..nrhs, with the v-cycle of Vmvcs (red/black
+ *  Gauss-Seidel, Hackbusch/Reusken damped coarse corrections) applied in
+ *  correction form.  x and f hold the nrhs values of a grid point next to
+ *  each other, so every stencil, prolongation and Helmholtz coefficient
+ *  loaded by the smoother, residual and transfer kernels serves nrhs
+ *  updates.  The coarsest level is solved right-hand side by right-hand
+ *  side with the factorization from Vbuildops (or cghs for mgsolv = 0).
+ *
+ *  The iteration stops once every right-hand side meets the istop test of
+ *  Vmvcs; the largest relative residual is the one reported.
+ *
+ *  @note    The operators must be assembled (ipc(13) = 0 on the fine level).
+ *           bw is the workspace sized by Vblksz; w2 and w3 are scalar
+ *           fine-grid vectors.
+ */
+VEXTERNC void Vmvblk(
+        int *nx,         ///< @todo:  Doc
+        int *ny,         ///< @todo:  Doc
+        int *nz,         ///< @todo:  Doc
+        int *nrhs,       ///< Number of right-hand sides
+        double *x,       ///< Interleaved fine grid solutions (in/out)
+        double *f,       ///< Interleaved fine grid sources
+        int *iz,         ///< @todo:  Doc
+        double *bw,      ///< Block workspace (see Vblksz)
+        double *w2,      ///< @todo:  Doc
+        double *w3,      ///< @todo:  Doc
+        int *istop,      ///< @todo:  Doc
+        int *itmax,      ///< @todo:  Doc
+        int *iters,      ///< @todo:  Doc
+        int *ierror,     ///< @todo:  Doc
+        int *nlev,       ///< @todo:  Doc
+        int *mgsolv,     ///< @todo:  Doc
+        int *iok,        ///< @todo:  Doc
+        int *iinfo,      ///< @todo:  Doc
+        double *epsiln,  ///< @todo:  Doc
+        double *errtol,  ///< @todo:  Doc
+        double *omega,   ///< @todo:  Doc
+        int *nu1,        ///< @todo:  Doc
+        int *nu2,        ///< @todo:  Doc
+        int *ipc,        ///< @todo:  Doc
+        double *rpc,     ///< @todo:  Doc
+        double *pc,      ///< @todo:  Doc
+        double *ac,      ///< @todo:  Doc
+        double *cc       ///< @todo:  Doc
+        );
+
+/** @brief   Multilevel driver for several right-hand sides over one operator
+ *  @ingroup PMGC
+ *
+ *  Counterpart of Vmgdriv for a linear problem (iparm(16) = 0) with nrhs
+ *  sources: the hierarchy is built once from a1cf..ccf (or taken over as
+ *  is for iparm(24) = 2, see Vmgdriv2), each fine source term is assembled
+ *  from its own fcf and Dirichlet faces with VbuildF, and all of them are
+ *  solved together by Vmvblk.
+ *
+ *  @note    u and fcf hold nrhs fine-grid maps one after the other.  The
+ *           face arrays hold nrhs blocks of the two faces VfboundPMG reads
+ *           (2*ny*nz values for gxcf, 2*nx*nz for gycf, 2*nx*ny for gzcf).
+ *           bw is sized by Vblksz.
+ */
+VEXTERNC void Vblkdriv(
+        int *iparm,     ///< @todo:  Doc
+        double *rparm,  ///< @todo:  Doc
+        int *iwork,     ///< @todo:  Doc
+        double *rwork,  ///< @todo:  Doc
+        int *nrhs,      ///< Number of right-hand sides
+        double *u,      ///< Solutions, nrhs fine grid maps
+        double *bw,     ///< Block workspace (see Vblksz)
+        double *xf,     ///< @todo:  Doc
+        double *yf,     ///< @todo:  Doc
+        double *zf,     ///< @todo:  Doc
+        double *gxcf,   ///< Dirichlet x faces, nrhs blocks
+        double *gycf,   ///< Dirichlet y faces, nrhs blocks
+        double *gzcf,   ///< Dirichlet z faces, nrhs blocks
+        double *a1cf,   ///< @todo:  Doc
+        double *a2cf,   ///< @todo:  Doc
+        double *a3cf,   ///< @todo:  Doc
+        double *ccf,    ///< @todo:  Doc
+        double *fcf,    ///< Sources, nrhs fine grid maps
+        double *tcf     ///< Scalar fine grid workspace
+        );
+
+#endif /* _MGBLKD_H_ */
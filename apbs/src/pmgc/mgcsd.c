@@ -49,6 +49,112 @@
 
 #include "mgcsd.h"
 
+VPUBLIC void Vfmvcs(int *nx, int *ny, int *nz,
+        double *x,
+        int *iz,
+        double *w0, double *w1, double *w2, double *w3,
+        int *istop, int *itmax, int *iters, int *ierror,
+        int *nlev, int *ilev, int *nlev_real,
+        int *mgsolv, int *iok, int *iinfo,
+        double *epsiln, double *errtol, double *omega,
+        int *nu1, int *nu2,
+        int *mgsmoo,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc, double *fc, double *tru) {
+
+    int level, itmxd, nlevd, iterd, iokd, istpd;
+    int nxf, nyf, nzf;
+    int nxc, nyc, nzc;
+    double errd;
+
+    int numlev;
+
+    MAT2(iz, 50, 1);
+
+    // Recover gridsizes
+    nxf = *nx;
+    nyf = *ny;
+    nzf = *nz;
+
+    if (*iinfo > 1) {
+        VMESSAGE0("Starting fmvcs operation");
+        VMESSAGE3("Fine Grid Size:   (%d, %d, %d)", nxf, nyf, nzf);
+    }
+
+    // Move down grids: restrict the source function to each coarser level
+    for (level = *ilev; level < *nlev_real; level++) {
+
+        numlev = 1;
+        Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        Vrestrc(&nxf, &nyf, &nzf,
+                &nxc, &nyc, &nzc,
+                RAT(fc, VAT2(iz,  1,   level)),
+                RAT(fc, VAT2(iz,  1, level+1)),
+                RAT(pc, VAT2(iz, 11,   level)));
+
+        nxf = nxc;
+        nyf = nyc;
+        nzf = nzc;
+    }
+    nxc = nxf;
+    nyc = nyf;
+    nzc = nzf;
+
+    // Move up grids: solve or v-cycle, then interpolate to the finer grid
+    for (level = *nlev_real; level >= *ilev + 1; level--) {
+
+        // One v-cycle (the coarse solve on the coarsest level), no test
+        errd  = *errtol;
+        itmxd = 1;
+        nlevd = *nlev_real - level + 1;
+        iterd = 0;
+        iokd  = 0;
+        istpd = *istop;
+
+        Vmvcs(&nxc, &nyc, &nzc,
+                x, iz,
+                w0, w1, w2, w3,
+                &istpd, &itmxd, &iterd, ierror,
+                &nlevd, &level, nlev_real,
+                mgsolv, &iokd, iinfo,
+                epsiln, &errd, omega,
+                nu1, nu2, mgsmoo,
+                ipc, rpc,
+                pc, ac, cc, fc, tru);
+
+        // Find new grid size
+        numlev = 1;
+        Vmkfine(&numlev, &nxc, &nyc, &nzc, &nxf, &nyf, &nzf);
+
+        // Interpolate to next finer grid
+        VinterpPMG(&nxc, &nyc, &nzc,
+                &nxf, &nyf, &nzf,
+                RAT( x, VAT2(iz,  1,   level)),
+                RAT( x, VAT2(iz,  1, level-1)),
+                RAT(pc, VAT2(iz, 11, level-1)));
+
+        // New grid size
+        nxc = nxf;
+        nyc = nyf;
+        nzc = nzf;
+    }
+
+    // Iterate on the finest level with the real stopping test
+    level = *ilev;
+
+    Vmvcs(nx, ny, nz,
+            x, iz,
+            w0, w1, w2, w3,
+            istop, itmax, iters, ierror,
+            nlev, &level, nlev_real,
+            mgsolv, iok, iinfo,
+            epsiln, errtol, omega,
+            nu1, nu2, mgsmoo,
+            ipc, rpc,
+            pc, ac, cc, fc, tru);
+}
+
 VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
         double *x,
         int *iz,
@@ -217,6 +323,16 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
             Vxcopy_large(&nxf, &nyf, &nzf, w1, RAT(x, VAT2(iz, 1,lev)));
             VfboundPMG00(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)));
 
+        } else if (*mgsolv == 2) {
+
+            // Sparse factorization from Vbuildops
+            lpv = lev + 1;
+
+            Vxcopy_small(&nxf, &nyf, &nzf, RAT(fc, VAT2(iz, 1,lev)), w1);
+            Vsparsesl(RAT(ipc, VAT2(iz, 5,lpv)), w1);
+            Vxcopy_large(&nxf, &nyf, &nzf, w1, RAT(x, VAT2(iz, 1,lev)));
+            VfboundPMG00(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)));
+
         } else {
             VABORT_MSG1("Invalid coarse solver requested: %d", *mgsolv);
         }
@@ -313,22 +429,25 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
         level = 1;
         lev   = (*ilev - 1) + level;
 
-        // nu1 pre-smoothings on fine grid (with residual)
-        iresid = 1;
-        iadjoint = 0;
+        /* nu1 pre-smoothings on fine grid; the residual goes straight to
+         * the next coarser level of w0 */
         iters_s  = 0;
         errtol_s = 0.0;
+        iadjoint = 0;
         nuuu = Vivariv(nu1, &lev);
 
-        Vsmooth(&nxf, &nyf, &nzf,
+        numlev = 1;
+        Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        Vsmoothr(&nxf, &nyf, &nzf,
+                &nxc, &nyc, &nzc,
                 RAT(ipc, VAT2(iz, 5,lev)), RAT(rpc, VAT2(iz, 6,lev)),
                  RAT(ac, VAT2(iz, 7,lev)),  RAT(cc, VAT2(iz, 1,lev)),  RAT(fc, VAT2(iz, 1,lev)),
                   RAT(x, VAT2(iz, 1,lev)), w2, w3, w1,
+                 RAT(w0, VAT2(iz, 1,lev+1)), RAT(pc, VAT2(iz, 11,lev)),
                 &nuuu, &iters_s,
                 &errtol_s, omega,
-                &iresid, &iadjoint, mgsmoo);
-
-        Vxcopy(&nxf, &nyf, &nzf, w1, RAT(w0, VAT2(iz, 1,lev)));
+                &iadjoint, mgsmoo, &lev);
 
 
 
@@ -336,20 +455,11 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
          * begin cycling down to coarse grid
          * *********************************************************************/
 
-        // Go down grids: restrict resid to coarser and smooth
+        // Go down grids: smooth and restrict the residual to the next grid
         for (level=2; level<=*nlev; level++) {
 
             lev = (*ilev - 1) + level;
 
-            // Find new grid size
-            numlev = 1;
-            Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
-
-            // Restrict residual to coarser grid ***
-            Vrestrc(&nxf, &nyf, &nzf,
-                    &nxc, &nyc, &nzc,
-                    w1, RAT(w0, VAT2(iz, 1,lev)), RAT(pc, VAT2(iz, 11,lev-1)));
-
             /// New grid size
             nxf = nxc;
             nyf = nyc;
@@ -358,21 +468,25 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
             // if not on coarsest level yet...
             if (level != *nlev) {
 
-                // nu1 pre-smoothings on this level (with residual)
-                // (w1 has residual...)
+                // nu1 pre-smoothings on this level (rhs in w0)
                 Vazeros(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)));
-                iresid = 1;
                 iadjoint = 0;
                 iters_s  = 0;
                 errtol_s = 0.0;
                 nuuu = Vivariv(nu1, &lev);
-                Vsmooth(&nxf, &nyf, &nzf,
+
+                numlev = 1;
+                Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+                Vsmoothr(&nxf, &nyf, &nzf,
+                       &nxc, &nyc, &nzc,
                        RAT(ipc, VAT2(iz, 5,lev)), RAT(rpc, VAT2(iz, 6,lev)),
                         RAT(ac, VAT2(iz, 7,lev)),  RAT(cc, VAT2(iz, 1,lev)), RAT(w0, VAT2(iz, 1,lev)),
                         RAT(x, VAT2(iz, 1,lev)), w2, w3, w1,
+                        RAT(w0, VAT2(iz, 1,lev+1)), RAT(pc, VAT2(iz, 11,lev)),
                         &nuuu, &iters_s,
-                        &errtol_s, omega ,
-                        &iresid, &iadjoint, mgsmoo);
+                        &errtol_s, omega,
+                        &iadjoint, mgsmoo, &lev);
             }
             // End of cycling down to coarse grid loop
         }
@@ -428,6 +542,16 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
             Vxcopy_large(&nxf, &nyf, &nzf, w1, RAT(x, VAT2(iz, 1,lev)));
             VfboundPMG00(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)));
 
+        } else if (*mgsolv == 2) {
+
+            // Sparse factorization from Vbuildops
+            lpv = lev + 1;
+
+            Vxcopy_small(&nxf, &nyf, &nzf, RAT(w0, VAT2(iz, 1,lev)), w1);
+            Vsparsesl(RAT(ipc, VAT2(iz, 5,lpv)), w1);
+            Vxcopy_large(&nxf, &nyf, &nzf, w1, RAT(x, VAT2(iz, 1,lev)));
+            VfboundPMG00(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)));
+
         } else {
             VABORT_MSG1("Invalid coarse solver requested: %d", *mgsolv);
         }
@@ -509,8 +633,9 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
         // Increment the iteration counter
         (*iters)++;
 
-        // Compute/check the current stopping test
-        if (iok != 0) {
+        /* Compute/check the current stopping test; without one (iok == 0)
+         * the residual only matters if another cycle may follow */
+        if (*iok != 0 || *iters < *itmax) {
             orsnrm = rsnrm;
             if (*istop == 0) {
                 Vmresid(&nxf, &nyf, &nzf,
@@ -529,7 +654,6 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
                 alpha = -1.0;
                 Vxaxpy(&nxf, &nyf, &nzf, &alpha, RAT(x, VAT2(iz, 1,lev)), w1);
                 rsnrm = Vxnrm1(&nxf, &nyf, &nzf, w1);
-                Vxcopy(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)), RAT(tru, VAT2(iz, 1,lev)));
             } else if (*istop == 3) {
                 Vxcopy(&nxf, &nyf, &nzf, RAT(tru, VAT2(iz, 1,lev)), w1);
                 alpha = -1.0;
@@ -554,6 +678,11 @@ VEXTERNC void Vmvcs(int *nx, int *ny, int *nz,
             }
             Vprtstp(*iok, *iters, rsnrm, rsden, orsnrm);
         }
+
+        // istop 2 measures against the last iterate, tested or not
+        if (*istop == 2) {
+            Vxcopy(&nxf, &nyf, &nzf, RAT(x, VAT2(iz, 1,lev)), RAT(tru, VAT2(iz, 1,lev)));
+        }
     } while (*iters<*itmax && (rsnrm/rsden) > *errtol);
 
     *ierror = *iters < *itmax ? 0 : 1;
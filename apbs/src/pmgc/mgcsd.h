@@ -62,6 +62,60 @@
 #include "pmgc/gsd.h"
 #include "pmgc/matvecd.h"
 #include "pmgc/mlinpckd.h"
+#include "pmgc/sparsed.h"
+
+/** @brief   Nested iteration for a linear multilevel method.
+ *
+ *    algorithm:  full multigrid startup for the linear v-cycle (cs)
+ *
+ *    the source function is restricted to every coarser level and solved
+ *    there; the solution is then interpolated to the next finer level and
+ *    improved by one v-cycle, up to the finest level, where vmvcs iterates
+ *    with the requested stopping test.  the fine-grid iteration thus
+ *    starts near discretization accuracy instead of from zero; x is
+ *    overwritten, so no initial guess is used.
+ *
+ *    the coarse levels of "fc" are overwritten with the restricted
+ *    source; vmvcs keeps its coarse right-hand sides in "w0".
+ *
+ *  @ingroup PMGC
+ *
+ *  @note    Replaces fmvcs from mgcsd.f
+ */
+VEXTERNC void Vfmvcs(
+        int    *nx,        ///< @todo: doc
+        int    *ny,        ///< @todo: doc
+        int    *nz,        ///< @todo: doc
+        double *x,         ///< @todo: doc
+        int    *iz,        ///< @todo: doc
+        double *w0,        ///< @todo: doc
+        double *w1,        ///< @todo: doc
+        double *w2,        ///< @todo: doc
+        double *w3,        ///< @todo: doc
+        int    *istop,     ///< @todo: doc
+        int    *itmax,     ///< @todo: doc
+        int    *iters,     ///< @todo: doc
+        int    *ierror,    ///< @todo: doc
+        int    *nlev,      ///< @todo: doc
+        int    *ilev,      ///< @todo: doc
+        int    *nlev_real, ///< @todo: doc
+        int    *mgsolv,    ///< @todo: doc
+        int    *iok,       ///< @todo: doc
+        int    *iinfo,     ///< @todo: doc
+        double *epsiln,    ///< @todo: doc
+        double *errtol,    ///< @todo: doc
+        double *omega,     ///< @todo: doc
+        int    *nu1,       ///< @todo: doc
+        int    *nu2,       ///< @todo: doc
+        int    *mgsmoo,    ///< @todo: doc
+        int    *ipc,       ///< @todo: doc
+        double *rpc,       ///< @todo: doc
+        double *pc,        ///< @todo: doc
+        double *ac,        ///< @todo: doc
+        double *cc,        ///< @todo: doc
+        double *fc,        ///< @todo: doc
+        double *tru        ///< @todo: doc
+        );
 
 /** @brief   Screaming linear multilevel method.
  *
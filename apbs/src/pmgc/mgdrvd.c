@@ -82,6 +82,7 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
     int mgcoar = 0;
     int mgdisc = 0;
     int mgsolv = 0;
+    int mgprec = 0;
     int k_iz   = 0;
     int k_ipc  = 0;
     int k_rpc  = 0;
@@ -89,6 +90,7 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
     int k_cc   = 0;
     int k_fc   = 0;
     int k_pc   = 0;
+    int k_sw   = 0;
 
     // Utility pointers to help in passing values
     int *iz     = VNULL;
@@ -98,6 +100,7 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
     double *ac  = VNULL;
     double *cc  = VNULL;
     double *fc  = VNULL;
+    float  *sw  = VNULL;
 
     // Decode some parameters
     nrwk   = VAT(iparm, 1);
@@ -125,6 +128,7 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
     mgcoar = VAT(iparm, 18);
     mgdisc = VAT(iparm, 19);
     mgsolv = VAT(iparm, 21);
+    mgprec = VAT(iparm, 23);
 
     Vmgsz(&mgcoar, &mgdisc, &mgsolv,
                 &nx, &ny, &nz,
@@ -135,6 +139,12 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
                 &n_rpc, &n_iz, &n_ipc,
                 &iretot, &iintot);
 
+    // A float fine operator that does not fit in place goes last
+    if (mgprec == 1) {
+        k_sw = iretot + 1;
+        iretot += Vmixsz(&mgdisc, &nf, &narrc);
+    }
+
     // Perform some more checks on input
     VASSERT_MSG2(
         iretot >= nrwk,
@@ -169,6 +179,9 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
     ac  = RAT(rwork, k_ac);
     cc  = RAT(rwork, k_cc);
     fc  = RAT(rwork, k_fc);
+    if (mgprec == 1) {
+        sw = (float *)RAT(rwork, k_sw);
+    }
 
     // Call the multigrid driver
     Vmgdriv2(iparm, rparm,
@@ -179,7 +192,7 @@ VPUBLIC void Vmgdriv(int* iparm, double* rparm,
                 xf, yf, zf,
                 gxcf, gycf, gzcf,
                 a1cf, a2cf, a3cf,
-                ccf, fcf, tcf);
+                ccf, fcf, tcf, sw);
 }
 
 VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
@@ -190,7 +203,7 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
         double *xf, double *yf, double *zf,
         double *gxcf, double *gycf, double *gzcf,
         double *a1cf, double *a2cf, double *a3cf,
-        double *ccf, double *fcf, double *tcf) {
+        double *ccf, double *fcf, double *tcf, float *sw) {
 
     // @todo Document this function
 
@@ -216,6 +229,10 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
     int mgsmoo    = 0;
     int iperf     = 0;
     int mode      = 0;
+    int mgprec    = 0;
+    int ireuse    = 0;
+    int iguess    = 0;
+    int icopy     = 0;
 
     double epsiln  = 0.0;
     double epsmac  = 0.0;
@@ -276,6 +293,16 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
     mgsmoo = VAT(iparm, 20);
     mgsolv = VAT(iparm, 21);
     iperf  = VAT(iparm, 22);
+    mgprec = VAT(iparm, 23);
+    ireuse = VAT(iparm, 24);
+    iguess = VAT(iparm, 25);
+
+    // The analysis below uses u as workspace
+    if ((iguess != 0) && (iperf != 0)) {
+        Vnm_print(2, "Vmgdriv2: initial guess ignored with iperf = %d\n",
+                iperf);
+        iguess = 0;
+    }
 
     // Decode real parameters from the rparm array
     errtol = VAT(rparm,  1);
@@ -285,42 +312,72 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
     /// @todo replace timer setup
     Vprtstp(0, -99, 0.0, 0.0, 0.0);
 
-    // Build the multigrid data structure in iz
-    Vbuildstr(nx, ny, nz, &nlev, iz);
+    if (ireuse == 2) {
+
+        // The hierarchy of the last solve is intact; only the source moved
+        Vnm_tstart(30, "Vmgdrv2: fine problem setup");
+        if (mgdisc == 2) {
+            // The fine operator slot holds the dielectric faces
+            VbuildF(nx, ny, nz, fc,
+                    xf, yf, zf,
+                    gxcf, gycf, gzcf,
+                    RAT(ac, 1), RAT(ac, *nx * *ny * *nz + 1),
+                    RAT(ac, 2 * *nx * *ny * *nz + 1),
+                    fcf);
+        } else {
+            VbuildF(nx, ny, nz, fc,
+                    xf, yf, zf,
+                    gxcf, gycf, gzcf,
+                    a1cf, a2cf, a3cf,
+                    fcf);
+        }
+        Vnm_tstop(30, "Vmgdrv2: fine problem setup");
 
-    // Start the timer
-    Vnm_tstart(30, "Vmgdrv2: fine problem setup");
-
-    // Build operator and rhs on fine grid
-    ido = 0;
-    Vbuildops(nx, ny, nz,
-            &nlev, &ipkey, &iinfo, &ido, iz,
-            &mgprol, &mgcoar, &mgsolv, &mgdisc,
-            ipc, rpc, pc, ac, cc, fc,
-            xf, yf, zf,
-            gxcf, gycf, gzcf,
-            a1cf, a2cf, a3cf,
-            ccf, fcf, tcf);
+        // The coarse solver may have fallen back when first factored
+        mgsolv = VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6);
 
-    // Stop the timer
-    Vnm_tstop(30, "Vmgdrv2: fine problem setup");
+    } else {
 
-    // Start the timer
-    Vnm_tstart(30, "Vmgdrv2: coarse problem setup");
-
-    // Build operator and rhs on all coarse grids
-    ido = 1;
-    Vbuildops(nx, ny, nz,
-            &nlev, &ipkey, &iinfo, &ido, iz,
-            &mgprol, &mgcoar, &mgsolv, &mgdisc,
-            ipc, rpc, pc, ac, cc, fc,
-            xf, yf, zf,
-            gxcf, gycf, gzcf,
-            a1cf, a2cf, a3cf,
-            ccf, fcf, tcf);
+        // Build the multigrid data structure in iz
+        Vbuildstr(nx, ny, nz, &nlev, iz);
 
-    // Stop the timer
-    Vnm_tstop(30, "Vmgdrv2: coarse problem setup");
+        // Start the timer
+        Vnm_tstart(30, "Vmgdrv2: fine problem setup");
+
+        // Build operator and rhs on fine grid
+        ido = 0;
+        Vbuildops(nx, ny, nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vmgdrv2: fine problem setup");
+
+        // Start the timer
+        Vnm_tstart(30, "Vmgdrv2: coarse problem setup");
+
+        // Build operator and rhs on all coarse grids
+        ido = 1;
+        Vbuildops(nx, ny, nz,
+                &nlev, &ipkey, &iinfo, &ido, iz,
+                &mgprol, &mgcoar, &mgsolv, &mgdisc,
+                ipc, rpc, pc, ac, cc, fc,
+                xf, yf, zf,
+                gxcf, gycf, gzcf,
+                a1cf, a2cf, a3cf,
+                ccf, fcf, tcf);
+
+        // Stop the timer
+        Vnm_tstop(30, "Vmgdrv2: coarse problem setup");
+
+        // Keep any fallback of the coarse solver for later reuse
+        VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6) = mgsolv;
+    }
 
     // Determine Machine Epsilon
     epsiln = Vnm_epsmac();
@@ -446,15 +503,18 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
             }
         }
 
-        // Reinitialize the solution function
-
-        Vazeros(&nxf, &nyf, &nzf, RAT(u, VAT2(iz, 1, level)));
+        // Reinitialize the solution function (but keep a fine guess)
+        if ((level > 1) || (iguess == 0)) {
+            Vazeros(&nxf, &nyf, &nzf, RAT(u, VAT2(iz, 1, level)));
+        }
 
         // Next grid
     }
 
-    // Reinitialize the solution function
+    // Reinitialize the solution function unless the caller gave a guess
+    if (iguess == 0) {
         Vazeros(nx, ny, nz, u);
+    }
 
     /*******************************************************************
      *** this overwrites the rhs array provided by pde specification ***
@@ -478,6 +538,7 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
         VfboundPMG00(nx, ny, nz, u);
 
     // Start the timer
+    Vsmoothr_resetTraffic();
     Vnm_tstart(30, "Vmgdrv2: solve");
 
     // Call specified multigrid method
@@ -486,7 +547,19 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
             iok  = 1;
             ilev = 1;
 
-            if (mgkey == 0) {
+            if (mode == 0 && mgprec == 1) {
+
+                /* Single-precision v-cycles, double-precision refinement;
+                 * a kept hierarchy keeps its float copy as well */
+                icopy = (ireuse != 2);
+                Vmvmix(nx, ny, nz,
+                        u, iz, a1cf, a2cf, a3cf, ccf,
+                        &istop, &itmax, &iters, &ierror, &nlev,
+                        &mgsolv, &iok, &iinfo, &epsiln, &errtol, &omegal,
+                        &nu1, &nu2,
+                        ipc, rpc, pc, ac, cc, fc, sw, &icopy);
+
+            } else if (mgkey == 0) {
 
                 Vmvcs(nx, ny, nz,
                         u, iz, a1cf, a2cf, a3cf, ccf,
@@ -496,8 +569,20 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
                         &nu1, &nu2, &mgsmoo,
                         ipc, rpc, pc, ac, cc, fc, tcf);
 
+            } else if (mgkey == 1 && iguess == 0) {
+
+                // Nested iteration from the coarsest level
+                Vfmvcs(nx, ny, nz,
+                        u, iz, a1cf, a2cf, a3cf, ccf,
+                        &istop, &itmax, &iters, &ierror, &nlev,
+                        &ilev, &nlev_real, &mgsolv,
+                        &iok, &iinfo, &epsiln, &errtol, &omegal,
+                        &nu1, &nu2, &mgsmoo,
+                        ipc, rpc, pc, ac, cc, fc, tcf);
+
             } else if (mgkey == 1) {
 
+                // A given initial guess is kept: plain v-cycles
                 Vmvcs(nx, ny, nz,
                         u, iz, a1cf, a2cf, a3cf, ccf,
                         &istop, &itmax, &iters, &ierror, &nlev,
@@ -546,6 +631,16 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
     // Stop the timer
     Vnm_tstop(30, "Vmgdrv2: solve");
 
+    // The sparse coarse factor is rebuilt by the next Vbuildops
+    if ((mgsolv == 2) && (ireuse == 0)) {
+        Vsparsefree(RAT(ipc, VAT2(iz, 5,nlev+1)));
+    }
+
+    // Memory traffic of the restriction leg, per level
+    if (iinfo > 0) {
+        Vsmoothr_printTraffic();
+    }
+
     // Restore boundary conditions
     ibound = 1;
 
@@ -554,6 +649,54 @@ VPUBLIC void Vmgdriv2(int *iparm, double *rparm,
 
 
 
+VPUBLIC void Vmgfree(int *iparm, int *iwork) {
+
+    int nlev;
+    int *iz, *ipc;
+
+    nlev = VAT(iparm, 6);
+    iz   = iwork;
+    ipc  = RAT(iwork, 50 * (nlev + 1) + 1);
+
+    MAT2(iz, 50, nlev + 1);
+
+    // Only the sparse coarse factor lives outside the work arrays
+    if (VAT(RAT(ipc, VAT2(iz, 5,nlev+1)), 6) == 2) {
+        Vsparsefree(RAT(ipc, VAT2(iz, 5,nlev+1)));
+    }
+}
+
+
+
+VPUBLIC double *Vmgfineop(int *iparm, double *rwork) {
+
+    int nx, ny, nz, nlev, nxc, nyc, nzc, nf, nc, narr, narrc;
+    int n_rpc, n_iz, n_ipc, iretot, iintot;
+    int mgcoar, mgdisc, mgsolv;
+
+    nx     = VAT(iparm,  3);
+    ny     = VAT(iparm,  4);
+    nz     = VAT(iparm,  5);
+    nlev   = VAT(iparm,  6);
+    mgcoar = VAT(iparm, 18);
+    mgdisc = VAT(iparm, 19);
+    mgsolv = VAT(iparm, 21);
+
+    Vmgsz(&mgcoar, &mgdisc, &mgsolv,
+            &nx, &ny, &nz,
+            &nlev,
+            &nxc, &nyc, &nzc,
+            &nf, &nc,
+            &narr, &narrc,
+            &n_rpc, &n_iz, &n_ipc,
+            &iretot, &iintot);
+
+    // Every driver splits rpc, cc, fc, pc, then ac, before its own vectors
+    return RAT(rwork, 1 + n_rpc + 2 * narr + 27 * narrc);
+}
+
+
+
 VPUBLIC void Vmgsz(int *mgcoar, int *mgdisc, int *mgsolv,
         int *nx, int *ny, int *nz,
         int *nlev,
@@ -569,10 +712,12 @@ VPUBLIC void Vmgsz(int *mgcoar, int *mgdisc, int *mgsolv,
     int num_narrc = 27;
 
     // Misc variables
-    int nc_band, num_band, n_band;
+    int nc_band, num_band;
+    int n_band = 0;
     int nxf, nyf, nzf;
     int level;
-    int num_nf_oper, num_narrc_oper;
+    int num_nf_oper = 0;
+    int num_narrc_oper = 0;
 
     // Utility variables
     int numlev;
@@ -611,6 +756,8 @@ VPUBLIC void Vmgsz(int *mgcoar, int *mgdisc, int *mgsolv,
     // Box or fem on fine grid?
     if (*mgdisc == 0) {
         num_nf_oper = 4;
+    } else if (*mgdisc == 2) {
+        num_nf_oper = 3;
     } else if (*mgdisc == 1) {
         num_nf_oper = 14;
     } else {
@@ -618,7 +765,7 @@ VPUBLIC void Vmgsz(int *mgcoar, int *mgdisc, int *mgsolv,
     }
 
     // Galerkin or standard coarsening?
-    if ((*mgcoar == 0 || *mgcoar == 1) && *mgdisc == 0) {
+    if ((*mgcoar == 0 || *mgcoar == 1) && *mgdisc != 1) {
         num_narrc_oper = 4;
     } else if (*mgcoar == 2) {
         num_narrc_oper = 14;
@@ -630,13 +777,16 @@ VPUBLIC void Vmgsz(int *mgcoar, int *mgdisc, int *mgsolv,
     if (*mgsolv == 0) {
         n_band = 0;
     } else if (*mgsolv == 1) {
-        if ((*mgcoar == 0 || *mgcoar == 1) && *mgdisc == 0) {
+        if ((*mgcoar == 0 || *mgcoar == 1) && *mgdisc != 1) {
             num_band = 1 + (*nxc - 2) * (*nyc - 2);
         } else {
             num_band = 1 + (*nxc - 2) * (*nyc - 2) + (*nxc - 2) + 1;
         }
         nc_band = (*nxc - 2) * (*nyc - 2) * (*nzc - 2);
         n_band  = nc_band * num_band;
+    } else if (*mgsolv == 2) {
+        // The sparse factor is held outside the work arrays
+        n_band = 0;
     } else {
         Vnm_print(2, "Vmgsz: invalid mgsolv parameter: %d\n", *mgsolv);
     }
@@ -64,6 +64,7 @@
 #include "pmgc/mgcsd.h"
 #include "pmgc/powerd.h"
 #include "pmgc/mgfasd.h"
+#include "pmgc/mgmixd.h"
 
 /** @brief   Multilevel solver driver
  *  @ingroup PMGC
@@ -152,7 +153,40 @@ VEXTERNC void Vmgdriv2(
         double *a3cf,  ///< @todo: Doc
         double *ccf,   ///< @todo: Doc
         double *fcf,   ///< @todo: Doc
-        double *tcf    ///< @todo: Doc
+        double *tcf,   ///< @todo: Doc
+        float *sw      ///< Single-precision workspace if iparm(23) = 1
+                       ///< (see Vmixsz), otherwise unused
+        );
+
+
+
+/** @brief   Releases the storage a kept multigrid hierarchy holds outside
+ *           the work arrays
+ *  @ingroup PMGC
+ *
+ *  Drivers called with iparm(24) > 0 leave the coarse operators (and any
+ *  sparse coarse factor) of the last solve in place for the next one; this
+ *  must be called once the hierarchy in iwork is abandoned.
+ */
+VEXTERNC void Vmgfree(
+        int *iparm, ///< Integer parameters of the last solve
+        int *iwork  ///< Integer work array of the last solve
+        );
+
+
+
+/** @brief   Returns the fine operator slot of the real work array that
+ *           Vmgdriv, Vcgmgdriv and Vnewdriv split according to iparm
+ *  @ingroup PMGC
+ *
+ *  With iparm(19) = 2 the slot holds the x-, y- and z-shifted dielectric
+ *  (nf doubles each) that the matrix-free kernels read; the caller fills it
+ *  in place of separate copies.
+ *  @returns Pointer to the first fine operator entry in rwork
+ */
+VEXTERNC double *Vmgfineop(
+        int *iparm,   ///< Integer parameters of the solve
+        double *rwork ///< Real work array passed to Vmgdriv
         );
 
 
@@ -179,6 +213,7 @@ VEXTERNC void Vmgdriv2(
  *       mgdisc   = discretization technique:
  *                  0=box method
  *                  1=fem method
+ *                  2=matrix-free box method
  *
  *       mgsolv   = coarse grid solver:
  *                  0=conjugate gradients
@@ -217,6 +252,7 @@ VEXTERNC void Vmgdriv2(
  *       STORE =  4*nf +  4*narrc + NBAND*nc (mgdisc=box, mgcoar=stan/harm)
  *          or =  4*nf + 14*narrc + NBAND*nc (mgdisc=box, mgcoar=gal)
  *          or = 14*nf + 14*narrc + NBAND*nc (mgdisc=fem, mgcoar=stan/harm/gal)
+ *          or =  3*nf + 14*narrc + NBAND*nc (mgdisc=matfree, mgcoar=gal)
  *
  *       NBAND = 0                           (mgsolv=iterative)
  *          or = 1+(nxc-2)*(nyc-2)           (mgsolv=7-pt banded linpack)
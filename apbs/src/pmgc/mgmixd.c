@@ -0,0 +1,890 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Mixed-precision multigrid: single-precision v-cycles inside a
+ *          double-precision iterative refinement loop
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#include "mgmixd.h"
+
+/*
+ * The single-precision kernels below mirror Vgsrb7x/Vgsrb27x,
+ * Vmresid7_1s/Vmresid27_1s, Vmatvec7_1s/Vmatvec27_1s, Vrestrc2 and
+ * VinterpPMG2 term by term; only the storage type differs.  The operator
+ * arrays use the layout of ac (ipc(11) = 7: oC, oE, oN, uC; ipc(11) = 27:
+ * the 14 coefficients in the order of Vgsrb).
+ */
+
+VPRIVATE void Vmixbound00(int *nx, int *ny, int *nz, float *x) {
+
+    int i, j, k;
+
+    MAT3(x, *nx, *ny, *nz);
+
+    for (k=1; k<=*nz; k++) {
+        for (j=1; j<=*ny; j++) {
+            VAT3(x,   1, j, k) = 0.0f;
+            VAT3(x, *nx, j, k) = 0.0f;
+        }
+        for (i=1; i<=*nx; i++) {
+            VAT3(x, i,   1, k) = 0.0f;
+            VAT3(x, i, *ny, k) = 0.0f;
+        }
+    }
+    for (j=1; j<=*ny; j++) {
+        for (i=1; i<=*nx; i++) {
+            VAT3(x, i, j,   1) = 0.0f;
+            VAT3(x, i, j, *nz) = 0.0f;
+        }
+    }
+}
+
+VPRIVATE void Vmixzeros(int *nx, int *ny, int *nz, float *x) {
+
+    int i, n = *nx * *ny * *nz;
+
+    #pragma omp parallel for private(i)
+    for (i=0; i<n; i++)
+        x[i] = 0.0f;
+}
+
+VPRIVATE double Vmixdot(int *nx, int *ny, int *nz, float *x, float *y) {
+
+    int i, j, k;
+    double xdot = 0.0;
+
+    MAT3(x, *nx, *ny, *nz);
+    MAT3(y, *nx, *ny, *nz);
+
+    for (k=2; k<=*nz-1; k++)
+        for (j=2; j<=*ny-1; j++)
+            for (i=2; i<=*nx-1; i++)
+                xdot += (double)VAT3(x, i, j, k) * (double)VAT3(y, i, j, k);
+
+    return xdot;
+}
+
+VPRIVATE void Vmixgs7(int *nx, int *ny, int *nz, float *ac,
+        float *cc, float *fc, float *x, int itmax, int iadjoint) {
+
+    int i, j, k, ioff, iters, color;
+
+    float *oC = ac;
+    float *oE = ac +     *nx * *ny * *nz;
+    float *oN = ac + 2 * *nx * *ny * *nz;
+    float *uC = ac + 3 * *nx * *ny * *nz;
+
+    MAT3(cc, *nx, *ny, *nz);
+    MAT3(fc, *nx, *ny, *nz);
+    MAT3( x, *nx, *ny, *nz);
+    MAT3(oC, *nx, *ny, *nz);
+    MAT3(oE, *nx, *ny, *nz);
+    MAT3(oN, *nx, *ny, *nz);
+    MAT3(uC, *nx, *ny, *nz);
+
+    for (iters=1; iters<=itmax; iters++) {
+
+        // Red points first (black first for the adjoint)
+        for (color=0; color<=1; color++) {
+            if (Vgsrb7_simdf(nx, ny, nz, oC, cc, fc, oE, oN, uC, x,
+                             (color + iadjoint) % 2))
+                continue;
+            #pragma omp parallel for private(i, j, k, ioff)
+            for (k=2; k<=*nz-1; k++) {
+                for (j=2; j<=*ny-1; j++) {
+                    ioff = (j + k + color + iadjoint) % 2;
+                    for (i=2+ioff; i<=*nx-1; i+=2) {
+                        VAT3(x, i, j, k) = (
+                                VAT3(fc,   i,   j,   k)
+                             +  VAT3(oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                             +  VAT3(oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                             +  VAT3(oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                             +  VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                             +  VAT3(uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                             +  VAT3(uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                             ) / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+                    }
+                }
+            }
+        }
+    }
+}
+
+VPRIVATE void Vmixgs27(int *nx, int *ny, int *nz, float *ac,
+        float *cc, float *fc, float *x, int itmax, int iadjoint) {
+
+    int i, j, k, ioff, iters, color, kpar;
+    int n = *nx * *ny * *nz;
+
+    float tmpO, tmpU, tmpD;
+
+    float  *oC = ac;
+    float  *oE = ac +      n;
+    float  *oN = ac +  2 * n;
+    float  *uC = ac +  3 * n;
+    float *oNE = ac +  4 * n;
+    float *oNW = ac +  5 * n;
+    float  *uE = ac +  6 * n;
+    float  *uW = ac +  7 * n;
+    float  *uN = ac +  8 * n;
+    float  *uS = ac +  9 * n;
+    float *uNE = ac + 10 * n;
+    float *uNW = ac + 11 * n;
+    float *uSE = ac + 12 * n;
+    float *uSW = ac + 13 * n;
+
+    MAT3( cc, *nx, *ny, *nz);
+    MAT3( fc, *nx, *ny, *nz);
+    MAT3(  x, *nx, *ny, *nz);
+    MAT3( oC, *nx, *ny, *nz);
+    MAT3( oE, *nx, *ny, *nz);
+    MAT3( oN, *nx, *ny, *nz);
+    MAT3( uC, *nx, *ny, *nz);
+    MAT3(oNE, *nx, *ny, *nz);
+    MAT3(oNW, *nx, *ny, *nz);
+    MAT3( uE, *nx, *ny, *nz);
+    MAT3( uW, *nx, *ny, *nz);
+    MAT3( uN, *nx, *ny, *nz);
+    MAT3( uS, *nx, *ny, *nz);
+    MAT3(uNE, *nx, *ny, *nz);
+    MAT3(uNW, *nx, *ny, *nz);
+    MAT3(uSE, *nx, *ny, *nz);
+    MAT3(uSW, *nx, *ny, *nz);
+
+    /* The 27-point stencil couples points of one colour across planes k
+     * and k+1, but never k and k+2, so the planes of one parity are
+     * independent and the sweep does not depend on the thread count */
+    for (iters=1; iters<=itmax; iters++) {
+        for (color=0; color<=1; color++) {
+            for (kpar=0; kpar<=1; kpar++) {
+                #pragma omp parallel for private(i, j, k, ioff, tmpO, tmpU, tmpD)
+                for (k=2+kpar; k<=*nz-1; k+=2) {
+                    for (j=2; j<=*ny-1; j++) {
+                        ioff = (j + k + color + iadjoint) % 2;
+                        for (i=2+ioff; i<=*nx-1; i+=2) {
+
+                            tmpO =
+                                 + VAT3(  oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                                 + VAT3(  oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                                 + VAT3(  oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                                 + VAT3(  oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                                 + VAT3( oNE,   i,   j,   k) * VAT3(x, i+1, j+1,   k)
+                                 + VAT3( oNW,   i,   j,   k) * VAT3(x, i-1, j+1,   k)
+                                 + VAT3( oNW, i+1, j-1,   k) * VAT3(x, i+1, j-1,   k)
+                                 + VAT3( oNE, i-1, j-1,   k) * VAT3(x, i-1, j-1,   k);
+
+                            tmpU =
+                                 + VAT3(  uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                                 + VAT3(  uN,   i,   j,   k) * VAT3(x,   i, j+1, k+1)
+                                 + VAT3(  uS,   i,   j,   k) * VAT3(x,   i, j-1, k+1)
+                                 + VAT3(  uE,   i,   j,   k) * VAT3(x, i+1,   j, k+1)
+                                 + VAT3(  uW,   i,   j,   k) * VAT3(x, i-1,   j, k+1)
+                                 + VAT3( uNE,   i,   j,   k) * VAT3(x, i+1, j+1, k+1)
+                                 + VAT3( uNW,   i,   j,   k) * VAT3(x, i-1, j+1, k+1)
+                                 + VAT3( uSE,   i,   j,   k) * VAT3(x, i+1, j-1, k+1)
+                                 + VAT3( uSW,   i,   j,   k) * VAT3(x, i-1, j-1, k+1);
+
+                            tmpD =
+                                 + VAT3(  uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                                 + VAT3(  uS,   i, j+1, k-1) * VAT3(x,   i, j+1, k-1)
+                                 + VAT3(  uN,   i, j-1, k-1) * VAT3(x,   i, j-1, k-1)
+                                 + VAT3(  uW, i+1,   j, k-1) * VAT3(x, i+1,   j, k-1)
+                                 + VAT3(  uE, i-1,   j, k-1) * VAT3(x, i-1,   j, k-1)
+                                 + VAT3( uSW, i+1, j+1, k-1) * VAT3(x, i+1, j+1, k-1)
+                                 + VAT3( uSE, i-1, j+1, k-1) * VAT3(x, i-1, j+1, k-1)
+                                 + VAT3( uNW, i+1, j-1, k-1) * VAT3(x, i+1, j-1, k-1)
+                                 + VAT3( uNE, i-1, j-1, k-1) * VAT3(x, i-1, j-1, k-1);
+
+                            VAT3(x, i, j, k) = (VAT3(fc, i, j, k) + (tmpO + tmpU + tmpD))
+                                             / (VAT3(oC, i, j, k) + VAT3(cc, i, j, k));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* y = A x (fc == VNULL) or r = f - A x, for either stencil */
+VPRIVATE void Vmixapply(int *nx, int *ny, int *nz, int *ipc,
+        float *ac, float *cc, float *fc, float *x, float *y) {
+
+    int i, j, k;
+    int n = *nx * *ny * *nz;
+
+    float tmpO, tmpU, tmpD, ax;
+
+    float  *oC = ac;
+    float  *oE = ac +      n;
+    float  *oN = ac +  2 * n;
+    float  *uC = ac +  3 * n;
+    float *oNE = ac +  4 * n;
+    float *oNW = ac +  5 * n;
+    float  *uE = ac +  6 * n;
+    float  *uW = ac +  7 * n;
+    float  *uN = ac +  8 * n;
+    float  *uS = ac +  9 * n;
+    float *uNE = ac + 10 * n;
+    float *uNW = ac + 11 * n;
+    float *uSE = ac + 12 * n;
+    float *uSW = ac + 13 * n;
+
+    MAT3( cc, *nx, *ny, *nz);
+    MAT3( fc, *nx, *ny, *nz);
+    MAT3(  x, *nx, *ny, *nz);
+    MAT3(  y, *nx, *ny, *nz);
+    MAT3( oC, *nx, *ny, *nz);
+    MAT3( oE, *nx, *ny, *nz);
+    MAT3( oN, *nx, *ny, *nz);
+    MAT3( uC, *nx, *ny, *nz);
+    MAT3(oNE, *nx, *ny, *nz);
+    MAT3(oNW, *nx, *ny, *nz);
+    MAT3( uE, *nx, *ny, *nz);
+    MAT3( uW, *nx, *ny, *nz);
+    MAT3( uN, *nx, *ny, *nz);
+    MAT3( uS, *nx, *ny, *nz);
+    MAT3(uNE, *nx, *ny, *nz);
+    MAT3(uNW, *nx, *ny, *nz);
+    MAT3(uSE, *nx, *ny, *nz);
+    MAT3(uSW, *nx, *ny, *nz);
+
+    if (VAT(ipc, 11) == 7) {
+
+        if (fc != VNULL && Vmresid7_simdf(nx, ny, nz,
+                                          oC, cc, fc, oE, oN, uC, x, y))
+            return;
+
+        #pragma omp parallel for private(i, j, k, ax)
+        for (k=2; k<=*nz-1; k++) {
+            for (j=2; j<=*ny-1; j++) {
+                for (i=2; i<=*nx-1; i++) {
+                    ax = - VAT3(oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                         - VAT3(oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                         - VAT3(oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                         - VAT3(oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                         - VAT3(uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                         - VAT3(uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                         + (VAT3(oC, i, j, k) + VAT3(cc, i, j, k)) * VAT3(x, i, j, k);
+                    VAT3(y, i, j, k) = (fc == VNULL) ? ax : VAT3(fc, i, j, k) - ax;
+                }
+            }
+        }
+
+    } else {
+
+        #pragma omp parallel for private(i, j, k, tmpO, tmpU, tmpD, ax)
+        for (k=2; k<=*nz-1; k++) {
+            for (j=2; j<=*ny-1; j++) {
+                for (i=2; i<=*nx-1; i++) {
+
+                    tmpO =
+                         + VAT3(  oN,   i,   j,   k) * VAT3(x,   i, j+1,   k)
+                         + VAT3(  oN,   i, j-1,   k) * VAT3(x,   i, j-1,   k)
+                         + VAT3(  oE,   i,   j,   k) * VAT3(x, i+1,   j,   k)
+                         + VAT3(  oE, i-1,   j,   k) * VAT3(x, i-1,   j,   k)
+                         + VAT3( oNE,   i,   j,   k) * VAT3(x, i+1, j+1,   k)
+                         + VAT3( oNW,   i,   j,   k) * VAT3(x, i-1, j+1,   k)
+                         + VAT3( oNW, i+1, j-1,   k) * VAT3(x, i+1, j-1,   k)
+                         + VAT3( oNE, i-1, j-1,   k) * VAT3(x, i-1, j-1,   k);
+
+                    tmpU =
+                         + VAT3(  uC,   i,   j,   k) * VAT3(x,   i,   j, k+1)
+                         + VAT3(  uN,   i,   j,   k) * VAT3(x,   i, j+1, k+1)
+                         + VAT3(  uS,   i,   j,   k) * VAT3(x,   i, j-1, k+1)
+                         + VAT3(  uE,   i,   j,   k) * VAT3(x, i+1,   j, k+1)
+                         + VAT3(  uW,   i,   j,   k) * VAT3(x, i-1,   j, k+1)
+                         + VAT3( uNE,   i,   j,   k) * VAT3(x, i+1, j+1, k+1)
+                         + VAT3( uNW,   i,   j,   k) * VAT3(x, i-1, j+1, k+1)
+                         + VAT3( uSE,   i,   j,   k) * VAT3(x, i+1, j-1, k+1)
+                         + VAT3( uSW,   i,   j,   k) * VAT3(x, i-1, j-1, k+1);
+
+                    tmpD =
+                         + VAT3(  uC,   i,   j, k-1) * VAT3(x,   i,   j, k-1)
+                         + VAT3(  uS,   i, j+1, k-1) * VAT3(x,   i, j+1, k-1)
+                         + VAT3(  uN,   i, j-1, k-1) * VAT3(x,   i, j-1, k-1)
+                         + VAT3(  uW, i+1,   j, k-1) * VAT3(x, i+1,   j, k-1)
+                         + VAT3(  uE, i-1,   j, k-1) * VAT3(x, i-1,   j, k-1)
+                         + VAT3( uSW, i+1, j+1, k-1) * VAT3(x, i+1, j+1, k-1)
+                         + VAT3( uSE, i-1, j+1, k-1) * VAT3(x, i-1, j+1, k-1)
+                         + VAT3( uNW, i+1, j-1, k-1) * VAT3(x, i+1, j-1, k-1)
+                         + VAT3( uNE, i-1, j-1, k-1) * VAT3(x, i-1, j-1, k-1);
+
+                    ax = (VAT3(oC, i, j, k) + VAT3(cc, i, j, k)) * VAT3(x, i, j, k)
+                       - (tmpO + tmpU + tmpD);
+                    VAT3(y, i, j, k) = (fc == VNULL) ? ax : VAT3(fc, i, j, k) - ax;
+                }
+            }
+        }
+    }
+}
+
+VPRIVATE void Vmixgs(int *nx, int *ny, int *nz, int *ipc,
+        float *ac, float *cc, float *fc, float *x, int itmax, int iadjoint) {
+
+    if (VAT(ipc, 11) == 7) {
+        Vmixgs7(nx, ny, nz, ac, cc, fc, x, itmax, iadjoint);
+    } else if (VAT(ipc, 11) == 27) {
+        Vmixgs27(nx, ny, nz, ac, cc, fc, x, itmax, iadjoint);
+    } else {
+        VABORT_MSG1("Invalid stencil type: %d", VAT(ipc, 11));
+    }
+}
+
+/* Restriction with the 27 prolongation coefficients (Vrestrc2) */
+VPRIVATE void Vmixrestrc(int *nxf, int *nyf, int *nzf,
+        int *nxc, int *nyc, int *nzc,
+        float *xin, float *xout, float *pc) {
+
+    int  i,  j,  k;
+    int ii, jj, kk;
+    int ip, nc = *nxc * *nyc * *nzc;
+
+    float tmpO, tmpU, tmpD;
+
+    MAT3( xin, *nxf, *nyf, *nzf);
+    MAT3(xout, *nxc, *nyc, *nzc);
+    MAT2(  pc,   nc,   27);
+
+    Vmixbound00(nxf, nyf, nzf, xin);
+
+    #pragma omp parallel for private(k, kk, j, jj, i, ii, ip, tmpO, tmpU, tmpD)
+    for (k=2; k<=*nzc-1; k++) {
+        kk = (k - 1) * 2 + 1;
+
+        for (j=2; j<=*nyc-1; j++) {
+            jj = (j - 1) * 2 + 1;
+
+            for (i=2; i<=*nxc-1; i++) {
+                ii = (i - 1) * 2 + 1;
+                ip = (k - 1) * *nyc * *nxc + (j - 1) * *nxc + i;
+
+                tmpO =
+                     + VAT2(pc, ip, 1) * VAT3(xin,   ii,   jj,   kk)
+                     + VAT2(pc, ip, 2) * VAT3(xin,   ii, jj+1,   kk)
+                     + VAT2(pc, ip, 3) * VAT3(xin,   ii, jj-1,   kk)
+                     + VAT2(pc, ip, 4) * VAT3(xin, ii+1,   jj,   kk)
+                     + VAT2(pc, ip, 5) * VAT3(xin, ii-1,   jj,   kk)
+                     + VAT2(pc, ip, 6) * VAT3(xin, ii+1, jj+1,   kk)
+                     + VAT2(pc, ip, 7) * VAT3(xin, ii-1, jj+1,   kk)
+                     + VAT2(pc, ip, 8) * VAT3(xin, ii+1, jj-1,   kk)
+                     + VAT2(pc, ip, 9) * VAT3(xin, ii-1, jj-1,   kk);
+
+                tmpU =
+                     + VAT2(pc, ip,10) * VAT3(xin,   ii,   jj, kk+1)
+                     + VAT2(pc, ip,11) * VAT3(xin,   ii, jj+1, kk+1)
+                     + VAT2(pc, ip,12) * VAT3(xin,   ii, jj-1, kk+1)
+                     + VAT2(pc, ip,13) * VAT3(xin, ii+1,   jj, kk+1)
+                     + VAT2(pc, ip,14) * VAT3(xin, ii-1,   jj, kk+1)
+                     + VAT2(pc, ip,15) * VAT3(xin, ii+1, jj+1, kk+1)
+                     + VAT2(pc, ip,16) * VAT3(xin, ii-1, jj+1, kk+1)
+                     + VAT2(pc, ip,17) * VAT3(xin, ii+1, jj-1, kk+1)
+                     + VAT2(pc, ip,18) * VAT3(xin, ii-1, jj-1, kk+1);
+
+                tmpD =
+                     + VAT2(pc, ip,19) * VAT3(xin,   ii,   jj, kk-1)
+                     + VAT2(pc, ip,20) * VAT3(xin,   ii, jj+1, kk-1)
+                     + VAT2(pc, ip,21) * VAT3(xin,   ii, jj-1, kk-1)
+                     + VAT2(pc, ip,22) * VAT3(xin, ii+1,   jj, kk-1)
+                     + VAT2(pc, ip,23) * VAT3(xin, ii-1,   jj, kk-1)
+                     + VAT2(pc, ip,24) * VAT3(xin, ii+1, jj+1, kk-1)
+                     + VAT2(pc, ip,25) * VAT3(xin, ii-1, jj+1, kk-1)
+                     + VAT2(pc, ip,26) * VAT3(xin, ii+1, jj-1, kk-1)
+                     + VAT2(pc, ip,27) * VAT3(xin, ii-1, jj-1, kk-1);
+
+                VAT3(xout, i, j, k) = tmpO + tmpU + tmpD;
+            }
+        }
+    }
+
+    Vmixbound00(nxc, nyc, nzc, xout);
+}
+
+/* Prolongation with the 27 coefficients (VinterpPMG2) */
+VPRIVATE void Vmixinterp(int *nxc, int *nyc, int *nzc,
+        int *nxf, int *nyf, int *nzf,
+        float *xin, float *xout, float *pc) {
+
+    int  i,  j,  k;
+    int ii, jj, kk;
+    int nc = *nxc * *nyc * *nzc;
+
+    MAT3( xin, *nxc, *nyc, *nzc);
+    MAT3(xout, *nxf, *nyf, *nzf);
+    MAT2(  pc,   nc,   27);
+
+/* Coefficient c of coarse point (ii,jj,kk) */
+#define VMIXPC(c, ii, jj, kk) \
+    VAT2(pc, ((kk) - 1) * *nyc * *nxc + ((jj) - 1) * *nxc + (ii), c)
+
+    Vmixbound00(nxc, nyc, nzc, xin);
+
+    #pragma omp parallel for private(k, kk, j, jj, i, ii)
+    for (k=1; k<=*nzf-2; k+=2) {
+        kk = (k - 1) / 2 + 1;
+
+        for (j=1; j<=*nyf-2; j+=2) {
+            jj = (j - 1) / 2 + 1;
+
+            for (i=1; i<=*nxf-2; i+=2) {
+                ii = (i - 1) / 2 + 1;
+
+                // Type 1: coinciding points
+                VAT3(xout, i, j, k) = VAT3(xin, ii, jj, kk);
+
+                // Type 2: points on coarse grid lines
+                VAT3(xout, i+1, j, k) =
+                      VMIXPC( 4,   ii, jj, kk) * VAT3(xin,   ii, jj, kk)
+                    + VMIXPC( 5, ii+1, jj, kk) * VAT3(xin, ii+1, jj, kk);
+                VAT3(xout, i, j+1, k) =
+                      VMIXPC( 2, ii,   jj, kk) * VAT3(xin, ii,   jj, kk)
+                    + VMIXPC( 3, ii, jj+1, kk) * VAT3(xin, ii, jj+1, kk);
+                VAT3(xout, i, j, k+1) =
+                      VMIXPC(10, ii, jj,   kk) * VAT3(xin, ii, jj,   kk)
+                    + VMIXPC(19, ii, jj, kk+1) * VAT3(xin, ii, jj, kk+1);
+
+                // Type 3: points on coarse grid faces
+                VAT3(xout, i+1, j+1, k) =
+                      VMIXPC( 6,   ii,   jj, kk) * VAT3(xin,   ii,   jj, kk)
+                    + VMIXPC( 7, ii+1,   jj, kk) * VAT3(xin, ii+1,   jj, kk)
+                    + VMIXPC( 8,   ii, jj+1, kk) * VAT3(xin,   ii, jj+1, kk)
+                    + VMIXPC( 9, ii+1, jj+1, kk) * VAT3(xin, ii+1, jj+1, kk);
+                VAT3(xout, i+1, j, k+1) =
+                      VMIXPC(13,   ii, jj,   kk) * VAT3(xin,   ii, jj,   kk)
+                    + VMIXPC(14, ii+1, jj,   kk) * VAT3(xin, ii+1, jj,   kk)
+                    + VMIXPC(22,   ii, jj, kk+1) * VAT3(xin,   ii, jj, kk+1)
+                    + VMIXPC(23, ii+1, jj, kk+1) * VAT3(xin, ii+1, jj, kk+1);
+                VAT3(xout, i, j+1, k+1) =
+                      VMIXPC(11, ii,   jj,   kk) * VAT3(xin, ii,   jj,   kk)
+                    + VMIXPC(12, ii, jj+1,   kk) * VAT3(xin, ii, jj+1,   kk)
+                    + VMIXPC(20, ii,   jj, kk+1) * VAT3(xin, ii,   jj, kk+1)
+                    + VMIXPC(21, ii, jj+1, kk+1) * VAT3(xin, ii, jj+1, kk+1);
+
+                // Type 4: cell centers
+                VAT3(xout, i+1, j+1, k+1) =
+                    + VMIXPC(15,   ii,   jj,   kk) * VAT3(xin,   ii,   jj,   kk)
+                    + VMIXPC(16, ii+1,   jj,   kk) * VAT3(xin, ii+1,   jj,   kk)
+                    + VMIXPC(17,   ii, jj+1,   kk) * VAT3(xin,   ii, jj+1,   kk)
+                    + VMIXPC(18, ii+1, jj+1,   kk) * VAT3(xin, ii+1, jj+1,   kk)
+                    + VMIXPC(24,   ii,   jj, kk+1) * VAT3(xin,   ii,   jj, kk+1)
+                    + VMIXPC(25, ii+1,   jj, kk+1) * VAT3(xin, ii+1,   jj, kk+1)
+                    + VMIXPC(26,   ii, jj+1, kk+1) * VAT3(xin,   ii, jj+1, kk+1)
+                    + VMIXPC(27, ii+1, jj+1, kk+1) * VAT3(xin, ii+1, jj+1, kk+1);
+            }
+        }
+    }
+
+#undef VMIXPC
+
+    Vmixbound00(nxf, nyf, nzf, xout);
+}
+
+/* Solve on the coarsest level in double precision: rhs sfc, solution sx;
+ * w2 holds the two double copies, w3 the three cghs vectors.  The
+ * coarsest operator is only kept in double, so the terms of the damping
+ * parameter of the coarse grid correction are formed here as well */
+VPRIVATE void Vmixcoarse(int *nx, int *ny, int *nz, int *iz, int lev,
+        int *mgsolv, double *epsiln, double *omega,
+        int *ipc, double *rpc, double *ac, double *cc,
+        float *sfc, float *sx, double *w2, double *w3,
+        double *xnum, double *xden) {
+
+    int i, n, m, lda, lpv;
+    int nc = *nx * *ny * *nz;
+    int iresid, iadjoint, itmax_s, iters_s, mgsmoo_s;
+
+    double errtol_s;
+    double *dfc = w2;
+    double *dx  = w2 + nc;
+
+    MAT2(iz, 50, 1);
+
+    for (i=0; i<nc; i++)
+        dfc[i] = (double)sfc[i];
+
+    if (*mgsolv == 0) {
+
+        // cghs, as in Vmvcs
+        iresid   = 0;
+        iadjoint = 0;
+        itmax_s  = 100;
+        iters_s  = 0;
+        errtol_s = *epsiln;
+        mgsmoo_s = 4;
+        Vazeros(nx, ny, nz, dx);
+        Vsmooth(nx, ny, nz,
+                RAT(ipc, VAT2(iz, 5,lev)), RAT(rpc, VAT2(iz, 6,lev)),
+                 RAT(ac, VAT2(iz, 7,lev)),  RAT(cc, VAT2(iz, 1,lev)), dfc,
+                dx, w3, w3 + nc, w3 + 2*nc,
+                &itmax_s, &iters_s, &errtol_s, omega,
+                &iresid, &iadjoint, &mgsmoo_s);
+        VWARN_MSG2(iters_s <= itmax_s,
+            "Exceeded maximum iterations: iters_s=%d, itmax_s=%d",
+            iters_s, itmax_s);
+
+    } else if (*mgsolv == 1) {
+
+        // Banded factorization from Vbuildops
+        lpv = lev + 1;
+        n   = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 1);
+        m   = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 2);
+        lda = VAT(ipc, (VAT2(iz, 5, lpv) - 1) + 3);
+
+        Vxcopy_small(nx, ny, nz, dfc, w3);
+        Vdpbsl(RAT(ac, VAT2(iz, 7,lpv)), &lda, &n, &m, w3);
+        Vxcopy_large(nx, ny, nz, w3, dx);
+        VfboundPMG00(nx, ny, nz, dx);
+
+    } else if (*mgsolv == 2) {
+
+        // Sparse factorization from Vbuildops
+        lpv = lev + 1;
+
+        Vxcopy_small(nx, ny, nz, dfc, w3);
+        Vsparsesl(RAT(ipc, VAT2(iz, 5,lpv)), w3);
+        Vxcopy_large(nx, ny, nz, w3, dx);
+        VfboundPMG00(nx, ny, nz, dx);
+
+    } else {
+        VABORT_MSG1("Invalid coarse solver requested: %d", *mgsolv);
+    }
+
+    for (i=0; i<nc; i++)
+        sx[i] = (float)dx[i];
+
+    Vmatvec(nx, ny, nz,
+            RAT(ipc, VAT2(iz, 5,lev)), RAT(rpc, VAT2(iz, 6,lev)),
+            RAT(ac, VAT2(iz, 7,lev)), RAT(cc, VAT2(iz, 1,lev)), dx, w3);
+    *xnum = Vxdot(nx, ny, nz, dx, dfc);
+    *xden = Vxdot(nx, ny, nz, dx, w3);
+}
+
+/* One single-precision v-cycle of Vmvcs for A x = w0 (level 1), x = 0;
+ * sac[lev], spc[lev] and scc[lev] are the float operator, prolongation and
+ * Helmholtz term of level lev (none on the coarsest level) */
+VPRIVATE void Vmixcycle(int *nx, int *ny, int *nz, int *iz, int *nlev,
+        int *mgsolv, double *epsiln, double *omega, int *nu1, int *nu2,
+        int *ipc, double *rpc, double *ac, double *cc,
+        float **sac, float **spc, float **scc,
+        float *sx, float *sw0, float *sw1, float *sw2,
+        double *w2, double *w3) {
+
+    int level, lev, nuuu, numlev;
+    int nxf, nyf, nzf;
+    int nxc, nyc, nzc;
+
+    double xnum, xden, xnumc, xdenc;
+    float xdamp, *sxl;
+
+    int i, n;
+
+    MAT2(iz, 50, 1);
+
+    nxf = *nx;
+    nyf = *ny;
+    nzf = *nz;
+
+    // Go down grids: smooth, then restrict the residual
+    for (level=1; level<*nlev; level++) {
+
+        lev = level;
+        numlev = 1;
+        Vmkcors(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        Vmixzeros(&nxf, &nyf, &nzf, RAT(sx, VAT2(iz, 1,lev)));
+        nuuu = Vivariv(nu1, &lev);
+        Vmixgs(&nxf, &nyf, &nzf, RAT(ipc, VAT2(iz, 5,lev)),
+               sac[lev], scc[lev],
+               RAT(sw0, VAT2(iz, 1,lev)), RAT(sx, VAT2(iz, 1,lev)),
+               nuuu, 0);
+        Vmixapply(&nxf, &nyf, &nzf, RAT(ipc, VAT2(iz, 5,lev)),
+                  sac[lev], scc[lev],
+                  RAT(sw0, VAT2(iz, 1,lev)), RAT(sx, VAT2(iz, 1,lev)), sw1);
+        Vmixrestrc(&nxf, &nyf, &nzf, &nxc, &nyc, &nzc,
+                   sw1, RAT(sw0, VAT2(iz, 1,lev+1)), spc[lev]);
+
+        nxf = nxc;
+        nyf = nyc;
+        nzf = nzc;
+    }
+
+    // Coarsest level
+    lev = *nlev;
+    Vmixcoarse(&nxf, &nyf, &nzf, iz, lev, mgsolv, epsiln, omega,
+               ipc, rpc, ac, cc,
+               RAT(sw0, VAT2(iz, 1,lev)), RAT(sx, VAT2(iz, 1,lev)), w2, w3,
+               &xnumc, &xdenc);
+
+    // Go up grids: damped coarse grid correction, then smooth
+    for (level=*nlev-1; level>=1; level--) {
+
+        lev = level;
+        numlev = 1;
+        Vmkfine(&numlev, &nxf, &nyf, &nzf, &nxc, &nyc, &nzc);
+
+        Vmixinterp(&nxf, &nyf, &nzf, &nxc, &nyc, &nzc,
+                   RAT(sx, VAT2(iz, 1,lev+1)), sw1, spc[lev]);
+
+        // Hackbusch/Reusken damping parameter, as in Vmvcs
+        if (lev+1 == *nlev) {
+            xnum = xnumc;
+            xden = xdenc;
+        } else {
+            Vmixapply(&nxf, &nyf, &nzf, RAT(ipc, VAT2(iz, 5,lev+1)),
+                      sac[lev+1], scc[lev+1],
+                      VNULL, RAT(sx, VAT2(iz, 1,lev+1)), sw2);
+            xnum = Vmixdot(&nxf, &nyf, &nzf,
+                           RAT(sx, VAT2(iz, 1,lev+1)),
+                           RAT(sw0, VAT2(iz, 1,lev+1)));
+            xden = Vmixdot(&nxf, &nyf, &nzf, RAT(sx, VAT2(iz, 1,lev+1)), sw2);
+        }
+        xdamp = (xden != 0.0) ? (float)(xnum / xden) : 1.0f;
+
+        nxf = nxc;
+        nyf = nyc;
+        nzf = nzc;
+
+        n = nxf * nyf * nzf;
+        sxl = RAT(sx, VAT2(iz, 1,lev));
+        #pragma omp parallel for private(i)
+        for (i=0; i<n; i++)
+            sxl[i] += xdamp * sw1[i];
+
+        nuuu = Vivariv(nu2, &lev);
+        Vmixgs(&nxf, &nyf, &nzf, RAT(ipc, VAT2(iz, 5,lev)),
+               sac[lev], scc[lev],
+               RAT(sw0, VAT2(iz, 1,lev)), RAT(sx, VAT2(iz, 1,lev)),
+               nuuu, 1);
+    }
+}
+
+VPUBLIC int Vmixsz(int *mgdisc, int *nf, int *narrc) {
+
+    size_t n_sac, n_free;
+
+    // Fine operator storage as in Vmgsz
+    if (*mgdisc == 1) {
+        n_sac = (size_t)14 * *nf;
+    } else {
+        n_sac = (size_t)4 * *nf;
+    }
+
+    /* The coarse fc and the pc that follows it are packed down to 27 narrc
+     * floats; the float fine operator takes the rest if it fits */
+    n_free = (size_t)29 * *narrc;
+    if (n_sac <= n_free) {
+        return 0;
+    }
+
+    return (int)((n_sac + 1) / 2);
+}
+
+/* Convert n doubles to floats in the first half of their own storage;
+ * each float lands on a double that has already been read */
+VPRIVATE void Vmixshrink(int n, double *d) {
+
+    int i;
+    float *s = (float *)d;
+
+    for (i=0; i<n; i++)
+        s[i] = (float)d[i];
+}
+
+VPUBLIC void Vmvmix(int *nx, int *ny, int *nz,
+        double *x, int *iz,
+        double *w0, double *w1, double *w2, double *w3,
+        int *istop, int *itmax, int *iters, int *ierror,
+        int *nlev, int *mgsolv, int *iok, int *iinfo,
+        double *epsiln, double *errtol, double *omega,
+        int *nu1, int *nu2,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc, double *fc,
+        float *sw, int *icopy) {
+
+    int i, lev, nf, narr, narrc, n_ac, n_pc, n_fre;
+
+    double rsden;   // @todo: doc
+    double rsnrm;   // @todo: doc
+    double orsnrm;  // @todo: doc
+    double scal;    // @todo: doc
+
+    float *sfre, *sx, *sw0, *sw1, *sw2;
+    float **sac, **spc, **scc;
+
+    MAT2(iz, 50, 1);
+
+    VASSERT_MSG1(*nlev > 1, "Mixed precision needs nlev > 1: %d", *nlev);
+
+    nf    = *nx * *ny * *nz;
+    narr  = VAT2(iz,  1, *nlev+1) - 1;
+    narrc = narr - nf;
+    n_ac  = VAT2(iz,  7, 2) - 1;
+    n_pc  = VAT2(iz, 11, *nlev) - 1;
+
+    /* The coarse fc and pc of rwork are one block; the coarse fc is not
+     * used here, so the float pc is packed to the end of the block and
+     * the rest is free */
+    VASSERT(pc == fc + narr);
+    n_fre = 2*(narrc + n_pc) - n_pc;
+    sfre  = (float *)(fc + nf);
+
+    /* Level by level float storage: the fine operator in the free part of
+     * that block if it fits (see Vmixsz), otherwise in sw; the fine
+     * Helmholtz term in w1; coarse operators and Helmholtz terms in place
+     * of their doubles.  The coarsest level is only used in double */
+    sac = (float **)Vmem_malloc(VNULL, *nlev+1, sizeof(float *));
+    spc = (float **)Vmem_malloc(VNULL, *nlev+1, sizeof(float *));
+    scc = (float **)Vmem_malloc(VNULL, *nlev+1, sizeof(float *));
+    sac[1] = (n_ac <= n_fre) ? sfre : sw;
+    scc[1] = (float *)w1;
+    for (lev=2; lev<*nlev; lev++) {
+        sac[lev] = (float *)RAT(ac, VAT2(iz, 7,lev));
+        scc[lev] = (float *)RAT(cc, VAT2(iz, 1,lev));
+    }
+    for (lev=1; lev<*nlev; lev++)
+        spc[lev] = RAT(sfre + n_fre, VAT2(iz, 11,lev));
+    VASSERT(sac[1] != VNULL);
+
+    // Each float vector pair takes the place of one double vector
+    sx  = (float *)w2;
+    sw0 = sx  + narr;
+    sw1 = (float *)w3;
+    sw2 = sw1 + nf;
+
+    /* Single-precision hierarchy, unless it is kept from the last solve;
+     * the in-place conversions run in order, so they stay serial */
+    if (*icopy) {
+        Vnm_tstart(30, "Vmvmix: single precision copy");
+        for (i=n_pc-1; i>=0; i--)
+            sfre[n_fre + i] = (float)pc[i];
+        #pragma omp parallel for private(i)
+        for (i=0; i<n_ac; i++)
+            sac[1][i] = (float)ac[i];
+        for (lev=2; lev<*nlev; lev++) {
+            Vmixshrink(VAT2(iz, 7,lev+1) - VAT2(iz, 7,lev),
+                       RAT(ac, VAT2(iz, 7,lev)));
+            Vmixshrink(VAT2(iz, 1,lev+1) - VAT2(iz, 1,lev),
+                       RAT(cc, VAT2(iz, 1,lev)));
+        }
+        Vnm_tstop(30, "Vmvmix: single precision copy");
+    }
+
+    // The fine Helmholtz term is rebuilt in w1 by every fine setup
+    #pragma omp parallel for private(i)
+    for (i=0; i<nf; i++)
+        scc[1][i] = (float)cc[i];
+    if (*iinfo > 1) {
+        VMESSAGE0("Starting mvmix operation");
+        VMESSAGE3("Fine Grid Size:   (%d, %d, %d)", *nx, *ny, *nz);
+    }
+
+    if (*iok != 0) {
+        Vprtstp(*iok, -1, 0.0, 0.0, 0.0);
+    }
+
+    // Compute denominator for stopping criterion
+    if (*istop == 0) {
+        rsden = 1.0;
+    } else if (*istop == 1) {
+        rsden = Vxnrm1(nx, ny, nz, fc);
+    } else {
+        VABORT_MSG1("Bad istop value: %d", *istop);
+    }
+    if (rsden == 0.0) {
+        rsden = 1.0;
+        VERRMSG0("rhs is zero on finest level");
+    }
+
+    // Initial residual in double precision
+    Vmresid(nx, ny, nz, ipc, rpc, ac, cc, fc, x, w0);
+    rsnrm = Vxnrm1(nx, ny, nz, w0);
+    orsnrm = rsnrm;
+
+    if (*iok != 0) {
+        Vprtstp(*iok, 0, rsnrm, rsden, orsnrm);
+    }
+
+    *iters = 0;
+    do {
+
+        /* Correction equation in single precision; the residual is scaled
+         * to unit mean so that it stays well inside the float range */
+        scal = (rsnrm > 0.0) ? (double)nf / rsnrm : 1.0;
+        #pragma omp parallel for private(i)
+        for (i=0; i<nf; i++)
+            sw0[i] = (float)(scal * w0[i]);
+        Vmixbound00(nx, ny, nz, sw0);
+
+        /* The double residual is dead until the update, so the coarsest
+         * solve borrows w0; its cghs vectors overlap sw1 and sw2, which
+         * are idle there */
+        Vmixcycle(nx, ny, nz, iz, nlev, mgsolv, epsiln, omega, nu1, nu2,
+                  ipc, rpc, ac, cc, sac, spc, scc,
+                  sx, sw0, sw1, sw2, w0, w3);
+
+        // Update and new residual in double precision
+        scal = 1.0 / scal;
+        #pragma omp parallel for private(i)
+        for (i=0; i<nf; i++)
+            x[i] += scal * (double)sx[i];
+
+        (*iters)++;
+
+        orsnrm = rsnrm;
+        Vmresid(nx, ny, nz, ipc, rpc, ac, cc, fc, x, w0);
+        rsnrm = Vxnrm1(nx, ny, nz, w0);
+
+        if (*iok != 0) {
+            Vprtstp(*iok, *iters, rsnrm, rsden, orsnrm);
+        }
+
+    } while (*iters < *itmax && (rsnrm/rsden) > *errtol);
+
+    // Converged means the residual test passed, whatever the count
+    *ierror = ((rsnrm/rsden) <= *errtol) ? 0 : 1;
+
+    Vmem_free(VNULL, *nlev+1, sizeof(float *), (void **)&sac);
+    Vmem_free(VNULL, *nlev+1, sizeof(float *), (void **)&spc);
+    Vmem_free(VNULL, *nlev+1, sizeof(float *), (void **)&scc);
+}
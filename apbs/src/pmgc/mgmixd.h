@@ -0,0 +1,141 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Mixed-precision multigrid: single-precision v-cycles inside a
+ *          double-precision iterative refinement loop
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#ifndef _MGMIXD_H_
+#define _MGMIXD_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+#include "pmgc/mgsubd.h"
+#include "pmgc/mikpckd.h"
+#include "pmgc/matvecd.h"
+#include "pmgc/smoothd.h"
+#include "pmgc/mlinpckd.h"
+#include "pmgc/sparsed.h"
+#include "pmgc/simdd.h"
+
+/** @brief   Real workspace needed by Vmvmix, in doubles
+ *  @ingroup PMGC
+ *
+ *  Vmvmix converts the coarse operators and Helmholtz terms to floats in
+ *  place, packs the float prolongations into the coarse part of fc and pc,
+ *  and puts the float fine operator in what is left of it.  Only a fine
+ *  operator too large for that space is appended to the end of rwork, by
+ *  the drivers when iparm(23) = 1.
+ *
+ *  @returns Number of doubles to add to the real workspace
+ */
+VEXTERNC int Vmixsz(
+        int *mgdisc,  ///< @todo:  Doc
+        int *nf,      ///< Number of fine grid unknowns
+        int *narrc    ///< Size of a multilevel vector without the fine level
+        );
+
+/** @brief   Linear multigrid with single-precision v-cycles
+ *  @ingroup PMGC
+ *
+ *  Iterative refinement for A x = f: the residual r = f - A x and the update
+ *  x = x + e are formed in double precision on the finest level, and the
+ *  correction e is one v-cycle of Vmvcs applied to A e = r in single
+ *  precision.  The stopping test is the one of Vmvcs (istop 0 or 1), so the
+ *  iteration still reaches errtol; only the v-cycles lose precision, and
+ *  they are only asked for one digit or so per step.
+ *
+ *  The operators must be assembled (mgdisc 0 or 1) and smoothed with
+ *  red/black Gauss-Seidel (mgsmoo 1).  The coarsest level is solved in
+ *  double precision with the existing factorization (or cghs for
+ *  mgsolv = 0).
+ *
+ *  @note    The coarse operators and Helmholtz terms, except on the
+ *           coarsest level, are overwritten by their float copies, and the
+ *           coarse part of fc and the whole of pc by packed floats.  A kept
+ *           hierarchy (icopy = 0) is only usable by Vmvmix.
+ *  @note    w0, w1, w2 and w3 are multilevel double vectors; w1 holds the
+ *           float fine Helmholtz term, w2 and w3 the float vectors of the
+ *           v-cycle.  sw is the workspace sized by Vmixsz.
+ */
+VEXTERNC void Vmvmix(
+        int *nx,         ///< @todo:  Doc
+        int *ny,         ///< @todo:  Doc
+        int *nz,         ///< @todo:  Doc
+        double *x,       ///< @todo:  Doc
+        int *iz,         ///< @todo:  Doc
+        double *w0,      ///< Fine grid residual
+        double *w1,      ///< Float Helmholtz term of the fine level
+        double *w2,      ///< Float x and w0 of every level
+        double *w3,      ///< Two fine-grid float vectors
+        int *istop,      ///< @todo:  Doc
+        int *itmax,      ///< @todo:  Doc
+        int *iters,      ///< @todo:  Doc
+        int *ierror,     ///< @todo:  Doc
+        int *nlev,       ///< @todo:  Doc
+        int *mgsolv,     ///< @todo:  Doc
+        int *iok,        ///< @todo:  Doc
+        int *iinfo,      ///< @todo:  Doc
+        double *epsiln,  ///< @todo:  Doc
+        double *errtol,  ///< @todo:  Doc
+        double *omega,   ///< @todo:  Doc
+        int *nu1,        ///< @todo:  Doc
+        int *nu2,        ///< @todo:  Doc
+        int *ipc,        ///< @todo:  Doc
+        double *rpc,     ///< @todo:  Doc
+        double *pc,      ///< @todo:  Doc
+        double *ac,      ///< @todo:  Doc
+        double *cc,      ///< @todo:  Doc
+        double *fc,      ///< @todo:  Doc
+        float *sw,       ///< Single-precision workspace (see Vmixsz)
+        int *icopy       ///< 0 if the float hierarchy of the last solve
+                         ///< is intact, otherwise it is converted again
+        );
+
+#endif /* _MGMIXD_H_ */
@@ -71,6 +71,7 @@ VPUBLIC void Vbuildops(
     int nzold = 0;
     int numdia = 0;
     int key = 0;
+    int mgdisc_c = 0;
 
     // Utility variables
     int i;
@@ -113,7 +114,8 @@ VPUBLIC void Vbuildops(
         }
     }
 
-    // Build the (nlev-1) level operators
+    // Build the (nlev-1) level operators; these are always assembled
+    mgdisc_c = (*mgdisc == 2) ? 0 : *mgdisc;
     if (*ido == 1 || *ido == 2 || *ido == 3) {
 
         for (lev=2; lev<=*nlev; lev++) {
@@ -155,7 +157,7 @@ VPUBLIC void Vbuildops(
                              RAT(ccf, VAT2(iz, 1,lev-1)),  RAT(fcf, VAT2(iz, 1,lev-1)),  RAT(tcf, VAT2(iz,  1,lev-1)));
 
                     VbuildA(&nxx, &nyy, &nzz,
-                            ipkey, mgdisc, &numdia,
+                            ipkey, &mgdisc_c, &numdia,
                              RAT(ipc, VAT2(iz, 5,lev)),  RAT(rpc, VAT2(iz, 6,lev)),
                               RAT(ac, VAT2(iz, 7,lev)),   RAT(cc, VAT2(iz, 1,lev)),   RAT(fc, VAT2(iz,  1,lev)),
                               RAT(xf, VAT2(iz, 8,lev)),   RAT(yf, VAT2(iz, 9,lev)),   RAT(zf, VAT2(iz, 10,lev)),
@@ -182,7 +184,7 @@ VPUBLIC void Vbuildops(
                              RAT(ccf, VAT2(iz, 1, lev-1)),  RAT(fcf, VAT2(iz, 1, lev-1)),  RAT(tcf, VAT2(iz,  1, lev-1)));
 
                     VbuildA(&nxx, &nyy, &nzz,
-                            ipkey, mgdisc, &numdia,
+                            ipkey, &mgdisc_c, &numdia,
                              RAT(ipc, VAT2(iz, 5,lev)),  RAT(rpc, VAT2(iz, 6,lev)),
                               RAT(ac, VAT2(iz, 7,lev)),   RAT(cc, VAT2(iz, 1,lev)),   RAT(fc, VAT2(iz,  1,lev)),
                               RAT(xf, VAT2(iz, 8,lev)),   RAT(yf, VAT2(iz, 9,lev)),   RAT(zf, VAT2(iz, 10,lev)),
@@ -198,14 +200,26 @@ VPUBLIC void Vbuildops(
                     if (*iinfo > 0)
                         VMESSAGE3("Galer: (%03d, %03d, %03d)", nxx, nyy, nzz);
 
-                    Vbuildgaler0(&nxold, &nyold, &nzold,
-                            &nxx, &nyy, &nzz,
-                            ipkey, &numdia,
-                             RAT(pc, VAT2(iz, 11,lev-1)),
-                            RAT(ipc, VAT2(iz,  5,lev-1)), RAT(rpc, VAT2(iz, 6,lev-1)),
-                             RAT(ac, VAT2(iz,  7,lev-1)),  RAT(cc, VAT2(iz, 1,lev-1)), RAT(fc, VAT2(iz, 1,lev-1)),
-                            RAT(ipc, VAT2(iz,  5,lev  )), RAT(rpc, VAT2(iz, 6,lev  )),
-                             RAT(ac, VAT2(iz,  7,lev  )),  RAT(cc, VAT2(iz, 1,lev  )), RAT(fc, VAT2(iz, 1,lev  )));
+                    // A matrix-free fine operator is assembled band by band
+                    if (VAT(RAT(ipc, VAT2(iz, 5,lev-1)), 13) == 1) {
+                        Vbuildgalermf(&nxold, &nyold, &nzold,
+                                &nxx, &nyy, &nzz,
+                                ipkey, &numdia,
+                                 RAT(pc, VAT2(iz, 11,lev-1)),
+                                RAT(ipc, VAT2(iz,  5,lev-1)), RAT(rpc, VAT2(iz, 6,lev-1)),
+                                 RAT(ac, VAT2(iz,  7,lev-1)),  RAT(cc, VAT2(iz, 1,lev-1)), RAT(fc, VAT2(iz, 1,lev-1)),
+                                RAT(ipc, VAT2(iz,  5,lev  )), RAT(rpc, VAT2(iz, 6,lev  )),
+                                 RAT(ac, VAT2(iz,  7,lev  )),  RAT(cc, VAT2(iz, 1,lev  )), RAT(fc, VAT2(iz, 1,lev  )));
+                    } else {
+                        Vbuildgaler0(&nxold, &nyold, &nzold,
+                                &nxx, &nyy, &nzz,
+                                ipkey, &numdia,
+                                 RAT(pc, VAT2(iz, 11,lev-1)),
+                                RAT(ipc, VAT2(iz,  5,lev-1)), RAT(rpc, VAT2(iz, 6,lev-1)),
+                                 RAT(ac, VAT2(iz,  7,lev-1)),  RAT(cc, VAT2(iz, 1,lev-1)), RAT(fc, VAT2(iz, 1,lev-1)),
+                                RAT(ipc, VAT2(iz,  5,lev  )), RAT(rpc, VAT2(iz, 6,lev  )),
+                                 RAT(ac, VAT2(iz,  7,lev  )),  RAT(cc, VAT2(iz, 1,lev  )), RAT(fc, VAT2(iz, 1,lev  )));
+                    }
 
 
 
@@ -239,6 +253,18 @@ VPUBLIC void Vbuildops(
                     RAT(ipc, VAT2(iz, 5,lev  )), RAT(rpc, VAT2(iz, 6,lev  )), RAT(ac, VAT2(iz, 7,lev  )),
                     RAT(ipc, VAT2(iz, 5,lev+1)), RAT(rpc, VAT2(iz, 6,lev+1)), RAT(ac, VAT2(iz, 7,lev+1)));
 
+            if (key == 1) {
+                VERRMSG0("Changing your mgsolv to iterative");
+                *mgsolv = 0;
+            }
+        } else if (*mgsolv == 2) {
+            lev = *nlev;
+
+            Vbuildsparse(&key, &nxx, &nyy, &nzz,
+                    RAT(ipc, VAT2(iz, 5,lev  )), RAT(rpc, VAT2(iz, 6,lev  )),
+                     RAT(ac, VAT2(iz, 7,lev  )),  RAT(cc, VAT2(iz, 1,lev  )),
+                    RAT(ipc, VAT2(iz, 5,lev+1)), RAT(rpc, VAT2(iz, 6,lev+1)));
+
             if (key == 1) {
                 VERRMSG0("Changing your mgsolv to iterative");
                 *mgsolv = 0;
@@ -344,14 +370,107 @@ VPUBLIC void Vbuildgaler0(int *nxf, int *nyf, int *nzf,
     int numdia_loc;
 
     // Call the algebraic galerkin routine
+    Vnm_tstart(31, "Vbuildgaler0: Galerkin product");
     numdia_loc = VAT(ipcFF, 11);
     VbuildG(nxf, nyf, nzf,
             nxc, nyc, nzc,
             &numdia_loc,
             pcFF, acFF, ac);
+    Vnm_tstop(31, "Vbuildgaler0: Galerkin product");
+
+    // Note how many nonzeros in this new discretization stencil
+    VAT(ipc, 11) = 27;
+    VAT(ipc, 13) = 0;
+    VAT(ipc, 14) = 0;
+    *numdia = 14;
+
+    // Save the problem key with this new operator
+    VAT(ipc, 10) = *ipkey;
+
+    // Restrict the helmholtz term and source function
+    Vrestrc(nxf, nyf, nzf,
+            nxc, nyc, nzc,
+            ccFF, cc, pcFF);
+
+    Vrestrc(nxf, nyf, nzf,
+            nxc, nyc, nzc,
+            fcFF, fc, pcFF);
+}
+
+
+VPUBLIC void Vbuildgalermf(int *nxf, int *nyf, int *nzf,
+        int *nxc, int *nyc, int *nzc,
+        int *ipkey, int *numdia,
+        double *pcFF, int   *ipcFF, double *rpcFF,
+        double *acFF, double *ccFF, double *fcFF,
+        int *ipc, double *rpc,
+        double *ac, double *cc, double *fc) {
+
+    int kc0, kc1, nzcw, nzfw, kf0, s;
+    size_t nfw, offc;
+    double *work, *oC, *oE, *oN, *uC;
+    double *pcw[27], *acw[14];
+
+    MAT2(pcFF, *nxc * *nyc * *nzc, 27);
+    MAT2(acFF, *nxf * *nyf * *nzf,  3);
+    MAT2(  ac, *nxc * *nyc * *nzc, 14);
+
+    /* Coarse planes kc0..kc1 need the fine planes 2*kc0-2 to 2*kc1; the
+     * band holds fine planes 2*kc0-3 to 2*kc1+1, so that VbuildG_7 sees
+     * coarse planes kc0-1..kc1+1 and fills the interior ones.  Neither
+     * routine uses the z extent for indexing, only the plane stride */
+    nzcw = VMIN2(VGALERMF_KBAND, *nzc - 2) + 2;
+    nzfw = 2 * nzcw - 1;
+    nfw  = (size_t)(*nxf) * (*nyf) * nzfw;
+    work = (double *)Vmem_malloc(VNULL, 4 * nfw, sizeof(double));
+    oC = work;
+    oE = work + nfw;
+    oN = work + 2 * nfw;
+    uC = work + 3 * nfw;
+
+    Vnm_tstart(31, "Vbuildgalermf: Galerkin product");
+    for (kc0=2; kc0<=*nzc-1; kc0+=VGALERMF_KBAND) {
+        kc1  = VMIN2(kc0 + VGALERMF_KBAND - 1, *nzc - 1);
+        nzcw = kc1 - kc0 + 3;
+        nzfw = 2 * nzcw - 1;
+        kf0  = 2 * kc0 - 3;
+
+        // Assemble the fine operator of this band
+        VexpandA_mf(nxf, nyf, nzf,
+                &kf0, &nzfw, rpcFF,
+                RAT2(acFF, 1, 1), RAT2(acFF, 1, 2), RAT2(acFF, 1, 3),
+                oC, oE, oN, uC);
+
+        // Call the algebraic galerkin routine on the matching coarse planes
+        offc = (size_t)(kc0 - 2) * (*nxc) * (*nyc);
+        for (s=0; s<27; s++)
+            pcw[s] = RAT2(pcFF, 1, s+1) + offc;
+        for (s=0; s<14; s++)
+            acw[s] = RAT2(ac, 1, s+1) + offc;
+
+        VbuildG_7(nxf, nyf, &nzfw,
+                nxc, nyc, &nzcw,
+                pcw[ 0], pcw[ 1], pcw[ 2], pcw[ 3], pcw[ 4],
+                pcw[ 5], pcw[ 6], pcw[ 7], pcw[ 8],
+                pcw[ 9], pcw[10], pcw[11], pcw[12], pcw[13],
+                pcw[14], pcw[15], pcw[16], pcw[17],
+                pcw[18], pcw[19], pcw[20], pcw[21], pcw[22],
+                pcw[23], pcw[24], pcw[25], pcw[26],
+                oC, oE, oN, uC,
+                acw[ 0], acw[ 1], acw[ 2],
+                acw[ 3],
+                acw[ 4], acw[ 5],
+                acw[ 6], acw[ 7], acw[ 8], acw[ 9],
+                acw[10], acw[11], acw[12], acw[13]);
+    }
+    Vnm_tstop(31, "Vbuildgalermf: Galerkin product");
+
+    Vmem_free(VNULL, 4 * nfw, sizeof(double), (void **)&work);
 
     // Note how many nonzeros in this new discretization stencil
     VAT(ipc, 11) = 27;
+    VAT(ipc, 13) = 0;
+    VAT(ipc, 14) = 0;
     *numdia = 14;
 
     // Save the problem key with this new operator
@@ -369,6 +488,7 @@ VPUBLIC void Vbuildgaler0(int *nxf, int *nyf, int *nzf,
 
 
 
+
 VPUBLIC void Vmkcors(int *numlev,
         int *nxold, int *nyold, int *nzold,
         int *nxnew, int *nynew, int *nznew) {
@@ -551,7 +671,8 @@ VPUBLIC void Vpackmg(int *iparm, double *rparm, size_t *nrwk, int *niwk,
         int *nx, int *ny, int *nz, int *nlev, int *nu1, int *nu2, int *mgkey,
         int *itmax, int *istop, int *ipcon, int *nonlin, int *mgsmoo, int *mgprol,
         int *mgcoar, int *mgsolv, int *mgdisc, int *iinfo, double *errtol,
-        int *ipkey, double *omegal, double *omegan, int *irite, int *iperf) {
+        int *ipkey, double *omegal, double *omegan, int *irite, int *iperf,
+        int *mgprec) {
 
     /// @todo  Convert this into a struct
 
@@ -578,6 +699,16 @@ VPUBLIC void Vpackmg(int *iparm, double *rparm, size_t *nrwk, int *niwk,
     VAT(iparm, 20) = *mgsmoo;
     VAT(iparm, 21) = *mgsolv;
     VAT(iparm, 22) = *iperf;
+    VAT(iparm, 23) = *mgprec;
+
+    // Operator reuse is negotiated per solve by the caller
+    VAT(iparm, 24) = 0;
+
+    // Zero initial guess unless the caller supplies one for a solve
+    VAT(iparm, 25) = 0;
+
+    // Classic Newton unless the caller asks for the inexact variant
+    VAT(iparm, 26) = 0;
 
     // Encode rparm parameters
     VAT(rparm, 1)  = *errtol;
@@ -61,6 +61,7 @@
 #include "pmgc/buildPd.h"
 #include "pmgc/buildBd.h"
 #include "pmgc/buildGd.h"
+#include "pmgc/sparsed.h"
 
 #define HARMO2(a, b)                   (2.0 * (a) * (b) / ((a) + (b)))
 #define HARMO4(a, b, c, d)             (1.0 / ( 0.25 * ( 1.0/(a) + 1.0/(b) + 1.0/(c) + 1.0/(d))))
@@ -69,6 +70,9 @@
 #define ARITH6(a, b, c, d, e, f)       (((a) + (b) + (c) + (d) + (e) + (f)) / 6.0)
 #define ARITH8(a, b, c, d, e, f, g, h) (((a) + (b) + (c) + (d) + (e) + (f) + (g) + (h)) / 8.0)
 
+/** @brief Coarse z-planes per band in Vbuildgalermf; whole VbuildG_7 blocks */
+#define VGALERMF_KBAND (4 * VBUILDG_KBLK)
+
 /** @brief   Build operators, boundary arrays, modify affine vectors
  *             ido==0: do only fine level
  *             ido==1: do only coarse levels (including second op at coarsest)
@@ -171,6 +175,37 @@ VEXTERNC void Vbuildgaler0(
         double *fc      ///< @todo: doc
         );
 
+/** @brief   Form the Galerkin coarse grid system from a matrix-free fine
+ *           operator (see VbuildA_mf)
+ *  @ingroup PMGC
+ *
+ *  Handled as in Vbuildgaler0, except that the fine operator is assembled
+ *  (VexpandA_mf) a band of z-planes at a time, into a scratch buffer
+ *  allocated here, and VbuildG_7 builds the coarse planes of each band.
+ *  No array of the caller is used as scratch.
+ */
+VEXTERNC void Vbuildgalermf(
+        int    *nxf,    ///< @todo: doc
+        int    *nyf,    ///< @todo: doc
+        int    *nzf,    ///< @todo: doc
+        int    *nxc,    ///< @todo: doc
+        int    *nyc,    ///< @todo: doc
+        int    *nzc,    ///< @todo: doc
+        int    *ipkey,  ///< @todo: doc
+        int    *numdia, ///< @todo: doc
+        double *pcFF,   ///< @todo: doc
+        int    *ipcFF,  ///< @todo: doc
+        double *rpcFF,  ///< @todo: doc
+        double *acFF,   ///< @todo: doc
+        double *ccFF,   ///< @todo: doc
+        double *fcFF,   ///< @todo: doc
+        int    *ipc,    ///< @todo: doc
+        double *rpc,    ///< @todo: doc
+        double *ac,     ///< @todo: doc
+        double *cc,     ///< @todo: doc
+        double *fc      ///< @todo: doc
+        );
+
 
 
 /** @brief   Coarsen a grid
@@ -304,7 +339,8 @@ VEXTERNC void Vpackmg(
         double *omegal,
         double *omegan,
         int *irite,
-        int *iperf
+        int *iperf,
+        int *mgprec
         );
 
 
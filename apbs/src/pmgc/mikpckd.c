@@ -335,7 +335,9 @@ VPUBLIC void Vprtmatd(int *nx, int *ny, int *nz,
 
     // Do the printing
     numdia = VAT(ipc, 11);
-    if (numdia == 7) {
+    if (numdia == 7 && VAT(ipc, 13) == 1) {
+       Vnm_print(2, "Vprtmatd: matrix-free operator has no stored diagonals\n");
+    } else if (numdia == 7) {
        Vprtmatd7(nx, ny, nz,
                ipc, rpc,
                RAT2(ac, 1, 1), RAT2(ac, 1, 2), RAT2(ac, 1, 3), RAT2(ac, 1, 4));
@@ -113,6 +113,19 @@ VPUBLIC void Vmypdefinitsmpbe(int *tnion, double *tcharge, double *tsconc,
 
 
 
+/* exp() of a block of clamped arguments, in place */
+VPRIVATE void Vmyp_exp(int n, double *x) {
+
+    int q;
+
+    if (!Vexp_simd(n, x, x)) {
+        for (q=0; q<n; q++)
+            x[q] = exp(x[q]);
+    }
+}
+
+
+
 VPUBLIC void Vc_vec(double *coef, double *uin, double *uout,
         int *nx, int *ny, int *nz, int *ipkey) {
 
@@ -133,13 +146,13 @@ VPUBLIC void Vc_vecpmg(double *coef, double *uin, double *uout,
     double am_zero;
     double am_neg;
     double am_pos;
-    double argument;
+    double argument[EXPBLOCK];
     int ichopped;
     int ichopped_neg;
     int ichopped_pos;
     int iion;
 
-    int n, i;
+    int n, i, i0, q, nb;
 
     n = *nx * *ny * *nz;
 
@@ -160,28 +173,40 @@ VPUBLIC void Vc_vecpmg(double *coef, double *uin, double *uout,
 
             #pragma omp parallel for \
              default(shared) \
-             private(i, ichopped_neg, ichopped_pos, am_zero, am_neg, am_pos, argument) \
+             private(i, i0, q, nb, ichopped_neg, ichopped_pos, \
+                     am_zero, am_neg, am_pos, argument) \
              reduction(+ : ichopped)
-            for (i=1; i<=n; i++) {
+            for (i0=1; i0<=n; i0+=EXPBLOCK) {
+                nb = VMIN2(EXPBLOCK, n - i0 + 1);
+
+                for (q=0; q<nb; q++) {
+                    i = i0 + q;
+
+                    // am_zero is 0 if coef zero, and 1 if coef nonzero
+                    am_zero = VMIN2(ZSMALL, VABS(zcf2 * VAT(coef, i))) * ZLARGE;
 
-                // am_zero is 0 if coef zero, and 1 if coef nonzero
-                am_zero = VMIN2(ZSMALL, VABS(zcf2 * VAT(coef, i))) * ZLARGE;
+                    // am_neg is chopped u if u negative, 0 if u positive
+                    am_neg = VMAX2(VMIN2(zu2 * VAT(uin, i), 0.0), SINH_MIN);
 
-                // am_neg is chopped u if u negative, 0 if u positive
-                am_neg = VMAX2(VMIN2(zu2 * VAT(uin, i), 0.0), SINH_MIN);
+                    // am_neg is chopped u if u positive, 0 if u negative
+                    am_pos = VMIN2(VMAX2(zu2 * VAT(uin, i), 0.0), SINH_MAX);
 
-                // am_neg is chopped u if u positive, 0 if u negative
-                am_pos = VMIN2(VMAX2(zu2 * VAT(uin, i), 0.0), SINH_MAX);
+                    // Finally determine the exp() argument
+                    argument[q] = am_zero * (am_neg + am_pos);
 
-                // Finally determine the function value
-                argument = am_zero * (am_neg + am_pos);
+                    // Count chopped values
+                    ichopped_neg = (int)(am_neg / SINH_MIN);
+                    ichopped_pos = (int)(am_pos / SINH_MAX);
+                    ichopped += (int)(floor(am_zero+0.5)) * (ichopped_neg + ichopped_pos);
+                }
 
-                VAT(uout, i) = VAT(uout, i) + zcf2 * VAT(coef, i) * exp(argument);
+                // One vector exp() call per block
+                Vmyp_exp(nb, argument);
 
-                // Count chopped values
-                ichopped_neg = (int)(am_neg / SINH_MIN);
-                ichopped_pos = (int)(am_pos / SINH_MAX);
-                ichopped += (int)(floor(am_zero+0.5)) * (ichopped_neg + ichopped_pos);
+                for (q=0; q<nb; q++) {
+                    i = i0 + q;
+                    VAT(uout, i) = VAT(uout, i) + zcf2 * VAT(coef, i) * argument[q];
+                }
             }
 
             // Info
@@ -216,6 +241,7 @@ VPUBLIC void Vc_vecsmpbe(double *coef, double *uin, double *uout,
     int ichopped, ichopped_neg, ichopped_pos;
     int iion;
     int n, i, ii, ipara, ivect;
+    int i0, q, nb;
 
     int nproc = 1;
 
@@ -223,7 +249,8 @@ VPUBLIC void Vc_vecsmpbe(double *coef, double *uin, double *uout,
     double fracOccA, fracOccB, fracOccC, phi, ionStr;
     double z1, z2, z3, ca, cb, cc, a, k;
     double a1_neg, a1_pos, a2_neg, a2_pos;
-    double a3_neg, a3_pos, a1, a2, a3;
+    double a3_neg, a3_pos;
+    double e1[EXPBLOCK], e2[EXPBLOCK], e3[EXPBLOCK];
     double f, g, gpark, alpha;
 
     WARN_UNTESTED;
@@ -283,48 +310,62 @@ VPUBLIC void Vc_vecsmpbe(double *coef, double *uin, double *uout,
     alpha  = (fracOccA / k) / (1 - phi);
     ionStr = 0.5 * (ca * VPOW(z1, 2.0) + cb * VPOW(z2, 2.0) + cc * VPOW(z3, 2));
 
-    for (i=1; i<=n; i++) {
+    for (i0=1; i0<=n; i0+=EXPBLOCK) {
+        nb = VMIN2(EXPBLOCK, n - i0 + 1);
 
-        am_zero = VMIN2(ZSMALL, VABS(VAT(coef, i))) * ZLARGE;
+        for (q=0; q<nb; q++) {
+            i = i0 + q;
 
-        // Compute the arguments for exp(-z*u) term
-        a1_neg = VMAX2(VMIN2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MIN);
-        a1_pos = VMIN2(VMAX2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MAX);
+            am_zero = VMIN2(ZSMALL, VABS(VAT(coef, i))) * ZLARGE;
 
-        // Compute the arguments for exp(-u) term
-        a2_neg = VMAX2(VMIN2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MIN);
-        a2_pos = VMIN2(VMAX2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MAX);
+            // Compute the arguments for exp(-z*u) term
+            a1_neg = VMAX2(VMIN2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MIN);
+            a1_pos = VMIN2(VMAX2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MAX);
 
-        // Compute the arguments for exp(u) term
-        a3_neg = VMAX2(VMIN2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MIN);
-        a3_pos = VMIN2(VMAX2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MAX);
+            // Compute the arguments for exp(-u) term
+            a2_neg = VMAX2(VMIN2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MIN);
+            a2_pos = VMIN2(VMAX2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MAX);
 
-        a1 = am_zero * (a1_neg + a1_pos);
-        a2 = am_zero * (a2_neg + a2_pos);
-        a3 = am_zero * (a3_neg + a3_pos);
+            // Compute the arguments for exp(u) term
+            a3_neg = VMAX2(VMIN2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MIN);
+            a3_pos = VMIN2(VMAX2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MAX);
 
-        gpark = (1 + alpha * exp(a1)) / (1 + alpha);
+            e1[q] = am_zero * (a1_neg + a1_pos);
+            e2[q] = am_zero * (a2_neg + a2_pos);
+            e3[q] = am_zero * (a3_neg + a3_pos);
 
-        if (k - 1 <  ZSMALL) {
-            f = z1 * ca * exp(a1) + z2 * cb * exp(a2) + z3 * cc * exp(a3);
-            g = 1 - phi + fracOccA * exp(a1)
-                        + fracOccB * exp(a2)
-                        + fracOccC * exp(a3);
-        } else {
-            f = z1 * ca * exp(a1) * VPOW(gpark, k-1)
-              + z2 * cb * exp(a2)
-              + z3 * cc * exp(a3);
-            g = (1 - phi + fracOccA / k) * VPOW(gpark, k)
-              + fracOccB * exp(a2)
-              + fracOccC * exp(a3);
+            // Count chopped values
+            ichopped_neg = (int)((a1_neg + a2_neg+a3_neg) / SINH_MIN);
+            ichopped_pos = (int)((a1_pos + a2_pos+a3_pos) / SINH_MAX);
+            ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
         }
 
-        VAT(uout, i) = -1.0 * VAT(coef, i) * (0.5 / ionStr) * (f / g);
+        // The exp() arguments become the exp() values
+        Vmyp_exp(nb, e1);
+        Vmyp_exp(nb, e2);
+        Vmyp_exp(nb, e3);
+
+        for (q=0; q<nb; q++) {
+            i = i0 + q;
+
+            gpark = (1 + alpha * e1[q]) / (1 + alpha);
+
+            if (k - 1 <  ZSMALL) {
+                f = z1 * ca * e1[q] + z2 * cb * e2[q] + z3 * cc * e3[q];
+                g = 1 - phi + fracOccA * e1[q]
+                            + fracOccB * e2[q]
+                            + fracOccC * e3[q];
+            } else {
+                f = z1 * ca * e1[q] * VPOW(gpark, k-1)
+                  + z2 * cb * e2[q]
+                  + z3 * cc * e3[q];
+                g = (1 - phi + fracOccA / k) * VPOW(gpark, k)
+                  + fracOccB * e2[q]
+                  + fracOccC * e3[q];
+            }
 
-        // Count chopped values
-        ichopped_neg = (int)((a1_neg + a2_neg+a3_neg) / SINH_MIN);
-        ichopped_pos = (int)((a1_pos + a2_pos+a3_pos) / SINH_MAX);
-        ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
+            VAT(uout, i) = -1.0 * VAT(coef, i) * (0.5 / ionStr) * (f / g);
+        }
     }
 
     // Info
@@ -352,10 +393,10 @@ VPUBLIC void Vdc_vecpmg(double *coef, double *uin, double *uout,
     int ideg, iion;
     double  zcf2, zu2;
     double am_zero, am_neg, am_pos;
-    double argument, poly, fact;
+    double argument[EXPBLOCK], poly, fact;
 
     int ichopped, ichopped_neg, ichopped_pos;
-    int n, i;
+    int n, i, i0, q, nb;
 
     // Find parallel loops (ipara), remainder (ivect)
     n = *nx * *ny * *nz;
@@ -377,28 +418,40 @@ VPUBLIC void Vdc_vecpmg(double *coef, double *uin, double *uout,
 
             #pragma omp parallel for \
              default(shared) \
-             private(i, ichopped_neg, ichopped_pos, \
+             private(i, i0, q, nb, ichopped_neg, ichopped_pos, \
                                  am_zero, am_neg, am_pos, argument) \
              reduction(+:ichopped)
-            for (i=1; i<=n; i++) {
+            for (i0=1; i0<=n; i0+=EXPBLOCK) {
+                nb = VMIN2(EXPBLOCK, n - i0 + 1);
+
+                for (q=0; q<nb; q++) {
+                    i = i0 + q;
 
-                // am_zero is 0 if coef zero, and 1 if coef nonzero
-                am_zero = VMIN2(ZSMALL, VABS(zcf2 * VAT(coef, i))) * ZLARGE;
+                    // am_zero is 0 if coef zero, and 1 if coef nonzero
+                    am_zero = VMIN2(ZSMALL, VABS(zcf2 * VAT(coef, i))) * ZLARGE;
 
-                // am_neg is chopped u if u negative, 0 if u positive
-                am_neg = VMAX2(VMIN2(zu2 * VAT(uin, i), 0.0), SINH_MIN);
+                    // am_neg is chopped u if u negative, 0 if u positive
+                    am_neg = VMAX2(VMIN2(zu2 * VAT(uin, i), 0.0), SINH_MIN);
 
-                // am_neg is chopped u if u positive, 0 if u negative
-                am_pos = VMIN2(VMAX2(zu2 * VAT(uin, i), 0.0), SINH_MAX);
+                    // am_neg is chopped u if u positive, 0 if u negative
+                    am_pos = VMIN2(VMAX2(zu2 * VAT(uin, i), 0.0), SINH_MAX);
 
-                // Finally determine the function value
-                argument = am_zero * (am_neg + am_pos);
-                VAT(uout, i) += zcf2 * VAT(coef, i) * exp( argument );
+                    // Finally determine the exp() argument
+                    argument[q] = am_zero * (am_neg + am_pos);
 
-                // Count chopped values
-                ichopped_neg = (int)(am_neg / SINH_MIN);
-                ichopped_pos = (int)(am_pos / SINH_MAX);
-                ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
+                    // Count chopped values
+                    ichopped_neg = (int)(am_neg / SINH_MIN);
+                    ichopped_pos = (int)(am_pos / SINH_MAX);
+                    ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
+                }
+
+                // One vector exp() call per block
+                Vmyp_exp(nb, argument);
+
+                for (q=0; q<nb; q++) {
+                    i = i0 + q;
+                    VAT(uout, i) += zcf2 * VAT(coef, i) * argument[q];
+                }
             }
 
             // Info
@@ -426,6 +479,7 @@ VPUBLIC void Vdc_vecsmpbe(double *coef, double *uin, double *uout,
 
     int n, i, ii;
     int ipara, ivect;
+    int i0, q, nb;
 
     int nproc = 1;
 
@@ -433,7 +487,8 @@ VPUBLIC void Vdc_vecsmpbe(double *coef, double *uin, double *uout,
     double fracOccA, fracOccB, fracOccC, phi, ionStr;
     double z1, z2, z3, ca, cb, cc, a, k;
     double a1_neg, a1_pos, a2_neg, a2_pos;
-    double a3_neg, a3_pos, a1, a2, a3;
+    double a3_neg, a3_pos;
+    double e1[EXPBLOCK], e2[EXPBLOCK], e3[EXPBLOCK];
     double f, g, fprime, gprime, gpark, alpha;
 
     WARN_UNTESTED;
@@ -469,72 +524,86 @@ VPUBLIC void Vdc_vecsmpbe(double *coef, double *uin, double *uout,
     alpha = (fracOccA / k) /(1 - phi);
     ionStr = 0.5*(ca * VPOW(z1, 2) + cb * VPOW(z2, 2) + cc * VPOW(z3, 2));
 
-    for (i=1; i<=n; i++) {
+    for (i0=1; i0<=n; i0+=EXPBLOCK) {
+        nb = VMIN2(EXPBLOCK, n - i0 + 1);
 
-        am_zero = VMIN2(ZSMALL, VABS(VAT(coef, i))) * ZLARGE;
+        for (q=0; q<nb; q++) {
+            i = i0 + q;
 
-        // Compute the arguments for exp(-z*u) term
-        a1_neg = VMAX2(VMIN2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MIN);
-        a1_pos = VMIN2(VMAX2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MAX);
+            am_zero = VMIN2(ZSMALL, VABS(VAT(coef, i))) * ZLARGE;
 
-        // Compute the arguments for exp(-u) term
-        a2_neg = VMAX2(VMIN2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MIN);
-        a2_pos = VMIN2(VMAX2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MAX);
+            // Compute the arguments for exp(-z*u) term
+            a1_neg = VMAX2(VMIN2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MIN);
+            a1_pos = VMIN2(VMAX2(-1.0 * z1 * VAT(uin, i), 0.0), SINH_MAX);
 
-        // Compute the arguments for exp(u) term
-        a3_neg = VMAX2(VMIN2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MIN);
-        a3_pos = VMIN2(VMAX2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MAX);
+            // Compute the arguments for exp(-u) term
+            a2_neg = VMAX2(VMIN2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MIN);
+            a2_pos = VMIN2(VMAX2(-1.0 * z2 * VAT(uin, i), 0.0), SINH_MAX);
 
-        a1 = am_zero * (a1_neg + a1_pos);
-        a2 = am_zero * (a2_neg + a2_pos);
-        a3 = am_zero * (a3_neg + a3_pos);
+            // Compute the arguments for exp(u) term
+            a3_neg = VMAX2(VMIN2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MIN);
+            a3_pos = VMIN2(VMAX2(-1.0 * z3 * VAT(uin, i), 0.0), SINH_MAX);
 
-        gpark = (1 + alpha * exp(a1)) / (1 + alpha);
+            e1[q] = am_zero * (a1_neg + a1_pos);
+            e2[q] = am_zero * (a2_neg + a2_pos);
+            e3[q] = am_zero * (a3_neg + a3_pos);
 
-        if (k - 1 < ZSMALL) {
-            f = z1 * ca * exp(a1) + z2 * cb * exp(a2) + z3 * cc * exp(a3);
-            g = 1 - phi + fracOccA * exp(a1)
-                        + fracOccB * exp(a2)
-                        + fracOccC * exp(a3);
+            // Count chopped values
+            ichopped_neg = (int)((a1_neg + a2_neg + a3_neg) / SINH_MIN);
+            ichopped_pos = (int)((a1_pos + a2_pos + a3_pos) / SINH_MAX);
+            ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
+        }
 
-            fprime =
-                   - VPOW(z1, 2) * ca * exp(a1)
-                   - VPOW(z2, 2) * cb * exp(a2)
-                   - VPOW(z3, 2) * cc * exp(a3);
+        // The exp() arguments become the exp() values
+        Vmyp_exp(nb, e1);
+        Vmyp_exp(nb, e2);
+        Vmyp_exp(nb, e3);
+
+        for (q=0; q<nb; q++) {
+            i = i0 + q;
+
+            gpark = (1 + alpha * e1[q]) / (1 + alpha);
+
+            if (k - 1 < ZSMALL) {
+                f = z1 * ca * e1[q] + z2 * cb * e2[q] + z3 * cc * e3[q];
+                g = 1 - phi + fracOccA * e1[q]
+                            + fracOccB * e2[q]
+                            + fracOccC * e3[q];
+
+                fprime =
+                       - VPOW(z1, 2) * ca * e1[q]
+                       - VPOW(z2, 2) * cb * e2[q]
+                       - VPOW(z3, 2) * cc * e3[q];
+
+                gprime =
+                       - z1 * fracOccA * e1[q]
+                       - z2 * fracOccB * e2[q]
+                       - z3 * fracOccC * e3[q];
+            } else {
+                f = z1 * ca * e1[q] * VPOW(gpark, k - 1)
+                  + z2 * cb * e2[q]
+                  + z3 * cc * e3[q];
+                g = (1 - phi + fracOccA / k) * VPOW(gpark, k)
+                  + fracOccB * e2[q]
+                  + fracOccC * e3[q];
+
+                fprime =
+                       - VPOW(z1, 2) * ca * e1[q] * VPOW(gpark, k - 2)
+                       * (gpark + (k - 1) * (alpha / (1 + alpha)) * e1[q])
+                       - VPOW(z2, 2) * cb * e2[q]
+                       - VPOW(z3, 2) * cc * e3[q];
+
+                gprime =
+                       - k * z1 * (alpha / (1 + alpha)) * e1[q]
+                       * (1 - phi + fracOccA / k) * VPOW(gpark, k - 1)
+                       - z2 * fracOccB * e2[q]
+                       - z3 * fracOccC * e3[q];
 
-            gprime =
-                   - z1 * fracOccA * exp(a1)
-                   - z2 * fracOccB * exp(a2)
-                   - z3 * fracOccC * exp(a3);
-        } else {
-            f = z1 * ca * exp(a1) * VPOW(gpark, k - 1)
-              + z2 * cb * exp(a2)
-              + z3 * cc * exp(a3);
-            g = (1 - phi + fracOccA / k) * VPOW(gpark, k)
-              + fracOccB * exp(a2)
-              + fracOccC * exp(a3);
-
-            fprime =
-                   - VPOW(z1, 2) * ca * exp(a1) * VPOW(gpark, k - 2)
-                   * (gpark + (k - 1) * (alpha / (1 + alpha)) * exp(a1))
-                   - VPOW(z2, 2) * cb * exp(a2)
-                   - VPOW(z3, 2) * cc * exp(a3);
-
-            gprime =
-                   - k * z1 * (alpha / (1 + alpha)) * exp(a1)
-                   * (1 - phi + fracOccA / k) * VPOW(gpark, k - 1)
-                   - z2 * fracOccB * exp(a2)
-                   - z3 * fracOccC * exp(a3);
+            }
 
+            VAT(uout, i) = -1.0 * VAT(coef, i) * (0.5 / ionStr)
+                         * (fprime * g - gprime * f) / VPOW(g, 2.0);
         }
-
-        VAT(uout, i) = -1.0 * VAT(coef, i) * (0.5 / ionStr)
-                     * (fprime * g - gprime * f) / VPOW(g, 2.0);
-
-        // Count chopped values
-        ichopped_neg = (int)((a1_neg + a2_neg + a3_neg) / SINH_MIN);
-        ichopped_pos = (int)((a1_pos + a2_pos + a3_pos) / SINH_MAX);
-        ichopped += (int)floor(am_zero+0.5) * (ichopped_neg + ichopped_pos);
     }
 
     // Info
@@ -57,7 +57,7 @@
 #include "maloc/maloc.h"
 
 #include "generic/vhal.h"
-#include "pmgc/mypdec.h"
+#include "pmgc/simdd.h"
 
 #define MAXIONS    50
 #define MAXPOLY   50
@@ -65,6 +65,7 @@
 #define ZLARGE     1.0e20
 #define SINH_MIN -85.0
 #define SINH_MAX  85.0
+#define EXPBLOCK  256   /* Points per vectorized exp() call */
 
 /// @todo  Remove dependencies on global variables
 double v1, v2, v3, conc1, conc2, conc3, vol, relSize;
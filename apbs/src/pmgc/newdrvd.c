@@ -92,6 +92,11 @@ VEXTERNC void Vnewdriv(
     int k_cc;   /// @todo: Doc
     int k_fc;   /// @todo: Doc
     int k_pc;   /// @todo: Doc
+    int k_r;    ///< Krylov vectors of the inexact Newton variant
+    int k_p;    ///< @see k_r
+    int k_ap;   ///< @see k_r
+    int k_z;    ///< @see k_r
+    int inewt;  ///< Nonzero for the inexact Newton-Krylov variant
 
     // Decode some parameters
     nrwk   = VAT(iparm, 1);
@@ -100,6 +105,7 @@ VEXTERNC void Vnewdriv(
     ny     = VAT(iparm, 4);
     nz     = VAT(iparm, 5);
     nlev   = VAT(iparm, 6);
+    inewt  = VAT(iparm, 26);
 
     // Some checks on input ***
     VASSERT_MSG0(nlev > 0, "The nlev parameter must be positive");
@@ -125,9 +131,21 @@ VEXTERNC void Vnewdriv(
             &n_rpc, &n_iz, &n_ipc,
             &iretot, &iintot);
 
-    // Allocate space for two additional work vectors ***
+    // Allocate space for two additional work vectors after the Vmgsz
+    // layout, which keeps the operator slots where Vmgfineop expects them
+    k_w1   = iretot + 1;
+    k_w2   = k_w1   + nf;
     iretot = iretot + 2 * nf;
 
+    // The inexact variant needs three more, and a multilevel one, for CG
+    if (inewt == 1) {
+        k_r    = k_w2   + nf;
+        k_p    = k_r    + nf;
+        k_ap   = k_p    + nf;
+        k_z    = k_ap   + nf;
+        iretot = iretot + 3 * nf + narr;
+    }
+
     // Some more checks on input
     VASSERT_MSG1( nrwk >= iretot, "Real work space must be: %d", iretot );
     VASSERT_MSG1( niwk >= iintot, "Integer work space must be: %d", iintot );
@@ -140,9 +158,7 @@ VEXTERNC void Vnewdriv(
     k_rpc  = 1;
     k_cc   = k_rpc  + n_rpc;
     k_fc   = k_cc   + narr;
-    k_w1   = k_fc   + narr;
-    k_w2   = k_w1   + nf;
-    k_pc   = k_w2   + nf;
+    k_pc   = k_fc   + narr;
     k_ac   = k_pc   + 27 * narrc;
     // k_ac_after = 4*nf + 14*narrc;
 
@@ -151,6 +167,10 @@ VEXTERNC void Vnewdriv(
             &nx, &ny, &nz,
             u, RAT(iwork, k_iz),
             RAT(rwork, k_w1),  RAT(rwork, k_w2),
+            (inewt == 1) ? RAT(rwork, k_r)  : VNULL,
+            (inewt == 1) ? RAT(rwork, k_p)  : VNULL,
+            (inewt == 1) ? RAT(rwork, k_ap) : VNULL,
+            (inewt == 1) ? RAT(rwork, k_z)  : VNULL,
             RAT(iwork, k_ipc), RAT(rwork, k_rpc),
             RAT(rwork, k_pc),  RAT(rwork, k_ac), RAT(rwork, k_cc), RAT(rwork, k_fc),
             xf, yf, zf,
@@ -165,6 +185,7 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
         int *nx, int *ny, int *nz,
         double *u, int *iz,
         double *w1, double *w2,
+        double *r, double *p, double *ap, double *z,
         int *ipc, double *rpc,
         double *pc, double *ac, double *cc, double *fc,
         double *xf, double *yf, double *zf,
@@ -184,7 +205,7 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
     int ilev;       /// @todo:  Doc
     int ido;        /// @todo:  Doc
     int iters;      /// @todo:  Doc
-    int ierror;     /// @todo:  Doc
+    int ierror = 0; /// @todo:  Doc
     int nlev_real;  /// @todo:  Doc
     int ibound;     /// @todo:  Doc
     int mgprol;     /// @todo:  Doc
@@ -193,6 +214,8 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
     int mgdisc;     /// @todo:  Doc
     int mgsmoo;     /// @todo:  Doc
     int mode;       /// @todo:  Doc
+    int iguess;     ///< Nonzero if u holds an initial guess
+    int inewt;      ///< Nonzero for the inexact Newton-Krylov variant
     double epsiln;  /// @todo:  Doc
     double epsmac;  /// @todo:  Doc
     double errtol;  /// @todo:  Doc
@@ -233,6 +256,8 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
     mgdisc = VAT(iparm, 19);
     mgsmoo = VAT(iparm, 20);
     mgsolv = VAT(iparm, 21);
+    iguess = VAT(iparm, 25);
+    inewt  = VAT(iparm, 26);
 
     errtol = VAT(rparm,  1);
     omegal = VAT(rparm,  9);
@@ -299,17 +324,35 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
     // Determine machine epsilon
     epsiln = Vnm_epsmac();
 
+    // Newton starts from u; clear it unless the caller gave a guess
+    if (iguess == 0) {
+        Vazeros(nx, ny, nz, u);
+    }
+
     // Impose zero dirichlet boundary conditions (now in source fcn)
     VfboundPMG00(nx, ny, nz, u);
 
     // Start the timer
+    Vsmoothr_resetTraffic();
     Vnm_tstart(30, "Vnewdrv2: solve");
 
     // Call specified multigrid method
     nlev_real = nlev;
     iok  = 1;
     ilev = 1;
-    if (mgkey == 0) {
+    if ((mgkey == 0) && (inewt == 1)) {
+        Vinewton(nx, ny, nz,
+                u, iz,
+                ccf, fcf, w1, w2,
+                r, p, ap, z,
+                &istop, &itmax, &iters, &ierror,
+                &nlev, &mgsolv, &iok, &iinfo,
+                &epsiln, &errtol, &omegan,
+                &nu1, &nu2, &mgsmoo,
+                a1cf, a2cf, a3cf,
+                ipc, rpc,
+                pc, ac, cc, fc);
+    } else if (mgkey == 0) {
         Vnewton(nx, ny, nz,
                 u, iz,
                 ccf, fcf, w1, w2,
@@ -339,6 +382,11 @@ VPUBLIC void Vnewdriv2(int *iparm, double *rparm,
     // Stop the timer
     Vnm_tstop(30, "Vnewdrv2: solve");
 
+    // Memory traffic of the restriction leg, per level
+    if (iinfo > 0) {
+        Vsmoothr_printTraffic();
+    }
+
     // Restore boundary conditions
     ibound = 1;
     VfboundPMG(&ibound, nx, ny, nz, u, gxcf, gycf, gzcf);
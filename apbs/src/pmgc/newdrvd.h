@@ -132,6 +132,10 @@ VEXTERNC void Vnewdriv2(
         int    *iz,    ///< @todo:  Doc
         double *w1,    ///< @todo:  Doc
         double *w2,    ///< @todo:  Doc
+        double *r,     ///< Krylov vectors for iparm(26) = 1, else VNULL
+        double *p,     ///< @see r
+        double *ap,    ///< @see r
+        double *z,     ///< @see r (multilevel)
         int    *ipc,   ///< @todo:  Doc
         double *rpc,   ///< @todo:  Doc
         double *pc,    ///< @todo:  Doc
@@ -282,6 +282,7 @@ VPUBLIC void Vnewton(int *nx, int *ny, int *nz,
     VMESSAGE0("Damping enabled");
     idamp  = 1;
     *iters  = 0;
+    *ierror = 0;
 
     //30
     while(1) {
@@ -299,6 +300,10 @@ VPUBLIC void Vnewton(int *nx, int *ny, int *nz,
         Vgetjac(nx, ny, nz, nlev_real, iz, ilev, &ipkey,
                 x, w0, cprime, rhs, cc, pc);
 
+        // The jacobian changed; have Vcheb re-estimate its spectral bounds
+        for (level=lev; level<=*nlev_real; level++)
+            VAT(RAT(ipc, VAT2(iz, 5, level)), 14) = 0;
+
         // Determine number of correct digits in current residual
         // Algorithm 5.3 in the thesis, test version (1')
         // Global-superlinear convergence
@@ -482,8 +487,10 @@ VPUBLIC void Vnewton(int *nx, int *ny, int *nz,
         }
 
         // Check iteration count ***
-        if (*iters >= *itmax)
+        if (*iters >= *itmax) {
+            *ierror = 1;
             break;
+        }
     }
 
     // Condition estimate of final jacobian
@@ -547,6 +554,265 @@ VPUBLIC void Vnewton(int *nx, int *ny, int *nz,
 
 
 
+VPUBLIC void Vinewton(int *nx, int *ny, int *nz,
+        double *x, int *iz,
+        double *w0, double *w1, double *w2, double *w3,
+        double *r, double *p, double *ap, double *z,
+        int *istop, int *itmax, int *iters, int *ierror,
+        int *nlev, int *mgsolv, int *iok, int *iinfo,
+        double *epsiln, double *errtol, double *omega,
+        int *nu1, int *nu2, int *mgsmoo,
+        double *cprime, double *rhs, double *xtmp,
+        int *ipc, double *rpc,
+        double *pc, double *ac, double *cc, double *fc) {
+
+    int level, lev;
+    int itmax_s, iters_s, ierror_s, iok_s, iinfo_s, istop_s;
+    double rsden, rsnrm, orsnrm;
+
+    double xnorm_old, xnorm_new, xnorm_prev, damp, xnorm_med, xnorm_den;
+    int iter_d, itmax_d, mode, idamp, ipkey;
+
+    // Eisenstat-Walker forcing terms (choice 2)
+    double eta, eta_s, eta_min;
+    double gamma = 0.9;
+    double eta_max = 0.9;
+
+    MAT2(iz, 50, 1);
+
+    // The Krylov solve runs on the finest level
+    lev = 1;
+
+    // Do some i/o if requested
+    if (*iinfo > 1) {
+        VMESSAGE3("Starting: (%d, %d, %d)", *nx, *ny, *nz);
+    }
+
+    if (*iok != 0) {
+        Vprtstp(*iok, -1, 0.0, 0.0, 0.0);
+    }
+
+    // Compute denominator for stopping criterion
+    if (*istop == 0) {
+        rsden = 1.0;
+    } else if (*istop == 1) {
+
+        // Residual of a zero initial guess, as in Vnewton
+        Vazeros(nx, ny, nz, w1);
+
+        Vnmresid(nx, ny, nz,
+                RAT(ipc, VAT2(iz, 5, lev)), RAT(rpc, VAT2(iz, 6, lev)),
+                RAT( ac, VAT2(iz, 7, lev)), RAT( cc, VAT2(iz, 1, lev)),
+                RAT( fc, VAT2(iz, 1, lev)),
+                w1, w2, w3);
+        rsden = Vxnrm1(nx, ny, nz, w2);
+    } else {
+        VABORT_MSG1("Bad istop value: %d", *istop);
+    }
+
+    if (rsden == 0.0) {
+        rsden = 1.0;
+        VWARN_MSG0(rsden != 0, "rhs is zero");
+    }
+    rsnrm = rsden;
+    orsnrm = rsnrm;
+
+    if (*iok != 0) {
+        Vprtstp(*iok, 0, rsnrm, rsden, orsnrm);
+    }
+
+    // Residual of the initial guess
+    Vnmresid(nx, ny, nz,
+            RAT(ipc, VAT2(iz, 5, lev)), RAT(rpc, VAT2(iz, 6, lev)),
+            RAT( ac, VAT2(iz, 7, lev)), RAT( cc, VAT2(iz, 1, lev)),
+            RAT( fc, VAT2(iz, 1, lev)), RAT(  x, VAT2(iz, 1, lev)),
+            w0, w2);
+    xnorm_old = Vxnrm1(nx, ny, nz, w0);
+    xnorm_prev = xnorm_old;
+    if (*iok != 0) {
+        xnorm_den = rsden;
+    } else {
+        xnorm_den = xnorm_old;
+    }
+
+    VMESSAGE0("Damping enabled");
+    idamp  = 1;
+    eta    = 0.5;
+    *iters = 0;
+    *ierror = 0;
+
+    while(1) {
+
+        (*iters)++;
+
+        // Compute the current jacobian system and rhs
+        ipkey = VAT(ipc, 10);
+        Vgetjac(nx, ny, nz, nlev, iz, &lev, &ipkey,
+                x, w0, cprime, rhs, cc, pc);
+
+        // The jacobian changed; have Vcheb re-estimate its spectral bounds
+        for (level=lev; level<=*nlev; level++)
+            VAT(RAT(ipc, VAT2(iz, 5, level)), 14) = 0;
+
+        // Forcing term: follow the observed rate of the outer iteration,
+        // but do not let it drop much faster than the previous one did
+        if (*iters > 1) {
+            eta_s = gamma * VPOW(xnorm_old / xnorm_prev, 2.0);
+            if (gamma * eta * eta > 0.1) {
+                eta_s = VMAX2(eta_s, gamma * eta * eta);
+            }
+            eta = VMIN2(eta_s, eta_max);
+        }
+
+        // No point in solving past what the outer stopping test needs
+        eta_min = 0.5 * (*errtol) * rsden / xnorm_old;
+        if (eta < eta_min) {
+            eta = VMIN2(eta_min, eta_max);
+        }
+        VMESSAGE1("Using forcing term: %g", eta);
+
+        // Krylov solve of the newton equations to relative tolerance eta
+        Vazeros(nx, ny, nz, RAT(xtmp, VAT2(iz, 1, lev)));
+
+        itmax_s   = 1000;
+        istop_s   = 1;
+        iters_s   = 0;
+        ierror_s  = 0;
+        iok_s     = 2;
+        iinfo_s   = 0;
+        if (*iinfo >= 2)
+            iinfo_s = *iinfo;
+
+        Vcgmg(nx, ny, nz,
+                RAT(xtmp, VAT2(iz, 1, lev)), iz,
+                w0, w1, w2, w3,
+                r, p, ap, z,
+                &istop_s, &itmax_s, &iters_s, &ierror_s,
+                nlev, mgsolv, &iok_s, &iinfo_s,
+                epsiln, &eta, omega,
+                nu1, nu2, mgsmoo,
+                ipc, rpc, pc, ac, cprime, rhs);
+
+        VMESSAGE1("Krylov iterations: %d", iters_s);
+
+        /**************************************************************
+         *** note: rhs and cprime are now available as temp vectors ***
+         **************************************************************/
+
+        xnorm_prev = xnorm_old;
+
+        // If damping is still enabled -- doit
+        if (idamp == 1) {
+
+            // Try the correction
+            Vxcopy(nx, ny, nz,
+                    RAT(x, VAT2(iz, 1, lev)), w1);
+            damp = 1.0;
+            Vxaxpy(nx, ny, nz, &damp, RAT(xtmp, VAT2(iz, 1, lev)), w1);
+
+            Vnmresid(nx, ny, nz,
+                    RAT(ipc, VAT2(iz, 5, lev)), RAT(rpc, VAT2(iz, 6, lev)),
+                    RAT( ac, VAT2(iz, 7, lev)), RAT( cc, VAT2(iz, 1, lev)),
+                    RAT( fc, VAT2(iz, 1, lev)),
+                    w1, w0,
+                    RAT(rhs, VAT2(iz, 1, lev)));
+            xnorm_new = Vxnrm1(nx, ny, nz, w0);
+
+            // Halve the step while that keeps reducing the residual
+            damp    = 1.0;
+            iter_d  = 0;
+            itmax_d = 10;
+            mode    = 0;
+            xnorm_med = xnorm_new;
+
+            VMESSAGE1("Attempting damping, relres = %f", xnorm_new / xnorm_den);
+
+            while(iter_d < itmax_d) {
+                if (mode == 0) {
+                    if (xnorm_new < xnorm_old) {
+                        mode = 1;
+                    }
+                } else if (xnorm_new > xnorm_med) {
+                        break;
+                }
+
+                // Keep old soln and residual around, and its norm
+                Vxcopy(nx, ny, nz, w1, w2);
+                Vxcopy(nx, ny, nz, w0, w3);
+                xnorm_med = xnorm_new;
+
+                // New damped correction, residual, and its norm
+                Vxcopy(nx, ny, nz,
+                        RAT(x, VAT2(iz, 1, lev)), w1);
+                damp = damp / 2.0;
+                Vxaxpy(nx, ny, nz, &damp, RAT(xtmp, VAT2(iz, 1, lev)), w1);
+
+                Vnmresid(nx, ny, nz,
+                        RAT(ipc, VAT2(iz, 5, lev)), RAT(rpc, VAT2(iz, 6, lev)),
+                        RAT( ac, VAT2(iz, 7, lev)), RAT( cc, VAT2(iz, 1, lev)),
+                        RAT( fc, VAT2(iz, 1, lev)),
+                        w1, w0,
+                        RAT(rhs, VAT2(iz, 1, lev)));
+                xnorm_new = Vxnrm1(nx, ny, nz, w0);
+
+                iter_d = iter_d + 1;
+                VMESSAGE1("Attempting damping, relres = %f",
+                    xnorm_new / xnorm_den);
+            }
+
+            Vxcopy(nx, ny, nz, w2, RAT(x, VAT2(iz, 1, lev)));
+            Vxcopy(nx, ny, nz, w3, w0);
+            xnorm_new = xnorm_med;
+            xnorm_old = xnorm_new;
+
+            VMESSAGE1("Damping accepted, relres = %f", xnorm_new / xnorm_den);
+
+            // Determine whether or not to disable damping
+            if ((iter_d - 1) == 0) {
+                VMESSAGE0("Damping disabled");
+                idamp = 0;
+            }
+        } else {
+
+            // Damping is disabled -- accept the newton step
+            damp = 1.0;
+
+            Vxaxpy(nx, ny, nz, &damp,
+                    RAT(xtmp, VAT2(iz, 1, lev)), RAT(x, VAT2(iz, 1, lev)));
+
+            Vnmresid(nx, ny, nz,
+                    RAT(ipc, VAT2(iz, 5, lev)), RAT(rpc, VAT2(iz, 6, lev)),
+                    RAT( ac, VAT2(iz, 7, lev)), RAT( cc, VAT2(iz, 1, lev)),
+                    RAT( fc, VAT2(iz, 1, lev)), RAT(  x, VAT2(iz, 1, lev)),
+                    w0,
+                    RAT(rhs, VAT2(iz, 1, lev)));
+
+            xnorm_new = Vxnrm1(nx, ny, nz, w0);
+            xnorm_old = xnorm_new;
+        }
+
+        // Compute/check the current stopping test
+        if (*iok != 0) {
+
+            orsnrm = rsnrm;
+            rsnrm = xnorm_new;
+
+            Vprtstp(*iok, *iters, rsnrm, rsden, orsnrm);
+
+            if ((rsnrm/rsden) <= *errtol)
+                break;
+        }
+
+        // Check iteration count
+        if (*iters >= *itmax) {
+            *ierror = 1;
+            break;
+        }
+    }
+}
+
+
+
 VPUBLIC void Vgetjac(int *nx, int *ny, int *nz,
         int *nlev_real, int *iz, int *lev, int *ipkey,
         double *x, double *r,
@@ -60,6 +60,7 @@
 #include "pmgc/mgcsd.h"
 #include "pmgc/mgsubd.h"
 #include "pmgc/powerd.h"
+#include "pmgc/cgmgdrvd.h"
 
 /** @brief   Nested iteration for an inexact-newton-multilevel method.
  *  @ingroup PMGC
@@ -124,7 +125,7 @@ VEXTERNC void Vnewton(
         int *istop,     ///< @todo: Doc
         int *itmax,     ///< @todo: Doc
         int *iters,     ///< @todo: Doc
-        int *ierror,    ///< @todo: Doc
+        int *ierror,    ///< 1 if itmax was reached first, 0 otherwise
         int *nlev,      ///< @todo: Doc
         int *ilev,      ///< @todo: Doc
         int *nlev_real, ///< @todo: Doc
@@ -150,6 +151,63 @@ VEXTERNC void Vnewton(
         );
 
 
+/** @brief   Inexact Newton-Krylov method with Eisenstat-Walker forcing terms.
+ *  @ingroup PMGC
+ *
+ *  Same outer iteration and damping as Vnewton, but each Jacobian system
+ *  J s = -F(x) is solved by MG-preconditioned CG (Vcgmg) only until
+ *
+ *      ||J s + F(x)|| <= eta_k ||F(x)||
+ *
+ *  with eta_0 = 0.5 and eta_k = 0.9 (||F_k|| / ||F_k-1||)^2 (choice 2 of
+ *  Eisenstat and Walker), safeguarded against dropping too fast and
+ *  capped at 0.9.  Early steps are cheap; the last ones are not solved
+ *  beyond what the outer stopping test needs.  The Jacobian of the box
+ *  discretized NPBE and SMPBE is symmetric positive definite.
+ *
+ *  Works on the finest level only and supports istop 0 and 1.
+ *
+ *  @note    r, p and ap are fine-grid vectors; w0, w1 and z are multilevel.
+ */
+VEXTERNC void Vinewton(
+        int *nx,        ///< @todo: Doc
+        int *ny,        ///< @todo: Doc
+        int *nz,        ///< @todo: Doc
+        double *x,      ///< @todo: Doc
+        int *iz,        ///< @todo: Doc
+        double *w0,     ///< @todo: Doc
+        double *w1,     ///< @todo: Doc
+        double *w2,     ///< @todo: Doc
+        double *w3,     ///< @todo: Doc
+        double *r,      ///< CG residual
+        double *p,      ///< CG search direction
+        double *ap,     ///< Jacobian times p
+        double *z,      ///< Preconditioned CG residual
+        int *istop,     ///< @todo: Doc
+        int *itmax,     ///< @todo: Doc
+        int *iters,     ///< @todo: Doc
+        int *ierror,    ///< 1 if itmax was reached first, 0 otherwise
+        int *nlev,      ///< @todo: Doc
+        int *mgsolv,    ///< @todo: Doc
+        int *iok,       ///< @todo: Doc
+        int *iinfo,     ///< @todo: Doc
+        double *epsiln, ///< @todo: Doc
+        double *errtol, ///< @todo: Doc
+        double *omega,  ///< @todo: Doc
+        int *nu1,       ///< @todo: Doc
+        int *nu2,       ///< @todo: Doc
+        int *mgsmoo,    ///< @todo: Doc
+        double *cprime, ///< @todo: Doc
+        double *rhs,    ///< @todo: Doc
+        double *xtmp,   ///< @todo: Doc
+        int *ipc,       ///< @todo: Doc
+        double *rpc,    ///< @todo: Doc
+        double *pc,     ///< @todo: Doc
+        double *ac,     ///< @todo: Doc
+        double *cc,     ///< @todo: Doc
+        double *fc      ///< @todo: Doc
+        );
+
 /** @brief   Form the jacobian system.
  *  @ingroup PMGC
  *  @author  Tucker Beck [C Translation], Michael Holst [Original]
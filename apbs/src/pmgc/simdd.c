@@ -0,0 +1,1162 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Runtime-dispatched SIMD kernels for the 7-point stencil
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+#include "simdd.h"
+
+#include "generic/vcap.h"
+
+#if defined(APBS_SIMD)
+#   include <immintrin.h>
+#   define VSIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/*
+ * The kernels below work on one (j,k) row of interior points at a time.  All
+ * pointers passed to a row kernel are offset to the first point of the row,
+ * and neighbors are reached with the strides sj = nx and sk = nx*ny.  Each
+ * point is evaluated with the same sequence of operations as the scalar loops
+ * in matvecd.c and gsd.c.  The AVX2 path therefore reproduces the scalar
+ * results bit for bit; AVX-512F implies FMA, so there the compiler may fuse
+ * multiply/add pairs and the results agree to round-off.
+ *
+ * Every vector loop ends with vzeroupper before the scalar remainder (and the
+ * return), since legacy-SSE code executed with dirty upper register halves
+ * runs several times slower on many processors.
+ */
+typedef void (*Vsimd_RowFn)(int n, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *out);
+
+typedef void (*Vsimd_RowFnF)(int n, int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *out);
+
+VPRIVATE int Vsimd_initialized = 0;
+VPRIVATE Vsimd_Level Vsimd_maxLevel = VSIMD_SCALAR;
+VPRIVATE Vsimd_Level Vsimd_level = VSIMD_SCALAR;
+
+VPRIVATE Vsimd_Level Vsimd_detect() {
+
+#if defined(APBS_SIMD)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return VSIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return VSIMD_AVX2;
+#endif
+    return VSIMD_SCALAR;
+}
+
+VPUBLIC Vsimd_Level Vsimd_getLevel() {
+
+    /* Vexp_simd may make the first call from inside a parallel region */
+    if (!Vsimd_initialized) {
+        #pragma omp critical (Vsimd_init)
+        if (!Vsimd_initialized) {
+            Vsimd_maxLevel = Vsimd_detect();
+            Vsimd_level = Vsimd_maxLevel;
+            Vsimd_initialized = 1;
+            Vnm_print(0, "Vsimd_getLevel:  using level %d stencil kernels\n",
+                      Vsimd_level);
+        }
+    }
+    return Vsimd_level;
+}
+
+VPUBLIC void Vsimd_setLevel(Vsimd_Level level) {
+
+    Vsimd_Level old;
+
+    old = Vsimd_getLevel();
+    if (level > Vsimd_maxLevel) {
+        if (level != VSIMD_AVX512) {
+            Vnm_print(2, "Vsimd_setLevel:  level %d is not supported by this \
+processor or build; using %d\n", level, Vsimd_maxLevel);
+        }
+        level = Vsimd_maxLevel;
+    }
+    Vsimd_level = level;
+    if (Vsimd_level != old) {
+        Vnm_print(0, "Vsimd_setLevel:  using level %d stencil kernels\n",
+                  Vsimd_level);
+    }
+}
+
+#if defined(APBS_SIMD)
+
+/* Scalar single-point versions, used for the row remainders */
+
+VPRIVATE void Vsimd_matvec7Pt(int q, int sj, int sk,
+        double *oC, double *cc,
+        double *oE, double *oN, double *uC,
+        double *x, double *y) {
+
+    y[q] = - oN[q]    * x[q+sj]
+           - oN[q-sj] * x[q-sj]
+           - oE[q]    * x[q+1]
+           - oE[q-1]  * x[q-1]
+           - uC[q-sk] * x[q-sk]
+           - uC[q]    * x[q+sk]
+           + (oC[q] + cc[q]) * x[q];
+}
+
+VPRIVATE void Vsimd_resid7Pt(int q, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *r) {
+
+    if (w1 == VNULL) {
+        r[q] = fc[q]
+             + oN[q]    * x[q+sj]
+             + oN[q-sj] * x[q-sj]
+             + oE[q]    * x[q+1]
+             + oE[q-1]  * x[q-1]
+             + uC[q-sk] * x[q-sk]
+             + uC[q]    * x[q+sk]
+             - (oC[q] + cc[q]) * x[q];
+    } else {
+        r[q] = fc[q]
+             + oN[q]    * x[q+sj]
+             + oN[q-sj] * x[q-sj]
+             + oE[q]    * x[q+1]
+             + oE[q-1]  * x[q-1]
+             + uC[q-sk] * x[q-sk]
+             + uC[q]    * x[q+sk]
+             - oC[q]    * x[q]
+             - w1[q];
+    }
+}
+
+VPRIVATE void Vsimd_gs7Pt(int q, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x) {
+
+    x[q] = (fc[q]
+         + oN[q]    * x[q+sj]
+         + oN[q-sj] * x[q-sj]
+         + oE[q]    * x[q+1]
+         + oE[q-1]  * x[q-1]
+         + uC[q-sk] * x[q-sk]
+         + uC[q]    * x[q+sk]
+         ) / (oC[q] + cc[q]);
+}
+
+/* *** AVX2 kernels (4 doubles per vector) *** */
+
+/* Load p[0], p[2], p[4], p[6].  This touches p[7] as well, which is always
+ * inside the grid (it is at most one point past the row boundary). */
+VPRIVATE VSIMD_TARGET("avx2") __m256d Vsimd_ld2_avx2(double *p) {
+
+    __m256d a = _mm256_loadu_pd(p);
+    __m256d b = _mm256_loadu_pd(p + 4);
+
+    return _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), 0xD8);
+}
+
+/* Store v into p[0], p[2], p[4], p[6] */
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_st2_avx2(double *p, __m256d v) {
+
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+
+    _mm_storel_pd(p, lo);
+    _mm_storeh_pd(p + 2, lo);
+    _mm_storel_pd(p + 4, hi);
+    _mm_storeh_pd(p + 6, hi);
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_matvec7Row_avx2(int n, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *y) {
+
+    int q;
+    __m256d s;
+
+    for (q=0; q+4<=n; q+=4) {
+        s = _mm256_sub_pd(_mm256_setzero_pd(),
+            _mm256_mul_pd(_mm256_loadu_pd(oN+q), _mm256_loadu_pd(x+q+sj)));
+        s = _mm256_sub_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oN+q-sj), _mm256_loadu_pd(x+q-sj)));
+        s = _mm256_sub_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oE+q), _mm256_loadu_pd(x+q+1)));
+        s = _mm256_sub_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oE+q-1), _mm256_loadu_pd(x+q-1)));
+        s = _mm256_sub_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(uC+q-sk), _mm256_loadu_pd(x+q-sk)));
+        s = _mm256_sub_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(uC+q), _mm256_loadu_pd(x+q+sk)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(
+                _mm256_add_pd(_mm256_loadu_pd(oC+q), _mm256_loadu_pd(cc+q)),
+                _mm256_loadu_pd(x+q)));
+        _mm256_storeu_pd(y+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_matvec7Pt(q, sj, sk, oC, cc, oE, oN, uC, x, y);
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_resid7Row_avx2(int n, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *r) {
+
+    int q;
+    __m256d s;
+
+    for (q=0; q+4<=n; q+=4) {
+        s = _mm256_loadu_pd(fc+q);
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oN+q), _mm256_loadu_pd(x+q+sj)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oN+q-sj), _mm256_loadu_pd(x+q-sj)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oE+q), _mm256_loadu_pd(x+q+1)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(oE+q-1), _mm256_loadu_pd(x+q-1)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(uC+q-sk), _mm256_loadu_pd(x+q-sk)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(_mm256_loadu_pd(uC+q), _mm256_loadu_pd(x+q+sk)));
+        if (w1 == VNULL) {
+            s = _mm256_sub_pd(s,
+                _mm256_mul_pd(
+                    _mm256_add_pd(_mm256_loadu_pd(oC+q), _mm256_loadu_pd(cc+q)),
+                    _mm256_loadu_pd(x+q)));
+        } else {
+            s = _mm256_sub_pd(s,
+                _mm256_mul_pd(_mm256_loadu_pd(oC+q), _mm256_loadu_pd(x+q)));
+            s = _mm256_sub_pd(s, _mm256_loadu_pd(w1+q));
+        }
+        _mm256_storeu_pd(r+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_resid7Pt(q, sj, sk, oC, cc, fc, oE, oN, uC, x, w1, r);
+}
+
+/* Here n counts every other point of the row (the ones of one color) */
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_gs7Row_avx2(int n, int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *out) {
+
+    int t, q;
+    __m256d s;
+
+    for (t=0; t+4<=n; t+=4) {
+        q = 2*t;
+        s = Vsimd_ld2_avx2(fc+q);
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(oN+q), Vsimd_ld2_avx2(x+q+sj)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(oN+q-sj), Vsimd_ld2_avx2(x+q-sj)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(oE+q), Vsimd_ld2_avx2(x+q+1)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(oE+q-1), Vsimd_ld2_avx2(x+q-1)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(uC+q-sk), Vsimd_ld2_avx2(x+q-sk)));
+        s = _mm256_add_pd(s,
+            _mm256_mul_pd(Vsimd_ld2_avx2(uC+q), Vsimd_ld2_avx2(x+q+sk)));
+        s = _mm256_div_pd(s,
+            _mm256_add_pd(Vsimd_ld2_avx2(oC+q), Vsimd_ld2_avx2(cc+q)));
+        Vsimd_st2_avx2(x+q, s);
+    }
+    _mm256_zeroupper();
+    for (; t<n; t++)
+        Vsimd_gs7Pt(2*t, sj, sk, oC, cc, fc, oE, oN, uC, x);
+}
+
+/* *** AVX-512 kernels (8 doubles per vector) *** */
+
+/* Load p[0], p[2], ..., p[14] (touches p[15], see Vsimd_ld2_avx2) */
+VPRIVATE VSIMD_TARGET("avx512f") __m512d Vsimd_ld2_avx512(double *p) {
+
+    const __m512i idx = _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0);
+
+    return _mm512_permutex2var_pd(_mm512_loadu_pd(p), idx,
+                                  _mm512_loadu_pd(p + 8));
+}
+
+/* Store v into p[0], p[2], ..., p[14] */
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_st2_avx512(double *p, __m512d v) {
+
+    const __m512i lo = _mm512_set_epi64(3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi = _mm512_set_epi64(7, 7, 6, 6, 5, 5, 4, 4);
+
+    _mm512_mask_storeu_pd(p, 0x55, _mm512_permutexvar_pd(lo, v));
+    _mm512_mask_storeu_pd(p + 8, 0x55, _mm512_permutexvar_pd(hi, v));
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_matvec7Row_avx512(int n,
+        int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *y) {
+
+    int q;
+    __m512d s;
+
+    for (q=0; q+8<=n; q+=8) {
+        s = _mm512_sub_pd(_mm512_setzero_pd(),
+            _mm512_mul_pd(_mm512_loadu_pd(oN+q), _mm512_loadu_pd(x+q+sj)));
+        s = _mm512_sub_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oN+q-sj), _mm512_loadu_pd(x+q-sj)));
+        s = _mm512_sub_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oE+q), _mm512_loadu_pd(x+q+1)));
+        s = _mm512_sub_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oE+q-1), _mm512_loadu_pd(x+q-1)));
+        s = _mm512_sub_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(uC+q-sk), _mm512_loadu_pd(x+q-sk)));
+        s = _mm512_sub_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(uC+q), _mm512_loadu_pd(x+q+sk)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(
+                _mm512_add_pd(_mm512_loadu_pd(oC+q), _mm512_loadu_pd(cc+q)),
+                _mm512_loadu_pd(x+q)));
+        _mm512_storeu_pd(y+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_matvec7Pt(q, sj, sk, oC, cc, oE, oN, uC, x, y);
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_resid7Row_avx512(int n,
+        int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *r) {
+
+    int q;
+    __m512d s;
+
+    for (q=0; q+8<=n; q+=8) {
+        s = _mm512_loadu_pd(fc+q);
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oN+q), _mm512_loadu_pd(x+q+sj)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oN+q-sj), _mm512_loadu_pd(x+q-sj)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oE+q), _mm512_loadu_pd(x+q+1)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(oE+q-1), _mm512_loadu_pd(x+q-1)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(uC+q-sk), _mm512_loadu_pd(x+q-sk)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(_mm512_loadu_pd(uC+q), _mm512_loadu_pd(x+q+sk)));
+        if (w1 == VNULL) {
+            s = _mm512_sub_pd(s,
+                _mm512_mul_pd(
+                    _mm512_add_pd(_mm512_loadu_pd(oC+q), _mm512_loadu_pd(cc+q)),
+                    _mm512_loadu_pd(x+q)));
+        } else {
+            s = _mm512_sub_pd(s,
+                _mm512_mul_pd(_mm512_loadu_pd(oC+q), _mm512_loadu_pd(x+q)));
+            s = _mm512_sub_pd(s, _mm512_loadu_pd(w1+q));
+        }
+        _mm512_storeu_pd(r+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_resid7Pt(q, sj, sk, oC, cc, fc, oE, oN, uC, x, w1, r);
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_gs7Row_avx512(int n,
+        int sj, int sk,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *out) {
+
+    int t, q;
+    __m512d s;
+
+    for (t=0; t+8<=n; t+=8) {
+        q = 2*t;
+        s = Vsimd_ld2_avx512(fc+q);
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(oN+q), Vsimd_ld2_avx512(x+q+sj)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(oN+q-sj), Vsimd_ld2_avx512(x+q-sj)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(oE+q), Vsimd_ld2_avx512(x+q+1)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(oE+q-1), Vsimd_ld2_avx512(x+q-1)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(uC+q-sk), Vsimd_ld2_avx512(x+q-sk)));
+        s = _mm512_add_pd(s,
+            _mm512_mul_pd(Vsimd_ld2_avx512(uC+q), Vsimd_ld2_avx512(x+q+sk)));
+        s = _mm512_div_pd(s,
+            _mm512_add_pd(Vsimd_ld2_avx512(oC+q), Vsimd_ld2_avx512(cc+q)));
+        Vsimd_st2_avx512(x+q, s);
+    }
+    _mm256_zeroupper();
+    for (; t<n; t++)
+        Vsimd_gs7Pt(2*t, sj, sk, oC, cc, fc, oE, oN, uC, x);
+}
+
+/* Pick the row kernel for the current level; VNULL means scalar */
+VPRIVATE Vsimd_RowFn Vsimd_pick(Vsimd_RowFn avx2, Vsimd_RowFn avx512) {
+
+    switch (Vsimd_getLevel()) {
+        case VSIMD_AVX512:
+            return avx512;
+        case VSIMD_AVX2:
+            return avx2;
+        default:
+            return VNULL;
+    }
+}
+
+/* *** Single-precision kernels for the mixed-precision v-cycle (mgmixd.c) ***
+ *
+ * Same structure as the double kernels, with twice as many points per
+ * vector.  Only the linear residual and the red/black sweep are needed. */
+
+VPRIVATE void Vsimd_resid7PtF(int q, int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *r) {
+
+    r[q] = fc[q]
+         + oN[q]    * x[q+sj]
+         + oN[q-sj] * x[q-sj]
+         + oE[q]    * x[q+1]
+         + oE[q-1]  * x[q-1]
+         + uC[q-sk] * x[q-sk]
+         + uC[q]    * x[q+sk]
+         - (oC[q] + cc[q]) * x[q];
+}
+
+VPRIVATE void Vsimd_gs7PtF(int q, int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x) {
+
+    x[q] = (fc[q]
+         + oN[q]    * x[q+sj]
+         + oN[q-sj] * x[q-sj]
+         + oE[q]    * x[q+1]
+         + oE[q-1]  * x[q-1]
+         + uC[q-sk] * x[q-sk]
+         + uC[q]    * x[q+sk]
+         ) / (oC[q] + cc[q]);
+}
+
+/* Load p[0], p[2], ..., p[14] (touches p[15], see Vsimd_ld2_avx2) */
+VPRIVATE VSIMD_TARGET("avx2") __m256 Vsimd_ld2f_avx2(float *p) {
+
+    __m256 v = _mm256_shuffle_ps(_mm256_loadu_ps(p), _mm256_loadu_ps(p + 8),
+                                 0x88);
+
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), 0xD8));
+}
+
+/* Store v into p[0], p[2], ..., p[14] */
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_st2f_avx2(float *p, __m256 v) {
+
+    const __m256i even = _mm256_set_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+    __m256 lo = _mm256_unpacklo_ps(v, v);
+    __m256 hi = _mm256_unpackhi_ps(v, v);
+
+    _mm256_maskstore_ps(p, even, _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_maskstore_ps(p + 8, even, _mm256_permute2f128_ps(lo, hi, 0x31));
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_resid7RowF_avx2(int n, int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *r) {
+
+    int q;
+    __m256 s;
+
+    for (q=0; q+8<=n; q+=8) {
+        s = _mm256_loadu_ps(fc+q);
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(oN+q), _mm256_loadu_ps(x+q+sj)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(oN+q-sj), _mm256_loadu_ps(x+q-sj)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(oE+q), _mm256_loadu_ps(x+q+1)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(oE+q-1), _mm256_loadu_ps(x+q-1)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(uC+q-sk), _mm256_loadu_ps(x+q-sk)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(_mm256_loadu_ps(uC+q), _mm256_loadu_ps(x+q+sk)));
+        s = _mm256_sub_ps(s,
+            _mm256_mul_ps(
+                _mm256_add_ps(_mm256_loadu_ps(oC+q), _mm256_loadu_ps(cc+q)),
+                _mm256_loadu_ps(x+q)));
+        _mm256_storeu_ps(r+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_resid7PtF(q, sj, sk, oC, cc, fc, oE, oN, uC, x, r);
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_gs7RowF_avx2(int n, int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *out) {
+
+    int t, q;
+    __m256 s;
+
+    for (t=0; t+8<=n; t+=8) {
+        q = 2*t;
+        s = Vsimd_ld2f_avx2(fc+q);
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(oN+q), Vsimd_ld2f_avx2(x+q+sj)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(oN+q-sj), Vsimd_ld2f_avx2(x+q-sj)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(oE+q), Vsimd_ld2f_avx2(x+q+1)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(oE+q-1), Vsimd_ld2f_avx2(x+q-1)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(uC+q-sk), Vsimd_ld2f_avx2(x+q-sk)));
+        s = _mm256_add_ps(s,
+            _mm256_mul_ps(Vsimd_ld2f_avx2(uC+q), Vsimd_ld2f_avx2(x+q+sk)));
+        s = _mm256_div_ps(s,
+            _mm256_add_ps(Vsimd_ld2f_avx2(oC+q), Vsimd_ld2f_avx2(cc+q)));
+        Vsimd_st2f_avx2(x+q, s);
+    }
+    _mm256_zeroupper();
+    for (; t<n; t++)
+        Vsimd_gs7PtF(2*t, sj, sk, oC, cc, fc, oE, oN, uC, x);
+}
+
+/* Load p[0], p[2], ..., p[30] (touches p[31], see Vsimd_ld2_avx2) */
+VPRIVATE VSIMD_TARGET("avx512f") __m512 Vsimd_ld2f_avx512(float *p) {
+
+    const __m512i idx = _mm512_set_epi32(30, 28, 26, 24, 22, 20, 18, 16,
+                                         14, 12, 10,  8,  6,  4,  2,  0);
+
+    return _mm512_permutex2var_ps(_mm512_loadu_ps(p), idx,
+                                  _mm512_loadu_ps(p + 16));
+}
+
+/* Store v into p[0], p[2], ..., p[30] */
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_st2f_avx512(float *p, __m512 v) {
+
+    const __m512i lo = _mm512_set_epi32(7, 7, 6, 6, 5, 5, 4, 4,
+                                        3, 3, 2, 2, 1, 1, 0, 0);
+    const __m512i hi = _mm512_set_epi32(15, 15, 14, 14, 13, 13, 12, 12,
+                                        11, 11, 10, 10,  9,  9,  8,  8);
+
+    _mm512_mask_storeu_ps(p, 0x5555, _mm512_permutexvar_ps(lo, v));
+    _mm512_mask_storeu_ps(p + 16, 0x5555, _mm512_permutexvar_ps(hi, v));
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_resid7RowF_avx512(int n,
+        int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *r) {
+
+    int q;
+    __m512 s;
+
+    for (q=0; q+16<=n; q+=16) {
+        s = _mm512_loadu_ps(fc+q);
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(oN+q), _mm512_loadu_ps(x+q+sj)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(oN+q-sj), _mm512_loadu_ps(x+q-sj)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(oE+q), _mm512_loadu_ps(x+q+1)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(oE+q-1), _mm512_loadu_ps(x+q-1)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(uC+q-sk), _mm512_loadu_ps(x+q-sk)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(_mm512_loadu_ps(uC+q), _mm512_loadu_ps(x+q+sk)));
+        s = _mm512_sub_ps(s,
+            _mm512_mul_ps(
+                _mm512_add_ps(_mm512_loadu_ps(oC+q), _mm512_loadu_ps(cc+q)),
+                _mm512_loadu_ps(x+q)));
+        _mm512_storeu_ps(r+q, s);
+    }
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        Vsimd_resid7PtF(q, sj, sk, oC, cc, fc, oE, oN, uC, x, r);
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_gs7RowF_avx512(int n,
+        int sj, int sk,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *out) {
+
+    int t, q;
+    __m512 s;
+
+    for (t=0; t+16<=n; t+=16) {
+        q = 2*t;
+        s = Vsimd_ld2f_avx512(fc+q);
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(oN+q), Vsimd_ld2f_avx512(x+q+sj)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(oN+q-sj), Vsimd_ld2f_avx512(x+q-sj)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(oE+q), Vsimd_ld2f_avx512(x+q+1)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(oE+q-1), Vsimd_ld2f_avx512(x+q-1)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(uC+q-sk), Vsimd_ld2f_avx512(x+q-sk)));
+        s = _mm512_add_ps(s,
+            _mm512_mul_ps(Vsimd_ld2f_avx512(uC+q), Vsimd_ld2f_avx512(x+q+sk)));
+        s = _mm512_div_ps(s,
+            _mm512_add_ps(Vsimd_ld2f_avx512(oC+q), Vsimd_ld2f_avx512(cc+q)));
+        Vsimd_st2f_avx512(x+q, s);
+    }
+    _mm256_zeroupper();
+    for (; t<n; t++)
+        Vsimd_gs7PtF(2*t, sj, sk, oC, cc, fc, oE, oN, uC, x);
+}
+
+/* Single-precision counterpart of Vsimd_pick */
+VPRIVATE Vsimd_RowFnF Vsimd_pickF(Vsimd_RowFnF avx2, Vsimd_RowFnF avx512) {
+
+    switch (Vsimd_getLevel()) {
+        case VSIMD_AVX512:
+            return avx512;
+        case VSIMD_AVX2:
+            return avx2;
+        default:
+            return VNULL;
+    }
+}
+
+/* *** Exponential of the nonlinear coefficient routines (mypdec.c) ***
+ *
+ * exp(x) = 2^k exp(r) with k = nint(x / ln 2) and r = x - k ln 2, where ln 2
+ * is split in two (Cody-Waite) so that k ln2_hi is exact and |r| <= ln(2)/2.
+ * exp(r) is its Taylor polynomial of degree 13, whose truncation error is
+ * below 5e-18 relative, so the error is that of the Horner recurrence: the
+ * result is within 1.5 ulp of exp(x).  Over 4e6 random arguments in
+ * [EXPMIN, EXPMAX] the largest error was 1.14 ulp for AVX2 (no FMA) and
+ * 0.87 ulp for AVX-512F (FMA).  2^k is formed directly in the
+ * exponent field: k is recovered from the low mantissa bits of
+ * x / ln 2 + 1.5 * 2^52.
+ *
+ * Arguments are clamped to [EXPMIN, EXPMAX] as in Vcap_exp, so the result is
+ * always a normal number.  The scalar version is used for the remainders and
+ * performs the same operations as the AVX2 lanes. */
+
+VPRIVATE const double Vsimd_expCoef[14] = {
+    1.0, 1.0, 0.5,
+    0.16666666666666666, 0.041666666666666664,
+    0.008333333333333333, 0.001388888888888889,
+    0.0001984126984126984, 2.48015873015873e-05,
+    2.7557319223985893e-06, 2.755731922398589e-07,
+    2.505210838544172e-08, 2.08767569878681e-09,
+    1.6059043836821613e-10
+};
+
+#define VSIMD_LOG2E   1.4426950408889634
+#define VSIMD_LN2HI   6.93147180369123816490e-01
+#define VSIMD_LN2LO   1.90821492927058770002e-10
+#define VSIMD_SHIFTER 6755399441055744.0
+
+VPRIVATE double Vsimd_expPt(double x) {
+
+    int j;
+    double t, k, r, p;
+
+    x = VMIN2(VMAX2(x, EXPMIN), EXPMAX);
+    t = x * VSIMD_LOG2E + VSIMD_SHIFTER;
+    k = t - VSIMD_SHIFTER;
+    r = x - k * VSIMD_LN2HI;
+    r = r - k * VSIMD_LN2LO;
+
+    p = Vsimd_expCoef[13];
+    for (j=12; j>=0; j--)
+        p = p * r + Vsimd_expCoef[j];
+
+    return ldexp(p, (int)k);
+}
+
+VPRIVATE VSIMD_TARGET("avx2") __m256d Vsimd_exp_avx2(__m256d v) {
+
+    int j;
+    __m256d t, k, r, p;
+    __m256i e;
+
+    v = _mm256_min_pd(_mm256_max_pd(v, _mm256_set1_pd(EXPMIN)),
+                      _mm256_set1_pd(EXPMAX));
+    t = _mm256_add_pd(_mm256_mul_pd(v, _mm256_set1_pd(VSIMD_LOG2E)),
+                      _mm256_set1_pd(VSIMD_SHIFTER));
+    k = _mm256_sub_pd(t, _mm256_set1_pd(VSIMD_SHIFTER));
+    r = _mm256_sub_pd(v, _mm256_mul_pd(k, _mm256_set1_pd(VSIMD_LN2HI)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(k, _mm256_set1_pd(VSIMD_LN2LO)));
+
+    p = _mm256_set1_pd(Vsimd_expCoef[13]);
+    for (j=12; j>=0; j--)
+        p = _mm256_add_pd(_mm256_mul_pd(p, r),
+                          _mm256_set1_pd(Vsimd_expCoef[j]));
+
+    e = _mm256_add_epi64(_mm256_castpd_si256(t), _mm256_set1_epi64x(1023));
+    e = _mm256_slli_epi64(e, 52);
+    return _mm256_mul_pd(p, _mm256_castsi256_pd(e));
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_expRow_avx2(int n,
+        double *x, double *y) {
+
+    int q;
+
+    for (q=0; q+4<=n; q+=4)
+        _mm256_storeu_pd(y+q, Vsimd_exp_avx2(_mm256_loadu_pd(x+q)));
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        y[q] = Vsimd_expPt(x[q]);
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") __m512d Vsimd_exp_avx512(__m512d v) {
+
+    int j;
+    __m512d t, k, r, p;
+    __m512i e;
+
+    v = _mm512_min_pd(_mm512_max_pd(v, _mm512_set1_pd(EXPMIN)),
+                      _mm512_set1_pd(EXPMAX));
+    t = _mm512_fmadd_pd(v, _mm512_set1_pd(VSIMD_LOG2E),
+                        _mm512_set1_pd(VSIMD_SHIFTER));
+    k = _mm512_sub_pd(t, _mm512_set1_pd(VSIMD_SHIFTER));
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(VSIMD_LN2HI), v);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(VSIMD_LN2LO), r);
+
+    p = _mm512_set1_pd(Vsimd_expCoef[13]);
+    for (j=12; j>=0; j--)
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(Vsimd_expCoef[j]));
+
+    e = _mm512_add_epi64(_mm512_castpd_si512(t), _mm512_set1_epi64(1023));
+    e = _mm512_slli_epi64(e, 52);
+    return _mm512_mul_pd(p, _mm512_castsi512_pd(e));
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_expRow_avx512(int n,
+        double *x, double *y) {
+
+    int q;
+
+    for (q=0; q+8<=n; q+=8)
+        _mm512_storeu_pd(y+q, Vsimd_exp_avx512(_mm512_loadu_pd(x+q)));
+    _mm256_zeroupper();
+    for (; q<n; q++)
+        y[q] = Vsimd_expPt(x[q]);
+}
+
+/* Screened Coulomb sums for the bcfl mdh boundary values.  The atoms are
+ * taken in blocks of VSIMD_MDHBLOCK (four coordinate/weight arrays of 256
+ * doubles, 8 kB) so that a block stays in L1 while every point of the
+ * batch is swept over it.  Each point keeps one vector of partial sums per
+ * block; the lanes are reduced and added to the point in double precision.
+ *
+ * 1/r comes from the single-precision reciprocal square root estimate
+ * (about 12 bits, 14 with AVX-512F) refined by Newton steps in double,
+ * y <- y (3 - r^2 y^2) / 2, each of which doubles the number of correct
+ * bits; three steps (two from the AVX-512F estimate) leave a few ulp.
+ * This avoids the long-latency divide and square root, which would
+ * otherwise bound the loop.  The scalar remainder of a block uses sqrt()
+ * and Vsimd_expPt. */
+
+#define VSIMD_MDHBLOCK 256
+
+VPRIVATE double Vsimd_mdhPt(double px, double py, double pz,
+        int n, double *ax, double *ay, double *az, double *w, double kappa) {
+
+    int q;
+    double dx, dy, dz, r, sum;
+
+    sum = 0.0;
+    for (q=0; q<n; q++) {
+        dx = px - ax[q];
+        dy = py - ay[q];
+        dz = pz - az[q];
+        r = sqrt(dx*dx + dy*dy + dz*dz);
+        if (kappa > 0.0) sum += w[q]*Vsimd_expPt(-kappa*r)/r;
+        else sum += w[q]/r;
+    }
+    return sum;
+}
+
+VPRIVATE VSIMD_TARGET("avx2") void Vsimd_mdh_avx2(int npts,
+        double *px, double *py, double *pz, int natoms,
+        double *ax, double *ay, double *az, double *w, double kappa,
+        double *val) {
+
+    int i, q, q0, n, nv;
+    double lane[4];
+    __m256d x, y, z, dx, dy, dz, r2, h, g, e, acc;
+
+    for (q0=0; q0<natoms; q0+=VSIMD_MDHBLOCK) {
+        n = VMIN2(VSIMD_MDHBLOCK, natoms-q0);
+        nv = n & ~3;
+        for (i=0; i<npts; i++) {
+            x = _mm256_set1_pd(px[i]);
+            y = _mm256_set1_pd(py[i]);
+            z = _mm256_set1_pd(pz[i]);
+            acc = _mm256_setzero_pd();
+            for (q=q0; q<q0+nv; q+=4) {
+                dx = _mm256_sub_pd(x, _mm256_loadu_pd(ax+q));
+                dy = _mm256_sub_pd(y, _mm256_loadu_pd(ay+q));
+                dz = _mm256_sub_pd(z, _mm256_loadu_pd(az+q));
+                r2 = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx),
+                        _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+                g = _mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(r2)));
+                h = _mm256_mul_pd(r2, _mm256_set1_pd(0.5));
+                g = _mm256_mul_pd(g, _mm256_sub_pd(_mm256_set1_pd(1.5),
+                        _mm256_mul_pd(h, _mm256_mul_pd(g, g))));
+                g = _mm256_mul_pd(g, _mm256_sub_pd(_mm256_set1_pd(1.5),
+                        _mm256_mul_pd(h, _mm256_mul_pd(g, g))));
+                g = _mm256_mul_pd(g, _mm256_sub_pd(_mm256_set1_pd(1.5),
+                        _mm256_mul_pd(h, _mm256_mul_pd(g, g))));
+                e = _mm256_mul_pd(_mm256_loadu_pd(w+q), g);
+                if (kappa > 0.0)
+                    e = _mm256_mul_pd(e, Vsimd_exp_avx2(_mm256_mul_pd(
+                            _mm256_set1_pd(-kappa), _mm256_mul_pd(r2, g))));
+                acc = _mm256_add_pd(acc, e);
+            }
+            _mm256_storeu_pd(lane, acc);
+            val[i] += (lane[0] + lane[1]) + (lane[2] + lane[3]);
+        }
+        _mm256_zeroupper();
+        if (nv < n) {
+            for (i=0; i<npts; i++)
+                val[i] += Vsimd_mdhPt(px[i], py[i], pz[i], n-nv,
+                        ax+q0+nv, ay+q0+nv, az+q0+nv, w+q0+nv, kappa);
+        }
+    }
+}
+
+VPRIVATE VSIMD_TARGET("avx512f") void Vsimd_mdh_avx512(int npts,
+        double *px, double *py, double *pz, int natoms,
+        double *ax, double *ay, double *az, double *w, double kappa,
+        double *val) {
+
+    int i, q, q0, n, nv;
+    __m512d x, y, z, dx, dy, dz, r2, h, g, e, acc;
+
+    for (q0=0; q0<natoms; q0+=VSIMD_MDHBLOCK) {
+        n = VMIN2(VSIMD_MDHBLOCK, natoms-q0);
+        nv = n & ~7;
+        for (i=0; i<npts; i++) {
+            x = _mm512_set1_pd(px[i]);
+            y = _mm512_set1_pd(py[i]);
+            z = _mm512_set1_pd(pz[i]);
+            acc = _mm512_setzero_pd();
+            for (q=q0; q<q0+nv; q+=8) {
+                dx = _mm512_sub_pd(x, _mm512_loadu_pd(ax+q));
+                dy = _mm512_sub_pd(y, _mm512_loadu_pd(ay+q));
+                dz = _mm512_sub_pd(z, _mm512_loadu_pd(az+q));
+                r2 = _mm512_fmadd_pd(dz, dz, _mm512_fmadd_pd(dy, dy,
+                        _mm512_mul_pd(dx, dx)));
+                g = _mm512_rsqrt14_pd(r2);
+                h = _mm512_mul_pd(r2, _mm512_set1_pd(0.5));
+                g = _mm512_mul_pd(g, _mm512_fnmadd_pd(h, _mm512_mul_pd(g, g),
+                        _mm512_set1_pd(1.5)));
+                g = _mm512_mul_pd(g, _mm512_fnmadd_pd(h, _mm512_mul_pd(g, g),
+                        _mm512_set1_pd(1.5)));
+                e = _mm512_mul_pd(_mm512_loadu_pd(w+q), g);
+                if (kappa > 0.0)
+                    e = _mm512_mul_pd(e, Vsimd_exp_avx512(_mm512_mul_pd(
+                            _mm512_set1_pd(-kappa), _mm512_mul_pd(r2, g))));
+                acc = _mm512_add_pd(acc, e);
+            }
+            val[i] += _mm512_reduce_add_pd(acc);
+        }
+        _mm256_zeroupper();
+        if (nv < n) {
+            for (i=0; i<npts; i++)
+                val[i] += Vsimd_mdhPt(px[i], py[i], pz[i], n-nv,
+                        ax+q0+nv, ay+q0+nv, az+q0+nv, w+q0+nv, kappa);
+        }
+    }
+}
+
+#endif /* if defined(APBS_SIMD) */
+
+/* Apply a row kernel to the interior rows of plane k.  With parity < 0 the
+ * rows are contiguous; otherwise only the points of one red/black color are
+ * visited, starting at i = 2 + (j + k + parity) % 2.  outk addresses point
+ * (1,1,k) of the output, so it may be a full grid or a single plane. */
+VPRIVATE void Vsimd_plane(int nx, int ny, int k, int parity, Vsimd_RowFn row,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *outk) {
+
+    int j, p, q, n, ioff;
+    int sj = nx;
+    int sk = nx * ny;
+
+    #pragma omp parallel for private(j, p, q, n, ioff)
+    for (j=2; j<=ny-1; j++) {
+        if (parity < 0) {
+            ioff = 0;
+            n = nx - 2;
+        } else {
+            ioff = (j + k + parity) % 2;
+            n = (nx - 1 - ioff) / 2;
+        }
+        /* Zero-based offset of point (2+ioff, j, k), and of (2+ioff, j)
+         * within the plane */
+        q = 1 + ioff + sj*(j - 1);
+        p = q + sk*(k - 1);
+        (*row)(n, sj, sk,
+               oC + p, cc + p, (fc == VNULL) ? VNULL : fc + p,
+               oE + p, oN + p, uC + p,
+               x + p, (w1 == VNULL) ? VNULL : w1 + p,
+               (outk == VNULL) ? VNULL : outk + q);
+    }
+}
+
+/* Apply a row kernel to every interior row (see Vsimd_plane) */
+VPRIVATE void Vsimd_rows(int nx, int ny, int nz, int parity, Vsimd_RowFn row,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *w1, double *out) {
+
+    int k;
+    int sk = nx * ny;
+
+    #pragma omp parallel for private(k)
+    for (k=2; k<=nz-1; k++) {
+        Vsimd_plane(nx, ny, k, parity, row,
+                    oC, cc, fc, oE, oN, uC, x, w1,
+                    (out == VNULL) ? VNULL : out + sk*(k - 1));
+    }
+}
+
+VPUBLIC int Vmatvec7_simd(int *nx, int *ny, int *nz,
+        double *oC, double *cc,
+        double *oE, double *oN, double *uC,
+        double *x, double *y) {
+
+    Vsimd_RowFn row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pick(Vsimd_matvec7Row_avx2, Vsimd_matvec7Row_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_rows(*nx, *ny, *nz, -1, row,
+               oC, cc, VNULL, oE, oN, uC, x, VNULL, y);
+    return 1;
+}
+
+VPUBLIC int Vmresid7_simd(int *nx, int *ny, int *nz,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *r, double *w1) {
+
+    Vsimd_RowFn row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pick(Vsimd_resid7Row_avx2, Vsimd_resid7Row_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_rows(*nx, *ny, *nz, -1, row,
+               oC, cc, fc, oE, oN, uC, x, w1, r);
+    return 1;
+}
+
+VPUBLIC int Vgsrb7_simd(int *nx, int *ny, int *nz,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, int parity) {
+
+    Vsimd_RowFn row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pick(Vsimd_gs7Row_avx2, Vsimd_gs7Row_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_rows(*nx, *ny, *nz, parity, row,
+               oC, cc, fc, oE, oN, uC, x, VNULL, VNULL);
+    return 1;
+}
+
+VPUBLIC int Vmresid7_simdPlane(int *nx, int *ny, int *nz, int k,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, double *rk) {
+
+    Vsimd_RowFn row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pick(Vsimd_resid7Row_avx2, Vsimd_resid7Row_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_plane(*nx, *ny, k, -1, row,
+                oC, cc, fc, oE, oN, uC, x, VNULL, rk);
+    return 1;
+}
+
+VPUBLIC int Vgsrb7_simdPlane(int *nx, int *ny, int *nz, int k,
+        double *oC, double *cc, double *fc,
+        double *oE, double *oN, double *uC,
+        double *x, int parity) {
+
+    Vsimd_RowFn row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pick(Vsimd_gs7Row_avx2, Vsimd_gs7Row_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_plane(*nx, *ny, k, parity, row,
+                oC, cc, fc, oE, oN, uC, x, VNULL, VNULL);
+    return 1;
+}
+
+/* Single-precision counterpart of Vsimd_rows (contiguous rows if
+ * parity < 0, else one red/black color) */
+VPRIVATE void Vsimd_rowsF(int nx, int ny, int nz, int parity, Vsimd_RowFnF row,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *out) {
+
+    int j, k, p, n, ioff;
+    int sj = nx;
+    int sk = nx * ny;
+
+    #pragma omp parallel for private(j, k, p, n, ioff)
+    for (k=2; k<=nz-1; k++) {
+        for (j=2; j<=ny-1; j++) {
+            if (parity < 0) {
+                ioff = 0;
+                n = nx - 2;
+            } else {
+                ioff = (j + k + parity) % 2;
+                n = (nx - 1 - ioff) / 2;
+            }
+            p = 1 + ioff + sj*(j - 1) + sk*(k - 1);
+            (*row)(n, sj, sk,
+                   oC + p, cc + p, fc + p, oE + p, oN + p, uC + p,
+                   x + p, (out == VNULL) ? VNULL : out + p);
+        }
+    }
+}
+
+VPUBLIC int Vmresid7_simdf(int *nx, int *ny, int *nz,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, float *r) {
+
+    Vsimd_RowFnF row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pickF(Vsimd_resid7RowF_avx2, Vsimd_resid7RowF_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_rowsF(*nx, *ny, *nz, -1, row, oC, cc, fc, oE, oN, uC, x, r);
+    return 1;
+}
+
+VPUBLIC int Vgsrb7_simdf(int *nx, int *ny, int *nz,
+        float *oC, float *cc, float *fc,
+        float *oE, float *oN, float *uC,
+        float *x, int parity) {
+
+    Vsimd_RowFnF row = VNULL;
+
+#if defined(APBS_SIMD)
+    row = Vsimd_pickF(Vsimd_gs7RowF_avx2, Vsimd_gs7RowF_avx512);
+#endif
+    if (row == VNULL) return 0;
+
+    Vsimd_rowsF(*nx, *ny, *nz, parity, row, oC, cc, fc, oE, oN, uC, x, VNULL);
+    return 1;
+}
+
+VPUBLIC int Vexp_simd(int n, double *x, double *y) {
+
+#if defined(APBS_SIMD)
+    switch (Vsimd_getLevel()) {
+        case VSIMD_AVX512:
+            Vsimd_expRow_avx512(n, x, y);
+            return 1;
+        case VSIMD_AVX2:
+            Vsimd_expRow_avx2(n, x, y);
+            return 1;
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
+
+VPUBLIC int Vmdh_simd(int npts, double *px, double *py, double *pz,
+        int natoms, double *ax, double *ay, double *az, double *w,
+        double kappa, double *val) {
+
+#if defined(APBS_SIMD)
+    switch (Vsimd_getLevel()) {
+        case VSIMD_AVX512:
+            Vsimd_mdh_avx512(npts, px, py, pz, natoms, ax, ay, az, w, kappa,
+                    val);
+            return 1;
+        case VSIMD_AVX2:
+            Vsimd_mdh_avx2(npts, px, py, pz, natoms, ax, ay, az, w, kappa,
+                    val);
+            return 1;
+        default:
+            break;
+    }
+#endif
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Runtime-dispatched SIMD kernels for the 7-point stencil
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+#ifndef _SIMDD_H_
+#define _SIMDD_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+
+/** @brief  Instruction set used by the vectorized stencil kernels
+ *  @ingroup PMGC
+ */
+enum eVsimd_Level {
+    VSIMD_SCALAR=0,  /**< Portable scalar loops (no vectorized kernels) */
+    VSIMD_AVX2=1,  /**< 256-bit AVX2 kernels */
+    VSIMD_AVX512=2  /**< 512-bit AVX-512F kernels */
+};
+
+/** @brief  Declare Vsimd_Level type
+ *  @ingroup PMGC
+ */
+typedef enum eVsimd_Level Vsimd_Level;
+
+/** @brief   Return the instruction set used by the stencil kernels
+ *  @ingroup PMGC
+ *
+ *  The level is detected from CPUID on the first call and cached; it is
+ *  always VSIMD_SCALAR if APBS was built without APBS_SIMD.
+ */
+VEXTERNC Vsimd_Level Vsimd_getLevel();
+
+/** @brief   Cap the instruction set used by the stencil kernels
+ *  @ingroup PMGC
+ *
+ *  Requests above what the processor supports are lowered to the detected
+ *  level (with a warning unless VSIMD_AVX512, which stands for "the best
+ *  available", was asked for).  Vpmg_ctor2 calls this with the level set by
+ *  the MG keyword "simd {auto|scalar|avx2|avx512}", so the vector and scalar
+ *  paths can be compared from an input file.
+ */
+VEXTERNC void Vsimd_setLevel(
+        Vsimd_Level level  ///< Highest instruction set to use
+        );
+
+/** @brief   Vectorized y = A x for the 7-point operator
+ *  @ingroup PMGC
+ *  @returns 1 if the product was computed, 0 if the caller must fall back to
+ *           the scalar loop
+ */
+VEXTERNC int Vmatvec7_simd(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        double *oC,  ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *oE,  ///< @todo:  Doc
+        double *oN,  ///< @todo:  Doc
+        double *uC,  ///< @todo:  Doc
+        double *x,   ///< @todo:  Doc
+        double *y    ///< @todo:  Doc
+        );
+
+/** @brief   Vectorized residual r = f - A x for the 7-point operator
+ *  @ingroup PMGC
+ *
+ *  If w1 is not VNULL it holds the (already evaluated) nonlinear term, and
+ *  the residual is r = f - (A - diag(cc)) x - w1 as in Vnmresid7_1s.
+ *
+ *  @returns 1 if the residual was computed, 0 if the caller must fall back
+ *           to the scalar loop
+ */
+VEXTERNC int Vmresid7_simd(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        double *oC,  ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *fc,  ///< @todo:  Doc
+        double *oE,  ///< @todo:  Doc
+        double *oN,  ///< @todo:  Doc
+        double *uC,  ///< @todo:  Doc
+        double *x,   ///< @todo:  Doc
+        double *r,   ///< @todo:  Doc
+        double *w1   ///< Nonlinear term, or VNULL for the linear residual
+        );
+
+/** @brief   Vectorized half-sweep of red/black Gauss-Seidel (Vgsrb7x)
+ *  @ingroup PMGC
+ *
+ *  Updates the points with (i + j + k + parity) even, i.e. the first point
+ *  of row (j,k) is i = 2 + (j + k + parity) % 2.
+ *
+ *  @returns 1 if the sweep was done, 0 if the caller must fall back to the
+ *           scalar loop
+ */
+VEXTERNC int Vgsrb7_simd(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        double *oC,  ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *fc,  ///< @todo:  Doc
+        double *oE,  ///< @todo:  Doc
+        double *oN,  ///< @todo:  Doc
+        double *uC,  ///< @todo:  Doc
+        double *x,   ///< @todo:  Doc
+        int parity   ///< Color offset of the half-sweep (0 or 1)
+        );
+
+/** @brief   Vectorized linear residual of one plane (Vmresid7_simd)
+ *  @ingroup PMGC
+ *
+ *  Computes the interior points of plane k of r = f - A x and stores them
+ *  in rk, an nx*ny plane laid out like one slice of the grid.
+ *
+ *  @returns 1 if the residual was computed, 0 if the caller must fall back
+ *           to the scalar loop
+ */
+VEXTERNC int Vmresid7_simdPlane(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        int k,       ///< Plane to evaluate (2 <= k <= nz-1)
+        double *oC,  ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *fc,  ///< @todo:  Doc
+        double *oE,  ///< @todo:  Doc
+        double *oN,  ///< @todo:  Doc
+        double *uC,  ///< @todo:  Doc
+        double *x,   ///< @todo:  Doc
+        double *rk   ///< Output plane (nx*ny)
+        );
+
+/** @brief   Vectorized red/black half-sweep of one plane (Vgsrb7_simd)
+ *  @ingroup PMGC
+ *  @returns 1 if the sweep was done, 0 if the caller must fall back to the
+ *           scalar loop
+ */
+VEXTERNC int Vgsrb7_simdPlane(
+        int *nx,     ///< @todo:  Doc
+        int *ny,     ///< @todo:  Doc
+        int *nz,     ///< @todo:  Doc
+        int k,       ///< Plane to update (2 <= k <= nz-1)
+        double *oC,  ///< @todo:  Doc
+        double *cc,  ///< @todo:  Doc
+        double *fc,  ///< @todo:  Doc
+        double *oE,  ///< @todo:  Doc
+        double *oN,  ///< @todo:  Doc
+        double *uC,  ///< @todo:  Doc
+        double *x,   ///< @todo:  Doc
+        int parity   ///< Color offset of the half-sweep (0 or 1)
+        );
+
+/** @brief   Single-precision Vmresid7_simd (linear residual only)
+ *  @ingroup PMGC
+ *  @returns 1 if the residual was computed, 0 if the caller must fall back
+ *           to the scalar loop
+ */
+VEXTERNC int Vmresid7_simdf(
+        int *nx,    ///< @todo:  Doc
+        int *ny,    ///< @todo:  Doc
+        int *nz,    ///< @todo:  Doc
+        float *oC,  ///< @todo:  Doc
+        float *cc,  ///< @todo:  Doc
+        float *fc,  ///< @todo:  Doc
+        float *oE,  ///< @todo:  Doc
+        float *oN,  ///< @todo:  Doc
+        float *uC,  ///< @todo:  Doc
+        float *x,   ///< @todo:  Doc
+        float *r    ///< @todo:  Doc
+        );
+
+/** @brief   Single-precision Vgsrb7_simd
+ *  @ingroup PMGC
+ *  @returns 1 if the sweep was done, 0 if the caller must fall back to the
+ *           scalar loop
+ */
+VEXTERNC int Vgsrb7_simdf(
+        int *nx,    ///< @todo:  Doc
+        int *ny,    ///< @todo:  Doc
+        int *nz,    ///< @todo:  Doc
+        float *oC,  ///< @todo:  Doc
+        float *cc,  ///< @todo:  Doc
+        float *fc,  ///< @todo:  Doc
+        float *oE,  ///< @todo:  Doc
+        float *oN,  ///< @todo:  Doc
+        float *uC,  ///< @todo:  Doc
+        float *x,   ///< @todo:  Doc
+        int parity  ///< Color offset of the half-sweep (0 or 1)
+        );
+
+/** @brief   Vectorized exponential, clamped like Vcap_exp
+ *  @ingroup PMGC
+ *
+ *  Sets y[i] = exp(x[i]) for 0 <= i < n, with x[i] first clamped to
+ *  [EXPMIN, EXPMAX].  The result is within 1.5 ulp of the exact
+ *  exponential of the clamped argument.  Callable from inside parallel
+ *  regions.
+ *
+ *  @returns 1 if y was computed, 0 if the caller must fall back to exp()
+ */
+VEXTERNC int Vexp_simd(
+        int n,      ///< Number of points
+        double *x,  ///< Arguments
+        double *y   ///< Output (may be x)
+        );
+
+/** @brief   Vectorized screened Coulomb sums
+ *  @ingroup PMGC
+ *
+ *  Adds sum_j w[j] exp(-kappa r_ij) / r_ij to val[i] for 0 <= i < npts,
+ *  where r_ij is the distance from point i to atom j; kappa = 0 gives
+ *  the plain Coulomb sum.  The atoms are swept in blocks that stay in L1
+ *  cache and the sums are accumulated in double precision; each term is
+ *  within a few ulp of the scalar expression.  Callable from inside
+ *  parallel regions.
+ *
+ *  @returns 1 if val was updated, 0 if the caller must fall back to the
+ *           scalar loop
+ */
+VEXTERNC int Vmdh_simd(
+        int npts,     ///< Number of points
+        double *px,   ///< Point x coordinates
+        double *py,   ///< Point y coordinates
+        double *pz,   ///< Point z coordinates
+        int natoms,   ///< Number of atoms
+        double *ax,   ///< Atom x coordinates
+        double *ay,   ///< Atom y coordinates
+        double *az,   ///< Atom z coordinates
+        double *w,    ///< Atom weights
+        double kappa, ///< Inverse screening length
+        double *val   ///< Sums (accumulated into)
+        );
+
+#endif /* _SIMDD_H_ */
@@ -47,6 +47,8 @@
  * @endverbatim
  */
 
+#include <time.h>
+
 #include "smoothd.h"
 
 VEXTERNC void Vsmooth(int *nx, int *ny, int *nz,
@@ -83,6 +85,22 @@ VEXTERNC void Vsmooth(int *nx, int *ny, int *nz,
                 itmax, iters,
                 errtol, omega,
                 iresid, iadjoint);
+    } else if (*meth == 5) {
+        Vgsmc(nx, ny, nz,
+                ipc, rpc,
+                ac, cc, fc,
+                x, w1, w2, r,
+                itmax, iters,
+                errtol, omega,
+                iresid, iadjoint);
+    } else if (*meth == 6) {
+        Vcheb(nx, ny, nz,
+                ipc, rpc,
+                ac, cc, fc,
+                x, w1, w2, r,
+                itmax, iters,
+                errtol, omega,
+                iresid, iadjoint);
     } else {
         VABORT_MSG1("Bad smoothing routine specified = %d", *meth);
     }
@@ -116,3 +134,127 @@ VEXTERNC void Vnsmooth(int *nx, int *ny, int *nz,
         VABORT_MSG1("Bad smoothing routine specified: %d", *meth );
     }
 }
+
+
+
+/* Per-level traffic counters for Vsmoothr, indexed by level - 1 */
+#define VSMOOTHR_MAXLEV 32
+
+VPRIVATE int    Vsmoothr_calls[VSMOOTHR_MAXLEV];
+VPRIVATE int    Vsmoothr_fused[VSMOOTHR_MAXLEV];
+VPRIVATE int    Vsmoothr_dime[VSMOOTHR_MAXLEV][3];
+VPRIVATE double Vsmoothr_bytes[VSMOOTHR_MAXLEV];
+VPRIVATE double Vsmoothr_secs[VSMOOTHR_MAXLEV];
+
+/* Wall-clock seconds; clock() would add up the CPU time of every thread */
+VPRIVATE double Vsmoothr_wtime() {
+
+    struct timespec t;
+
+    timespec_get(&t, TIME_UTC);
+    return (double)t.tv_sec + 1.0e-9 * (double)t.tv_nsec;
+}
+
+VPUBLIC void Vsmoothr(int *nx, int *ny, int *nz,
+        int *nxc, int *nyc, int *nzc,
+        int *ipc, double *rpc,
+        double *ac, double *cc, double *fc,
+        double *x, double *w1, double *w2, double *r,
+        double *rc, double *pc,
+        int *itmax, int *iters,
+        double *errtol, double *omega,
+        int *iadjoint, int *meth, int *lev) {
+
+    int n, nc, ncoef, fused, iresid, l;
+    double streams, ts;
+
+    MAT2(ac, *nx * *ny * *nz, 1);
+
+    ts = Vsmoothr_wtime();
+
+    // The fused sweep exists for red/black GS on the assembled 7-point box
+    fused = ((*meth == 1) || (*meth == 5))
+         && (VAT(ipc, 11) == 7) && (VAT(ipc, 13) == 0);
+
+    if (fused) {
+        Vgsrb7rx(nx, ny, nz,
+                nxc, nyc, nzc,
+                ipc, rpc,
+                RAT2(ac, 1,1), cc, fc,
+                RAT2(ac, 1,2), RAT2(ac, 1,3), RAT2(ac, 1,4),
+                x, w1, w2, r,
+                rc, pc,
+                itmax, iters, errtol, omega, iadjoint);
+    } else {
+        iresid = 1;
+        Vsmooth(nx, ny, nz,
+                ipc, rpc,
+                ac, cc, fc,
+                x, w1, w2, r,
+                itmax, iters,
+                errtol, omega,
+                &iresid, iadjoint, meth);
+        Vrestrc(nx, ny, nz,
+                nxc, nyc, nzc,
+                r, rc, pc);
+    }
+
+    /* Main-memory traffic model, in full passes over a grid vector: each
+     * half-sweep reads x, fc, cc and the stored diagonals and writes x; the
+     * residual reads the same minus the write and writes r (with its
+     * write-allocate); the restriction reads r and the 27 prolongation
+     * coefficients and writes the coarse vector.  The fused kernel keeps
+     * the residual in cache, so only the sweeps and the coarse side remain */
+    l = *lev - 1;
+    if ((l < 0) || (l >= VSMOOTHR_MAXLEV))
+        return;
+
+    n  = *nx * *ny * *nz;
+    nc = *nxc * *nyc * *nzc;
+    if (VAT(ipc, 11) == 27) ncoef = 14;
+    else if (VAT(ipc, 13) == 1) ncoef = 3;
+    else ncoef = 4;
+
+    streams = 2.0 * VMAX2(*itmax, 0) * (ncoef + 4) * n + 29.0 * nc;
+    if (!fused)
+        streams += (ncoef + 4) * n + n;
+
+    Vsmoothr_calls[l]++;
+    Vsmoothr_fused[l] += fused;
+    Vsmoothr_dime[l][0] = *nx;
+    Vsmoothr_dime[l][1] = *ny;
+    Vsmoothr_dime[l][2] = *nz;
+    Vsmoothr_bytes[l] += 8.0 * streams;
+    Vsmoothr_secs[l] += Vsmoothr_wtime() - ts;
+}
+
+VPUBLIC void Vsmoothr_resetTraffic() {
+
+    int l;
+
+    for (l=0; l<VSMOOTHR_MAXLEV; l++) {
+        Vsmoothr_calls[l] = 0;
+        Vsmoothr_fused[l] = 0;
+        Vsmoothr_bytes[l] = 0.0;
+        Vsmoothr_secs[l] = 0.0;
+    }
+}
+
+VPUBLIC void Vsmoothr_printTraffic() {
+
+    int l;
+    double rate;
+
+    for (l=0; l<VSMOOTHR_MAXLEV; l++) {
+        if (Vsmoothr_calls[l] == 0)
+            continue;
+        rate = (Vsmoothr_secs[l] > 0.0)
+             ? Vsmoothr_bytes[l] / Vsmoothr_secs[l] * 1.0e-9 : 0.0;
+        Vnm_print(0, "Vsmoothr: level %d (%d x %d x %d): %d passes (%d fused), \
+%.1f MB modelled in %.3f s wall, %.2f GB/s modelled\n",
+                l + 1,
+                Vsmoothr_dime[l][0], Vsmoothr_dime[l][1], Vsmoothr_dime[l][2],
+                Vsmoothr_calls[l], Vsmoothr_fused[l],
+                Vsmoothr_bytes[l] * 1.0e-6, Vsmoothr_secs[l], rate);
+    }
+}
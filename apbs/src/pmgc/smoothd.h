@@ -57,6 +57,7 @@
 #include "generic/vmatrix.h"
 #include "pmgc/gsd.h"
 #include "pmgc/cgd.h"
+#include "pmgc/chebd.h"
 
 /** @brief   call the appropriate linear smoothing routine.
  *  @ingroup PMGC
@@ -113,6 +114,64 @@ VEXTERNC void Vnsmooth(
         int    *iadjoint, ///< @todo: Doc
         int    *meth      ///< @todo: Doc
         );
+/** @brief   Pre-smooth and restrict the resulting residual
+ *  @ingroup PMGC
+ *
+ *  Runs itmax sweeps of the smoother meth and restricts the residual into
+ *  rc on the next coarser grid, i.e. Vsmooth with iresid = 1 followed by
+ *  Vrestrc.  For red/black Gauss-Seidel on an assembled 7-point operator
+ *  this is done by the fused Vgsrb7rx, which leaves only three residual
+ *  planes in r instead of the whole fine grid residual.
+ *
+ *  Each call adds its modelled memory traffic and its wall-clock time to
+ *  a counter for level lev; see Vsmoothr_printTraffic.
+ *
+ *  The fusion only removes the residual write and read-back, not the
+ *  sweeps, so it cuts the modelled fine-level traffic by about 20% for
+ *  nu1 = 2, not by 2x.  Only the residual and restriction part halves.
+ */
+VEXTERNC void Vsmoothr(
+        int    *nx,       ///< @todo: Doc
+        int    *ny,       ///< @todo: Doc
+        int    *nz,       ///< @todo: Doc
+        int    *nxc,      ///< Coarse grid size
+        int    *nyc,      ///< Coarse grid size
+        int    *nzc,      ///< Coarse grid size
+        int    *ipc,      ///< @todo: Doc
+        double *rpc,      ///< @todo: Doc
+        double *ac,       ///< @todo: Doc
+        double *cc,       ///< @todo: Doc
+        double *fc,       ///< @todo: Doc
+        double *x,        ///< @todo: Doc
+        double *w1,       ///< @todo: Doc
+        double *w2,       ///< @todo: Doc
+        double *r,        ///< Fine grid residual workspace
+        double *rc,       ///< Restricted residual on the coarse grid
+        double *pc,       ///< Prolongation operator of this level
+        int    *itmax,    ///< @todo: Doc
+        int    *iters,    ///< @todo: Doc
+        double *errtol,   ///< @todo: Doc
+        double *omega,    ///< @todo: Doc
+        int    *iadjoint, ///< @todo: Doc
+        int    *meth,     ///< @todo: Doc
+        int    *lev       ///< Level (1 = finest) to charge the traffic to
+        );
+
+/** @brief   Clear the per-level traffic counters of Vsmoothr
+ *  @ingroup PMGC
+ */
+VEXTERNC void Vsmoothr_resetTraffic();
+
+/** @brief   Print the per-level traffic counters of Vsmoothr
+ *  @ingroup PMGC
+ *
+ *  Reports to the log (unit 0), per level, the number of smooth/restrict
+ *  passes, the modelled bytes moved to and from main memory, the
+ *  wall-clock time spent and the resulting bandwidth.  The byte counts
+ *  come from a streaming model, not from hardware counters, so the
+ *  bandwidth is an estimate as well.
+ */
+VEXTERNC void Vsmoothr_printTraffic();
 
 
 #endif /* _SMOOTHD_H_ */
@@ -0,0 +1,224 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Sparse Cholesky solver for the coarsest multigrid level
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#include <vector>
+
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+
+#include "sparsed.h"
+
+typedef Eigen::SparseMatrix<double> Vsparse_Mat;
+typedef Eigen::SimplicialLDLT<Vsparse_Mat, Eigen::Upper> Vsparse_Fac;
+
+/*
+ * Factors are referred to from ipcB by a 1-based slot in this table, so the
+ * integer work arrays never hold a pointer.
+ */
+static std::vector<Vsparse_Fac *> Vsparse_table;
+
+VPRIVATE int Vsparse_store(Vsparse_Fac *fac) {
+
+    size_t i;
+
+    for (i=0; i<Vsparse_table.size(); i++) {
+        if (Vsparse_table[i] == VNULL) {
+            Vsparse_table[i] = fac;
+            return (int)i + 1;
+        }
+    }
+    Vsparse_table.push_back(fac);
+    return (int)Vsparse_table.size();
+}
+
+/*
+ * Coupling of interior point (i,j,k) to the neighbour (i+di,j+dj,k+dk)
+ * that follows it in natural ordering; the entry is -coef(i,j,k) as in
+ * Vmatvec7/Vmatvec27.  Neighbours on the boundary carry no unknown.
+ */
+VPRIVATE void Vsparse_couple(std::vector<Eigen::Triplet<double> > &trip,
+        int nx, int ny, int nz, int i, int j, int k,
+        int di, int dj, int dk, double coef) {
+
+    int ip = i + di;
+    int jp = j + dj;
+    int kp = k + dk;
+
+    if ((ip < 2) || (ip > nx-1) || (jp < 2) || (jp > ny-1) || (kp > nz-1))
+        return;
+
+    trip.push_back(Eigen::Triplet<double>(
+            ((k-2)*(ny-2) + (j-2))*(nx-2) + (i-2),
+            ((kp-2)*(ny-2) + (jp-2))*(nx-2) + (ip-2),
+            -coef));
+}
+
+VPUBLIC void Vbuildsparse(int *key, int *nx, int *ny, int *nz,
+        int *ipc, double *rpc, double *ac, double *cc,
+        int *ipcB, double *rpcB) {
+
+    int i, j, k, row;
+    int numdia;
+    int n = (*nx - 2) * (*ny - 2) * (*nz - 2);
+    int nxyz = *nx * *ny * *nz;
+
+    std::vector<Eigen::Triplet<double> > trip;
+    Vsparse_Mat A(n, n);
+    Vsparse_Fac *fac;
+
+    MAT2(ac, nxyz, 1);
+    MAT3(cc, *nx, *ny, *nz);
+
+    Vsparsefree(ipcB);
+
+    numdia = VAT(ipc, 11);
+    if ((numdia != 7) && (numdia != 27)) {
+        Vnm_print(2, "Vbuildsparse: invalid stencil type given...\n");
+        *key = 1;
+        return;
+    }
+
+    trip.reserve((size_t)n * ((numdia + 1) / 2));
+
+    for (k=2; k<=*nz-1; k++) {
+        for (j=2; j<=*ny-1; j++) {
+            for (i=2; i<=*nx-1; i++) {
+
+                // The offsets into the diagonals are those of Vmatvec
+                row = (k - 1) * *nx * *ny + (j - 1) * *nx + i;
+
+                trip.push_back(Eigen::Triplet<double>(
+                        ((k-2)*(*ny-2) + (j-2))*(*nx-2) + (i-2),
+                        ((k-2)*(*ny-2) + (j-2))*(*nx-2) + (i-2),
+                        VAT2(ac, row, 1) + VAT3(cc, i, j, k)));
+
+                // oE, oN, uC
+                Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  1,  0,  0,
+                        VAT2(ac, row, 2));
+                Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  0,  1,  0,
+                        VAT2(ac, row, 3));
+                Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  0,  0,  1,
+                        VAT2(ac, row, 4));
+
+                if (numdia == 27) {
+
+                    // oNE, oNW
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  1,  1,  0,
+                            VAT2(ac, row, 5));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k, -1,  1,  0,
+                            VAT2(ac, row, 6));
+
+                    // uE, uW, uN, uS
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  1,  0,  1,
+                            VAT2(ac, row, 7));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k, -1,  0,  1,
+                            VAT2(ac, row, 8));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  0,  1,  1,
+                            VAT2(ac, row, 9));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  0, -1,  1,
+                            VAT2(ac, row, 10));
+
+                    // uNE, uNW, uSE, uSW
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  1,  1,  1,
+                            VAT2(ac, row, 11));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k, -1,  1,  1,
+                            VAT2(ac, row, 12));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k,  1, -1,  1,
+                            VAT2(ac, row, 13));
+                    Vsparse_couple(trip, *nx, *ny, *nz, i, j, k, -1, -1,  1,
+                            VAT2(ac, row, 14));
+                }
+            }
+        }
+    }
+
+    A.setFromTriplets(trip.begin(), trip.end());
+
+    // Symbolic analysis (AMD ordering) and numeric factorization
+    fac = new Vsparse_Fac();
+    fac->compute(A);
+
+    VAT(ipcB, 1) = n;
+    VAT(ipcB, 4) = 0;
+    *key = 0;
+
+    if (fac->info() != Eigen::Success) {
+        Vnm_print(2, "Vbuildsparse: LDL^T factorization failed...\n");
+        delete fac;
+        *key = 1;
+        return;
+    }
+
+    VAT(ipcB, 4) = 1;
+    VAT(ipcB, 5) = Vsparse_store(fac);
+}
+
+VPUBLIC void Vsparsesl(int *ipcB, double *b) {
+
+    int n = VAT(ipcB, 1);
+    int id = VAT(ipcB, 5);
+
+    Eigen::Map<Eigen::VectorXd> x(b, n);
+
+    VASSERT((id >= 1) && (id <= (int)Vsparse_table.size()));
+    VASSERT(Vsparse_table[id-1] != VNULL);
+
+    x = Vsparse_table[id-1]->solve(Eigen::VectorXd(x));
+}
+
+VPUBLIC void Vsparsefree(int *ipcB) {
+
+    int id = VAT(ipcB, 5);
+
+    if ((id >= 1) && (id <= (int)Vsparse_table.size())) {
+        delete Vsparse_table[id-1];
+        Vsparse_table[id-1] = VNULL;
+    }
+    VAT(ipcB, 4) = 0;
+    VAT(ipcB, 5) = 0;
+}
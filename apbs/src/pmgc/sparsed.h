@@ -0,0 +1,104 @@
+/**
+ *  @ingroup PMGC
+ *  @brief  Sparse Cholesky solver for the coarsest multigrid level
+ *
+ *  @attention
+ *  @verbatim
+ *
+ * APBS -- Adaptive Poisson-Boltzmann Solver
+ *
+ * Nathan A. Baker (nathan.baker@pnl.gov)
+ * Pacific Northwest National Laboratory
+ *
+ * Additional contributing authors listed in the code documentation.
+ *
+ * Copyright (c) 2010-2014 Battelle Memorial Institute. Developed at the Pacific Northwest National Laboratory, operated by Battelle Memorial Institute, Pacific Northwest Division for the U.S. Department Energy.  Portions Copyright (c) 2002-2010, Washington University in St. Louis.  Portions Copyright (c) 2002-2010, Nathan A. Baker.  Portions Copyright (c) 1999-2002, The Regents of the University of California. Portions Copyright (c) 1995, Michael Holst.
+ * All rights reserved.
+ *
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * -  Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * - Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * - Neither the name of Washington University in St. Louis nor the names of its
+ * contributors may be used to endorse or promote products derived from this
+ * software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @endverbatim
+ */
+
+
+#ifndef _SPARSED_H_
+#define _SPARSED_H_
+
+#include "apbscfg.h"
+
+#include "maloc/maloc.h"
+
+#include "generic/vhal.h"
+#include "generic/vmatrix.h"
+
+/** @brief   Assemble the coarsest operator in compressed sparse form and
+ *           factor it
+ *  @ingroup PMGC
+ *
+ *  The interior unknowns of the 7- or 27-point operator (plus the
+ *  Helmholtz term cc on the diagonal) are assembled as a symmetric sparse
+ *  matrix and factored with a simplicial LDL^T after an approximate
+ *  minimum degree reordering.  The factor lives outside the work arrays;
+ *  ipcB(1) receives the number of unknowns, ipcB(4) is set once the
+ *  factorization succeeded and ipcB(5) holds the handle used by Vsparsesl.
+ *  Any factor already recorded in ipcB is released first.
+ *
+ *  @note  Counterpart of Vbuildband for mgsolv = 2
+ */
+VEXTERNC void Vbuildsparse(
+        int *key,     ///< Set to 1 if the factorization failed
+        int *nx,      ///< @todo:  Doc
+        int *ny,      ///< @todo:  Doc
+        int *nz,      ///< @todo:  Doc
+        int *ipc,     ///< @todo:  Doc
+        double *rpc,  ///< @todo:  Doc
+        double *ac,   ///< @todo:  Doc
+        double *cc,   ///< @todo:  Doc
+        int *ipcB,    ///< Parameters of the factored operator
+        double *rpcB  ///< @todo:  Doc
+        );
+
+/** @brief   Solve with the factor from Vbuildsparse
+ *  @ingroup PMGC
+ *
+ *  b holds the interior unknowns in natural ordering (as produced by
+ *  Vxcopy_small) and is overwritten with the solution.
+ */
+VEXTERNC void Vsparsesl(
+        int *ipcB,    ///< Parameters of the factored operator
+        double *b     ///< Right-hand side on input, solution on output
+        );
+
+/** @brief   Release the factor recorded in ipcB, if any
+ *  @ingroup PMGC
+ */
+VEXTERNC void Vsparsefree(
+        int *ipcB     ///< Parameters of the factored operator
+        );
+
+#endif /* _SPARSED_H_ */
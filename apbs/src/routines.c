@@ -55,6 +55,10 @@
 
 VEMBED(rcsid="$Id$")
 
+/* Grid memory shared by the Vpmg objects of a run: created by the first
+ * initMG, handed to every Vpmg through its Vpmgp and released by killMG */
+VPRIVATE Varena *mgArena = VNULL;
+
 VPUBLIC void startVio() { Vio_start(); }
 
 VPUBLIC Vparam* loadParameter(NOsh *nosh) {
@@ -1078,6 +1082,18 @@ harmonic average smoothing\n");
             Vnm_tprint( 1, "  Using spline-based surface definition;\
 window = %4.3f\n", pbeparm->swin);
             break;
+        case 5:
+            Vnm_tprint( 1, "  Using \"molecular\" surface \
+definition from a distance transform; no smoothing\n");
+            Vnm_tprint( 1, "  Solvent probe radius: %4.3f A\n",
+                        pbeparm->srad);
+            break;
+        case 6:
+            Vnm_tprint( 1, "  Using \"molecular\" surface definition \
+from a distance transform; harmonic average smoothing\n");
+            Vnm_tprint( 1, "  Solvent probe radius: %4.3f A\n",
+                        pbeparm->srad);
+            break;
         default:
             break;
     }
@@ -1227,6 +1243,8 @@ VPUBLIC int initMG(int icalc,
 
     int j,
         focusFlag,
+        keepOld,
+        filled,
         iatom;
     size_t bytesTotal,
            highWater;
@@ -1298,13 +1316,22 @@ VPUBLIC int initMG(int icalc,
         case PBE_NPBE:
             /* TEMPORARY USEAQUA */
             mgparm->nonlintype = NONLIN_NPBE;
+            if (mgparm->setmethod && (mgparm->method == VSOL_CGMG)) {
+                Vnm_tprint(2, "  CGMG solver is linear only; using Newton for NPBE\n");
+            }
             mgparm->method = (mgparm->useAqua == 1) ? VSOL_NewtonAqua : VSOL_Newton;
             pmgp[icalc] = Vpmgp_ctor(mgparm);
             break;
         case PBE_LPBE:
             /* TEMPORARY USEAQUA */
             mgparm->nonlintype = NONLIN_LPBE;
-            mgparm->method = (mgparm->useAqua == 1) ? VSOL_CGMGAqua : VSOL_MG;
+            if (mgparm->useAqua == 1) {
+                mgparm->method = VSOL_CGMGAqua;
+            } else if (mgparm->setmethod && (mgparm->method == VSOL_CGMG)) {
+                mgparm->method = VSOL_CGMG;
+            } else {
+                mgparm->method = VSOL_MG;
+            }
             pmgp[icalc] = Vpmgp_ctor(mgparm);
             break;
         case PBE_LRPBE:
@@ -1315,6 +1342,8 @@ VPUBLIC int initMG(int icalc,
             return 0;
         case PBE_SMPBE: /* SMPBE Added */
             mgparm->nonlintype = NONLIN_SMPBE;
+            /* Like NPBE, SMPBE is solved by Newton */
+            mgparm->method = (mgparm->useAqua == 1) ? VSOL_NewtonAqua : VSOL_Newton;
             pmgp[icalc] = Vpmgp_ctor(mgparm);
 
             /* Copy Code */
@@ -1327,12 +1356,24 @@ VPUBLIC int initMG(int icalc,
             Vnm_tprint(2, "Error!  Unknown PBE type (%d)!\n", pbeparm->pbetype);
             return 0;
     }
+    if (pbeparm->newton == 1) {
+        if ((pmgp[icalc]->nonlin != NONLIN_LPBE) &&
+            (pmgp[icalc]->meth == VSOL_Newton)) {
+            pmgp[icalc]->inewt = 1;
+        } else {
+            Vnm_tprint(2, "  Inexact Newton needs npbe or smpbe with the \
+Newton solver; ignoring newton inexact\n");
+        }
+    }
+    if (mgArena == VNULL) mgArena = Varena_ctor();
+    pmgp[icalc]->arena = mgArena;
     Vnm_tprint(0, "Setting PDE center to local center...\n");
     pmgp[icalc]->bcfl = pbeparm->bcfl;
     pmgp[icalc]->xcent = realCenter[0];
     pmgp[icalc]->ycent = realCenter[1];
     pmgp[icalc]->zcent = realCenter[2];
 
+    keepOld = 0;
     if (pbeparm->bcfl == BCFL_FOCUS) {
         if (icalc == 0) {
             Vnm_tprint( 2, "Can't focus first calculation!\n");
@@ -1346,10 +1387,20 @@ VPUBLIC int initMG(int icalc,
         we should be able to destroy it here. */
         /* Vpmg_dtor(&(pmg[icalc-1])); */
     } else {
-        if (icalc>0) Vpmg_dtor(&(pmg[icalc-1]));
+        /* The previous calculation may hand over its operator hierarchy,
+        its potential or its coefficient maps once the new coefficients are
+        known, so it is destroyed after fillco; its coefficient maps are
+        freed first unless they are to be patched */
+        keepOld = ((icalc > 0) &&
+                   (pmgp[icalc]->reuseops || mgparm->warmstart ||
+                    mgparm->reusemaps));
+        if ((icalc>0) && !keepOld) Vpmg_dtor(&(pmg[icalc-1]));
+        if (keepOld && !mgparm->reusemaps) {
+            Vpmg_releaseFine(pmg[icalc-1], mgparm->warmstart);
+        }
         pmg[icalc] = Vpmg_ctor(pmgp[icalc], pbe[icalc], 0, VNULL, mgparm, PCE_NO);
     }
-    if (icalc>0) {
+    if ((icalc>0) && !keepOld) {
         Vpmgp_dtor(&(pmgp[icalc-1]));
         Vpbe_dtor(&(pbe[icalc-1]));
     }
@@ -1415,8 +1466,20 @@ VPUBLIC int initMG(int icalc,
         return 0;
     }
 
-    // Initialize calculation coefficients
-    if (!Vpmg_fillco(pmg[icalc],
+    // Initialize calculation coefficients; for a variant of the previous
+    // molecule the previous ones may only need patching
+    filled = 0;
+    if (keepOld && mgparm->reusemaps && !pbeparm->useDielMap &&
+        !pbeparm->useKappaMap && !pbeparm->usePotMap &&
+        !pbeparm->useChargeMap) {
+        filled = Vpmg_fillcoFrom(pmg[icalc], pmg[icalc-1],
+                                 pbeparm->srfm, pbeparm->swin, mgparm->chgm);
+        if (!filled) {
+            Vnm_tprint(1, "  Molecule differs too much from the previous \
+one; filling the maps anew\n");
+        }
+    }
+    if (!filled && !Vpmg_fillco(pmg[icalc],
                      pbeparm->srfm, pbeparm->swin, mgparm->chgm,
                      pbeparm->useDielMap, theDielXMap,
                      pbeparm->useDielMap, theDielYMap,
@@ -1428,6 +1491,16 @@ VPUBLIC int initMG(int icalc,
         return 0;
     }
 
+    if (keepOld) {
+        if (mgparm->warmstart) {
+            Vpmg_setGuessPmg(pmg[icalc], pmg[icalc-1]);
+        }
+        Vpmg_adoptOps(pmg[icalc], pmg[icalc-1]);
+        Vpmg_dtor(&(pmg[icalc-1]));
+        Vpmgp_dtor(&(pmgp[icalc-1]));
+        Vpbe_dtor(&(pbe[icalc-1]));
+    }
+
     /* Print a few derived parameters */
 #ifndef VAPBSQUIET
     Vnm_tprint(1, "  Debye length:  %g A\n", Vpbe_getDeblen(pbe[icalc]));
@@ -1436,14 +1509,21 @@ VPUBLIC int initMG(int icalc,
     /* Setup time statistics */
     Vnm_tstop(APBS_TIMER_SETUP, "Setup timer");
 
-    /* Memory statistics */
-    bytesTotal = Vmem_bytesTotal();
-    highWater = Vmem_highWaterTotal();
+    /* Memory statistics; free arena blocks are cache, and the arena never
+       holds more than its peak in use */
+    bytesTotal = Vmem_bytesTotal() + Varena_busyBytes(mgArena);
+    highWater = Vmem_highWaterTotal() + Varena_peakBytes(mgArena);
 
 #ifndef VAPBSQUIET
     Vnm_tprint( 1, "  Current memory usage:  %4.3f MB total, \
 %4.3f MB high water\n", (double)(bytesTotal)/(1024.*1024.),
                 (double)(highWater)/(1024.*1024.));
+    if (mgArena != VNULL) {
+        Vnm_tprint( 1, "  Grid arena:  %4.3f MB in use, %4.3f MB cached\n",
+                   (double)(Varena_busyBytes(mgArena))/(1024.*1024.),
+                   (double)(Varena_bytes(mgArena)
+                            - Varena_busyBytes(mgArena))/(1024.*1024.));
+    }
 #endif
 
     return 1;
@@ -1474,6 +1554,18 @@ VPUBLIC void killMG(NOsh *nosh, Vpbe *pbe[NOSH_MAXCALC],
         Vpmgp_dtor(&(pmgp[i]));
     }
 
+    /* Any Vpmg still alive at this point has been abandoned (see the
+       focusing case of initMG), so its arena blocks can go as well */
+    if (mgArena != VNULL) {
+#ifndef VAPBSQUIET
+        Vnm_tprint(1, "  Grid arena:  %d of %d arrays recycled, %d \
+released early, %4.3f MB held\n", mgArena->nreuse,
+                   mgArena->nreuse + mgArena->nnew, mgArena->nrelease,
+                   (double)(Varena_bytes(mgArena))/(1024.*1024.));
+#endif
+        Varena_dtor(&mgArena);
+    }
+
 }
 
 VPUBLIC int solveMG(NOsh *nosh,
@@ -1594,10 +1686,8 @@ VPUBLIC int energyMG(NOsh *nosh,
         } else *totEnergy = 0;
     } else if (pbeparm->calcenergy == PCE_COMPS) {
         *nenergy = 1;
-        *totEnergy = Vpmg_energy(pmg, extEnergy);
-        *qfEnergy = Vpmg_qfEnergy(pmg, extEnergy);
-        *qmEnergy = Vpmg_qmEnergy(pmg, extEnergy);
-        *dielEnergy = Vpmg_dielEnergy(pmg, extEnergy);
+        *totEnergy = Vpmg_energyComps(pmg, extEnergy, qfEnergy, qmEnergy,
+                                      dielEnergy);
 #ifndef VAPBSQUIET
         Vnm_tprint( 1, "  Total electrostatic energy = %1.12E \
 kJ/mol\n", Vunit_kb*pbeparm->temp*(1e-3)*Vunit_Na*(*totEnergy));
@@ -1625,6 +1715,61 @@ kJ/mol\n", Vunit_kb*pbeparm->temp*(1e-3)*Vunit_Na*(*totEnergy));
     return 1;
 }
 
+VPUBLIC int blockMG(NOsh *nosh,
+                    int icalc,
+                    Vpmg *pmg,
+                    Vgrid *chargeMap[NOSH_MAXMOL]
+                   ) {
+
+    int i,
+        nmap;
+    double energy[MGPARM_MAXMAPS];
+    Vgrid *map[MGPARM_MAXMAPS];
+    MGparm *mgparm;
+    PBEparm *pbeparm;
+
+    mgparm = nosh->calc[icalc]->mgparm;
+    pbeparm = nosh->calc[icalc]->pbeparm;
+
+    nmap = mgparm->nblockmaps;
+    if ((nmap == 0) || nosh->bogus) return 1;
+
+    /* Focusing boundary values come from the potential of this
+     * calculation, not from those of the maps */
+    if (pbeparm->bcfl == BCFL_FOCUS) {
+        Vnm_tprint(2, "blockMG:  blockmaps does not work with focusing \
+boundary conditions!\n");
+        return 0;
+    }
+    for (i=0; i<nmap; i++) {
+        if ((mgparm->blockmaps[i] < 1) ||
+            (mgparm->blockmaps[i] > nosh->ncharge)) {
+            Vnm_tprint(2, "blockMG:  Charge map %d does not exist!\n",
+                       mgparm->blockmaps[i]);
+            return 0;
+        }
+        map[i] = chargeMap[mgparm->blockmaps[i]-1];
+    }
+
+    Vnm_tprint(1, "  Solving for %d charge maps in one block...\n", nmap);
+    Vnm_tstart(APBS_TIMER_SOLVER, "Solver timer");
+    if (!Vpmg_solveMaps(pmg, nmap, map, energy)) {
+        Vnm_print(2, "  Error during block solution!\n");
+        return 0;
+    }
+    Vnm_tstop(APBS_TIMER_SOLVER, "Solver timer");
+
+#ifndef VAPBSQUIET
+    for (i=0; i<nmap; i++) {
+        Vnm_tprint(1, "  Charge map %d:\n", mgparm->blockmaps[i]);
+        Vnm_tprint(1, "  Total electrostatic energy = %1.12E kJ/mol\n",
+                   Vunit_kb*pbeparm->temp*(1e-3)*Vunit_Na*energy[i]);
+    }
+#endif
+
+    return 1;
+}
+
 VPUBLIC int forceMG(Vmem *mem,
                     NOsh *nosh,
                     PBEparm *pbeparm,
@@ -1986,6 +2131,14 @@ VPUBLIC int writedataFlat(
                 fprintf(file,"    srfm spl2\n");
                 fprintf(file,"    srad %4.3f\n", pbeparm->srad);
                 break;
+            case 5:
+                fprintf(file,"    srfm mol-edt\n");
+                fprintf(file,"    srad %4.3f\n", pbeparm->srad);
+                break;
+            case 6:
+                fprintf(file,"    srfm smol-edt\n");
+                fprintf(file,"    srad %4.3f\n", pbeparm->srad);
+                break;
             default:
                 break;
         }
@@ -2232,6 +2385,14 @@ VPUBLIC int writedataXML(NOsh *nosh, Vcom *com, const char *fname,
             case 2:
                 fprintf(file,"      <srfm>spl2</srfm>\n");
                 break;
+            case 5:
+                fprintf(file,"      <srfm>mol-edt</srfm>\n");
+                fprintf(file,"      <srad>%4.3f</srad>\n", pbeparm->srad);
+                break;
+            case 6:
+                fprintf(file,"      <srfm>smol-edt</srfm>\n");
+                fprintf(file,"      <srad>%4.3f</srad>\n", pbeparm->srad);
+                break;
             default:
                 break;
         }
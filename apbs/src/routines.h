@@ -305,6 +305,18 @@ VEXTERNC int energyMG(NOsh* nosh, int icalc, Vpmg *pmg,
   int *nenergy, double *totEnergy, double *qfEnergy, double *qmEnergy,
   double *dielEnergy);
 
+/**
+ * @brief  Solve for the charge maps of the blockmaps keyword on the operator
+ *         of an MG calculation and print their energies
+ * @ingroup  Frontend
+ * @param nosh  Object with parsed input file parameters
+ * @param icalc  Index of calculation
+ * @param pmg  MG object, solved
+ * @param chargeMap  Charge maps
+ * @return  1 if successful (or there are no such maps), 0 otherwise */
+VEXTERNC int blockMG(NOsh *nosh, int icalc, Vpmg *pmg,
+  Vgrid *chargeMap[NOSH_MAXMOL]);
+
 /**
  * @brief  Kill arrays allocated for energies
  * @ingroup  Frontend
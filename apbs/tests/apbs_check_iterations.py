@@ -0,0 +1,84 @@
+#! /usr/bin/env python
+
+"""
+Compares the multigrid iteration counts of two apbs runs
+"""
+
+import sys, re
+from apbs_logger import Logger
+
+# The multigrid drivers report each iteration to io.mc through Vprtstp
+iteration_pattern = r'iteration = (\d+)'
+
+
+
+def extract_iterations( mc_file ):
+    """
+    Extracts the number of iterations taken by each solve logged in mc_file
+    """
+
+    f = None
+    try:
+        f = open( mc_file, 'r' )
+    except IOError:
+        print >> sys.stderr, "Couldn't read from iteration log %s" % mc_file
+        return []
+
+    # Every solve starts by reporting iteration 0
+    iteration_list = []
+    for line in f.readlines():
+        m = re.search( iteration_pattern, line )
+        if m:
+            iteration = int( m.group( 1 ) )
+            if iteration == 0 or iteration_list == []:
+                iteration_list.append( iteration )
+            else:
+                iteration_list[ -1 ] = iteration
+
+    return iteration_list
+
+
+
+def check_iterations( test_iterations, reference_iterations, tolerance, input_file, logger ):
+    """
+    Checks that the total iteration count of a run is within tolerance percent
+    of the count of its reference run
+    """
+
+    logger.both( "Checking iteration counts for input file %s" % input_file )
+    logger.message( "Iterations per solve:  %s" % test_iterations )
+    logger.message( "Reference iterations:  %s" % reference_iterations )
+
+    test_total = sum( test_iterations )
+    reference_total = sum( reference_iterations )
+
+    if reference_total == 0 or len( test_iterations ) != len( reference_iterations ):
+        logger.message( "*** FAILED ***" )
+        logger.message( "   Could not match %d solves against %d reference solves" % ( len( test_iterations ), len( reference_iterations ) ) )
+        logger.log( "FAILED (iteration logs do not match)" )
+        return
+
+    error = abs( test_total - reference_total ) * 100.0 / reference_total
+
+    if error <= tolerance:
+        logger.message( "*** PASSED ***" )
+        logger.log( "PASSED %d iterations (reference %d; %g%% difference)" % ( test_total, reference_total, error ) )
+    else:
+        logger.message( "*** FAILED ***" )
+        logger.message( "   APBS took %d iterations" % test_total )
+        logger.message( "   Reference took %d iterations (%g%% difference)" % ( reference_total, error ) )
+        logger.log( "FAILED (%d iterations; reference %d; %g%% difference)" % ( test_total, reference_total, error ) )
+
+
+
+def test():
+    l = open( 'iterations.log', 'w' )
+    logger = Logger( sys.stderr, l )
+    iteration_list = extract_iterations( 'io.mc' )
+    check_iterations( iteration_list, iteration_list, 0.0, 'io.mc', logger )
+
+
+
+if __name__ == '__main__':
+    print >> sys.stderr, "The python source file %s is a module and not runnable" % sys.argv[ 0 ]
+    sys.exit( 1 )
@@ -15,6 +15,7 @@ from inputgen import splitInput
 from apbs_check_forces import check_forces
 from apbs_check_results import check_results
 from apbs_check_intermediate_energies import check_energies
+from apbs_check_iterations import extract_iterations, check_iterations
 from apbs_logger import Logger
 
 # Matches a floating point number such as -1.23456789E-20
@@ -154,7 +155,57 @@ def run_test( binary, test_files, test_name, test_directory, setup, logger, ocd
             logger.log( 'Testing forces from %s' % input_file )
             start_time = datetime.datetime.now()
             check_forces( input_file, 'polarforces', 'apolarforces', logger )
-            
+
+        # If the expected results name a reference input, run both and compare
+        elif expected_results.startswith( 'iterations' ):
+            ( reference_name, tolerance ) = expected_results.split()[ 1: ]
+            reference_file = '%s.in' % reference_name
+            logger.message( '-' * 80 )
+            logger.message( 'Testing input file %s against %s' % ( input_file, reference_file ) )
+            logger.message( '' )
+            logger.log( 'Testing %s against %s' % ( input_file, reference_file ) )
+            start_time = datetime.datetime.now()
+
+            # The iteration log is only written while apbs runs
+            if os.path.exists( 'io.mc' ):
+                os.remove( 'io.mc' )
+            reference_results = process_serial( binary, reference_file )
+            reference_iterations = extract_iterations( 'io.mc' )
+
+            if os.path.exists( 'io.mc' ):
+                os.remove( 'io.mc' )
+            computed_results = process_serial( binary, input_file )
+            computed_iterations = extract_iterations( 'io.mc' )
+
+            # The energies must agree with the reference run
+            for ( computed_result, reference_result ) in zip( computed_results, reference_results ):
+                logger.message( "Testing computed result %.12E against reference result %12E" % ( computed_result, reference_result ) )
+                check_results( computed_result, reference_result, input_file, logger, ocd )
+
+            check_iterations( computed_iterations, reference_iterations, float( tolerance ), input_file, logger )
+
+        # If the expected results name a reference input and a tolerance in
+        # percent, run both and compare their energies within it
+        elif expected_results.startswith( 'compare' ):
+            ( reference_name, tolerance ) = expected_results.split()[ 1: ]
+            reference_file = '%s.in' % reference_name
+            logger.message( '-' * 80 )
+            logger.message( 'Testing input file %s against %s within %s%%' % ( input_file, reference_file, tolerance ) )
+            logger.message( '' )
+            logger.log( 'Testing %s against %s within %s%%' % ( input_file, reference_file, tolerance ) )
+            start_time = datetime.datetime.now()
+
+            reference_results = process_serial( binary, reference_file )
+            computed_results = process_serial( binary, input_file )
+
+            if len( computed_results ) != len( reference_results ):
+                logger.message( "*** FAILED ***" )
+                logger.log( "FAILED (%d results; reference %d)" % ( len( computed_results ), len( reference_results ) ) )
+
+            for ( computed_result, reference_result ) in zip( computed_results, reference_results ):
+                logger.message( "Testing computed result %.12E against reference result %12E" % ( computed_result, reference_result ) )
+                check_results( computed_result, reference_result, input_file, logger, False, float( tolerance ) / 100.0 )
+
         else:
             logger.message( '-' * 80 )
             logger.message( 'Testing input file %s' % input_file )